@@ -21,6 +21,7 @@
 #include "CBot/CBotCStack.h"
 
 #include "CBot/CBotClass.h"
+#include "CBot/CBotContext.h"
 #include "CBot/CBotToken.h"
 #include "CBot/CBotExternalCall.h"
 
@@ -406,7 +407,7 @@ bool CBotCStack::CheckCall(CBotToken* &pToken, CBotDefParam* pParam, const std::
         }
     }
 
-    for (CBotFunction* pp : CBotFunction::m_publicFunctions)
+    for (CBotFunction* pp : CBotContext::GetCurrent().publicFunctions)
     {
         if ( name == pp->GetName() )
         {
@@ -31,6 +31,7 @@
 
 #include "CBot/CBotVar/CBotVar.h"
 
+#include "CBot/CBotContext.h"
 #include "CBot/CBotExternalCall.h"
 #include "CBot/CBotStack.h"
 #include "CBot/CBotCStack.h"
@@ -42,30 +43,29 @@
 namespace CBot
 {
 
-////////////////////////////////////////////////////////////////////////////////
-std::set<CBotClass*> CBotClass::m_publicClasses{};
-
 ////////////////////////////////////////////////////////////////////////////////
 CBotClass::CBotClass(const std::string& name,
                      CBotClass* parent,
                      bool bIntrinsic)
+    : m_context(&CBotContext::GetCurrent())
 {
     m_parent    = parent;
     m_name      = name;
     m_pVar      = nullptr;
     m_externalMethods = new CBotExternalCallList();
     m_rUpdate   = nullptr;
+    m_rUpdateItem = nullptr;
     m_IsDef     = true;
     m_bIntrinsic= bIntrinsic;
     m_nbVar     = m_parent == nullptr ? 0 : m_parent->m_nbVar;
 
-    m_publicClasses.insert(this);
+    m_context->publicClasses.insert(this);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 CBotClass::~CBotClass()
 {
-    m_publicClasses.erase(this);
+    m_context->publicClasses.erase(this);
 
     delete  m_pVar;
     delete  m_externalMethods;
@@ -82,9 +82,10 @@ CBotClass* CBotClass::Create(const std::string& name,
 ////////////////////////////////////////////////////////////////////////////////
 void CBotClass::ClearPublic()
 {
-    while ( !m_publicClasses.empty() )
+    auto& publicClasses = CBotContext::GetCurrent().publicClasses;
+    while ( !publicClasses.empty() )
     {
-        auto it = m_publicClasses.begin();
+        auto it = publicClasses.begin();
         delete *it; // calling destructor removes the class from the list
     }
 }
@@ -138,7 +139,7 @@ void CBotClass::Unlock()
 ////////////////////////////////////////////////////////////////////////////////
 void CBotClass::FreeLock(CBotProgram* prog)
 {
-    for (CBotClass* pClass : m_publicClasses)
+    for (CBotClass* pClass : CBotContext::GetCurrent().publicClasses)
     {
         if (pClass->m_lockProg.size() > 0 && prog == pClass->m_lockProg[0])
         {
@@ -276,7 +277,7 @@ CBotClass* CBotClass::Find(CBotToken* &pToken)
 ////////////////////////////////////////////////////////////////////////////////
 CBotClass* CBotClass::Find(const std::string& name)
 {
-    for (CBotClass* p : m_publicClasses)
+    for (CBotClass* p : CBotContext::GetCurrent().publicClasses)
     {
         if ( p->GetName() == name ) return p;
     }
@@ -299,6 +300,22 @@ bool CBotClass::SetUpdateFunc(void rUpdate(CBotVar* thisVar, void* user))
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotClass::SetUpdateItemFunc(void rUpdateItem(CBotVar* thisVar, CBotVar* item, void* user))
+{
+    m_rUpdateItem = rUpdateItem;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool CBotClass::SetStateFunc(bool rSave(CBotVar* thisVar, std::ostream &ostr),
+                             bool rRestore(CBotVar* thisVar, std::istream &istr))
+{
+    m_rSaveState = rSave;
+    m_rRestoreState = rRestore;
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 CBotTypResult CBotClass::CompileMethode(CBotToken* name,
                                         CBotVar* pThis,
@@ -368,7 +385,7 @@ bool CBotClass::SaveStaticState(std::ostream &ostr)
     if (!WriteLong(ostr, CBOTVERSION*2)) return false;
 
     // saves the state of static variables in classes
-    for (CBotClass* p : m_publicClasses)
+    for (CBotClass* p : CBotContext::GetCurrent().publicClasses)
     {
         if (!WriteWord(ostr, 1)) return false;
         // save the name of the class
@@ -811,7 +828,36 @@ CBotClass* CBotClass::Compile(CBotToken* &p, CBotCStack* pStack)
 
 void CBotClass::Update(CBotVar* var, void* user)
 {
-    m_rUpdate(var, user);
+    if (m_rUpdate != nullptr) m_rUpdate(var, user);
+
+    if (m_rUpdateItem != nullptr)
+    {
+        for (CBotVar* item = var->GetItemList(); item != nullptr; item = item->GetNext())
+            m_rUpdateItem(var, item, user);
+    }
+}
+
+void CBotClass::UpdateItem(CBotVar* var, CBotVar* item, void* user)
+{
+    if (m_rUpdateItem != nullptr) m_rUpdateItem(var, item, user);
+}
+
+bool CBotClass::SaveInstanceState(CBotVar* var, std::ostream &ostr)
+{
+    for (CBotClass* pClass = this; pClass != nullptr; pClass = pClass->m_parent)
+    {
+        if (pClass->m_rSaveState != nullptr) return pClass->m_rSaveState(var, ostr);
+    }
+    return true;
+}
+
+bool CBotClass::RestoreInstanceState(CBotVar* var, std::istream &istr)
+{
+    for (CBotClass* pClass = this; pClass != nullptr; pClass = pClass->m_parent)
+    {
+        if (pClass->m_rRestoreState != nullptr) return pClass->m_rRestoreState(var, istr);
+    }
+    return true;
 }
 
 } // namespace CBot
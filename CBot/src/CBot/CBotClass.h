@@ -32,6 +32,7 @@ namespace CBot
 {
 
 class CBotCallMethode;
+class CBotContext;
 class CBotFunction;
 class CBotProgram;
 class CBotStack;
@@ -149,7 +150,43 @@ public:
      * \return
      */
     bool SetUpdateFunc(void rUpdate(CBotVar* thisVar, void* user));
-    //
+
+    /*!
+     * \brief SetUpdateItemFunc Defines routine to be called to update a single
+     * element of the class.
+     *
+     * Unlike with SetUpdateFunc(), the update of an instance is then delayed
+     * until its elements are used, and only the elements which are used are
+     * updated. Reading one field of an instance costs as much as updating that
+     * field alone, regardless of how many fields the class has. Each element
+     * is updated at most once per update request, and an update still pending
+     * when the user pointer of the instance changes (e.g. to OBJECTDELETED)
+     * is completed first.
+     * \param rUpdateItem Function called with the instance and the element to update
+     * \return
+     */
+    bool SetUpdateItemFunc(void rUpdateItem(CBotVar* thisVar, CBotVar* item, void* user));
+
+    /*!
+     * \brief HasUpdateItemFunc
+     * \return true if elements of instances are updated one by one, see SetUpdateItemFunc()
+     */
+    bool HasUpdateItemFunc() const { return m_rUpdateItem != nullptr; }
+
+    /*!
+     * \brief SetStateFunc Defines routines to save and restore the state of
+     * instances which is not held in their elements, like the contents of
+     * a native container.
+     *
+     * rSave is called after the elements of an instance are saved and
+     * rRestore after they are restored. rRestore is given nullptr if the
+     * restored instance already exists, it must then only skip the saved state.
+     * \param rSave Function saving the state of an instance
+     * \param rRestore Function restoring the state of an instance
+     * \return
+     */
+    bool SetStateFunc(bool rSave(CBotVar* thisVar, std::ostream &ostr),
+                      bool rRestore(CBotVar* thisVar, std::istream &istr));
 
     /*!
      * \brief AddItem Adds an element to the class.
@@ -380,10 +417,34 @@ public:
 
     void Update(CBotVar* var, void* user);
 
-private:
-    //! List of all public classes
-    static std::set<CBotClass*> m_publicClasses;
+    /*!
+     * \brief UpdateItem Updates a single element of an instance
+     * \param var Instance
+     * \param item Element of the instance to update
+     * \param user User pointer
+     */
+    void UpdateItem(CBotVar* var, CBotVar* item, void* user);
+
+    /*!
+     * \brief SaveInstanceState Saves the state of an instance set by SetStateFunc()
+     * of this class or of the nearest parent class which has one
+     * \param var Instance
+     * \param ostr Output stream
+     * \return false on write error
+     */
+    bool SaveInstanceState(CBotVar* var, std::ostream &ostr);
+
+    /*!
+     * \brief RestoreInstanceState Restores the state saved by SaveInstanceState()
+     * \param var Instance, nullptr to skip the saved state
+     * \param istr Input stream
+     * \return false on read error
+     */
+    bool RestoreInstanceState(CBotVar* var, std::istream &istr);
 
+private:
+    //! Context this class is public in, see CBotContext::publicClasses
+    CBotContext* const m_context;
 
     //! true if this class is fully compiled, false if only precompiled
     bool m_IsDef;
@@ -402,6 +463,9 @@ private:
     //! List of all class methods
     std::list<CBotFunction*> m_pMethod{};
     void (*m_rUpdate)(CBotVar* thisVar, void* user);
+    void (*m_rUpdateItem)(CBotVar* thisVar, CBotVar* item, void* user);
+    bool (*m_rSaveState)(CBotVar* thisVar, std::ostream &ostr) = nullptr;
+    bool (*m_rRestoreState)(CBotVar* thisVar, std::istream &istr) = nullptr;
 
     CBotToken* m_pOpenblk;
 
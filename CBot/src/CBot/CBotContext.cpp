@@ -0,0 +1,87 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBotContext.h"
+
+#include "CBot/CBotClass.h"
+#include "CBot/CBotExternalCall.h"
+
+#include "CBot/stdlib/Containers.h"
+#include "CBot/stdlib/stdlib_public.h"
+
+namespace CBot
+{
+
+namespace
+{
+
+thread_local CBotContext* g_currentContext = nullptr;
+
+} // namespace
+
+CBotContext::CBotContext()
+{
+}
+
+CBotContext::~CBotContext()
+{
+    CBotContextGuard guard(*this);
+
+    files.clear();
+    ClearContainers();
+    externalCalls.reset();
+
+    // calling destructor removes the class from the list
+    while (!publicClasses.empty())
+        delete *publicClasses.begin();
+}
+
+void CBotContext::ClearContainers()
+{
+    // values may hold the last reference to another container
+    auto removed = std::move(containers);
+    containers.clear();
+    removed.clear();
+}
+
+CBotContext& CBotContext::GetCurrent()
+{
+    if (g_currentContext != nullptr) return *g_currentContext;
+    return GetDefault();
+}
+
+CBotContext& CBotContext::GetDefault()
+{
+    // Never destroyed, so it stays usable while static objects of the host are destroyed
+    static CBotContext* context = new CBotContext();
+    return *context;
+}
+
+CBotContextGuard::CBotContextGuard(CBotContext& context)
+    : m_previous(g_currentContext)
+{
+    g_currentContext = &context;
+}
+
+CBotContextGuard::~CBotContextGuard()
+{
+    g_currentContext = m_previous;
+}
+
+} // namespace CBot
@@ -0,0 +1,129 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace CBot
+{
+
+class CBotClass;
+class CBotContainer;
+class CBotExternalCallList;
+class CBotFile;
+class CBotFunction;
+class CBotVarClass;
+
+/**
+ * \brief State of one independent instance of the CBot runtime
+ *
+ * Public classes and functions, constants defined with CBotProgram::DefineNum(),
+ * external functions added with CBotProgram::AddFunction() and class instances
+ * are only visible to programs of the same context.
+ *
+ * Programs of different contexts can be compiled and run at the same time on
+ * different threads. One context must only be used by one thread at a time.
+ *
+ * Each thread has a current context, which the static functions of CBotProgram
+ * and CBotClass work with. It is the default context of the process unless
+ * changed with CBotContextGuard. Each CBotProgram makes the context which was
+ * current when it was created current again while it compiles or runs.
+ *
+ * \code
+ * CBotContext context;
+ * CBotContextGuard guard(context);
+ *
+ * CBotProgram::Init();
+ * auto program = std::make_unique<CBotProgram>();
+ * program->Compile(code, externFunctions);
+ * // ...
+ * program.reset();
+ * CBotProgram::Free();
+ * \endcode
+ */
+class CBotContext
+{
+public:
+    CBotContext();
+    ~CBotContext();
+
+    CBotContext(const CBotContext&) = delete;
+    CBotContext& operator=(const CBotContext&) = delete;
+
+    /**
+     * \brief Returns the current context of the calling thread
+     */
+    static CBotContext& GetCurrent();
+
+    /**
+     * \brief Returns the default context, current on threads which did not select another one
+     */
+    static CBotContext& GetDefault();
+
+    /**
+     * \brief Removes the contents of all maps and sets
+     */
+    void ClearContainers();
+
+    //! External functions, see CBotProgram::AddFunction()
+    std::unique_ptr<CBotExternalCallList> externalCalls;
+    //! Public classes, see CBotClass::Find()
+    std::set<CBotClass*> publicClasses;
+    //! Public functions of all programs
+    std::set<CBotFunction*> publicFunctions;
+    //! Constants, see CBotProgram::DefineNum()
+    std::map<std::string, long> defineNum;
+    //! Instances of classes, by unique identifier
+    std::set<CBotVarClass*> instances;
+    //! Last unique identifier given to a variable, see CBotVar::NextUniqNum()
+    long identCounter = 0;
+    //! Files opened by programs
+    std::unordered_map<int, std::unique_ptr<CBotFile>> files;
+    //! Next file handle given to programs
+    int nextFileId = 1;
+    //! Contents of instances of the map and set classes
+    std::unordered_map<int, std::unique_ptr<CBotContainer>> containers;
+    //! Next container handle
+    int nextContainerId = 1;
+};
+
+/**
+ * \brief Makes a context current on the calling thread for its lifetime
+ *
+ * The previously current context is restored on destruction, so guards can be nested.
+ */
+class CBotContextGuard
+{
+public:
+    explicit CBotContextGuard(CBotContext& context);
+    ~CBotContextGuard();
+
+    CBotContextGuard(const CBotContextGuard&) = delete;
+    CBotContextGuard& operator=(const CBotContextGuard&) = delete;
+
+private:
+    CBotContext* m_previous;
+};
+
+} // namespace CBot
@@ -274,6 +274,7 @@ enum CBotError : int
     CBotErrNotOpen       = 6013, //!< channel not open
     CBotErrRead          = 6014, //!< error while reading
     CBotErrWrite         = 6015, //!< writing error
+    CBotErrBadValueType  = 6016, //!< stored value does not have the type of the result
 
     CBotErrMAX, //!< Max errors
 };
@@ -77,10 +77,11 @@ int CBotExternalCallList::DoCall(CBotToken* token, CBotVar* thisVar, CBotVar** p
     if (token == nullptr)
         return -1;
 
-    if (m_list.count(token->GetString()) == 0)
+    auto it = m_list.find(token->GetString());
+    if (it == m_list.end())
         return -1;
 
-    CBotExternalCall* pt = m_list[token->GetString()].get();
+    CBotExternalCall* pt = it->second.get();
 
     if (thisVar == nullptr && pStack->IsCallFinished()) return true;  // only for non-method external call
 
@@ -89,8 +90,9 @@ int CBotExternalCallList::DoCall(CBotToken* token, CBotVar* thisVar, CBotVar** p
 
     if (pile->GetState() == 0) // the first time?
     {
-        // lists the parameters depending on the contents of the stack
-        CBotVar* pVar = MakeListVars(ppVar, true);
+        // lists the parameters depending on the contents of the stack,
+        // they are the results of the evaluation of the arguments and not used afterwards
+        CBotVar* pVar = MoveListVars(ppVar);
         pile->SetVar(pVar);
 
         CBotStack* pile2 = pile->AddStack();
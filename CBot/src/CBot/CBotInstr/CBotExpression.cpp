@@ -21,6 +21,7 @@
 
 #include "CBot/CBotInstr/CBotInstrUtils.h"
 
+#include "CBot/CBotInstr/CBotStringAppend.h"
 #include "CBot/CBotInstr/CBotTwoOpExpr.h"
 
 #include "CBot/CBotStack.h"
@@ -48,7 +49,7 @@ CBotExpression::~CBotExpression()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-CBotInstr* CBotExpression::Compile(CBotToken* &p, CBotCStack* pStack)
+CBotInstr* CBotExpression::Compile(CBotToken* &p, CBotCStack* pStack, bool bStatement)
 {
     CBotToken*    pp = p;
 
@@ -78,6 +79,7 @@ CBotInstr* CBotExpression::Compile(CBotToken* &p, CBotCStack* pStack)
             return nullptr;
         }
 
+        CBotToken* pRight = p;
         inst->m_rightop = CBotExpression::Compile(p, pStack);
         if (inst->m_rightop == nullptr)
         {
@@ -142,6 +144,17 @@ CBotInstr* CBotExpression::Compile(CBotToken* &p, CBotCStack* pStack)
             return nullptr;
         }
 
+        if (bStatement)
+        {
+            // appending to a string can be done without copying it
+            CBotInstr* append = CBotStringAppend::Compile(inst, pRight, p, var);
+            if (append != nullptr)
+            {
+                delete inst;
+                return append;
+            }
+        }
+
         return inst;        // compatible type?
     }
 
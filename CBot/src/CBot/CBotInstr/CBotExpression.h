@@ -48,9 +48,10 @@ public:
      * \brief Compile
      * \param p
      * \param pStack
+     * \param bStatement true if the value of the expression is not used
      * \return
      */
-    static CBotInstr* Compile(CBotToken* &p, CBotCStack* pStack);
+    static CBotInstr* Compile(CBotToken* &p, CBotCStack* pStack, bool bStatement = false);
 
     /*!
      * \brief Execute Executes an expression with assignment.
@@ -75,6 +76,7 @@ private:
     CBotLeftExpr* m_leftop;
     //! Right operand
     CBotInstr* m_rightop;
+    friend class CBotStringAppend;
 };
 
 } // namespace CBot
@@ -27,6 +27,7 @@
 #include "CBot/CBotInstr/CBotEmpty.h"
 #include "CBot/CBotInstr/CBotListArray.h"
 
+#include "CBot/CBotContext.h"
 #include "CBot/CBotStack.h"
 #include "CBot/CBotCStack.h"
 #include "CBot/CBotClass.h"
@@ -54,9 +55,6 @@ CBotFunction::CBotFunction()
     m_bSynchro    = false;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-std::set<CBotFunction*> CBotFunction::m_publicFunctions{};
-
 ////////////////////////////////////////////////////////////////////////////////
 CBotFunction::~CBotFunction()
 {
@@ -66,7 +64,7 @@ CBotFunction::~CBotFunction()
     // remove public list if there is
     if (m_bPublic)
     {
-        m_publicFunctions.erase(this);
+        CBotContext::GetCurrent().publicFunctions.erase(this);
     }
 }
 
@@ -531,7 +529,7 @@ CBotFunction* CBotFunction::FindLocalOrPublic(const std::list<CBotFunction*>& lo
         }
 
         // search the list of public functions
-        for (CBotFunction* pt : m_publicFunctions)
+        for (CBotFunction* pt : CBotContext::GetCurrent().publicFunctions)
         {
             if (pt->m_nFuncIdent == nIdent)
             {
@@ -641,7 +639,7 @@ void CBotFunction::SearchPublic(const std::string& name, CBotVar** ppVars, CBotT
                                 std::map<CBotFunction*, int>& funcMap, CBotClass* pClass)
 {
     {
-        for (CBotFunction* pt : m_publicFunctions)
+        for (CBotFunction* pt : CBotContext::GetCurrent().publicFunctions)
         {
             if ( pt->m_token.GetString() == name )
             {
@@ -979,7 +977,7 @@ CBotFunction* CBotFunction::FindMethod(long& nIdent, const std::string& name,
         // search the list of public functions
         if (!skipPublic)
         {
-            for (CBotFunction* pt : m_publicFunctions)
+            for (CBotFunction* pt : CBotContext::GetCurrent().publicFunctions)
             {
                 if (pt->m_nFuncIdent == nIdent)
                 {
@@ -1214,7 +1212,7 @@ const std::string& CBotFunction::GetClassName() const
 ////////////////////////////////////////////////////////////////////////////////
 void CBotFunction::AddPublic(CBotFunction* func)
 {
-    m_publicFunctions.insert(func);
+    CBotContext::GetCurrent().publicFunctions.insert(func);
 }
 
 bool CBotFunction::HasReturn()
@@ -358,9 +358,6 @@ private:
     CBotToken m_openblk;
     CBotToken m_closeblk;
 
-    //! List of public functions
-    static std::set<CBotFunction*> m_publicFunctions;
-
     friend class CBotProgram;
     friend class CBotClass;
     friend class CBotCStack;
@@ -48,8 +48,8 @@ namespace CBot
 {
 
 ////////////////////////////////////////////////////////////////////////////////
-int CBotInstr::m_LoopLvl = 0;
-std::vector<std::string> CBotInstr::m_labelLvl = std::vector<std::string>();
+thread_local int CBotInstr::m_LoopLvl = 0;
+thread_local std::vector<std::string> CBotInstr::m_labelLvl = std::vector<std::string>();
 
 ////////////////////////////////////////////////////////////////////////////////
 CBotInstr::CBotInstr()
@@ -260,7 +260,9 @@ CBotInstr* CBotInstr::Compile(CBotToken* &p, CBotCStack* pStack)
     CBotToken*    ppp = p;
     if (IsOfType(ppp, TokenTypVar))
     {
-        if (CBotClass::Find(p) != nullptr) // Does class with this name exist?
+        // Does class with this name exist, followed by a name or "[]"?
+        // Otherwise names of classes such as "map" or "set" can still be used for variables and functions
+        if (CBotClass::Find(p) != nullptr && (ppp->GetType() == TokenTypVar || ppp->GetType() == ID_OPBRK))
         {
             // Yes, compile the declaration of the instance
             return CBotDefClass::Compile(p, pStack);
@@ -268,7 +270,7 @@ CBotInstr* CBotInstr::Compile(CBotToken* &p, CBotCStack* pStack)
     }
 
     // This can be an arithmetic expression
-    CBotInstr* inst = CBotExpression::Compile(p, pStack);
+    CBotInstr* inst = CBotExpression::Compile(p, pStack, true);
     if (IsOfType(p, ID_SEP))
     {
         return inst;
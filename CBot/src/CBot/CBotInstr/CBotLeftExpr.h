@@ -96,6 +96,7 @@ protected:
 
 private:
     long m_nIdent;
+    friend class CBotStringAppend;
 };
 
 } // namespace CBot
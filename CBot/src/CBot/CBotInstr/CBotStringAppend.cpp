@@ -0,0 +1,197 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBotInstr/CBotStringAppend.h"
+
+#include "CBot/CBotInstr/CBotExpression.h"
+#include "CBot/CBotInstr/CBotTwoOpExpr.h"
+
+#include "CBot/CBotStack.h"
+
+#include "CBot/CBotVar/CBotVarString.h"
+
+#include <cmath>
+
+namespace CBot
+{
+
+////////////////////////////////////////////////////////////////////////////////
+CBotStringAppend::CBotStringAppend()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotStringAppend::~CBotStringAppend()
+{
+    for (CBotInstr* value : m_values)
+        delete value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotStringAppend* CBotStringAppend::Compile(CBotExpression* expr, CBotToken* start, CBotToken* end, CBotVar* var)
+{
+    CBotLeftExpr* left = expr->m_leftop;
+    int opType = expr->GetTokenType();
+
+    if (var->GetType() != CBotTypString) return nullptr;
+    if (left->m_next3 != nullptr) return nullptr;       // only a local variable, not a field or an element
+
+    // "s = s + a + b" is made of CBotTwoOpExpr "((s + a) + b)"
+    std::vector<CBotTwoOpExpr*> additions;
+    if (opType == ID_ASS)
+    {
+        CBotToken* next = start->GetNext();
+        if (start->GetType() != TokenTypVar || start->GetString() != left->GetToken()->GetString() ||
+            next == nullptr || next->GetType() != ID_ADD)
+            return nullptr;
+
+        CBotInstr* op = expr->m_rightop;
+        while (op->GetTokenType() == ID_ADD)
+        {
+            CBotTwoOpExpr* addition = static_cast<CBotTwoOpExpr*>(op);
+            additions.push_back(addition);
+            op = addition->m_leftop;
+        }
+        // the leftmost operand must be the first token, the variable itself
+        if (additions.empty() || op->GetToken()->GetStart() != start->GetStart()) return nullptr;
+        start = next;
+    }
+    else if (opType != ID_ASSADD)
+    {
+        return nullptr;
+    }
+
+    // appended values are evaluated before appending, so they must not use the variable
+    for (CBotToken* p = start; p != nullptr && p != end; p = p->GetNext())
+    {
+        if (p->GetType() == TokenTypVar && p->GetString() == left->GetToken()->GetString()) return nullptr;
+    }
+
+    CBotStringAppend* inst = new CBotStringAppend();
+    inst->SetToken(left->GetToken());
+    inst->m_nIdent = left->m_nIdent;
+
+    if (opType == ID_ASS)
+    {
+        inst->m_checkNan = true;
+        for (auto it = additions.rbegin(); it != additions.rend(); ++it)
+        {
+            inst->m_values.push_back((*it)->m_rightop);
+            inst->m_operators.push_back(*(*it)->GetToken());
+            (*it)->m_rightop = nullptr;
+        }
+    }
+    else
+    {
+        inst->m_values.push_back(expr->m_rightop);
+        inst->m_operators.push_back(*expr->GetToken());
+        expr->m_rightop = nullptr;
+    }
+
+    return inst;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool CBotStringAppend::Execute(CBotStack* &pj)
+{
+    CBotStack* pile = pj->AddStack(this);
+
+    // evaluates the values, each one on its own level of the stack
+    CBotStack* pk = pile;
+    for (std::size_t i = 0; i < m_values.size(); ++i)
+    {
+        pk = pk->AddStack();
+        if (pk->StackOver()) return pj->Return(pk);
+
+        if (pk->GetState() == 0)
+        {
+            if (!m_values[i]->Execute(pk)) return false;    // interrupted here?
+
+            CBotVar* value = pk->GetVar();
+            if (m_checkNan &&
+                ((value->GetType() == CBotTypFloat && std::isnan(value->GetValFloat())) ||
+                 (value->GetType() == CBotTypDouble && std::isnan(value->GetValDouble()))))
+            {
+                pk->SetError(CBotErrNan, &m_operators[i]);
+                return pj->Return(pk);
+            }
+            pk->IncState();
+        }
+    }
+
+    CBotStack* pStep = pk->AddStack(this);
+    if (pStep->IfStep()) return false;                      // shows the operation if step by step
+
+    CBotVar* var = pile->FindVar(m_nIdent, false);
+    if (var->IsUndefined())
+    {
+        pile->SetError(CBotErrNotInit, &m_token);
+        return pj->Return(pile);
+    }
+
+    CBotVarString* string = static_cast<CBotVarString*>(var);
+    pk = pile;
+    for (std::size_t i = 0; i < m_values.size(); ++i)
+    {
+        pk = pk->AddStack();
+
+        CBotVar* value = pk->GetVar();
+        value->Update(m_checkNan ? nullptr : pj->GetUserPtr());
+        string->Append(value);
+    }
+
+    return pj->Return(pile);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CBotStringAppend::RestoreState(CBotStack* &pj, bool bMain)
+{
+    if (!bMain) return;
+
+    CBotStack* pile = pj->RestoreStack(this);
+    if (pile == nullptr) return;
+
+    CBotStack* pk = pile;
+    for (CBotInstr* value : m_values)
+    {
+        pk = pk->RestoreStack();
+        if (pk == nullptr) return;
+
+        if (pk->GetState() == 0)
+        {
+            value->RestoreState(pk, bMain);                 // interrupted here!
+            return;
+        }
+    }
+}
+
+std::string CBotStringAppend::GetDebugData()
+{
+    return m_token.GetString();
+}
+
+std::map<std::string, CBotInstr*> CBotStringAppend::GetDebugLinks()
+{
+    auto links = CBotInstr::GetDebugLinks();
+    for (std::size_t i = 0; i < m_values.size(); ++i)
+        links["m_values[" + std::to_string(i) + "]"] = m_values[i];
+    return links;
+}
+
+} // namespace CBot
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#pragma once
+
+#include "CBot/CBotInstr/CBotInstr.h"
+
+#include <vector>
+
+namespace CBot
+{
+
+class CBotExpression;
+
+/**
+ * \brief Appending to a local string variable, in place
+ *
+ * Replaces statements like these, whose value is not used:
+ * \code
+ * s += a;
+ * s = s + a + b;
+ * \endcode
+ *
+ * CBotExpression copies the whole string a few times for each of them,
+ * so building a string piece by piece takes quadratic time. This instruction
+ * evaluates the appended values and then appends them to the variable
+ * without copying it.
+ */
+class CBotStringAppend : public CBotInstr
+{
+public:
+    CBotStringAppend();
+    ~CBotStringAppend();
+
+    /*!
+     * \brief Converts an assignment to an append, if possible
+     *
+     * The variable must be a local string and it must not be used
+     * by the appended values, which are evaluated before the append.
+     *
+     * \param expr Compiled assignment, its operands are taken over on success
+     * \param start First token of the right side of the assignment
+     * \param end Token following the assignment
+     * \param var Assigned variable, as found during compilation
+     * \return New instruction, or nullptr if the assignment must be kept
+     */
+    static CBotStringAppend* Compile(CBotExpression* expr, CBotToken* start, CBotToken* end, CBotVar* var);
+
+    /*!
+     * \brief Execute Evaluates the appended values and appends them
+     * \param pj
+     * \return
+     */
+    bool Execute(CBotStack* &pj) override;
+
+    /*!
+     * \brief RestoreState
+     * \param pj
+     * \param bMain
+     */
+    void RestoreState(CBotStack* &pj, bool bMain) override;
+
+protected:
+    virtual const std::string GetDebugName() override { return "CBotStringAppend"; }
+    virtual std::string GetDebugData() override;
+    virtual std::map<std::string, CBotInstr*> GetDebugLinks() override;
+
+private:
+    //! Unique identifier of the variable
+    long m_nIdent = 0;
+    //! Appended values, in order
+    std::vector<CBotInstr*> m_values;
+    //! Operator of each value, for errors
+    std::vector<CBotToken> m_operators;
+    //! true for "s = s + a", where NaN is an error like in CBotTwoOpExpr
+    bool m_checkNan = false;
+};
+
+} // namespace CBot
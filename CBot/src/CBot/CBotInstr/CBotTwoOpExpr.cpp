@@ -29,10 +29,14 @@
 #include "CBot/CBotCStack.h"
 
 #include "CBot/CBotVar/CBotVar.h"
+#include "CBot/CBotVar/CBotVarBoolean.h"
+#include "CBot/CBotVar/CBotVarFloat.h"
+#include "CBot/CBotVar/CBotVarInt.h"
 
 #include <cassert>
 #include <cmath>
 #include <algorithm>
+#include <type_traits>
 
 namespace CBot
 {
@@ -42,6 +46,9 @@ CBotTwoOpExpr::CBotTwoOpExpr()
 {
     m_leftop    = nullptr;
     m_rightop   = nullptr;
+    m_typedOperation = nullptr;
+    m_leftType  = CBotTypVoid;
+    m_rightType = CBotTypVoid;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -134,6 +141,313 @@ static bool TypeOk(int type, int test)
     }
 }
 
+// Operations on bool, int and float operands whose types are known at compile time.
+// They give the same results and errors as the virtual operations of CBotVar
+// used by the generic path of CBotTwoOpExpr::Execute.
+
+template <typename T>
+static bool IsNanValue(T a, T b)
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return std::isnan(a) || std::isnan(b);
+    else
+        return false;
+}
+
+struct TypedAdd
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        if ( IsNanValue(a, b) ) return CBotErrNan;
+        result->InitValue(a + b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedSub
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        if ( IsNanValue(a, b) ) return CBotErrNan;
+        result->InitValue(a - b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedMul
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        if ( IsNanValue(a, b) ) return CBotErrNan;
+        result->InitValue(a * b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedDiv
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        if ( IsNanValue(a, b) ) return CBotErrNan;
+        if ( b == static_cast<T>(0) ) return CBotErrZeroDiv;
+        result->InitValue(a / b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedModulo
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        if ( IsNanValue(a, b) ) return CBotErrNan;
+        if ( b == static_cast<T>(0) ) return CBotErrZeroDiv;
+        if constexpr (std::is_integral_v<T>)
+            result->InitValue(a % b);
+        else
+            result->InitValue(std::fmod(a, b));
+        return CBotNoErr;
+    }
+};
+
+struct TypedLo
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        if ( IsNanValue(a, b) ) return CBotErrNan;
+        result->InitValue(a < b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedHi
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        if ( IsNanValue(a, b) ) return CBotErrNan;
+        result->InitValue(a > b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedLs
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        if ( IsNanValue(a, b) ) return CBotErrNan;
+        result->InitValue(a <= b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedHs
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        if ( IsNanValue(a, b) ) return CBotErrNan;
+        result->InitValue(a >= b);
+        return CBotNoErr;
+    }
+};
+
+// NaN is only equal to NaN, see the generic path
+struct TypedEq
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        if ( IsNanValue(a, b) )
+            result->InitValue(std::isnan(a) == std::isnan(b));
+        else
+            result->InitValue(a == b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedNe
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        if ( IsNanValue(a, b) )
+            result->InitValue(std::isnan(a) != std::isnan(b));
+        else
+            result->InitValue(a != b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedAnd
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        result->InitValue(a & b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedOr
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        result->InitValue(a | b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedXOr
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        result->InitValue(a ^ b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedSL
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        result->InitValue(a << b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedASR
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        result->InitValue(a >> b);
+        return CBotNoErr;
+    }
+};
+
+struct TypedSR
+{
+    template <typename T, typename Result>
+    static CBotError Apply(T a, T b, Result* result)
+    {
+        result->InitValue(static_cast<unsigned>(a) >> b);
+        return CBotNoErr;
+    }
+};
+
+/**
+ * \brief Reads both operands in the type of the calculation and creates the result
+ * \tparam Left, Right variable classes of the operands
+ * \tparam T type in which the calculation is done
+ * \tparam Result variable class of the result
+ */
+template <typename Left, typename Right, typename T, typename Result, typename Op>
+static CBotError ExecuteTyped(CBotVar* left, CBotVar* right, CBotVar* &result)
+{
+    T a = static_cast<T>(static_cast<Left*>(left)->GetValue());
+    T b = static_cast<T>(static_cast<Right*>(right)->GetValue());
+
+    Result* res = new Result(CBotToken());
+    result = res;
+    return Op::Apply(a, b, res);
+}
+
+template <typename Left, typename Right, typename T>
+static CBotTwoOpExpr::TypedOperation SelectTypedOperation(int typeOp)
+{
+    using Value = std::conditional_t<std::is_same_v<T, bool>, CBotVarBoolean,
+                  std::conditional_t<std::is_same_v<T, int>, CBotVarInt, CBotVarFloat>>;
+
+    constexpr bool isBool = std::is_same_v<T, bool>;
+    constexpr bool isInt = std::is_same_v<T, int>;
+
+    switch (typeOp)
+    {
+    case ID_EQ:     return &ExecuteTyped<Left, Right, T, CBotVarBoolean, TypedEq>;
+    case ID_NE:     return &ExecuteTyped<Left, Right, T, CBotVarBoolean, TypedNe>;
+    }
+
+    if constexpr (isBool)
+    {
+        switch (typeOp)
+        {
+        case ID_TXT_AND:
+        case ID_LOG_AND:
+        case ID_AND:    return &ExecuteTyped<Left, Right, T, Value, TypedAnd>;
+        case ID_TXT_OR:
+        case ID_LOG_OR:
+        case ID_OR:     return &ExecuteTyped<Left, Right, T, Value, TypedOr>;
+        case ID_XOR:    return &ExecuteTyped<Left, Right, T, Value, TypedXOr>;
+        }
+        return nullptr;
+    }
+    else
+    {
+        switch (typeOp)
+        {
+        case ID_ADD:    return &ExecuteTyped<Left, Right, T, Value, TypedAdd>;
+        case ID_SUB:    return &ExecuteTyped<Left, Right, T, Value, TypedSub>;
+        case ID_MUL:    return &ExecuteTyped<Left, Right, T, Value, TypedMul>;
+        case ID_DIV:    return &ExecuteTyped<Left, Right, T, Value, TypedDiv>;
+        case ID_MODULO: return &ExecuteTyped<Left, Right, T, Value, TypedModulo>;
+        case ID_LO:     return &ExecuteTyped<Left, Right, T, CBotVarBoolean, TypedLo>;
+        case ID_HI:     return &ExecuteTyped<Left, Right, T, CBotVarBoolean, TypedHi>;
+        case ID_LS:     return &ExecuteTyped<Left, Right, T, CBotVarBoolean, TypedLs>;
+        case ID_HS:     return &ExecuteTyped<Left, Right, T, CBotVarBoolean, TypedHs>;
+        }
+
+        if constexpr (isInt)
+        {
+            switch (typeOp)
+            {
+            case ID_AND:    return &ExecuteTyped<Left, Right, T, Value, TypedAnd>;
+            case ID_OR:     return &ExecuteTyped<Left, Right, T, Value, TypedOr>;
+            case ID_XOR:    return &ExecuteTyped<Left, Right, T, Value, TypedXOr>;
+            case ID_SL:     return &ExecuteTyped<Left, Right, T, Value, TypedSL>;
+            case ID_ASR:    return &ExecuteTyped<Left, Right, T, Value, TypedASR>;
+            case ID_SR:     return &ExecuteTyped<Left, Right, T, Value, TypedSR>;
+            }
+        }
+        return nullptr;
+    }
+}
+
+/**
+ * \brief Selects the typed operation for the given compile time types of the operands
+ * \return nullptr if the operation must go through the generic path (strings, pointers, power, ...)
+ */
+static CBotTwoOpExpr::TypedOperation SelectTypedOperation(int typeOp, int type1, int type2)
+{
+    if ( type1 == CBotTypInt && type2 == CBotTypInt )
+        return SelectTypedOperation<CBotVarInt, CBotVarInt, int>(typeOp);
+    if ( type1 == CBotTypFloat && type2 == CBotTypFloat )
+        return SelectTypedOperation<CBotVarFloat, CBotVarFloat, float>(typeOp);
+    if ( type1 == CBotTypInt && type2 == CBotTypFloat )
+        return SelectTypedOperation<CBotVarInt, CBotVarFloat, float>(typeOp);
+    if ( type1 == CBotTypFloat && type2 == CBotTypInt )
+        return SelectTypedOperation<CBotVarFloat, CBotVarInt, float>(typeOp);
+    if ( type1 == CBotTypBoolean && type2 == CBotTypBoolean )
+        return SelectTypedOperation<CBotVarBoolean, CBotVarBoolean, bool>(typeOp);
+    return nullptr;
+}
+
+void CBotTwoOpExpr::SetTypedOperation(int typeOp, const CBotTypResult& type1, const CBotTypResult& type2)
+{
+    m_leftType  = static_cast<CBotType>(type1.GetType());
+    m_rightType = static_cast<CBotType>(type2.GetType());
+    m_typedOperation = SelectTypedOperation(typeOp, m_leftType, m_rightType);
+}
+
 CBotInstr* CBotTwoOpExpr::Compile(CBotToken* &p, CBotCStack* pStack, int* pOperations, bool bConstExpr)
 {
     int typeMask;
@@ -249,6 +563,7 @@ CBotInstr* CBotTwoOpExpr::Compile(CBotToken* &p, CBotCStack* pStack, int* pOpera
             case ID_LS:
                 TypeRes = CBotTypBoolean;
             }
+            inst->SetTypedOperation(typeOp, type1, type2);          // before TypeCompatible converts the types
             if ( TypeCompatible (type1, type2, typeOp) )               // the results are compatible
             {
                 // ok so, saves the operand in the object
@@ -266,6 +581,7 @@ CBotInstr* CBotTwoOpExpr::Compile(CBotToken* &p, CBotCStack* pStack, int* pOpera
                     p = p->GetNext();                                       // advance after
                     i->m_rightop = CBotTwoOpExpr::Compile(p, pStk, pOp, bConstExpr);
                     type2 = pStk->GetTypResult();
+                    i->SetTypedOperation(typeOp, type1, type2);
 
                     if ( !TypeCompatible (type1, type2, typeOp) )       // the results are compatible
                     {
@@ -374,12 +690,27 @@ bool CBotTwoOpExpr::Execute(CBotStack* &pStack)
     }
 
     assert(pStk1->GetVar() != nullptr && pStk2->GetVar() != nullptr);
-    CBotTypResult       type1 = pStk1->GetVar()->GetTypResult();      // what kind of results?
-    CBotTypResult       type2 = pStk2->GetVar()->GetTypResult();
 
     CBotStack* pStk3 = pStk2->AddStack(this);               // adds an item to the stack
     if ( pStk3->IfStep() ) return false;                    // shows the operation if step by step
 
+    // operation selected at compile time, the types of the operands are checked
+    // because some expressions (e.g. a ? 1 : 2.5) can give a value of another type
+    if ( m_typedOperation != nullptr &&
+         pStk1->GetVar()->GetType() == m_leftType && pStk2->GetVar()->GetType() == m_rightType )
+    {
+        CBotVar*    result = nullptr;
+        CBotError   err = m_typedOperation(pStk1->GetVar(), pStk2->GetVar(), result);
+
+        pStk2->SetVar(result);                      // puts the result on the stack
+        if ( err ) pStk2->SetError(err, &m_token);  // and the possible error (division by zero)
+
+        return pStack->Return(pStk2);               // transmits the result
+    }
+
+    CBotTypResult       type1 = pStk1->GetVar()->GetTypResult();      // what kind of results?
+    CBotTypResult       type2 = pStk2->GetVar()->GetTypResult();
+
     // creates a temporary variable to put the result
     // what kind of result?
     int TypeRes = std::max(type1.GetType(), type2.GetType());
@@ -435,11 +766,22 @@ bool CBotTwoOpExpr::Execute(CBotStack* &pStack)
         TypeRes = CBotTypString;
     }
 
-    CBotVar*    temp;
+    // comparisons are performed by a variable of the type of operands
+    CBotVar*    temp = nullptr;
 
-    if ( TypeRes == CBotTypPointer ) TypeRes = CBotTypNullPointer;
-    if ( TypeRes == CBotTypClass ) temp = CBotVar::Create("", CBotTypResult(CBotTypIntrinsic, type1.GetClass() ) );
-    else                           temp = CBotVar::Create("", TypeRes );
+    switch (GetTokenType())
+    {
+    case ID_LO:
+    case ID_HI:
+    case ID_LS:
+    case ID_HS:
+    case ID_EQ:
+    case ID_NE:
+        if ( TypeRes == CBotTypPointer ) TypeRes = CBotTypNullPointer;
+        if ( TypeRes == CBotTypClass ) temp = CBotVar::Create("", CBotTypResult(CBotTypIntrinsic, type1.GetClass() ) );
+        else                           temp = CBotVar::Create("", TypeRes );
+        break;
+    }
 
     CBotError err = CBotNoErr;
     // is a operation according to request
@@ -81,16 +81,34 @@ public:
      */
     void RestoreState(CBotStack* &pj, bool bMain) override;
 
+    /*!
+     * \brief Operation on operands whose types are known at compile time
+     *
+     * Creates the result from the values of both operands
+     * and returns the error of the operation, if any.
+     */
+    using TypedOperation = CBotError (*)(CBotVar* left, CBotVar* right, CBotVar* &result);
+
 protected:
     virtual const std::string GetDebugName() override { return "CBotTwoOpExpr"; }
     virtual std::string GetDebugData() override;
     virtual std::map<std::string, CBotInstr*> GetDebugLinks() override;
 
 private:
+    /*!
+     * \brief Selects the typed operation from the types of the operands found by Compile()
+     */
+    void SetTypedOperation(int typeOp, const CBotTypResult& type1, const CBotTypResult& type2);
+
     //! Left element
     CBotInstr* m_leftop;
     //! Right element
     CBotInstr* m_rightop;
+    //! Operation selected at compile time, nullptr if the operand types need runtime dispatch
+    TypedOperation m_typedOperation;
+    //! Types of the left and right operand for which m_typedOperation applies
+    CBotType m_leftType, m_rightType;
+    friend class CBotStringAppend;
 };
 
 } // namespace CBot
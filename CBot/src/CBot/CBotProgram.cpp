@@ -19,6 +19,7 @@
 
 #include "CBot/CBotVar/CBotVar.h"
 
+#include "CBot/CBotContext.h"
 #include "CBot/CBotExternalCall.h"
 #include "CBot/CBotStack.h"
 #include "CBot/CBotCStack.h"
@@ -34,19 +35,21 @@
 namespace CBot
 {
 
-std::unique_ptr<CBotExternalCallList> CBotProgram::m_externalCalls;
-
 CBotProgram::CBotProgram()
+: m_context(&CBotContext::GetCurrent())
 {
 }
 
 CBotProgram::CBotProgram(CBotVar* thisVar)
-: m_thisVar(thisVar)
+: m_context(&CBotContext::GetCurrent()),
+  m_thisVar(thisVar)
 {
 }
 
 CBotProgram::~CBotProgram()
 {
+    CBotContextGuard guard(*m_context);
+
 //  delete  m_classes;
     for (CBotClass* c : m_classes)
         c->Purge();
@@ -60,6 +63,8 @@ CBotProgram::~CBotProgram()
 
 bool CBotProgram::Compile(const std::string& program, std::vector<std::string>& externFunctions, void* pUser)
 {
+    CBotContextGuard guard(*m_context);
+
     // Cleanup the previously compiled program
     Stop();
 
@@ -82,7 +87,7 @@ bool CBotProgram::Compile(const std::string& program, std::vector<std::string>&
     CBotToken* p = tokens.get()->GetNext();                 // skips the first token (separator)
 
     pStack->SetProgram(this);                               // defined used routines
-    m_externalCalls->SetUserPtr(pUser);
+    m_context->externalCalls->SetUserPtr(pUser);
 
     // Step 2. Find all function and class definitions
     while ( pStack->IsOk() && p != nullptr && p->GetType() != 0)
@@ -149,6 +154,8 @@ bool CBotProgram::Compile(const std::string& program, std::vector<std::string>&
 
 bool CBotProgram::Start(const std::string& name)
 {
+    CBotContextGuard guard(*m_context);
+
     Stop();
 
     auto it = std::find_if(m_functions.begin(), m_functions.end(), [&name](CBotFunction* x) { return x->GetName() == name; });
@@ -176,6 +183,8 @@ bool CBotProgram::GetPosition(const std::string& name, int& start, int& stop, CB
 
 bool CBotProgram::Run(void* pUser, int timer)
 {
+    CBotContextGuard guard(*m_context);
+
     if (m_stack == nullptr || m_entryPoint == nullptr)
     {
         m_error = CBotErrNoRun;
@@ -197,6 +206,7 @@ bool CBotProgram::Run(void* pUser, int timer)
         // returns to normal execution
         ok = m_entryPoint->Execute(nullptr, m_stack, m_thisVar);
     }
+    m_runTicks = m_stack->GetTimerUsed();
 
     // completed on a mistake?
     if (ok || !m_stack->IsOk())
@@ -212,8 +222,15 @@ bool CBotProgram::Run(void* pUser, int timer)
     return ok;
 }
 
+int CBotProgram::GetRunTicks()
+{
+    return m_runTicks;
+}
+
 void CBotProgram::Stop()
 {
+    CBotContextGuard guard(*m_context);
+
     if (m_stack != nullptr)
     {
         m_stack->Delete();
@@ -287,7 +304,8 @@ bool CBotProgram::ClassExists(std::string name)
 static CBotTypResult cSizeOf( CBotVar* &pVar, void* pUser )
 {
     if ( pVar == nullptr ) return CBotTypResult( CBotErrLowParam );
-    if ( pVar->GetType() != CBotTypArrayPointer )
+    if ( pVar->GetType() != CBotTypArrayPointer &&
+         !(pVar->GetType() == CBotTypPointer && IsContainerClass(pVar->GetClass())) )
                         return CBotTypResult( CBotErrBadParam );
     return CBotTypResult( CBotTypInt );
 }
@@ -296,6 +314,14 @@ static bool rSizeOf( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
 {
     if ( pVar == nullptr ) { ex = CBotErrLowParam; return true; }
 
+    if ( pVar->GetType() == CBotTypPointer )                // a map or a set
+    {
+        int size = GetContainerSize(pVar);
+        if ( size < 0 ) { ex = CBotErrNull; return true; }
+        pResult->SetValInt(size);
+        return true;
+    }
+
     int i = 0;
     pVar = pVar->GetItemList();
 
@@ -314,7 +340,7 @@ bool CBotProgram::AddFunction(const std::string& name,
                               bool rExec(CBotVar* pVar, CBotVar* pResult, int& Exception, void* pUser),
                               CBotTypResult rCompile(CBotVar*& pVar, void* pUser))
 {
-    return m_externalCalls->AddFunction(name, std::unique_ptr<CBotExternalCall>(new CBotExternalCallDefault(rExec, rCompile)));
+    return CBotContext::GetCurrent().externalCalls->AddFunction(name, std::unique_ptr<CBotExternalCall>(new CBotExternalCallDefault(rExec, rCompile)));
 }
 
 bool CBotProgram::DefineNum(const std::string& name, long val)
@@ -326,6 +352,8 @@ bool CBotProgram::DefineNum(const std::string& name, long val)
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotProgram::SaveState(std::ostream &ostr)
 {
+    CBotContextGuard guard(*m_context);
+
     if (!WriteLong(ostr, CBOTVERSION)) return false;
 
 
@@ -344,6 +372,8 @@ bool CBotProgram::SaveState(std::ostream &ostr)
 
 bool CBotProgram::RestoreState(std::istream &istr)
 {
+    CBotContextGuard guard(*m_context);
+
     unsigned short  w;
     std::string      s;
 
@@ -388,7 +418,7 @@ int CBotProgram::GetVersion()
 
 void CBotProgram::Init()
 {
-    m_externalCalls.reset(new CBotExternalCallList);
+    CBotContext::GetCurrent().externalCalls.reset(new CBotExternalCallList);
 
     CBotProgram::DefineNum("CBotErrZeroDiv",    CBotErrZeroDiv);     // division by zero
     CBotProgram::DefineNum("CBotErrNotInit",    CBotErrNotInit);     // uninitialized variable
@@ -402,25 +432,36 @@ void CBotProgram::Init()
     CBotProgram::DefineNum("CBotErrOutArray",   CBotErrOutArray);    // Attempted access out of bounds of an array
     CBotProgram::DefineNum("CBotErrStackOver",  CBotErrStackOver);   // Stack overflow
     CBotProgram::DefineNum("CBotErrDeletedPtr", CBotErrDeletedPtr);  // Attempted to use deleted object
+    CBotProgram::DefineNum("CBotErrBadValueType", CBotErrBadValueType); // Map or set value of another type than the default
 
     CBotProgram::AddFunction("sizeof", rSizeOf, cSizeOf);
 
     InitStringFunctions();
     InitMathFunctions();
     InitFileFunctions();
+    InitContainerFunctions();
 }
 
 void CBotProgram::Free()
 {
+    CBotContext& context = CBotContext::GetCurrent();
+
     CBotToken::ClearDefineNum();
-    m_externalCalls->Clear();
+    context.externalCalls->Clear();
     CBotClass::ClearPublic();
-    m_externalCalls.reset();
+    context.files.clear();
+    context.ClearContainers();
+    context.externalCalls.reset();
 }
 
 const std::unique_ptr<CBotExternalCallList>& CBotProgram::GetExternalCalls()
 {
-    return m_externalCalls;
+    return CBotContext::GetCurrent().externalCalls;
+}
+
+CBotContext* CBotProgram::GetContext()
+{
+    return m_context;
 }
 
 } // namespace CBot
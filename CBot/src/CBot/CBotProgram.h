@@ -29,6 +29,7 @@
 namespace CBot
 {
 
+class CBotContext;
 class CBotFunction;
 class CBotClass;
 class CBotStack;
@@ -104,11 +105,13 @@ public:
 
     /**
      * \brief Initializes the module, should be done once (and only once) at the beginning
+     *
+     * Initializes the current context, see CBotContext
      */
     static void Init();
 
     /**
-     * \brief Frees the static memory areas
+     * \brief Frees the static memory areas of the current context
      */
     static void Free();
 
@@ -180,6 +183,11 @@ public:
      */
     bool Run(void* pUser = nullptr, int timer = -1);
 
+    /**
+     * \brief Returns the number of "timer ticks" (parts of instructions) executed by the last call to Run()
+     */
+    int GetRunTicks();
+
     /**
      * \brief Gives the current position in the executing program
      * \param[out] functionName Name of the currently executed function
@@ -327,13 +335,18 @@ public:
     bool ClassExists(std::string name);
 
     /**
-     * \brief Returns static list of all registered external calls
+     * \brief Returns list of all external calls registered in the current context
      */
     static const std::unique_ptr<CBotExternalCallList>& GetExternalCalls();
 
+    /**
+     * \brief Returns context of this program, current when the program was created
+     */
+    CBotContext* GetContext();
+
 private:
-    //! All external calls
-    static std::unique_ptr<CBotExternalCallList> m_externalCalls;
+    //! Context of this program
+    CBotContext* const m_context;
     //! All user-defined functions
     std::list<CBotFunction*> m_functions{};
     //! The entry point function
@@ -350,6 +363,8 @@ private:
     CBotError m_error = CBotNoErr;
     int m_errorStart = 0;
     int m_errorEnd = 0;
+    //! Timer ticks executed by the last call to Run()
+    int m_runTicks = 0;
 };
 
 } // namespace CBot
@@ -487,6 +487,11 @@ int CBotStack::GetTimer()
     return m_data->initimer;
 }
 
+int CBotStack::GetTimerUsed()
+{
+    return m_data->initimer - m_data->timer;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotStack::Execute()
 {
@@ -798,12 +803,12 @@ bool CBotVar::Save0State(std::ostream &ostr)
         if (GetPointer()->m_bConstructor)                    // constructor was called?
         {
             if (!WriteWord(ostr, (2000 + static_cast<unsigned short>(m_binit)) )) return false;
-            return WriteString(ostr, m_token->GetString());  // and variable name
+            return WriteString(ostr, m_token.GetString());  // and variable name
         }
     }
 
     if (!WriteWord(ostr, static_cast<unsigned short>(m_binit))) return false;        // variable defined?
-    return WriteString(ostr, m_token->GetString());          // and variable name
+    return WriteString(ostr, m_token.GetString());          // and variable name
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -948,6 +953,16 @@ bool CBotVar::RestoreState(std::istream &istr, CBotVar* &pVar)
                         }
                     }
 
+                    if (isClass && pNew->GetClass() != nullptr)
+                    {
+                        CBotVar* pInstance = p == nullptr ? pNew : nullptr;
+                        if (!pNew->GetClass()->RestoreInstanceState(pInstance, istr))
+                        {
+                            delete pNew;
+                            return false;
+                        }
+                    }
+
                     if ( p != nullptr )
                     {
                         delete pNew;
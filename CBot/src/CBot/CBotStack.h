@@ -445,6 +445,10 @@ public:
      * \brief Get the current configured maximum number of "timer ticks" (parts of instructions) to execute
      */
     int             GetTimer();
+    /**
+     * \brief Get the number of "timer ticks" used since the last call to Reset()
+     */
+    int             GetTimerUsed();
 
     /**
      * \brief Get current position in the program
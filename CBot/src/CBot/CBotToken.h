@@ -205,9 +205,6 @@ private:
     //! The end position of the token in the CBotProgram
     int m_end = 0;
 
-    //! Map of all defined constants (see DefineNum())
-    static std::map<std::string, long> m_defineNum;
-
     /**
      * \brief Check if the word is a keyword
      * \param w The word to check
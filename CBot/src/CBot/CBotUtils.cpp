@@ -25,6 +25,7 @@
 #include "CBot/CBotCStack.h"
 
 #include "CBot/CBotVar/CBotVar.h"
+#include "CBot/CBotVar/CBotVarString.h"
 
 #include <cstring>
 
@@ -55,6 +56,27 @@ CBotVar* MakeListVars(CBotVar** ppVars, bool bSetVal)
     return pVar;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+CBotVar* MoveListVars(CBotVar** ppVars)
+{
+    CBotVar*    pVar = nullptr;
+    CBotVar*    pLast = nullptr;
+
+    for (int i = 0; ppVars[i] != nullptr; i++)
+    {
+        CBotVar*    pp = CBotVar::Create(ppVars[i]);
+        if (pp->GetType() == CBotTypString)
+            static_cast<CBotVarString*>(pp)->Move(static_cast<CBotVarString*>(ppVars[i]));
+        else
+            pp->Copy(ppVars[i]);
+
+        if (pVar == nullptr) pVar = pp;
+        else pLast->AddNext(pp);
+        pLast = pp;
+    }
+    return pVar;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 CBotTypResult TypeParam(CBotToken* &p, CBotCStack* pile)
 {
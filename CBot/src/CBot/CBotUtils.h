@@ -42,6 +42,14 @@ class CBotTypResult;
  */
 CBotVar* MakeListVars(CBotVar** ppVars, bool bSetVal=false);
 
+/*!
+ * \brief MoveListVars Like MakeListVars(ppVars, true), for variables which
+ * are not used anymore: string values are moved instead of copied
+ * \param ppVars
+ * \return
+ */
+CBotVar* MoveListVars(CBotVar** ppVars);
+
 /*!
  * \brief TypeParam
  * \param p
@@ -37,24 +37,127 @@
 #include "CBot/CBotVar/CBotVarString.h"
 
 #include "CBot/CBotClass.h"
+#include "CBot/CBotContext.h"
 #include "CBot/CBotToken.h"
 
 #include "CBot/CBotEnums.h"
 
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstdio>
+#include <new>
 #include <string>
 
 
 namespace CBot
 {
 
+namespace
+{
+
+//! Sizes of recycled variables are rounded up to a multiple of this
+constexpr std::size_t POOL_GRANULARITY = 16;
+//! Variables bigger than this are not recycled
+constexpr std::size_t POOL_MAX_SIZE = 384;
+//! Maximum number of blocks of each size kept for reuse
+constexpr int POOL_MAX_FREE = 1024;
+
+/**
+ * \brief Memory of destroyed variables of one thread, kept for reuse
+ *
+ * Trivially destructible, so that it stays usable while other thread local
+ * and static objects are destroyed.
+ */
+struct CBotVarPool
+{
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    std::array<FreeBlock*, POOL_MAX_SIZE / POOL_GRANULARITY> free;
+    std::array<int, POOL_MAX_SIZE / POOL_GRANULARITY> count;
+    //! Set when the thread ends, memory goes straight back to the heap afterwards
+    bool closed;
+};
+
+thread_local CBotVarPool g_varPool{};
+
+//! Returns kept memory to the heap when the thread ends
+struct CBotVarPoolCleanup
+{
+    ~CBotVarPoolCleanup()
+    {
+        for (auto& block : g_varPool.free)
+        {
+            while (block != nullptr)
+            {
+                CBotVarPool::FreeBlock* next = block->next;
+                ::operator delete(block);
+                block = next;
+            }
+        }
+        g_varPool.closed = true;
+    }
+};
+
+thread_local CBotVarPoolCleanup g_varPoolCleanup;
+
+/**
+ * \brief Returns the pool of the calling thread
+ *
+ * Also registers the cleanup of the pool, a thread may only ever delete
+ * variables created by other threads and still keep their memory.
+ */
+CBotVarPool& GetVarPool()
+{
+    static_cast<void>(&g_varPoolCleanup);
+    return g_varPool;
+}
+
+// intrinsic instances like point are passed to most game functions
+static_assert(sizeof(CBotVarClass) <= POOL_MAX_SIZE, "class instances must be recycled");
+static_assert(sizeof(CBotVarString) <= POOL_MAX_SIZE, "strings must be recycled");
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
-long CBotVar::m_identcpt = 0;
+void* CBotVar::operator new(std::size_t size)
+{
+    CBotVarPool& pool = GetVarPool();
+    if (size > POOL_MAX_SIZE || pool.closed) return ::operator new(size);
+
+    std::size_t index = (size - 1) / POOL_GRANULARITY;
+    CBotVarPool::FreeBlock* block = pool.free[index];
+    if (block == nullptr) return ::operator new((index + 1) * POOL_GRANULARITY);
+
+    pool.free[index] = block->next;
+    pool.count[index]--;
+    return block;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
-CBotVar::CBotVar( ) : m_token(nullptr)
+void CBotVar::operator delete(void* ptr, std::size_t size)
+{
+    if (ptr == nullptr) return;
+
+    CBotVarPool& pool = GetVarPool();
+    std::size_t index = (size - 1) / POOL_GRANULARITY;
+    if (size > POOL_MAX_SIZE || pool.closed || pool.count[index] >= POOL_MAX_FREE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto block = static_cast<CBotVarPool::FreeBlock*>(ptr);
+    block->next = pool.free[index];
+    pool.free[index] = block;
+    pool.count[index]++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotVar::CBotVar( )
 {
     m_pMyThis = nullptr;
     m_pUserPtr = nullptr;
@@ -67,7 +170,7 @@ CBotVar::CBotVar( ) : m_token(nullptr)
     m_mPrivate = ProtectionLevel::Public;
 }
 
-CBotVar::CBotVar(const CBotToken &name) : m_token(new CBotToken(name))
+CBotVar::CBotVar(const CBotToken &name) : m_token(name)
 {
     m_pMyThis = nullptr;
     m_pUserPtr = nullptr;
@@ -83,7 +186,6 @@ CBotVar::CBotVar(const CBotToken &name) : m_token(new CBotToken(name))
 ////////////////////////////////////////////////////////////////////////////////
 CBotVar::~CBotVar( )
 {
-    delete  m_token;
     delete  m_InitExpr;
     delete  m_LimExpr;
 }
@@ -97,6 +199,10 @@ void CBotVar::ConstructorSet()
 ////////////////////////////////////////////////////////////////////////////////
 void CBotVar::SetUserPtr(void* pUser)
 {
+    // a pending update was requested for the previous user, typically an object about to be deleted
+    if (m_type.Eq(CBotTypClass) && pUser != m_pUserPtr)
+        static_cast<CBotVarClass*>(this)->CompletePendingUpdate();
+
     m_pUserPtr = pUser;
     if (m_type.Eq(CBotTypPointer) &&
         (static_cast<CBotVarPointer*>(this))->m_pVarClass != nullptr )
@@ -122,8 +228,9 @@ void CBotVar::SetUniqNum(long n)
 ////////////////////////////////////////////////////////////////////////////////
 long CBotVar::NextUniqNum()
 {
-    if (++m_identcpt < 10000) m_identcpt = 10000;
-    return m_identcpt;
+    long& identCounter = CBotContext::GetCurrent().identCounter;
+    if (++identCounter < 10000) identCounter = 10000;
+    return identCounter;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -226,7 +333,7 @@ CBotVar* CBotVar::Create(const CBotToken& name, CBotTypResult type)
 ////////////////////////////////////////////////////////////////////////////////
 CBotVar* CBotVar::Create( CBotVar* pVar )
 {
-    CBotVar*    p = Create(pVar->m_token->GetString(), pVar->GetTypResult(CBotVar::GetTypeMode::CLASS_AS_INTRINSIC));
+    CBotVar*    p = Create(pVar->m_token.GetString(), pVar->GetTypResult(CBotVar::GetTypeMode::CLASS_AS_INTRINSIC));
     return p;
 }
 
@@ -411,19 +518,19 @@ void CBotVar::SetInit(CBotVar::InitType initType)
 ////////////////////////////////////////////////////////////////////////////////
 const std::string& CBotVar::GetName()
 {
-    return    m_token->GetString();
+    return    m_token.GetString();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void CBotVar::SetName(const std::string& name)
 {
-    m_token->SetString(name);
+    m_token.SetString(name);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 CBotToken* CBotVar::GetToken()
 {
-    return    m_token;
+    return    &m_token;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -484,7 +591,7 @@ CBotVar* CBotVar::GetStaticVar()
     if ( m_bStatic == 0 || m_pMyThis == nullptr ) return this;
 
     CBotClass*    pClass = m_pMyThis->GetClass();
-    return pClass->GetItem( m_token->GetString() );
+    return pClass->GetItem( m_token.GetString() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -803,7 +910,7 @@ void CBotVar::Dec()
 ////////////////////////////////////////////////////////////////////////////////
 void CBotVar::Copy(CBotVar* pSrc, bool bName)
 {
-    if (bName) *m_token = *pSrc->m_token;
+    if (bName) m_token = pSrc->m_token;
     m_type = pSrc->m_type;
     m_binit = pSrc->m_binit;
 //-    m_bStatic    = pSrc->m_bStatic;
@@ -20,10 +20,12 @@
 #pragma once
 
 #include "CBot/CBotDefines.h"
+#include "CBot/CBotToken.h"
 #include "CBot/CBotTypResult.h"
 #include "CBot/CBotEnums.h"
 #include "CBot/CBotUtils.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -33,7 +35,6 @@ namespace CBot
 class CBotVarClass;
 class CBotInstr;
 class CBotClass;
-class CBotToken;
 
 /**
  * \brief A CBot variable
@@ -61,6 +62,20 @@ public:
      */
     virtual ~CBotVar();
 
+    /**
+     * \brief Allocates memory for a variable
+     *
+     * Variables are created and destroyed for every intermediate result of an expression,
+     * so memory of destroyed variables is kept by each thread for reuse instead of going
+     * back to the heap.
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * \brief Releases memory of a variable for reuse, see operator new()
+     */
+    static void operator delete(void* ptr, std::size_t size);
+
     /**
      * \brief Creates a new variable from a type described by CBotTypResult
      * \param name Variable name
@@ -675,7 +690,7 @@ public:
 
 protected:
     //! The corresponding token, defines the variable name
-    CBotToken* const m_token;
+    CBotToken m_token;
     //! Type of value.
     CBotTypResult m_type;
     //! Initialization status
@@ -703,9 +718,6 @@ protected:
      */
     long m_ident;
 
-    //! TODO: ?
-    static long m_identcpt;
-
     friend class CBotStack;
     friend class CBotCStack;
     friend class CBotInstrCall;
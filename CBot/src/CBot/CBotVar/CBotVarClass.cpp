@@ -20,6 +20,7 @@
 #include "CBot/CBotVar/CBotVarClass.h"
 
 #include "CBot/CBotClass.h"
+#include "CBot/CBotContext.h"
 #include "CBot/CBotStack.h"
 #include "CBot/CBotDefines.h"
 
@@ -31,10 +32,8 @@ namespace CBot
 {
 
 ////////////////////////////////////////////////////////////////////////////////
-std::set<CBotVarClass*> CBotVarClass::m_instances{};
-
-////////////////////////////////////////////////////////////////////////////////
-CBotVarClass::CBotVarClass(const CBotToken& name, const CBotTypResult& type) : CBotVar(name)
+CBotVarClass::CBotVarClass(const CBotToken& name, const CBotTypResult& type)
+    : CBotVar(name), m_context(&CBotContext::GetCurrent())
 {
     if ( !type.Eq(CBotTypClass)        &&
          !type.Eq(CBotTypIntrinsic)    &&                // by convenience there accepts these types
@@ -62,7 +61,7 @@ CBotVarClass::CBotVarClass(const CBotToken& name, const CBotTypResult& type) : C
     m_ItemIdent = type.Eq(CBotTypIntrinsic) ? 0 : CBotVar::NextUniqNum();
 
     // add to the list
-    if (m_ItemIdent != 0) m_instances.insert(this);
+    if (m_ItemIdent != 0) m_context->instances.insert(this);
 
     CBotClass* pClass = type.GetClass();
 
@@ -77,7 +76,7 @@ CBotVarClass::~CBotVarClass( )
         assert(0);
 
     // removes the class list
-    if (m_ItemIdent != 0) m_instances.erase(this);
+    if (m_ItemIdent != 0) m_context->instances.erase(this);
 
     delete    m_pVar;
 }
@@ -97,8 +96,9 @@ void CBotVarClass::Copy(CBotVar* pSrc, bool bName)
         assert(0);
 
     CBotVarClass*    p = static_cast<CBotVarClass*>(pSrc);
+    p->CompletePendingUpdate();
 
-    if (bName)    *m_token    = *p->m_token;
+    if (bName)    m_token    = p->m_token;
 
     m_type        = p->m_type;
     m_binit        = p->m_binit;
@@ -215,19 +215,49 @@ CBotClass* CBotVarClass::GetClass()
 
 ////////////////////////////////////////////////////////////////////////////////
 void CBotVarClass::Update(void* pUser)
+{
+    if (m_pClass->HasUpdateItemFunc())
+    {
+        // elements are updated only once they are used
+        m_updatePending = true;
+        m_updateUser = pUser;
+        m_updatedItems = 0;
+        return;
+    }
+
+    pUser = GetUpdateUser(pUser);
+    if (pUser == nullptr) return;
+    m_pClass->Update(this, pUser);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void* CBotVarClass::GetUpdateUser(void* pUser) const
 {
     // retrieves the user pointer according to the class
     // or according to the parameter passed to CBotProgram::Run()
 
     if ( m_pUserPtr != nullptr) pUser = m_pUserPtr;
     if ( pUser == OBJECTDELETED ||
-         pUser == OBJECTCREATED ) return;
+         pUser == OBJECTCREATED ) return nullptr;
+    return pUser;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CBotVarClass::CompletePendingUpdate()
+{
+    if (!m_updatePending) return;
+    m_updatePending = false;
+
+    void* pUser = GetUpdateUser(m_updateUser);
+    if (pUser == nullptr) return;
     m_pClass->Update(this, pUser);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 CBotVar* CBotVarClass::GetItem(const std::string& name)
 {
+    CompletePendingUpdate();
+
     CBotVar*    p = m_pVar;
 
     while ( p != nullptr )
@@ -243,11 +273,25 @@ CBotVar* CBotVarClass::GetItem(const std::string& name)
 CBotVar* CBotVarClass::GetItemRef(int nIdent)
 {
     CBotVar*    p = m_pVar;
+    int         index = 0;
 
     while ( p != nullptr )
     {
-        if ( p->GetUniqNum() == nIdent ) return p;
+        if ( p->GetUniqNum() == nIdent )
+        {
+            // updates only the element which is used, once per update
+            // elements past the tracked ones are updated on every use
+            std::uint64_t bit = index < 64 ? std::uint64_t(1) << index : 0;
+            if (m_updatePending && (m_updatedItems & bit) == 0)
+            {
+                m_updatedItems |= bit;
+                void* pUser = GetUpdateUser(m_updateUser);
+                if (pUser != nullptr) m_pClass->UpdateItem(this, p, pUser);
+            }
+            return p;
+        }
         p = p->GetNext();
+        index++;
     }
 
     return nullptr;
@@ -287,6 +331,7 @@ CBotVar* CBotVarClass::GetItem(int n, bool bExtend)
 ////////////////////////////////////////////////////////////////////////////////
 CBotVar* CBotVarClass::GetItemList()
 {
+    CompletePendingUpdate();
     return m_pVar;
 }
 
@@ -297,6 +342,7 @@ std::string CBotVarClass::GetValString() const
 
     if ( m_pClass != nullptr )                        // not used for an array
     {
+        const_cast<CBotVarClass*>(this)->CompletePendingUpdate();
         res = m_pClass->GetName() + std::string("( ");
 
         CBotClass* pClass = m_pClass;
@@ -412,7 +458,7 @@ CBotVarClass* CBotVarClass::GetPointer()
 ////////////////////////////////////////////////////////////////////////////////
 CBotVarClass* CBotVarClass::Find(long id)
 {
-    for (CBotVarClass* p : m_instances)
+    for (CBotVarClass* p : CBotContext::GetCurrent().instances)
     {
         if (p->m_ItemIdent == id) return p;
     }
@@ -460,7 +506,11 @@ bool CBotVarClass::Save1State(std::ostream &ostr)
     if (!WriteType(ostr, m_type)) return false;
     if (!WriteLong(ostr, m_ItemIdent)) return false;
 
-    return SaveVars(ostr, m_pVar);                              // content of the object
+    CompletePendingUpdate();
+    if (!SaveVars(ostr, m_pVar)) return false;                  // content of the object
+
+    if (m_pClass == nullptr) return true;                       // an array
+    return m_pClass->SaveInstanceState(this, ostr);             // native state of the object
 }
 
 } // namespace CBot
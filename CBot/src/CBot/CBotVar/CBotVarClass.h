@@ -21,11 +21,13 @@
 
 #include "CBot/CBotVar/CBotVar.h"
 
-#include <set>
+#include <cstdint>
 
 namespace CBot
 {
 
+class CBotContext;
+
 /**
  * \brief CBotVar subclass for managing classes (::CBotTypClass, ::CBotTypIntrinsic)
  *
@@ -95,8 +97,8 @@ public:
     void ConstructorSet() override;
 
 private:
-    //! List of all class instances - first
-    static std::set<CBotVarClass*> m_instances;
+    //! Context this instance is listed in, see CBotContext::instances
+    CBotContext* m_context;
     //! Class definition
     CBotClass* m_pClass;
     //! Class members
@@ -107,6 +109,20 @@ private:
     long m_ItemIdent;
     //! Set after constructor is called, allows destructor to be called
     bool m_bConstructor;
+    //! Set by Update() when the class updates its elements one by one, see CBotClass::SetUpdateItemFunc()
+    bool m_updatePending = false;
+    //! User pointer given to the pending update
+    void* m_updateUser = nullptr;
+    //! Elements already updated since the pending update was requested, bit n for the n-th element
+    std::uint64_t m_updatedItems = 0;
+
+    /**
+     * \brief Resolves the user pointer for an update of this instance
+     * \return nullptr if the instance must not be updated
+     */
+    void* GetUpdateUser(void* pUser) const;
+    //! Updates all elements if an update is pending
+    void CompletePendingUpdate();
 
     friend class CBotVar;
     friend class CBotVarPointer;
@@ -19,12 +19,33 @@
 
 #include "CBot/CBotVar/CBotVarString.h"
 
+#include <utility>
+
 namespace CBot
 {
 
 void CBotVarString::Add(CBotVar* left, CBotVar* right)
 {
-    SetValString(left->GetValString() + right->GetValString());
+    std::string value = left->GetValString();
+    value += right->GetValString();
+    m_val = std::move(value);
+    m_binit = CBotVar::InitType::DEF;
+}
+
+void CBotVarString::Append(CBotVar* var)
+{
+    if (var->GetType() == CBotTypString && var->IsDefined())
+        m_val += static_cast<CBotVarString*>(var)->m_val;
+    else
+        m_val += var->GetValString();
+    m_binit = CBotVar::InitType::DEF;
+}
+
+void CBotVarString::Move(CBotVarString* pSrc)
+{
+    CBotVar::Copy(pSrc);
+    m_val = std::move(pSrc->m_val);
+    pSrc->m_val.clear();
 }
 
 bool CBotVarString::Eq(CBotVar* left, CBotVar* right)
@@ -40,48 +40,43 @@ public:
 
     void SetValInt(int val, const std::string& s = "") override
     {
-        SetValString(ToString(val));
+        SetValString(ValueToString(val));
     }
 
     void SetValFloat(float val) override
     {
-        SetValString(ToString(val));
+        SetValString(ValueToString(val));
     }
 
     int GetValInt() const override
     {
-        return FromString<int>(GetValString());
+        return StringToValue<int>(GetValString());
     }
 
     float GetValFloat() const override
     {
-        return FromString<float>(GetValString());
+        return StringToValue<float>(GetValString());
     }
 
     void Add(CBotVar* left, CBotVar* right) override;
 
+    /**
+     * \brief Appends the value of the given variable converted to string
+     *
+     * Unlike Add(), this does not copy the current value.
+     */
+    void Append(CBotVar* var);
+
+    /**
+     * \brief Copies a variable which is not used anymore, taking its value instead of copying it
+     * \param pSrc Source variable, its value is left empty
+     */
+    void Move(CBotVarString* pSrc);
+
     bool Eq(CBotVar* left, CBotVar* right) override;
     bool Ne(CBotVar* left, CBotVar* right) override;
 
     bool Save1State(std::ostream &ostr) override;
-
-private:
-    template<typename T>
-    static std::string ToString(T val)
-    {
-        std::ostringstream ss;
-        ss << val;
-        return ss.str();
-    }
-
-    template<typename T>
-    static T FromString(std::string val)
-    {
-        std::istringstream ss(val);
-        T v;
-        ss >> v;
-        return v;
-    }
 };
 
 } // namespace CBot
@@ -24,13 +24,108 @@
 #include "CBot/CBotEnums.h"
 #include "CBot/CBotToken.h"
 
-#include <sstream>
+#include <algorithm>
+#include <charconv>
+#include <cctype>
 #include <cmath>
+#include <limits>
+#include <sstream>
+#include <type_traits>
 
 
 namespace CBot
 {
 
+/**
+ * \brief Converts a value to text the same way as std::ostream with std::boolalpha,
+ * without creating a stream for numbers and strings
+ */
+template <typename T>
+std::string ValueToString(T val)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        return val ? "true" : "false";
+    }
+    else if constexpr (std::is_same_v<T, std::string>)
+    {
+        return val;
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        char buffer[64];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), val, std::chars_format::general, 6);
+        return std::string(buffer, result.ptr);
+    }
+    else if constexpr (std::is_integral_v<T> && sizeof(T) > 1)
+    {
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), val);
+        return std::string(buffer, result.ptr);
+    }
+    else
+    {
+        std::ostringstream s;
+        s << val;
+        return s.str();
+    }
+}
+
+/**
+ * \brief Reads a value from text the same way as std::istream,
+ * without creating a stream for numbers
+ *
+ * Leading whitespace is skipped and 0 is returned if the text is not a number.
+ * Like with std::istream, "inf" and "nan" are not numbers, and values out of
+ * range give the largest or smallest value of the type.
+ */
+template <typename T>
+T StringToValue(const std::string& text)
+{
+    if constexpr ((std::is_integral_v<T> && sizeof(T) > 1 && !std::is_same_v<T, bool>) || std::is_floating_point_v<T>)
+    {
+        const char* first = text.data();
+        const char* last = first + text.size();
+        while (first != last && std::isspace(static_cast<unsigned char>(*first))) ++first;
+        if (first != last && *first == '+' && (first + 1 == last || first[1] != '-')) ++first;
+
+        T value = static_cast<T>(0);
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            // from_chars also accepts infinity and NaN, streams only digits
+            const char* digits = first != last && *first == '-' ? first + 1 : first;
+            if (digits == last || !(std::isdigit(static_cast<unsigned char>(*digits)) || *digits == '.'))
+                return value;
+        }
+
+        auto result = std::from_chars(first, last, value);
+        if (result.ec == std::errc::result_out_of_range)
+        {
+            if constexpr (std::is_integral_v<T>)
+                return *first == '-' ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+
+            // rare, leaves telling overflow from underflow to the stream
+            std::istringstream s(text);
+            s >> value;
+        }
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            // streams fail on an exponent without digits, from_chars stops before it
+            bool exponent = std::any_of(first, result.ptr, [](char c) { return c == 'e' || c == 'E'; });
+            if (result.ptr != last && (*result.ptr == 'e' || *result.ptr == 'E') && !exponent)
+                return static_cast<T>(0);
+        }
+        return value;
+    }
+    else
+    {
+        std::istringstream s(text);
+        T value{};
+        s >> value;
+        return value;
+    }
+}
+
 /**
  * \brief A variable holding a simple value (bool, int, float, string)
  */
@@ -57,8 +152,7 @@ public:
 
     void SetValString(const std::string& val) override
     {
-        std::istringstream s(val);
-        s >> m_val;
+        m_val = StringToValue<T>(val);
         m_binit = CBotVar::InitType::DEF;
     }
 
@@ -67,9 +161,24 @@ public:
         if (m_binit == CBotVar::InitType::UNDEF)
             return UndefinedTokenString();
 
-        std::ostringstream s;
-        s << std::boolalpha << m_val;
-        return s.str();
+        return ValueToString(m_val);
+    }
+
+    /**
+     * \brief Returns the value without going through the virtual getters
+     */
+    T GetValue() const
+    {
+        return m_val;
+    }
+
+    /**
+     * \brief Sets the value of a newly created variable without going through the virtual setters
+     */
+    void InitValue(T val)
+    {
+        m_val = val;
+        m_binit = CBotVar::InitType::DEF;
     }
 
 protected:
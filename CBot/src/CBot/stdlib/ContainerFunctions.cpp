@@ -0,0 +1,536 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/stdlib/stdlib.h"
+#include "CBot/stdlib/Containers.h"
+
+#include "CBot/CBot.h"
+#include "CBot/CBotContext.h"
+#include "CBot/CBotFileUtils.h"
+
+#include "CBot/CBotInstr/CBotInstrUtils.h"
+
+#include "CBot/CBotVar/CBotVarClass.h"
+
+#include <cmath>
+#include <functional>
+
+namespace CBot
+{
+
+CBotContainer::CBotContainer(bool hasValues)
+    : m_hasValues(hasValues)
+{
+}
+
+CBotContainer::~CBotContainer()
+{
+}
+
+bool CBotContainer::IsKeyType(int type)
+{
+    return (type >= CBotTypByte && type <= CBotTypDouble) || type == CBotTypString;
+}
+
+bool CBotContainer::Key::operator==(const Key& other) const
+{
+    if (isString != other.isString) return false;
+    return isString ? string == other.string : number == other.number;
+}
+
+std::size_t CBotContainer::KeyHash::operator()(const Key& key) const
+{
+    if (key.isString) return std::hash<std::string>()(key.string);
+    return std::hash<double>()(key.number);
+}
+
+CBotContainer::Key CBotContainer::MakeKey(CBotVar* var)
+{
+    Key key;
+    if (var->GetType() == CBotTypString)
+    {
+        key.isString = true;
+        key.string = var->GetValString();
+    }
+    else
+    {
+        key.number = var->GetValDouble();
+        if (key.number == 0.0) key.number = 0.0; // -0 and 0 are the same key
+    }
+    return key;
+}
+
+int CBotContainer::Find(CBotVar* key) const
+{
+    auto it = m_positions.find(MakeKey(key));
+    return it == m_positions.end() ? -1 : it->second;
+}
+
+int CBotContainer::Insert(CBotVar* key, bool& added)
+{
+    int position = GetSize();
+    auto result = m_positions.emplace(MakeKey(key), position);
+    added = result.second;
+    if (!added) return result.first->second;
+
+    Entry entry;
+    entry.key.reset(CBotVar::Create("key", key->GetTypResult()));
+    entry.key->Copy(key, false);
+    m_entries.push_back(std::move(entry));
+    return position;
+}
+
+bool CBotContainer::Remove(CBotVar* key)
+{
+    auto it = m_positions.find(MakeKey(key));
+    if (it == m_positions.end()) return false;
+
+    int position = it->second;
+    m_positions.erase(it);
+
+    // the last entry takes the place of the removed one
+    Entry removed = std::move(m_entries[position]);
+    if (position != GetSize() - 1)
+    {
+        m_entries[position] = std::move(m_entries.back());
+        m_positions[MakeKey(m_entries[position].key.get())] = position;
+    }
+    m_entries.pop_back();
+
+    // values are destroyed last, as it may run destructors of CBot classes
+    return true;
+}
+
+void CBotContainer::Clear()
+{
+    std::vector<Entry> entries;
+    entries.swap(m_entries);
+    m_positions.clear();
+}
+
+void CBotContainer::SetValue(int index, CBotVar* value)
+{
+    std::unique_ptr<CBotVar> copy(CBotVar::Create(value));
+    copy->Copy(value, false);
+    m_entries[index].value.swap(copy);
+}
+
+bool CBotContainer::Save(std::ostream &ostr) const
+{
+    for (const Entry& entry : m_entries)
+    {
+        if (!entry.key->Save0State(ostr)) return false;
+        if (!entry.key->Save1State(ostr)) return false;
+        if (!m_hasValues) continue;
+        if (!entry.value->Save0State(ostr)) return false;
+        if (!entry.value->Save1State(ostr)) return false;
+    }
+    return WriteWord(ostr, 0); // same terminator as SaveVars()
+}
+
+bool CBotContainer::Restore(std::istream &istr)
+{
+    Clear();
+
+    CBotVar* list = nullptr;
+    if (!CBotVar::RestoreState(istr, list)) return false;
+
+    for (CBotVar* p = list; p != nullptr; p = p->GetNext())
+    {
+        bool added = false;
+        int position = Insert(p, added);
+        if (!m_hasValues) continue;
+
+        p = p->GetNext();
+        if (p == nullptr) break;
+        SetValue(position, p);
+    }
+
+    delete list;
+    return true;
+}
+
+namespace
+{
+
+CBotContainer* CreateContainer(CBotVar* pThis)
+{
+    CBotContext& context = CBotContext::GetCurrent();
+    int handle = context.nextContainerId++;
+
+    bool hasValues = !pThis->GetClass()->IsChildOf(CBotClass::Find("set"));
+    CBotContainer* container = new CBotContainer(hasValues);
+    context.containers[handle].reset(container);
+
+    pThis->GetItem("handle")->SetValInt(handle);
+    return container;
+}
+
+CBotContainer* GetContainer(CBotVar* pThis)
+{
+    CBotVar* handle = pThis->GetItem("handle");
+    if (handle->IsDefined())
+    {
+        auto& containers = CBotContext::GetCurrent().containers;
+        auto it = containers.find(handle->GetValInt());
+        if (it != containers.end()) return it->second.get();
+    }
+
+    // the constructor was not called
+    return CreateContainer(pThis);
+}
+
+// checks that the parameter can be used as a key
+bool CheckKey(CBotVar* pVar, int& exception)
+{
+    if (pVar == nullptr) { exception = CBotErrLowParam; return false; }
+    if (pVar->GetType() != CBotTypString && std::isnan(pVar->GetValDouble())) { exception = CBotErrNan; return false; }
+    return true;
+}
+
+// checks that a stored key or value can be returned in the result, which has the type of the default value
+bool CheckResultType(CBotVar* pResult, CBotVar* value, int& exception)
+{
+    CBotTypResult resultType = pResult->GetTypResult();
+    CBotTypResult valueType = value->GetTypResult();
+
+    bool compatible = false;
+    if (resultType.Eq(CBotTypString))
+        compatible = valueType.GetType() <= CBotTypString;      // converted to text
+    else if (resultType.Eq(CBotTypNullPointer))                 // the default is null
+        compatible = valueType.Eq(CBotTypPointer) || valueType.Eq(CBotTypNullPointer);
+    else if (resultType.Eq(CBotTypArrayPointer))
+        compatible = valueType.Eq(CBotTypNullPointer) || resultType.Compare(valueType);
+    else
+        compatible = TypesCompatibles(resultType, valueType);
+
+    if (!compatible) exception = CBotErrBadValueType;
+    return compatible;
+}
+
+// gets the position given as first parameter
+bool GetPosition(CBotContainer* container, CBotVar* pVar, int& position, int& exception)
+{
+    position = pVar->GetValInt();
+    if (position < 0 || position >= container->GetSize()) { exception = CBotErrOutArray; return false; }
+    return true;
+}
+
+// constructor of map and set
+
+// execution
+bool rContainerConstruct(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& exception, void* user)
+{
+    CreateContainer(pThis);
+    return true;
+}
+
+// compilation
+CBotTypResult cContainerConstruct(CBotVar* pThis, CBotVar* &pVar)
+{
+    // accepts no parameters
+    if (pVar != nullptr) return CBotTypResult(CBotErrOverParam);
+
+    // the result is void (constructor)
+    return CBotTypResult(0);
+}
+
+// destructor of map and set
+
+bool rContainerDestruct(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& exception, void* user)
+{
+    pVar = pThis->GetItem("handle");
+    if (!pVar->IsDefined()) return true;
+
+    auto& containers = CBotContext::GetCurrent().containers;
+    auto it = containers.find(pVar->GetValInt());
+    if (it != containers.end())
+    {
+        // values may hold the last reference to another map
+        std::unique_ptr<CBotContainer> container = std::move(it->second);
+        containers.erase(it);
+    }
+
+    pVar->SetInit(CBotVar::InitType::UNDEF);
+    return true;
+}
+
+// compilation of a method taking a key
+
+CBotTypResult cKey(CBotVar* pThis, CBotVar* &pVar)
+{
+    // there must be a parameter
+    if (pVar == nullptr) return CBotTypResult(CBotErrLowParam);
+
+    // which must be a number or a string
+    if (!CBotContainer::IsKeyType(pVar->GetType())) return CBotTypResult(CBotErrBadParam);
+
+    // no second parameter
+    if (pVar->GetNext() != nullptr) return CBotTypResult(CBotErrOverParam);
+
+    // the function returns a boolean result
+    return CBotTypResult(CBotTypBoolean);
+}
+
+// compilation of clear()
+
+CBotTypResult cClear(CBotVar* pThis, CBotVar* &pVar)
+{
+    // it shouldn't be any parameter
+    if (pVar != nullptr) return CBotTypResult(CBotErrOverParam);
+
+    return CBotTypResult(CBotTypVoid);
+}
+
+// compilation of a method taking a key or position and a default value
+
+CBotTypResult cWithDefault(CBotVar* pThis, CBotVar* &pVar, bool position)
+{
+    // there must be two parameters
+    if (pVar == nullptr) return CBotTypResult(CBotErrLowParam);
+
+    if (position)
+    {
+        // the first one is a number
+        if (pVar->GetType() > CBotTypDouble) return CBotTypResult(CBotErrBadNum);
+    }
+    else
+    {
+        // the first one is a key
+        if (!CBotContainer::IsKeyType(pVar->GetType())) return CBotTypResult(CBotErrBadParam);
+    }
+
+    pVar = pVar->GetNext();
+    if (pVar == nullptr) return CBotTypResult(CBotErrLowParam);
+    if (pVar->GetType() == CBotTypVoid) return CBotTypResult(CBotErrBadParam);
+
+    // no third parameter
+    if (pVar->GetNext() != nullptr) return CBotTypResult(CBotErrOverParam);
+
+    // the result has the type of the default value
+    return pVar->GetTypResult(CBotVar::GetTypeMode::CLASS_AS_INTRINSIC);
+}
+
+CBotTypResult cKeyWithDefault(CBotVar* pThis, CBotVar* &pVar)
+{
+    return cWithDefault(pThis, pVar, false);
+}
+
+CBotTypResult cPositionWithDefault(CBotVar* pThis, CBotVar* &pVar)
+{
+    return cWithDefault(pThis, pVar, true);
+}
+
+// method contains(key)
+
+bool rContains(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& exception, void* user)
+{
+    if (!CheckKey(pVar, exception)) return false;
+
+    pResult->SetValInt(GetContainer(pThis)->Find(pVar) >= 0);
+    return true;
+}
+
+// method remove(key)
+
+bool rRemove(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& exception, void* user)
+{
+    if (!CheckKey(pVar, exception)) return false;
+
+    pResult->SetValInt(GetContainer(pThis)->Remove(pVar));
+    return true;
+}
+
+// method clear()
+
+bool rClear(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& exception, void* user)
+{
+    GetContainer(pThis)->Clear();
+    return true;
+}
+
+// method key(position, default)
+
+bool rKeyAt(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& exception, void* user)
+{
+    CBotContainer* container = GetContainer(pThis);
+
+    int position = 0;
+    if (!GetPosition(container, pVar, position, exception)) return false;
+    if (!CheckResultType(pResult, container->GetKey(position), exception)) return false;
+
+    pResult->SetVal(container->GetKey(position));
+    return true;
+}
+
+// method map.put(key, value)
+
+bool rMapPut(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& exception, void* user)
+{
+    if (!CheckKey(pVar, exception)) return false;
+
+    CBotContainer* container = GetContainer(pThis);
+
+    bool added = false;
+    int position = container->Insert(pVar, added);
+    container->SetValue(position, pVar->GetNext());
+    return true;
+}
+
+CBotTypResult cMapPut(CBotVar* pThis, CBotVar* &pVar)
+{
+    // there must be two parameters
+    if (pVar == nullptr) return CBotTypResult(CBotErrLowParam);
+
+    // the first one is a key
+    if (!CBotContainer::IsKeyType(pVar->GetType())) return CBotTypResult(CBotErrBadParam);
+
+    // the second one is any value
+    pVar = pVar->GetNext();
+    if (pVar == nullptr) return CBotTypResult(CBotErrLowParam);
+    if (pVar->GetType() == CBotTypVoid) return CBotTypResult(CBotErrBadParam);
+
+    // no third parameter
+    if (pVar->GetNext() != nullptr) return CBotTypResult(CBotErrOverParam);
+
+    return CBotTypResult(CBotTypVoid);
+}
+
+// method map.get(key, default)
+
+bool rMapGet(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& exception, void* user)
+{
+    if (!CheckKey(pVar, exception)) return false;
+
+    CBotContainer* container = GetContainer(pThis);
+
+    int position = container->Find(pVar);
+    CBotVar* value = position >= 0 ? container->GetValue(position) : pVar->GetNext();
+    if (!CheckResultType(pResult, value, exception)) return false;
+
+    pResult->SetVal(value);
+    return true;
+}
+
+// method map.value(position, default)
+
+bool rMapValueAt(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& exception, void* user)
+{
+    CBotContainer* container = GetContainer(pThis);
+
+    int position = 0;
+    if (!GetPosition(container, pVar, position, exception)) return false;
+    if (!CheckResultType(pResult, container->GetValue(position), exception)) return false;
+
+    pResult->SetVal(container->GetValue(position));
+    return true;
+}
+
+// method set.add(key)
+
+bool rSetAdd(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& exception, void* user)
+{
+    if (!CheckKey(pVar, exception)) return false;
+
+    bool added = false;
+    GetContainer(pThis)->Insert(pVar, added);
+    pResult->SetValInt(added);
+    return true;
+}
+
+// saving and restoring the contents
+
+bool SaveContainer(CBotVar* pThis, std::ostream &ostr)
+{
+    return GetContainer(pThis)->Save(ostr);
+}
+
+bool RestoreContainer(CBotVar* pThis, std::istream &istr)
+{
+    if (pThis == nullptr)
+    {
+        // the instance already exists, skip its contents
+        CBotVar* list = nullptr;
+        bool result = CBotVar::RestoreState(istr, list);
+        delete list;
+        return result;
+    }
+
+    // the saved handle may belong to another instance
+    return CreateContainer(pThis)->Restore(istr);
+}
+
+} // namespace
+
+int GetContainerSize(CBotVar* var)
+{
+    CBotVarClass* instance = var->GetPointer();
+    if (instance == nullptr) return -1;
+    return GetContainer(instance)->GetSize();
+}
+
+bool IsContainerClass(CBotClass* pClass)
+{
+    return pClass != nullptr &&
+           (pClass->IsChildOf(CBotClass::Find("map")) || pClass->IsChildOf(CBotClass::Find("set")));
+}
+
+void InitContainerFunctions()
+{
+    // map m();
+    // m.put("titanium", 3);
+    // int n = m.get("titanium", 0);
+    // for (int i = 0; i < sizeof(m); ++i) message(m.key(i, "") + " " + m.value(i, 0));
+
+    CBotClass* bc = CBotClass::Create("map", nullptr);
+    bc->AddItem("handle", CBotTypInt, CBotVar::ProtectionLevel::Private);
+
+    bc->AddFunction("map", rContainerConstruct, cContainerConstruct);
+    bc->AddFunction("~map", rContainerDestruct, nullptr);
+
+    bc->AddFunction("put", rMapPut, cMapPut);
+    bc->AddFunction("get", rMapGet, cKeyWithDefault);
+    bc->AddFunction("contains", rContains, cKey);
+    bc->AddFunction("remove", rRemove, cKey);
+    bc->AddFunction("clear", rClear, cClear);
+    bc->AddFunction("key", rKeyAt, cPositionWithDefault);
+    bc->AddFunction("value", rMapValueAt, cPositionWithDefault);
+
+    bc->SetStateFunc(SaveContainer, RestoreContainer);
+
+    // set s();
+    // s.add(3);
+    // if (s.contains(3)) ...
+
+    bc = CBotClass::Create("set", nullptr);
+    bc->AddItem("handle", CBotTypInt, CBotVar::ProtectionLevel::Private);
+
+    bc->AddFunction("set", rContainerConstruct, cContainerConstruct);
+    bc->AddFunction("~set", rContainerDestruct, nullptr);
+
+    bc->AddFunction("add", rSetAdd, cKey);
+    bc->AddFunction("contains", rContains, cKey);
+    bc->AddFunction("remove", rRemove, cKey);
+    bc->AddFunction("clear", rClear, cClear);
+    bc->AddFunction("key", rKeyAt, cPositionWithDefault);
+
+    bc->SetStateFunc(SaveContainer, RestoreContainer);
+}
+
+} // namespace CBot
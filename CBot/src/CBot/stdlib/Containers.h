@@ -0,0 +1,135 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#pragma once
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CBot
+{
+
+class CBotVar;
+
+/**
+ * \brief Contents of an instance of the "map" or "set" classes of CBot
+ *
+ * Entries are kept in an array in the order they were added in, a removed
+ * entry is replaced by the last one. A hash table gives the position of the
+ * entry of each key, so lookups, insertions and removals take constant
+ * expected time, and entries can be iterated by position.
+ *
+ * Keys are numbers or strings. Numbers are compared by value, 1 and 1.0 are
+ * the same key, and never equal a string.
+ */
+class CBotContainer
+{
+public:
+    //! \param hasValues true for a map, false for a set
+    explicit CBotContainer(bool hasValues);
+    ~CBotContainer();
+
+    CBotContainer(const CBotContainer&) = delete;
+    CBotContainer& operator=(const CBotContainer&) = delete;
+
+    //! Returns true if the type can be used as key
+    static bool IsKeyType(int type);
+
+    //! Returns the number of entries
+    int GetSize() const { return static_cast<int>(m_entries.size()); }
+
+    /**
+     * \brief Finds the entry of a key
+     * \return Position of the entry, -1 if there is none
+     */
+    int Find(CBotVar* key) const;
+
+    /**
+     * \brief Adds an entry for a key if there is none yet
+     * \param key Key, copied into the entry
+     * \param[out] added true if the entry was added
+     * \return Position of the entry
+     */
+    int Insert(CBotVar* key, bool& added);
+
+    /**
+     * \brief Removes the entry of a key
+     * \return false if there was none
+     */
+    bool Remove(CBotVar* key);
+
+    //! Removes all entries
+    void Clear();
+
+    //! Returns the key of the entry at the given position
+    CBotVar* GetKey(int index) const { return m_entries[index].key.get(); }
+
+    //! Returns the value of the entry at the given position, nullptr in a set
+    CBotVar* GetValue(int index) const { return m_entries[index].value.get(); }
+
+    //! Replaces the value of the entry at the given position with a copy of the given one
+    void SetValue(int index, CBotVar* value);
+
+    /**
+     * \brief Saves all entries
+     *
+     * The keys and values are written in the same format as the elements of a class.
+     */
+    bool Save(std::ostream &ostr) const;
+
+    /**
+     * \brief Replaces the contents with entries saved by Save()
+     */
+    bool Restore(std::istream &istr);
+
+private:
+    struct Key
+    {
+        bool isString = false;
+        double number = 0.0;
+        std::string string;
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    struct Entry
+    {
+        std::unique_ptr<CBotVar> key;
+        std::unique_ptr<CBotVar> value;
+    };
+
+    static Key MakeKey(CBotVar* var);
+
+    //! true for a map, false for a set
+    const bool m_hasValues;
+    //! Entries in iteration order
+    std::vector<Entry> m_entries;
+    //! Position of the entry of each key in m_entries
+    std::unordered_map<Key, int, KeyHash> m_positions;
+};
+
+} // namespace CBot
@@ -20,6 +20,7 @@
 #include "CBot/stdlib/stdlib.h"
 
 #include "CBot/CBot.h"
+#include "CBot/CBotContext.h"
 
 #include <memory>
 #include <unordered_map>
@@ -31,8 +32,6 @@ namespace CBot
 namespace
 {
 std::unique_ptr<CBotFileAccessHandler> g_fileHandler;
-std::unordered_map<int, std::unique_ptr<CBotFile>> g_files;
-int g_nextFileId = 1;
 
 bool FileClassOpenFile(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception)
 {
@@ -74,8 +73,9 @@ bool FileClassOpenFile(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exc
 
     if (!file->Opened()) { Exception = CBotErrFileOpen; return false; }
 
-    int fileHandle = g_nextFileId++;
-    g_files[fileHandle] = std::move(file);
+    CBotContext& context = CBotContext::GetCurrent();
+    int fileHandle = context.nextFileId++;
+    context.files[fileHandle] = std::move(file);
 
     // save the file handle
     pVar = pThis->GetItem("handle");
@@ -131,7 +131,7 @@ bool rfdestruct (CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception
     pVar = pThis->GetItem("handle");
 
     if (!pVar->IsDefined()) return true; // file not opened
-    g_files.erase(pVar->GetValInt());
+    CBotContext::GetCurrent().files.erase(pVar->GetValInt());
 
     pVar->SetInit(CBotVar::InitType::UNDEF);
     return true;
@@ -194,14 +194,15 @@ bool rfclose (CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception, v
 
     int fileHandle = pVar->GetValInt();
 
-    const auto handleIter = g_files.find(fileHandle);
-    if (handleIter == g_files.end())
+    auto& files = CBotContext::GetCurrent().files;
+    const auto handleIter = files.find(fileHandle);
+    if (handleIter == files.end())
     {
         Exception = CBotErrNotOpen;
         return false;
     }
 
-    g_files.erase(handleIter);
+    files.erase(handleIter);
 
     pVar->SetInit(CBotVar::InitType::UNDEF);
     return true;
@@ -237,8 +238,9 @@ bool rfwrite (CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception, v
 
     int fileHandle = pVar->GetValInt();
 
-    const auto handleIter = g_files.find(fileHandle);
-    if (handleIter == g_files.end())
+    auto& files = CBotContext::GetCurrent().files;
+    const auto handleIter = files.find(fileHandle);
+    if (handleIter == files.end())
     {
         Exception = CBotErrNotOpen;
         return false;
@@ -283,8 +285,9 @@ bool rfread(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception, voi
 
     int fileHandle = pVar->GetValInt();
 
-    const auto handleIter = g_files.find(fileHandle);
-    if (handleIter == g_files.end())
+    auto& files = CBotContext::GetCurrent().files;
+    const auto handleIter = files.find(fileHandle);
+    if (handleIter == files.end())
     {
         Exception = CBotErrNotOpen;
         return false;
@@ -325,8 +328,9 @@ bool rfeof (CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception, voi
 
     int fileHandle = pVar->GetValInt();
 
-    const auto handleIter = g_files.find(fileHandle);
-    if (handleIter == g_files.end())
+    auto& files = CBotContext::GetCurrent().files;
+    const auto handleIter = files.find(fileHandle);
+    if (handleIter == files.end())
     {
         Exception = CBotErrNotOpen;
         return false;
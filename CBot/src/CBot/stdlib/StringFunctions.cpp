@@ -25,6 +25,8 @@
 
 #include <common/stringutils.h>
 
+#include <cstdio>
+
 namespace CBot
 {
 namespace
@@ -282,6 +284,205 @@ bool rStrLower( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+CBotTypResult cStrJoin( CBotVar*& var, void* user )
+{
+    // it takes a parameter
+    if ( var == nullptr ) return CBotTypResult( CBotErrLowParam );
+
+    // to be an array of strings or numbers
+    if ( var->GetType() != CBotTypArrayPointer ||
+         var->GetTypResult().GetTypElem().GetType() > CBotTypString )
+        return CBotTypResult( CBotErrBadParam );
+
+    // the separator is optional
+    var = var->GetNext();
+    if ( var != nullptr )
+    {
+        // to be a string
+        if ( var->GetType() != CBotTypString )
+            return CBotTypResult( CBotErrBadString );
+
+        // no third parameter
+        if ( var->GetNext() != nullptr ) return CBotTypResult( CBotErrOverParam );
+    }
+
+    // the end result is a string
+    return CBotTypResult( CBotTypString );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool rStrJoin( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
+{
+    std::string separator;
+    if ( pVar->GetNext() != nullptr ) separator = pVar->GetNext()->GetValString();
+
+    // builds the result at once, without intermediate strings
+    std::string s;
+    bool first = true;
+    for ( CBotVar* item = pVar->GetItemList() ; item != nullptr ; item = item->GetNext() )
+    {
+        if ( !first ) s += separator;
+        s += item->GetValString();
+        first = false;
+    }
+
+    // puts on the stack
+    pResult->SetValString( s );
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotTypResult cStrSplit( CBotVar*& var, void* user )
+{
+    CBotTypResult result = cIntStrStr( var, user );
+    if ( result.GetType() != CBotTypInt ) return result;
+
+    // the end result is an array of strings
+    return CBotTypResult( CBotTypArrayPointer, CBotTypResult( CBotTypString ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool rStrSplit( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
+{
+    // get the contents of the string and the separator
+    std::string s = pVar->GetValString();
+    std::string separator = pVar->GetNext()->GetValString();
+
+    // an empty separator gives the whole string
+    int i = 0;
+    std::size_t start = 0;
+    while ( !separator.empty() )
+    {
+        std::size_t end = s.find(separator, start);
+        if ( end == std::string::npos ) break;
+
+        pResult->GetItem(i++, true)->SetValString(s.substr(start, end - start));
+        start = end + separator.length();
+    }
+    pResult->GetItem(i, true)->SetValString(s.substr(start));
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotTypResult cStrFormat( CBotVar*& var, void* user )
+{
+    // it takes a parameter
+    if ( var == nullptr ) return CBotTypResult( CBotErrLowParam );
+
+    // to be a string
+    if ( var->GetType() != CBotTypString )
+        return CBotTypResult( CBotErrBadString );
+
+    // followed by any number of values, checked with the format on execution
+    for ( var = var->GetNext() ; var != nullptr ; var = var->GetNext() )
+    {
+        if ( var->GetType() == CBotTypVoid )
+            return CBotTypResult( CBotErrBadParam );
+    }
+
+    // the end result is a string
+    return CBotTypResult( CBotTypString );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Formats values like printf(): %d %i %x %X %o %c for integers,
+// %f %e %g %F %E %G for floats, %s for anything and %% for %.
+// Flags, width and precision are allowed, length modifiers are not.
+
+bool rStrFormat( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
+{
+    std::string format = pVar->GetValString();
+    pVar = pVar->GetNext();
+
+    std::string s;
+    s.reserve(format.length());
+
+    char buffer[128];
+    std::size_t i = 0;
+    while ( i < format.length() )
+    {
+        char c = format[i++];
+        if ( c != '%' )
+        {
+            s += c;
+            continue;
+        }
+        if ( i < format.length() && format[i] == '%' )
+        {
+            s += '%';
+            i++;
+            continue;
+        }
+
+        // copies the specification without the conversion,
+        // width and precision have at most 3 digits so that the result stays small
+        std::string spec = "%";
+        while ( i < format.length() && CharInList(format[i], "-+ #0") )  spec += format[i++];
+        std::size_t start = spec.length();
+        while ( i < format.length() && format[i] >= '0' && format[i] <= '9' )  spec += format[i++];
+        if ( spec.length() - start > 3 ) { ex = CBotErrBadParam ; return true; }
+        if ( i < format.length() && format[i] == '.' )
+        {
+            spec += format[i++];
+            start = spec.length();
+            while ( i < format.length() && format[i] >= '0' && format[i] <= '9' )  spec += format[i++];
+            if ( spec.length() - start > 3 ) { ex = CBotErrBadParam ; return true; }
+        }
+        if ( i >= format.length() || spec.length() > 16 ) { ex = CBotErrBadParam ; return true; }
+        char conversion = format[i++];
+
+        // each specification takes a value
+        if ( pVar == nullptr ) { ex = CBotErrLowParam ; return true; }
+
+        int len = 0;
+        switch ( conversion )
+        {
+            case 'd': case 'i': case 'x': case 'X': case 'o': case 'c':
+                if ( pVar->GetType() > CBotTypDouble ) { ex = CBotErrBadNum ; return true; }
+                spec += conversion;
+                len = snprintf(buffer, sizeof(buffer), spec.c_str(), pVar->GetValInt());
+                break;
+
+            case 'f': case 'e': case 'g': case 'F': case 'E': case 'G':
+                if ( pVar->GetType() > CBotTypDouble ) { ex = CBotErrBadNum ; return true; }
+                spec += conversion;
+                len = snprintf(buffer, sizeof(buffer), spec.c_str(), pVar->GetValDouble());
+                break;
+
+            case 's':
+            {
+                spec += conversion;
+                std::string value = pVar->GetValString();
+                int needed = snprintf(nullptr, 0, spec.c_str(), value.c_str());
+                if ( needed > 0 )
+                {
+                    std::size_t offset = s.length();
+                    s.resize(offset + needed);
+                    snprintf(&s[offset], needed + 1, spec.c_str(), value.c_str());
+                }
+                pVar = pVar->GetNext();
+                continue;
+            }
+
+            default:
+                ex = CBotErrBadParam;
+                return true;
+        }
+
+        if ( len < 0 || len >= static_cast<int>(sizeof(buffer)) ) { ex = CBotErrBadParam ; return true; }
+        s.append(buffer, len);
+        pVar = pVar->GetNext();
+    }
+
+    // every value must be used
+    if ( pVar != nullptr ) { ex = CBotErrOverParam ; return true; }
+
+    // puts on the stack
+    pResult->SetValString( s );
+    return true;
+}
+
 } // namespace
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -297,6 +498,10 @@ void InitStringFunctions()
 
     CBotProgram::AddFunction("strupper", rStrUpper, cStrStr );
     CBotProgram::AddFunction("strlower", rStrLower, cStrStr );
+
+    CBotProgram::AddFunction("strjoin",   rStrJoin,   cStrJoin );
+    CBotProgram::AddFunction("strsplit",  rStrSplit,  cStrSplit );
+    CBotProgram::AddFunction("strformat", rStrFormat, cStrFormat );
 }
 
 } // namespace CBot
@@ -27,5 +27,14 @@ namespace CBot
 void InitStringFunctions();
 void InitFileFunctions();
 void InitMathFunctions();
+void InitContainerFunctions();
+
+class CBotClass;
+class CBotVar;
+
+//! Returns true if the class is "map", "set" or derived from one of them
+bool IsContainerClass(CBotClass* pClass);
+//! Returns the number of entries of the map or set the variable points to, -1 for null
+int GetContainerSize(CBotVar* var);
 
 } // namespace CBot
@@ -49,6 +49,7 @@ public:
     virtual bool DeleteFile(const std::string& filename) = 0;
 };
 
+//! Sets handler used by file functions, it is shared by all contexts (see CBotContext)
 void SetFileAccessHandler(std::unique_ptr<CBotFileAccessHandler> fileHandler);
 
 // TODO: provide default implementation of CBotFileAccessHandler
@@ -36,6 +36,8 @@
 
 #include "common/system/system.h"
 
+#include "common/thread/job_system.h"
+
 #include "graphics/core/device.h"
 #include "graphics/engine/engine.h"
 #include "graphics/opengl33/glutil.h"
@@ -55,7 +57,6 @@
 #include <stdlib.h>
 #include <getopt.h>
 #include <localename.h>
-#include <thread>
 
 #include <libintl.h>
 
@@ -111,6 +112,7 @@ struct ApplicationPrivate
 CApplication::CApplication(CSystemUtils* systemUtils)
     : m_systemUtils(systemUtils),
       m_private(std::make_unique<ApplicationPrivate>()),
+      m_jobSystem(std::make_unique<CJobSystem>()),
       m_configFile(std::make_unique<CConfigFile>()),
       m_input(std::make_unique<CInput>()),
       m_pathManager(std::make_unique<CPathManager>(systemUtils)),
@@ -157,6 +159,9 @@ CApplication::~CApplication()
 {
     m_joystickEnabled = false;
 
+    // finish background jobs while everything they may use still exists
+    m_jobSystem.reset();
+
     m_controller.reset();
     m_sound.reset();
 
@@ -213,6 +218,11 @@ CModManager* CApplication::GetModManager()
     return m_modManager.get();
 }
 
+CJobSystem* CApplication::GetJobSystem()
+{
+    return m_jobSystem.get();
+}
+
 void CApplication::LoadEnvironmentVariables()
 {
     auto dataDir = m_systemUtils->GetEnvVar("COLOBOT_DATA_DIR");
@@ -1144,6 +1154,10 @@ int CApplication::Run()
                 m_eventQueue->AddEvent(std::move(event));
         }
 
+        // Results of background jobs are handed back before events are processed,
+        // also while the window is inactive so that no job result waits for it
+        m_jobSystem->ProcessCompletions();
+
         // Enter game update & frame rendering only if active
         if (m_active)
         {
@@ -1544,7 +1558,7 @@ void CApplication::InternalResumeSimulation()
 
 void CApplication::StartLoadingMusic()
 {
-    std::thread{[this]()
+    m_jobSystem->Submit([this]()
     {
         GetLogger()->Debug("Cache sounds...");
         TimeStamp musicLoadStart{m_systemUtils->GetCurrentTimeStamp()};
@@ -1555,7 +1569,7 @@ void CApplication::StartLoadingMusic()
         TimeStamp musicLoadEnd{m_systemUtils->GetCurrentTimeStamp()};
         float musicLoadTime = TimeUtils::Diff(musicLoadStart, musicLoadEnd, TimeUnit::MILLISECONDS);
         GetLogger()->Debug("Sound loading took %% ms", static_cast<int>(musicLoadTime));
-    }}.detach();
+    });
 }
 
 bool CApplication::GetSimulationSuspended() const
@@ -40,6 +40,7 @@
 
 class CEventQueue;
 class CController;
+class CJobSystem;
 class CSoundInterface;
 class CInput;
 class CModManager;
@@ -165,6 +166,8 @@ public:
     CSoundInterface* GetSound();
     //! Returns the mod manager
     CModManager* GetModManager();
+    //! Returns the thread pool for background jobs
+    CJobSystem* GetJobSystem();
 
 public:
     //! Loads some data from environment variables
@@ -309,7 +312,7 @@ protected:
     //! Internal procedure to reset time counters
     void InternalResumeSimulation();
 
-    //! Loads music in a new thread
+    //! Loads music in a background job
     void StartLoadingMusic();
 
 protected:
@@ -319,6 +322,8 @@ protected:
     std::unique_ptr<ApplicationPrivate> m_private;
     //! Global event queue
     std::unique_ptr<CEventQueue> m_eventQueue;
+    //! Thread pool for background jobs
+    std::unique_ptr<CJobSystem> m_jobSystem;
     //! Graphics engine
     std::unique_ptr<Gfx::CEngine> m_engine;
     //! Graphics device
@@ -30,6 +30,8 @@ long long CProfiler::m_performanceCounters[PCNT_MAX] = {0};
 long long CProfiler::m_prevPerformanceCounters[PCNT_MAX] = {0};
 std::stack<TimeStamp> CProfiler::m_runningPerformanceCounters;
 std::stack<PerformanceCounter> CProfiler::m_runningPerformanceCountersType;
+long long CProfiler::m_performanceStats[PSTAT_MAX] = {0};
+long long CProfiler::m_prevPerformanceStats[PSTAT_MAX] = {0};
 
 void CProfiler::SetSystemUtils(CSystemUtils* systemUtils)
 {
@@ -69,12 +71,37 @@ float CProfiler::GetPerformanceCounterFraction(PerformanceCounter counter)
     return static_cast<float>(m_prevPerformanceCounters[counter]) / static_cast<float>(m_prevPerformanceCounters[PCNT_ALL]);
 }
 
+void CProfiler::AddPerformanceStat(PerformanceStat stat, long long count)
+{
+    m_performanceStats[stat] += count;
+}
+
+long long CProfiler::GetPerformanceStat(PerformanceStat stat)
+{
+    return m_prevPerformanceStats[stat];
+}
+
+long long CProfiler::GetCurrentPerformanceStat(PerformanceStat stat)
+{
+    return m_performanceStats[stat];
+}
+
+void CProfiler::ResetPerformanceStats()
+{
+    for (int i = 0; i < PSTAT_MAX; ++i)
+    {
+        m_performanceStats[i] = 0;
+    }
+}
+
 void CProfiler::ResetPerformanceCounters()
 {
     for (int i = 0; i < PCNT_MAX; ++i)
     {
         m_performanceCounters[i] = 0;
     }
+
+    ResetPerformanceStats();
 }
 
 void CProfiler::SavePerformanceCounters()
@@ -85,4 +112,9 @@ void CProfiler::SavePerformanceCounters()
     {
         m_prevPerformanceCounters[i] = m_performanceCounters[i];
     }
+
+    for (int i = 0; i < PSTAT_MAX; ++i)
+    {
+        m_prevPerformanceStats[i] = m_performanceStats[i];
+    }
 }
@@ -54,6 +54,28 @@ enum PerformanceCounter
     PCNT_MAX
 };
 
+/**
+ * \enum PerformanceStat
+ * \brief Type of per-frame statistic counted by the profiler
+ *
+ * Unlike PerformanceCounter, these count events rather than time,
+ * so they can be checked without a GPU through the recording device.
+ */
+enum PerformanceStat
+{
+    PSTAT_TEXTURE_BINDS,        //! < textures actually bound by renderers
+    PSTAT_DRAW_CALLS,           //! < draw calls submitted by renderers
+    PSTAT_TRIANGLES,            //! < triangles submitted by renderers
+    PSTAT_STATE_CHANGES,        //! < other render state changes (blending, color, model matrix) applied by renderers
+    PSTAT_CBOT_TICKS,           //! < CBot timer ticks (parts of instructions) run
+    PSTAT_CBOT_THROTTLED_PROGRAMS, //! < CBot programs given less than their ipf() to keep within frame time
+    PSTAT_RESOURCE_BYTES_COPIED, //! < bytes of resource files copied into intermediate buffers instead of being mapped
+    PSTAT_BUFFER_UPLOADS,       //! < buffer updates (vertices, uniforms) issued by renderers
+    PSTAT_BUFFER_UPLOAD_BYTES,  //! < bytes of vertex and uniform data sent to the GPU by renderers
+
+    PSTAT_MAX
+};
+
 class CProfiler
 {
 public:
@@ -64,6 +86,15 @@ public:
     static long long GetPerformanceCounterTime(PerformanceCounter counter);
     static float GetPerformanceCounterFraction(PerformanceCounter counter);
 
+    //! Adds \a count to the given statistic for the current frame
+    static void AddPerformanceStat(PerformanceStat stat, long long count = 1);
+    //! Returns value of the given statistic from the previous frame
+    static long long GetPerformanceStat(PerformanceStat stat);
+    //! Returns value of the given statistic accumulated so far in the current frame
+    static long long GetCurrentPerformanceStat(PerformanceStat stat);
+    //! Clears statistics of the current frame, used when there is no frame loop (e.g. in tests)
+    static void ResetPerformanceStats();
+
 private:
     static void ResetPerformanceCounters();
     static void SavePerformanceCounters();
@@ -75,6 +106,9 @@ private:
     static long long m_prevPerformanceCounters[PCNT_MAX];
     static std::stack<TimeUtils::TimeStamp> m_runningPerformanceCounters;
     static std::stack<PerformanceCounter> m_runningPerformanceCountersType;
+
+    static long long m_performanceStats[PSTAT_MAX];
+    static long long m_prevPerformanceStats[PSTAT_MAX];
 };
 
 
@@ -19,21 +19,8 @@
 
 #include "common/resources/inputstreambuffer.h"
 
-#include "common/resources/resourcemanager.h"
-
-#include <stdexcept>
-#include <sstream>
-
-CInputStreamBuffer::CInputStreamBuffer(std::size_t bufferSize)
-  : m_bufferSize(bufferSize)
-  , m_file(nullptr)
+CInputStreamBuffer::CInputStreamBuffer()
 {
-    if (bufferSize <= 0)
-    {
-        throw std::runtime_error("File buffer must be larger than 0 bytes");
-    }
-
-    m_buffer = std::make_unique<char[]>(bufferSize);
 }
 
 
@@ -45,27 +32,31 @@ CInputStreamBuffer::~CInputStreamBuffer()
 
 void CInputStreamBuffer::open(const std::filesystem::path& path)
 {
-    if (PHYSFS_isInit())
-        m_file = PHYSFS_openRead(CResourceManager::CleanPath(path.generic_u8string()).c_str());
+    // The whole contents are the get area, so reading never goes back to the file
+    if (m_file.Open(path))
+    {
+        char* data = const_cast<char*>(m_file.GetData());
+        setg(data, data, data + m_file.GetSize());
+    }
 }
 
 
 void CInputStreamBuffer::close()
 {
-    if (is_open())
-        PHYSFS_close(m_file);
+    m_file.Close();
+    setg(nullptr, nullptr, nullptr);
 }
 
 
 bool CInputStreamBuffer::is_open()
 {
-    return m_file != nullptr;
+    return m_file.IsOpen();
 }
 
 
 std::size_t CInputStreamBuffer::size()
 {
-    return PHYSFS_fileLength(m_file);
+    return m_file.GetSize();
 }
 
 
@@ -74,16 +65,7 @@ std::streambuf::int_type CInputStreamBuffer::underflow()
     if (gptr() < egptr())
         return traits_type::to_int_type(*gptr());
 
-    if (PHYSFS_eof(m_file))
-        return traits_type::eof();
-
-    PHYSFS_sint64 read_count = PHYSFS_readBytes(m_file, m_buffer.get(), sizeof(char) * m_bufferSize);
-    if (read_count <= 0)
-        return traits_type::eof();
-
-    setg(m_buffer.get(), m_buffer.get(), m_buffer.get() + read_count);
-
-    return traits_type::to_int_type(*gptr());
+    return traits_type::eof();
 }
 
 
@@ -95,40 +77,15 @@ std::streampos CInputStreamBuffer::seekpos(std::streampos sp, std::ios_base::ope
 
 std::streampos CInputStreamBuffer::seekoff(std::streamoff off, std::ios_base::seekdir way, std::ios_base::openmode which)
 {
-    /* A bit of explanation:
-       We are reading file by m_bufferSize parts so our 3 internal pointers will be
-       * eback (not used here) - start of block
-       * gptr - position of read cursor in block
-       * egtpr - end of block
-       off argument is relative to way */
+    std::streamoff position = off;
+    if (way == std::ios_base::cur)
+        position += gptr() - eback();
+    else if (way == std::ios_base::end)
+        position += egptr() - eback();
 
-    std::streamoff new_position{};
-
-    switch (way)
-    {
-        case std::ios_base::beg:
-            new_position = off;
-            break;
-
-        case std::ios_base::cur:
-            // tell will give cursor at begining of block so we have to add where in block we currently are
-            new_position = off + static_cast<off_type>(PHYSFS_tell(m_file)) - static_cast<off_type> (egptr() - gptr());
-            break;
-
-        case std::ios_base::end:
-            new_position = off + static_cast<off_type>(PHYSFS_fileLength(m_file));
-            break;
-
-        default:
-            break;
-    }
-
-    if (PHYSFS_seek(m_file, new_position))
-    {
-        setg(m_buffer.get(), m_buffer.get(), m_buffer.get()); // reset buffer
-
-        return pos_type(new_position);
-    }
+    if (!is_open() || position < 0 || position > egptr() - eback())
+        return pos_type(off_type(-1));
 
-    return pos_type(off_type(-1));
+    setg(eback(), eback() + position, egptr());
+    return pos_type(position);
 }
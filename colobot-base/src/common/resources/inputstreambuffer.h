@@ -19,18 +19,20 @@
 
 #pragma once
 
+#include "common/resources/mapped_file.h"
+
 #include <cstddef>
 #include <filesystem>
-#include <memory>
 #include <streambuf>
-#include <string>
-
-#include <physfs.h>
 
+/**
+ * \class CInputStreamBuffer
+ * \brief Stream buffer over the whole contents of a resource file, see CMappedFile
+ */
 class CInputStreamBuffer : public std::streambuf
 {
 public:
-    CInputStreamBuffer(std::size_t bufferSize = 512);
+    CInputStreamBuffer();
     virtual ~CInputStreamBuffer();
 
     CInputStreamBuffer(const CInputStreamBuffer &) = delete;
@@ -47,7 +49,5 @@ private:
     std::streampos seekpos(std::streampos sp, std::ios_base::openmode which) override;
     std::streampos seekoff(std::streamoff off, std::ios_base::seekdir way, std::ios_base::openmode which) override;
 
-    const std::size_t m_bufferSize;
-    PHYSFS_File *m_file;
-    std::unique_ptr<char[]> m_buffer;
+    CMappedFile m_file;
 };
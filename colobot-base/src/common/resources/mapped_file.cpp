@@ -0,0 +1,206 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "common/resources/mapped_file.h"
+
+#include "common/config.h"
+#include "common/profiler.h"
+
+#include "common/resources/resourcemanager.h"
+
+#include <physfs.h>
+
+#include <string>
+
+#if PLATFORM_WINDOWS
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace
+{
+
+//! Returns the file of the operating system behind a path of the resource system, empty if it is in an archive
+std::filesystem::path GetSystemPath(const std::string& path)
+{
+    const char* realDir = PHYSFS_getRealDir(path.c_str());
+    if (realDir == nullptr) return {};
+
+    std::error_code error;
+    std::filesystem::path directory = std::filesystem::u8path(realDir);
+    if (!std::filesystem::is_directory(directory, error)) return {};
+
+    // The directory may be mounted somewhere else than the root of the resource system
+    std::string relative = path;
+    while (!relative.empty() && relative.front() == '/') relative.erase(0, 1);
+
+    const char* mountPoint = PHYSFS_getMountPoint(realDir);
+    if (mountPoint != nullptr)
+    {
+        std::string prefix = mountPoint;
+        while (!prefix.empty() && prefix.front() == '/') prefix.erase(0, 1);
+        if (relative.compare(0, prefix.size(), prefix) != 0) return {};
+        relative.erase(0, prefix.size());
+    }
+
+    return directory / std::filesystem::u8path(relative);
+}
+
+} // anonymous namespace
+
+CMappedFile::CMappedFile()
+{
+}
+
+CMappedFile::~CMappedFile()
+{
+    Close();
+}
+
+bool CMappedFile::Open(const std::filesystem::path& path, bool mapOnly)
+{
+    Close();
+
+    if (!PHYSFS_isInit()) return false;
+
+    std::string cleanPath = CResourceManager::CleanPath(path);
+
+    PHYSFS_File* file = PHYSFS_openRead(cleanPath.c_str());
+    if (file == nullptr) return false;
+
+    PHYSFS_sint64 length = PHYSFS_fileLength(file);
+
+    // Finding the file behind the resource system and mapping it costs more than copying small files
+    if (length >= static_cast<PHYSFS_sint64>(MIN_MAPPED_SIZE))
+    {
+        auto systemPath = GetSystemPath(cleanPath);
+        if (!systemPath.empty() && Map(systemPath))
+        {
+            PHYSFS_close(file);
+            m_open = true;
+            return true;
+        }
+    }
+
+    if (!mapOnly)
+        m_open = Read(file, length);
+
+    PHYSFS_close(file);
+    return m_open;
+}
+
+void CMappedFile::Close()
+{
+    if (m_mapping != nullptr)
+    {
+#if PLATFORM_WINDOWS
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+#else
+        munmap(m_mapping, m_size);
+#endif
+        m_mapping = nullptr;
+    }
+
+    m_buffer.reset();
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+bool CMappedFile::IsOpen() const
+{
+    return m_open;
+}
+
+bool CMappedFile::IsMapped() const
+{
+    return m_mapping != nullptr;
+}
+
+const char* CMappedFile::GetData() const
+{
+    return m_data;
+}
+
+std::size_t CMappedFile::GetSize() const
+{
+    return m_size;
+}
+
+bool CMappedFile::Map(const std::filesystem::path& systemPath)
+{
+    std::error_code error;
+    auto size = std::filesystem::file_size(systemPath, error);
+    if (error || size == 0) return false;
+
+#if PLATFORM_WINDOWS
+    HANDLE file = CreateFileW(systemPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) return false;
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    m_mapping = mapping;
+#else
+    int file = open(systemPath.c_str(), O_RDONLY);
+    if (file < 0) return false;
+
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED) return false;
+
+    m_mapping = data;
+#endif
+
+    m_data = static_cast<const char*>(data);
+    m_size = size;
+    return true;
+}
+
+bool CMappedFile::Read(PHYSFS_File* file, long long length)
+{
+    if (length < 0) return false;
+
+    m_buffer = std::make_unique<char[]>(length + 1);
+    if (PHYSFS_readBytes(file, m_buffer.get(), length) != length)
+    {
+        m_buffer.reset();
+        return false;
+    }
+
+    CProfiler::AddPerformanceStat(PSTAT_RESOURCE_BYTES_COPIED, length);
+
+    m_data = m_buffer.get();
+    m_size = length;
+    return true;
+}
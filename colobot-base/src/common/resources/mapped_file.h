@@ -0,0 +1,86 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file common/resources/mapped_file.h
+ * \brief Read-only view of the contents of a resource file - CMappedFile class
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+#include <physfs.h>
+
+/**
+ * \class CMappedFile
+ * \brief Gives the whole contents of a resource file in memory
+ *
+ * Files in plain directories, which is the common case for the data directory,
+ * are mapped into memory, so their contents are never copied. Small files and
+ * files in archives are read into a buffer at once, which counts as copied
+ * in PSTAT_RESOURCE_BYTES_COPIED.
+ */
+class CMappedFile
+{
+public:
+    //! Files smaller than this are read into a buffer, as mapping them costs more
+    static constexpr std::size_t MIN_MAPPED_SIZE = 64 * 1024;
+
+    CMappedFile();
+    ~CMappedFile();
+
+    CMappedFile(const CMappedFile&) = delete;
+    CMappedFile& operator=(const CMappedFile&) = delete;
+
+    /**
+     * \brief Opens a file of the resource system
+     * \param path path in the resource system
+     * \param mapOnly if true, files that aren't mapped are not read into a buffer but left closed
+     * \return true if the file is open
+     */
+    bool Open(const std::filesystem::path& path, bool mapOnly = false);
+    //! Releases the contents
+    void Close();
+
+    bool IsOpen() const;
+    //! Returns true if the contents are mapped rather than copied into a buffer
+    bool IsMapped() const;
+
+    //! Returns the contents, valid until the file is closed
+    const char* GetData() const;
+    //! Returns the size of the contents in bytes
+    std::size_t GetSize() const;
+
+private:
+    //! Maps the file of the operating system, returns false if not possible
+    bool Map(const std::filesystem::path& systemPath);
+    //! Reads the whole file into m_buffer
+    bool Read(PHYSFS_File* file, long long length);
+
+private:
+    bool m_open = false;
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+    //! Mapping of the file, nullptr if the contents are in m_buffer
+    void* m_mapping = nullptr;
+    std::unique_ptr<char[]> m_buffer;
+};
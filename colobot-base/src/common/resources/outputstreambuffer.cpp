@@ -97,5 +97,12 @@ std::streambuf::int_type COutputStreamBuffer::overflow(std::streambuf::int_type
 
 int COutputStreamBuffer::sync()
 {
-    return overflow(traits_type::eof());
+    // overflow() returns eof also on success when it has no final char to write
+    if (pbase() == pptr())
+        return 0;
+
+    if (!is_open() || (overflow(traits_type::eof()) == traits_type::eof() && pbase() != pptr()))
+        return -1;
+
+    return 0;
 }
@@ -33,6 +33,13 @@
 
 #include <regex>
 
+namespace
+{
+
+//! Incremented on every change of the search path or save location
+int g_locationsRevision = 0;
+
+} // anonymous namespace
 
 CResourceManager::CResourceManager(const char *argv0)
 {
@@ -60,8 +67,13 @@ CResourceManager::~CResourceManager()
 
 std::string CResourceManager::CleanPath(const std::filesystem::path& path)
 {
-    return std::regex_replace(StrUtils::Cast<std::string>(path.generic_u8string()),
-        std::regex("(.*)/\\.\\./"), "");
+    std::string result = StrUtils::Cast<std::string>(path.generic_u8string());
+
+    // Most paths have nothing to clean, don't pay for the regex then
+    if (result.find("/../") == std::string::npos)
+        return result;
+
+    return std::regex_replace(result, std::regex("(.*)/\\.\\./"), "");
 }
 
 bool CResourceManager::AddLocation(const std::string &location, bool prepend, const std::string &mountPoint)
@@ -73,6 +85,7 @@ bool CResourceManager::AddLocation(const std::string &location, bool prepend, co
         return false;
     }
 
+    g_locationsRevision++;
     return true;
 }
 
@@ -86,6 +99,7 @@ bool CResourceManager::RemoveLocation(const std::string &location)
         return false;
     }
 
+    g_locationsRevision++;
     return true;
 }
 
@@ -106,6 +120,11 @@ bool CResourceManager::LocationExists(const std::string& location)
     return it != locations.cend();
 }
 
+int CResourceManager::GetLocationsRevision()
+{
+    return g_locationsRevision;
+}
+
 bool CResourceManager::SetSaveLocation(const std::string &location)
 {
     if (!PHYSFS_setWriteDir(location.c_str()))
@@ -115,6 +134,7 @@ bool CResourceManager::SetSaveLocation(const std::string &location)
         return false;
     }
 
+    g_locationsRevision++;
     return true;
 }
 
@@ -256,7 +276,8 @@ long long CResourceManager::GetLastModificationTime(const std::string& filename)
     if (PHYSFS_isInit())
     {
         PHYSFS_Stat statbuf;
-        PHYSFS_stat(CleanPath(filename).c_str(), &statbuf);
+        if (!PHYSFS_stat(CleanPath(filename).c_str(), &statbuf))
+            return -1;
         return statbuf.modtime;
     }
     return -1;
@@ -270,3 +291,22 @@ bool CResourceManager::Remove(const std::string& filename)
     }
     return false;
 }
+
+bool CResourceManager::Move(const std::string& from, const std::string& to)
+{
+    if (PHYSFS_isInit() && PHYSFS_getWriteDir() != nullptr)
+    {
+        // PhysFS can't rename, but the write directory is always a real directory
+        std::filesystem::path writeDir = std::filesystem::u8path(PHYSFS_getWriteDir());
+        std::error_code error;
+        std::filesystem::rename(writeDir / std::filesystem::u8path(CleanPath(from)),
+                                writeDir / std::filesystem::u8path(CleanPath(to)), error);
+        if (error)
+        {
+            GetLogger()->Error("Error while renaming \"%%\" to \"%%\": %%", from, to, error.message());
+            return false;
+        }
+        return true;
+    }
+    return false;
+}
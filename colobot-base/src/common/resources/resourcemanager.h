@@ -44,6 +44,8 @@ public:
     static std::vector<std::string> GetLocations();
     //! Check if given location is in the search path
     static bool LocationExists(const std::string &location);
+    //! Returns a number that changes every time the search path or the save location changes
+    static int GetLocationsRevision();
 
     static bool SetSaveLocation(const std::string &location);
     static std::string GetSaveLocation();
@@ -70,9 +72,11 @@ public:
 
     //! Returns file size in bytes
     static long long GetFileSize(const std::string &filename);
-    //! Returns last modification date as timestamp
+    //! Returns last modification date as timestamp, -1 if unknown or if the file doesn't exist
     static long long GetLastModificationTime(const std::string &filename);
 
     //! Remove file
     static bool Remove(const std::string& filename);
+    //! Rename file in write directory, replacing \a to if it exists
+    static bool Move(const std::string& from, const std::string& to);
 };
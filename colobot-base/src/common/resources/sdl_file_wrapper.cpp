@@ -21,6 +21,7 @@
 #include "common/resources/sdl_file_wrapper.h"
 
 #include "common/logger.h"
+#include "common/profiler.h"
 
 #include <physfs.h>
 
@@ -34,6 +35,20 @@ CSDLFileWrapper::CSDLFileWrapper(const std::string& filename)
         return;
     }
 
+    if (m_mappedFile.Open(filename, true))
+    {
+        m_rwops = SDL_RWFromConstMem(m_mappedFile.GetData(), m_mappedFile.GetSize());
+        if (m_rwops == nullptr)
+        {
+            GetLogger()->Error("Unable to allocate SDL_RWops for \"%%\"\n", filename);
+            return;
+        }
+
+        // This is safe because SDL_FreeRW will be called in destructor
+        m_rwops->close = SDLCloseMappedFile;
+        return;
+    }
+
     PHYSFS_File *file = PHYSFS_openRead(filename.c_str());
     if (file == nullptr)
     {
@@ -60,7 +75,10 @@ CSDLFileWrapper::CSDLFileWrapper(const std::string& filename)
 
 CSDLFileWrapper::~CSDLFileWrapper()
 {
-    SDLCloseWithFreeRW(m_rwops);
+    if (m_mappedFile.IsOpen())
+        SDL_FreeRW(m_rwops);
+    else
+        SDLCloseWithFreeRW(m_rwops);
 }
 
 SDL_RWops* CSDLFileWrapper::GetHandler()
@@ -103,6 +121,12 @@ int CSDLFileWrapper::SDLCloseWithFreeRW(SDL_RWops *context)
     return SDLClose(context, true);
 }
 
+int CSDLFileWrapper::SDLCloseMappedFile(SDL_RWops *context)
+{
+    // The mapping is released with the wrapper
+    return 0;
+}
+
 bool CSDLFileWrapper::CheckSDLContext(SDL_RWops *context)
 {
     if (context->type != SDL_RWOPS_UNKNOWN)
@@ -161,6 +185,8 @@ size_t CSDLFileWrapper::SDLRead(SDL_RWops *context, void *ptr, size_t size, size
         SDL_memset(ptr, 0, size * maxnum);
 
         auto result = PHYSFS_readBytes(file, ptr, size * maxnum);
+        if (result > 0)
+            CProfiler::AddPerformanceStat(PSTAT_RESOURCE_BYTES_COPIED, result);
         return (result >= 0) ? result : 0;
     }
 
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include "common/resources/mapped_file.h"
+
 #include <string>
 
 #include <SDL.h>
@@ -44,8 +46,11 @@ private:
     static int SDLClose(SDL_RWops *context, bool freeRW);
     static int SDLCloseWithoutFreeRW(SDL_RWops *context);
     static int SDLCloseWithFreeRW(SDL_RWops *context);
+    static int SDLCloseMappedFile(SDL_RWops *context);
     static bool CheckSDLContext(SDL_RWops *context);
 
 private:
     SDL_RWops* m_rwops;
+    //! Contents of files in plain directories, read by SDL directly from memory
+    CMappedFile m_mappedFile;
 };
@@ -36,23 +36,13 @@ CSDLMemoryWrapper::CSDLMemoryWrapper(const std::string& filename)
         return;
     }
 
-    PHYSFS_File *file = PHYSFS_openRead(filename.c_str());
-    if (file == nullptr)
+    if (!m_file.Open(filename))
     {
         GetLogger()->Error("Error opening file with PHYSFS: \"%%\"", filename);
         return;
     }
 
-    PHYSFS_sint64 length = PHYSFS_fileLength(file);
-    m_buffer = std::make_unique<char[]>(length);
-    if (PHYSFS_readBytes(file, m_buffer.get(), length) != length)
-    {
-        GetLogger()->Error("Unable to read data for \"%%\"", filename);
-        PHYSFS_close(file);
-        return;
-    }
-    PHYSFS_close(file);
-    m_rwops = SDL_RWFromMem(m_buffer.get(), length);
+    m_rwops = SDL_RWFromConstMem(m_file.GetData(), m_file.GetSize());
 
     if (m_rwops == nullptr)
     {
@@ -64,7 +54,6 @@ CSDLMemoryWrapper::CSDLMemoryWrapper(const std::string& filename)
 CSDLMemoryWrapper::~CSDLMemoryWrapper()
 {
     SDL_FreeRW(m_rwops);
-    m_buffer.reset();
 }
 
 SDL_RWops* CSDLMemoryWrapper::GetHandler()
@@ -20,8 +20,9 @@
 
 #pragma once
 
+#include "common/resources/mapped_file.h"
+
 #include <string>
-#include <memory>
 
 #include <SDL.h>
 
@@ -39,5 +40,5 @@ public:
 
 private:
     SDL_RWops* m_rwops;
-    std::unique_ptr<char[]> m_buffer;
+    CMappedFile m_file;
 };
@@ -90,6 +90,12 @@ sf_count_t CSNDFileWrapper::Read(short int *ptr, sf_count_t items)
 }
 
 
+sf_count_t CSNDFileWrapper::Seek(sf_count_t frame)
+{
+    return sf_seek(m_snd_file, frame, SEEK_SET);
+}
+
+
 sf_count_t CSNDFileWrapper::SNDLength(void *data)
 {
     return PHYSFS_fileLength(static_cast<PHYSFS_File *>(data));
@@ -38,6 +38,8 @@ public:
     bool IsOpen();
     std::string &GetLastError();
     sf_count_t Read(short int *ptr, sf_count_t items);
+    //! Moves the read position to the given frame, returns the new position or -1 on error
+    sf_count_t Seek(sf_count_t frame);
 
 private:
     static sf_count_t SNDLength(void *data);
@@ -31,6 +31,8 @@
 
 #include "level/robotmain.h"
 
+#include "script/script_scheduler.h"
+
 #include "sound/sound.h"
 
 CSettings::CSettings()
@@ -85,6 +87,8 @@ void CSettings::SaveSettings()
     GetConfigFile().SetBoolProperty("Setup", "Autosave", main->GetAutosave());
     GetConfigFile().SetIntProperty("Setup", "AutosaveInterval", main->GetAutosaveInterval());
     GetConfigFile().SetIntProperty("Setup", "AutosaveSlots", main->GetAutosaveSlots());
+    GetConfigFile().SetBoolProperty("Setup", "TextSaves", main->GetTextSaves());
+    GetConfigFile().SetFloatProperty("Setup", "ScriptFrameTime", main->GetScriptScheduler()->GetFrameBudget() * 1000.0f);
     GetConfigFile().SetBoolProperty("Setup", "ObjectDirty", engine->GetDirty());
     GetConfigFile().SetBoolProperty("Setup", "FogMode", engine->GetFog());
     GetConfigFile().SetBoolProperty("Setup", "LightMode", engine->GetLightMode());
@@ -192,6 +196,13 @@ void CSettings::LoadSettings()
     if (GetConfigFile().GetIntProperty("Setup", "AutosaveSlots", iValue))
         main->SetAutosaveSlots(iValue);
 
+    if (GetConfigFile().GetBoolProperty("Setup", "TextSaves", bValue))
+        main->SetTextSaves(bValue);
+
+    // Time for all CBot programs in one frame, in milliseconds, 0 for no limit
+    if (GetConfigFile().GetFloatProperty("Setup", "ScriptFrameTime", fValue))
+        main->GetScriptScheduler()->SetFrameBudget(fValue / 1000.0f);
+
     if (GetConfigFile().GetBoolProperty("Setup", "ObjectDirty", bValue))
         engine->SetDirty(bValue);
 
@@ -0,0 +1,272 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "common/thread/job_system.h"
+
+#include "common/logger.h"
+
+#include <algorithm>
+#include <exception>
+
+struct Job
+{
+    CJobSystem::JobFunction work;
+    CJobSystem::JobFunction completion;
+    //! Dependencies not finished yet
+    int pendingDependencies = 0;
+    //! Jobs waiting for this one
+    std::vector<JobHandle> dependents;
+    //! Jobs this one waits for, cleared once they all finished
+    std::vector<std::weak_ptr<Job>> dependencies;
+    //! The job is in the queue, its work was not started yet
+    bool queued = false;
+    bool finished = false;
+};
+
+
+CJobSystem::CJobSystem(int threadCount)
+{
+    if (threadCount <= 0)
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+
+    m_threads.reserve(threadCount);
+    for (int i = 0; i < threadCount; ++i)
+        m_threads.emplace_back(&CJobSystem::Run, this);
+}
+
+CJobSystem::~CJobSystem()
+{
+    // completions may submit more jobs
+    do
+    {
+        WaitAll();
+    }
+    while (ProcessCompletions() > 0);
+
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_running = false;
+    }
+    m_queueCond.notify_all();
+
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+JobHandle CJobSystem::Submit(JobFunction work, JobFunction completion, const std::vector<JobHandle>& dependencies)
+{
+    auto job = std::make_shared<Job>();
+    job->work = std::move(work);
+    job->completion = std::move(completion);
+
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        for (const auto& dependency : dependencies)
+        {
+            if (dependency == nullptr || dependency->finished)
+                continue;
+
+            dependency->dependents.push_back(job);
+            job->dependencies.push_back(dependency);
+            ++job->pendingDependencies;
+        }
+
+        ++m_unfinished;
+
+        if (job->pendingDependencies == 0)
+        {
+            job->queued = true;
+            m_queue.push_back(job);
+        }
+    }
+
+    if (job->pendingDependencies == 0)
+        m_queueCond.notify_one();
+
+    return job;
+}
+
+void CJobSystem::ParallelFor(int count, int batchSize, const std::function<void(int)>& function)
+{
+    batchSize = std::max(1, batchSize);
+
+    std::vector<JobHandle> jobs;
+    jobs.reserve((count + batchSize - 1) / batchSize);
+
+    for (int begin = 0; begin < count; begin += batchSize)
+    {
+        int end = std::min(count, begin + batchSize);
+        jobs.push_back(Submit([&function, begin, end]()
+        {
+            for (int i = begin; i < end; ++i)
+                function(i);
+        }));
+    }
+
+    for (const auto& job : jobs)
+        Wait(job);
+}
+
+bool CJobSystem::IsFinished(const JobHandle& job)
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return job == nullptr || job->finished;
+}
+
+void CJobSystem::Wait(const JobHandle& job)
+{
+    if (job == nullptr)
+        return;
+
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (!job->finished)
+    {
+        JobHandle queued = TakeQueued(job);
+        if (queued != nullptr)
+            RunJob(lock, std::move(queued));
+        else
+            m_finishCond.wait(lock);
+    }
+}
+
+void CJobSystem::WaitAll()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (m_unfinished > 0)
+    {
+        if (!m_queue.empty())
+            RunJob(lock);
+        else
+            m_finishCond.wait(lock);
+    }
+}
+
+int CJobSystem::ProcessCompletions()
+{
+    std::vector<JobFunction> completions;
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        completions.swap(m_completions);
+    }
+
+    for (auto& completion : completions)
+        completion();
+
+    return static_cast<int>(completions.size());
+}
+
+int CJobSystem::GetThreadCount() const
+{
+    return static_cast<int>(m_threads.size());
+}
+
+void CJobSystem::Run()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (true)
+    {
+        m_queueCond.wait(lock, [&]() { return !m_running || !m_queue.empty(); });
+        if (!m_running) break;
+
+        RunJob(lock);
+    }
+}
+
+void CJobSystem::RunJob(std::unique_lock<std::mutex>& lock)
+{
+    JobHandle job = std::move(m_queue.front());
+    m_queue.pop_front();
+
+    RunJob(lock, std::move(job));
+}
+
+void CJobSystem::RunJob(std::unique_lock<std::mutex>& lock, JobHandle job)
+{
+    job->queued = false;
+
+    lock.unlock();
+
+    try
+    {
+        job->work();
+    }
+    catch (const std::exception& e)
+    {
+        GetLogger()->Error("Unhandled exception in job: %%", e.what());
+    }
+    catch (...)
+    {
+        GetLogger()->Error("Unhandled exception in job");
+    }
+
+    lock.lock();
+
+    Finish(job);
+}
+
+JobHandle CJobSystem::TakeQueued(const JobHandle& job)
+{
+    if (job->queued)
+    {
+        m_queue.erase(std::find(m_queue.begin(), m_queue.end(), job));
+        return job;
+    }
+
+    for (const auto& weakDependency : job->dependencies)
+    {
+        JobHandle dependency = weakDependency.lock();
+        if (dependency == nullptr || dependency->finished)
+            continue;
+
+        JobHandle queued = TakeQueued(dependency);
+        if (queued != nullptr)
+            return queued;
+    }
+
+    return nullptr;
+}
+
+void CJobSystem::Finish(const JobHandle& job)
+{
+    job->finished = true;
+    job->work = nullptr;
+
+    int queued = 0;
+    for (const auto& dependent : job->dependents)
+    {
+        if (--dependent->pendingDependencies == 0)
+        {
+            dependent->dependencies.clear();
+            dependent->queued = true;
+            m_queue.push_back(dependent);
+            ++queued;
+        }
+    }
+    job->dependents.clear();
+
+    if (job->completion)
+        m_completions.push_back(std::move(job->completion));
+
+    --m_unfinished;
+
+    for (int i = 0; i < queued; ++i)
+        m_queueCond.notify_one();
+    m_finishCond.notify_all();
+}
@@ -0,0 +1,126 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file common/thread/job_system.h
+ * \brief Pool of threads running dependent jobs - CJobSystem class
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct Job;
+
+//! Handle to a submitted job, used for dependencies and waiting
+using JobHandle = std::shared_ptr<Job>;
+
+/**
+ * \class CJobSystem
+ * \brief Thread pool that runs jobs on all cores
+ *
+ * A job is a function run on one of the worker threads. It can depend on
+ * other jobs, it is then started only after all of them finished.
+ * A job can also have a completion function, which is run on the thread
+ * calling ProcessCompletions(), normally the main thread once per frame.
+ * This is the way to hand results back to code that is not thread-safe.
+ *
+ * Threads waiting for a job in Wait() run the job and its dependencies
+ * themselves if no worker thread started them yet, so jobs may also wait
+ * for other jobs. Unrelated jobs are left to the worker threads, so that
+ * waiting for a short job never takes as long as a long one.
+ */
+class CJobSystem
+{
+public:
+    using JobFunction = std::function<void()>;
+
+    /**
+     * \brief Starts worker threads
+     * \param threadCount number of threads, 0 means one less than number of cores (at least one)
+     */
+    explicit CJobSystem(int threadCount = 0);
+    //! Finishes all submitted jobs, runs their pending completions on the calling thread and stops worker threads
+    ~CJobSystem();
+
+    CJobSystem(const CJobSystem&) = delete;
+    CJobSystem& operator=(const CJobSystem&) = delete;
+
+    /**
+     * \brief Adds job to be run
+     * \param work function run on a worker thread
+     * \param completion function run by ProcessCompletions() after \a work finished, may be empty
+     * \param dependencies jobs which must finish before \a work starts, empty handles are ignored
+     * \return handle to the new job
+     */
+    JobHandle Submit(JobFunction work, JobFunction completion = nullptr,
+                     const std::vector<JobHandle>& dependencies = {});
+
+    /**
+     * \brief Runs \a function for all indexes in [0, \a count), split into jobs of \a batchSize indexes
+     *
+     * Returns after all calls finished. The calling thread takes part in the work.
+     */
+    void ParallelFor(int count, int batchSize, const std::function<void(int)>& function);
+
+    //! Returns true if work of the job has finished
+    bool IsFinished(const JobHandle& job);
+    //! Waits until work of the job has finished, running it or its dependencies if they are still queued
+    void Wait(const JobHandle& job);
+    //! Waits until work of all submitted jobs has finished, running queued ones in the meantime
+    void WaitAll();
+
+    /**
+     * \brief Runs completion functions of finished jobs on the calling thread
+     * \return number of completion functions run
+     */
+    int ProcessCompletions();
+
+    //! Returns number of worker threads
+    int GetThreadCount() const;
+
+private:
+    void Run();
+    //! Runs first queued job, expects locked \a lock and returns with it locked
+    void RunJob(std::unique_lock<std::mutex>& lock);
+    //! Runs \a job taken from the queue, expects locked \a lock and returns with it locked
+    void RunJob(std::unique_lock<std::mutex>& lock, JobHandle job);
+    //! Removes \a job or one of its dependencies from the queue and returns it, nullptr if none is queued
+    JobHandle TakeQueued(const JobHandle& job);
+    //! Marks job finished and queues jobs depending on it, expects locked mutex
+    void Finish(const JobHandle& job);
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    //! Signalled when a job is queued
+    std::condition_variable m_queueCond;
+    //! Signalled when a job finishes
+    std::condition_variable m_finishCond;
+    std::deque<JobHandle> m_queue;
+    std::vector<JobFunction> m_completions;
+    //! Jobs submitted and not finished
+    int m_unfinished = 0;
+    bool m_running = true;
+};
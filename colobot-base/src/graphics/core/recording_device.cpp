@@ -0,0 +1,599 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/core/recording_device.h"
+
+#include "common/image.h"
+#include "common/profiler.h"
+
+#include "graphics/core/framebuffer.h"
+#include "graphics/core/renderers.h"
+#include "graphics/core/transparency.h"
+#include "graphics/core/vertex.h"
+
+#include <vector>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+namespace
+{
+
+//! Counts one buffer upload of the given size, like the OpenGL renderers
+void RecordUpload(long long bytes)
+{
+    CProfiler::AddPerformanceStat(PSTAT_BUFFER_UPLOADS);
+    CProfiler::AddPerformanceStat(PSTAT_BUFFER_UPLOAD_BYTES, bytes);
+}
+
+//! Counts one draw call of the given number of triangles, like the OpenGL renderers
+void RecordDraw(long long triangles)
+{
+    CProfiler::AddPerformanceStat(PSTAT_DRAW_CALLS);
+    CProfiler::AddPerformanceStat(PSTAT_TRIANGLES, triangles);
+}
+
+//! Counts one draw call of a whole vertex buffer
+void RecordDraw(const CVertexBuffer* buffer)
+{
+    RecordDraw(buffer != nullptr ? GetTriangleCount(buffer->GetType(), static_cast<int>(buffer->Size())) : 0);
+}
+
+/**
+ * \struct RecordedTextureSlot
+ * \brief Texture unit binding, counts a bind only when the bound texture changes
+ */
+struct RecordedTextureSlot
+{
+    unsigned int id = 0;
+
+    void Set(const Texture& texture)
+    {
+        if (id == texture.id) return;
+
+        id = texture.id;
+        CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+    }
+
+    void Reset()
+    {
+        id = 0;
+    }
+};
+
+class CRecordingVertexBuffer : public CVertexBuffer
+{
+public:
+    CRecordingVertexBuffer(PrimitiveType type, size_t size)
+        : CVertexBuffer(type, size)
+    {
+    }
+
+    void Update() override
+    {
+        RecordUpload(m_data.size() * sizeof(Vertex3D));
+    }
+};
+
+} // anonymous namespace
+
+class CRecordingUIRenderer : public CUIRenderer
+{
+public:
+    void SetProjection(float left, float right, float bottom, float top) override
+    {
+        glm::vec4 projection(left, right, bottom, top);
+        if (m_projection == projection) return;
+        m_projection = projection;
+        m_uniformsDirty = true;
+    }
+
+    void SetTexture(const Texture& texture) override { m_texture.Set(texture); }
+
+    void SetColor(const glm::vec4& color) override
+    {
+        if (m_color == color) return;
+        m_color = color;
+        m_uniformsDirty = true;
+    }
+
+    void SetTransparency(TransparencyMode mode) override {}
+
+    Vertex2D* BeginPrimitive(PrimitiveType type, int count) override
+    {
+        m_buffer.resize(count);
+        m_triangles = GetTriangleCount(type, count);
+        return m_buffer.data();
+    }
+
+    Vertex2D* BeginPrimitives(PrimitiveType type, int drawCount, const int* counts) override
+    {
+        int total = 0;
+        m_triangles = 0;
+        for (int i = 0; i < drawCount; i++)
+        {
+            total += counts[i];
+            m_triangles += GetTriangleCount(type, counts[i]);
+        }
+
+        m_buffer.resize(total);
+        return m_buffer.data();
+    }
+
+    // Like the OpenGL renderer, vertices are sent with every draw and uniforms only after a change
+    bool EndPrimitive() override
+    {
+        RecordUpload(m_buffer.size() * sizeof(Vertex2D));
+        if (m_uniformsDirty)
+        {
+            RecordUpload(sizeof(glm::mat4) + sizeof(glm::vec4));
+            m_uniformsDirty = false;
+        }
+
+        RecordDraw(m_triangles);
+        return true;
+    }
+
+private:
+    RecordedTextureSlot m_texture;
+    std::vector<Vertex2D> m_buffer;
+    long long m_triangles = 0;
+    glm::vec4 m_projection = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f);
+    glm::vec4 m_color = glm::vec4(1.0f);
+    // The OpenGL renderer sends the initial uniforms when it is created
+    bool m_uniformsDirty = false;
+};
+
+class CRecordingTerrainRenderer : public CTerrainRenderer
+{
+public:
+    void Begin() override
+    {
+        m_albedoTexture.Reset();
+        m_detailTexture.Reset();
+        m_emissiveTexture.Reset();
+        m_materialTexture.Reset();
+        m_shadowMap.Reset();
+    }
+
+    void End() override {}
+
+    void SetProjectionMatrix(const glm::mat4& matrix) override {}
+    void SetViewMatrix(const glm::mat4& matrix) override {}
+    void SetModelMatrix(const glm::mat4& matrix) override {}
+
+    void SetAlbedoColor(const Color& color) override {}
+    void SetAlbedoTexture(const Texture& texture) override { m_albedoTexture.Set(texture); }
+    void SetEmissiveColor(const Color& color) override {}
+    void SetEmissiveTexture(const Texture& texture) override { m_emissiveTexture.Set(texture); }
+    void SetMaterialParams(float roughness, float metalness, float aoStrength) override {}
+    void SetMaterialTexture(const Texture& texture) override { m_materialTexture.Set(texture); }
+
+    void SetDetailTexture(const Texture& texture) override { m_detailTexture.Set(texture); }
+    void SetShadowMap(const Texture& texture) override { m_shadowMap.Set(texture); }
+
+    void SetLight(const glm::vec4& position, const float& intensity, const glm::vec3& color) override {}
+    void SetSky(const Color& color, float intensity) override {}
+    void SetShadowParams(int count, const ShadowParam* params) override {}
+
+    void SetFog(float min, float max, const glm::vec3& color) override {}
+
+    void DrawObject(const glm::mat4& matrix, const CVertexBuffer* buffer) override
+    {
+        RecordDraw(buffer);
+    }
+
+private:
+    RecordedTextureSlot m_albedoTexture;
+    RecordedTextureSlot m_detailTexture;
+    RecordedTextureSlot m_emissiveTexture;
+    RecordedTextureSlot m_materialTexture;
+    RecordedTextureSlot m_shadowMap;
+};
+
+class CRecordingObjectRenderer : public CObjectRenderer
+{
+public:
+    void Begin() override
+    {
+        m_albedoTexture.Reset();
+        m_detailTexture.Reset();
+        m_emissiveTexture.Reset();
+        m_materialTexture.Reset();
+        m_shadowMap.Reset();
+    }
+
+    void End() override {}
+
+    void SetProjectionMatrix(const glm::mat4& matrix) override {}
+    void SetViewMatrix(const glm::mat4& matrix) override {}
+    void SetModelMatrix(const glm::mat4& matrix) override {}
+
+    void SetAlbedoColor(const Color& color) override {}
+    void SetAlbedoTexture(const Texture& texture) override { m_albedoTexture.Set(texture); }
+    void SetEmissiveColor(const Color& color) override {}
+    void SetEmissiveTexture(const Texture& texture) override { m_emissiveTexture.Set(texture); }
+    void SetMaterialParams(float roughness, float metalness, float aoStrength) override {}
+    void SetMaterialTexture(const Texture& texture) override { m_materialTexture.Set(texture); }
+
+    void SetDetailTexture(const Texture& texture) override { m_detailTexture.Set(texture); }
+    void SetShadowMap(const Texture& texture) override { m_shadowMap.Set(texture); }
+
+    void SetLighting(bool enabled) override {}
+    void SetLight(const glm::vec4& position, const float& intensity, const glm::vec3& color) override {}
+    void SetSky(const Color& color, float intensity) override {}
+    void SetShadowParams(int count, const ShadowParam* params) override {}
+
+    void SetFog(float min, float max, const glm::vec3& color) override {}
+    void SetAlphaScissor(float alpha) override {}
+
+    void SetRecolor(bool enabled, const glm::vec3& from, const glm::vec3& to, float threshold) override {}
+
+    void SetDepthTest(bool enabled) override {}
+    void SetDepthMask(bool enabled) override {}
+    void SetCullFace(CullFace mode) override {}
+    void SetTransparency(TransparencyMode mode) override {}
+
+    void SetUVTransform(const glm::vec2& offset, const glm::vec2& scale) override {}
+
+    void SetTriplanarMode(bool enabled) override {}
+    void SetTriplanarScale(float scale) override {}
+
+    void DrawObject(const CVertexBuffer* buffer) override
+    {
+        RecordDraw(buffer);
+    }
+
+    void DrawPrimitive(PrimitiveType type, int count, const Vertex3D* vertices) override
+    {
+        DrawPrimitives(type, 1, &count, vertices);
+    }
+
+    void DrawPrimitives(PrimitiveType type, int drawCount, int count[], const Vertex3D* vertices) override
+    {
+        long long total = 0;
+        long long triangles = 0;
+        for (int i = 0; i < drawCount; i++)
+        {
+            total += count[i];
+            triangles += GetTriangleCount(type, count[i]);
+        }
+
+        RecordUpload(total * sizeof(Vertex3D));
+        RecordDraw(triangles);
+    }
+
+private:
+    RecordedTextureSlot m_albedoTexture;
+    RecordedTextureSlot m_detailTexture;
+    RecordedTextureSlot m_emissiveTexture;
+    RecordedTextureSlot m_materialTexture;
+    RecordedTextureSlot m_shadowMap;
+};
+
+class CRecordingParticleRenderer : public CParticleRenderer
+{
+public:
+    void Begin() override
+    {
+        m_texture.Reset();
+        m_color = glm::vec4(1.0f);
+    }
+
+    void End() override {}
+
+    void SetProjectionMatrix(const glm::mat4& matrix) override {}
+    void SetViewMatrix(const glm::mat4& matrix) override {}
+    void SetModelMatrix(const glm::mat4& matrix) override
+    {
+        CProfiler::AddPerformanceStat(PSTAT_STATE_CHANGES);
+    }
+
+    void SetColor(const glm::vec4& color) override
+    {
+        if (m_color == color) return;
+        m_color = color;
+        CProfiler::AddPerformanceStat(PSTAT_STATE_CHANGES);
+    }
+
+    void SetTexture(const Texture& texture) override { m_texture.Set(texture); }
+
+    // Like the OpenGL device, only changes of the mode reach the GPU
+    void SetTransparency(TransparencyMode mode) override
+    {
+        if (m_transparency == mode) return;
+        m_transparency = mode;
+        CProfiler::AddPerformanceStat(PSTAT_STATE_CHANGES);
+    }
+
+    void DrawParticle(PrimitiveType type, int count, const VertexParticle* vertices) override
+    {
+        RecordUpload(count * sizeof(VertexParticle));
+        RecordDraw(GetTriangleCount(type, count));
+    }
+
+private:
+    RecordedTextureSlot m_texture;
+    glm::vec4 m_color = glm::vec4(1.0f);
+    TransparencyMode m_transparency = TransparencyMode::NONE;
+};
+
+class CRecordingShadowRenderer : public CShadowRenderer
+{
+public:
+    void Begin() override {}
+
+    void End() override {}
+
+    void SetProjectionMatrix(const glm::mat4& matrix) override {}
+    void SetViewMatrix(const glm::mat4& matrix) override {}
+    void SetModelMatrix(const glm::mat4& matrix) override {}
+
+    // Like the OpenGL shadow renderer, every call binds the texture
+    void SetTexture(const Texture& texture) override { CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS); }
+
+    void SetShadowMap(const Texture& texture) override {}
+    void SetShadowRegion(const glm::vec2& offset, const glm::vec2& scale) override {}
+
+    // Clears and copies stay on the GPU, they are neither draw calls nor uploads
+    void ClearShadowRegion() override {}
+    void CopyShadowRegion(const Texture& source) override {}
+
+    void DrawObject(const CVertexBuffer* buffer, bool transparent) override
+    {
+        RecordDraw(buffer);
+    }
+};
+
+CRecordingDevice::CRecordingDevice(const DeviceConfig &config)
+    : m_config(config)
+{
+    m_capabilities.multitexturingSupported = true;
+    m_capabilities.maxTextures = 16;
+    m_capabilities.maxTextureSize = 16384;
+    m_capabilities.shadowMappingSupported = true;
+    m_capabilities.framebufferSupported = true;
+    m_capabilities.maxRenderbufferSize = 16384;
+}
+
+CRecordingDevice::~CRecordingDevice()
+{
+}
+
+std::string CRecordingDevice::GetName()
+{
+    return std::string("Recording");
+}
+
+bool CRecordingDevice::Create()
+{
+    m_uiRenderer = std::make_unique<CRecordingUIRenderer>();
+    m_terrainRenderer = std::make_unique<CRecordingTerrainRenderer>();
+    m_objectRenderer = std::make_unique<CRecordingObjectRenderer>();
+    m_particleRenderer = std::make_unique<CRecordingParticleRenderer>();
+    m_shadowRenderer = std::make_unique<CRecordingShadowRenderer>();
+
+    FramebufferParams params;
+    params.width = m_config.size.x;
+    params.height = m_config.size.y;
+    params.depth = m_config.depthSize;
+
+    m_framebuffers["default"] = std::make_unique<CDefaultFramebuffer>(params);
+
+    return true;
+}
+
+void CRecordingDevice::Destroy()
+{
+    m_framebuffers.clear();
+
+    m_uiRenderer.reset();
+    m_terrainRenderer.reset();
+    m_objectRenderer.reset();
+    m_particleRenderer.reset();
+    m_shadowRenderer.reset();
+}
+
+void CRecordingDevice::ConfigChanged(const DeviceConfig &newConfig)
+{
+    m_config = newConfig;
+}
+
+void CRecordingDevice::BeginScene()
+{
+}
+
+void CRecordingDevice::EndScene()
+{
+}
+
+void CRecordingDevice::Clear()
+{
+}
+
+CUIRenderer* CRecordingDevice::GetUIRenderer()
+{
+    return m_uiRenderer.get();
+}
+
+CTerrainRenderer* CRecordingDevice::GetTerrainRenderer()
+{
+    return m_terrainRenderer.get();
+}
+
+CObjectRenderer* CRecordingDevice::GetObjectRenderer()
+{
+    return m_objectRenderer.get();
+}
+
+CParticleRenderer* CRecordingDevice::GetParticleRenderer()
+{
+    return m_particleRenderer.get();
+}
+
+CShadowRenderer* CRecordingDevice::GetShadowRenderer()
+{
+    return m_shadowRenderer.get();
+}
+
+Texture CRecordingDevice::CreateTexture(CImage *image, const TextureCreateParams &params)
+{
+    Texture result;
+    result.id = ++m_lastTextureId;
+    result.size = image->GetSize();
+    result.originalSize = result.size;
+    return result;
+}
+
+Texture CRecordingDevice::CreateTexture(ImageData *data, const TextureCreateParams &params)
+{
+    Texture result;
+    result.id = ++m_lastTextureId;
+    return result;
+}
+
+Texture CRecordingDevice::CreateDepthTexture(int width, int height, int depth)
+{
+    Texture result;
+    result.id = ++m_lastTextureId;
+    result.size = { width, height };
+    result.originalSize = result.size;
+    return result;
+}
+
+void CRecordingDevice::UpdateTexture(const Texture& texture, const glm::ivec2& offset, ImageData* data, TextureFormat format)
+{
+}
+
+void CRecordingDevice::DestroyTexture(const Texture &texture)
+{
+}
+
+void CRecordingDevice::DestroyAllTextures()
+{
+}
+
+CVertexBuffer* CRecordingDevice::CreateVertexBuffer(PrimitiveType primitiveType, const Vertex3D* vertices, int vertexCount)
+{
+    auto buffer = new CRecordingVertexBuffer(primitiveType, vertexCount);
+    buffer->SetData(vertices, 0, vertexCount);
+    return buffer;
+}
+
+void CRecordingDevice::DestroyVertexBuffer(CVertexBuffer* buffer)
+{
+    delete buffer;
+}
+
+void CRecordingDevice::SetViewport(int x, int y, int width, int height)
+{
+}
+
+void CRecordingDevice::SetDepthTest(bool enabled)
+{
+}
+
+void CRecordingDevice::SetDepthMask(bool enabled)
+{
+}
+
+void CRecordingDevice::SetCullFace(CullFace mode)
+{
+}
+
+void CRecordingDevice::SetTransparency(TransparencyMode mode)
+{
+}
+
+void CRecordingDevice::SetColorMask(bool red, bool green, bool blue, bool alpha)
+{
+}
+
+void CRecordingDevice::SetClearColor(const Color &color)
+{
+}
+
+void CRecordingDevice::CopyFramebufferToTexture(Texture& texture, int xOffset, int yOffset, int x, int y, int width, int height)
+{
+}
+
+std::unique_ptr<CFrameBufferPixels> CRecordingDevice::GetFrameBufferPixels() const
+{
+    return nullptr;
+}
+
+CFramebuffer* CRecordingDevice::GetFramebuffer(std::string name)
+{
+    auto it = m_framebuffers.find(name);
+    if (it == m_framebuffers.end())
+        return nullptr;
+
+    return it->second.get();
+}
+
+CFramebuffer* CRecordingDevice::CreateFramebuffer(std::string name, const FramebufferParams& params)
+{
+    if (name == "default") return nullptr;
+
+    auto framebuffer = std::make_unique<CDefaultFramebuffer>(params);
+    auto framebufferPtr = framebuffer.get();
+    m_framebuffers[name] = std::move(framebuffer);
+    return framebufferPtr;
+}
+
+void CRecordingDevice::DeleteFramebuffer(std::string name)
+{
+    if (name == "default") return;
+
+    m_framebuffers.erase(name);
+}
+
+bool CRecordingDevice::IsAnisotropySupported()
+{
+    return false;
+}
+
+int CRecordingDevice::GetMaxAnisotropyLevel()
+{
+    return 1;
+}
+
+int CRecordingDevice::GetMaxSamples()
+{
+    return 1;
+}
+
+bool CRecordingDevice::IsShadowMappingSupported()
+{
+    return true;
+}
+
+int CRecordingDevice::GetMaxTextureSize()
+{
+    return m_capabilities.maxTextureSize;
+}
+
+bool CRecordingDevice::IsFramebufferSupported()
+{
+    return true;
+}
+
+} // namespace Gfx
@@ -0,0 +1,133 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file graphics/core/recording_device.h
+ * \brief Headless device - CRecordingDevice class
+ */
+
+#pragma once
+
+#include "graphics/core/device.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+class CRecordingUIRenderer;
+class CRecordingTerrainRenderer;
+class CRecordingObjectRenderer;
+class CRecordingParticleRenderer;
+class CRecordingShadowRenderer;
+
+/**
+ * \class CRecordingDevice
+ * \brief Implementation of CDevice that draws nothing
+ *
+ * Every renderer of this device filters redundant state changes the same way
+ * the OpenGL renderers do and reports what would reach the GPU
+ * (texture binds, draw calls, triangles) as CProfiler statistics.
+ * This allows measuring rendering changes in tests and benchmarks
+ * without a GPU or a window.
+ */
+class CRecordingDevice : public CDevice
+{
+public:
+    explicit CRecordingDevice(const DeviceConfig &config = {});
+    virtual ~CRecordingDevice();
+
+    std::string GetName() override;
+
+    bool Create() override;
+    void Destroy() override;
+
+    void ConfigChanged(const DeviceConfig &newConfig) override;
+
+    void BeginScene() override;
+    void EndScene() override;
+
+    void Clear() override;
+
+    CUIRenderer* GetUIRenderer() override;
+    CTerrainRenderer* GetTerrainRenderer() override;
+    CObjectRenderer* GetObjectRenderer() override;
+    CParticleRenderer* GetParticleRenderer() override;
+    CShadowRenderer* GetShadowRenderer() override;
+
+    Texture CreateTexture(CImage *image, const TextureCreateParams &params) override;
+    Texture CreateTexture(ImageData *data, const TextureCreateParams &params) override;
+    Texture CreateDepthTexture(int width, int height, int depth) override;
+    void UpdateTexture(const Texture& texture, const glm::ivec2& offset, ImageData* data, TextureFormat format) override;
+    void DestroyTexture(const Texture &texture) override;
+    void DestroyAllTextures() override;
+
+    CVertexBuffer* CreateVertexBuffer(PrimitiveType primitiveType, const Vertex3D* vertices, int vertexCount) override;
+    void DestroyVertexBuffer(CVertexBuffer*) override;
+
+    void SetViewport(int x, int y, int width, int height) override;
+
+    void SetDepthTest(bool enabled) override;
+    void SetDepthMask(bool enabled) override;
+
+    void SetCullFace(CullFace mode) override;
+
+    void SetTransparency(TransparencyMode mode) override;
+
+    void SetColorMask(bool red, bool green, bool blue, bool alpha) override;
+
+    void SetClearColor(const Color &color) override;
+
+    void CopyFramebufferToTexture(Texture& texture, int xOffset, int yOffset, int x, int y, int width, int height) override;
+
+    std::unique_ptr<CFrameBufferPixels> GetFrameBufferPixels() const override;
+
+    CFramebuffer* GetFramebuffer(std::string name) override;
+
+    CFramebuffer* CreateFramebuffer(std::string name, const FramebufferParams& params) override;
+
+    void DeleteFramebuffer(std::string name) override;
+
+    bool IsAnisotropySupported() override;
+    int GetMaxAnisotropyLevel() override;
+    int GetMaxSamples() override;
+    bool IsShadowMappingSupported() override;
+    int GetMaxTextureSize() override;
+    bool IsFramebufferSupported() override;
+
+private:
+    DeviceConfig m_config;
+
+    //! Last texture ID handed out
+    unsigned int m_lastTextureId = 0;
+
+    std::map<std::string, std::unique_ptr<CFramebuffer>> m_framebuffers;
+
+    std::unique_ptr<CRecordingUIRenderer> m_uiRenderer;
+    std::unique_ptr<CRecordingTerrainRenderer> m_terrainRenderer;
+    std::unique_ptr<CRecordingObjectRenderer> m_objectRenderer;
+    std::unique_ptr<CRecordingParticleRenderer> m_particleRenderer;
+    std::unique_ptr<CRecordingShadowRenderer> m_shadowRenderer;
+};
+
+} // namespace Gfx
@@ -54,6 +54,21 @@ enum class PrimitiveType : unsigned char
     TRIANGLE_FAN,
 };
 
+//! Returns the number of triangles drawn from the given number of vertices
+inline int GetTriangleCount(PrimitiveType type, int vertexCount)
+{
+    switch (type)
+    {
+        case PrimitiveType::TRIANGLES:
+            return vertexCount / 3;
+        case PrimitiveType::TRIANGLE_STRIP:
+        case PrimitiveType::TRIANGLE_FAN:
+            return vertexCount > 2 ? vertexCount - 2 : 0;
+        default:
+            return 0;
+    }
+}
+
 struct ShadowParam
 {
     glm::mat4 matrix;
@@ -285,6 +300,10 @@ public:
     virtual void SetShadowMap(const Texture& texture) = 0;
     //! Sets shadow region
     virtual void SetShadowRegion(const glm::vec2& offset, const glm::vec2& scale) = 0;
+    //! Clears the depth of the current shadow region
+    virtual void ClearShadowRegion() = 0;
+    //! Copies the depth of the current shadow region from another shadow map of the same size
+    virtual void CopyShadowRegion(const Texture& source) = 0;
 
     //! Draws terrain object
     virtual void DrawObject(const CVertexBuffer* buffer, bool transparent) = 0;
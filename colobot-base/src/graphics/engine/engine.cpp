@@ -31,6 +31,8 @@
 
 #include "common/system/system.h"
 
+#include "common/thread/job_system.h"
+
 #include "graphics/core/device.h"
 #include "graphics/core/framebuffer.h"
 #include "graphics/core/material.h"
@@ -41,6 +43,7 @@
 #include "graphics/engine/cloud.h"
 #include "graphics/engine/lightman.h"
 #include "graphics/engine/lightning.h"
+#include "graphics/engine/mesh_lod.h"
 #include "graphics/engine/oldmodelmanager.h"
 #include "graphics/engine/particle.h"
 #include "graphics/engine/planet.h"
@@ -61,10 +64,10 @@
 
 #include "ui/controls/interface.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <SDL_surface.h>
 #include <SDL_thread.h>
-#include <thread>
 
 using TimeUtils::TimeUnit;
 
@@ -84,6 +87,9 @@ struct EngineBaseObjDataTier
     std::vector<Vertex3D>   vertices;
     CVertexBuffer* buffer = nullptr;
     bool                    updateStaticBuffer = false;
+    //! Buffers of the simplified triangles for each level of detail of the base object,
+    //! nullptr if none are left; empty if the tier is never simplified
+    std::vector<CVertexBuffer*> lodBuffers;
 
     Texture                 albedoTexture;
     Texture                 emissiveTexture;
@@ -115,6 +121,16 @@ struct EngineBaseObject
     Math::Sphere           boundingSphere;
     //! Next tier
     std::vector<EngineBaseObjDataTier> next;
+    //! Triangles for mouse picking, built when first needed
+    CPickingTree           pickingTree;
+    //! Tier and first vertex of every triangle of pickingTree
+    std::vector<std::pair<int, int>> pickingTriangles;
+    //! If true, pickingTree must be rebuilt
+    bool                   pickingTreeDirty = true;
+    //! Errors of the simplified meshes, see MeshLODLevel
+    std::vector<float>     lodErrors;
+    //! If true, the simplified meshes must be rebuilt
+    bool                   lodDirty = true;
 
     inline void LoadDefault()
     {
@@ -157,6 +173,41 @@ struct EngineMouse
 };
 
 constexpr glm::ivec2 MOUSE_SIZE(32, 32);
+
+//! Largest error of simplified objects on screen, in pixels
+constexpr float LOD_MAX_PIXELS = 2.0f;
+//! Largest number of simplified meshes of a base object
+constexpr int LOD_MAX_LEVELS = 4;
+
+//! Frames without moving after which an object is drawn into the static shadow map
+constexpr long long SHADOW_STATIC_FRAMES = 30;
+
+namespace
+{
+
+//! Returns the buffer of the tier at the given level of detail, nullptr if no triangles are left
+CVertexBuffer* GetLODBuffer(const EngineBaseObjDataTier& data, int level)
+{
+    if (level == 0 || level > static_cast<int>(data.lodBuffers.size()))
+        return data.buffer;
+
+    return data.lodBuffers[level - 1];
+}
+
+//! Returns the world box around the transformed bounding box of the base object of an object
+PickingBox GetPickingBox(const EngineObject& object, const EngineBaseObject& p1)
+{
+    glm::vec3 center = Math::Transform(object.transform, (p1.bboxMin + p1.bboxMax) * 0.5f);
+    glm::vec3 halfSize = (p1.bboxMax - p1.bboxMin) * 0.5f;
+    glm::vec3 extent{ 0, 0, 0 };
+    for (int i = 0; i < 3; i++)
+        extent += glm::abs(glm::vec3(object.transform[i])) * halfSize[i];
+
+    return { center - extent, center + extent };
+}
+
+} // anonymous namespace
+
 const std::map<EngineMouseType, EngineMouse> MOUSE_TYPES = {
     {{ENG_MOUSE_NORM},    {EngineMouse( 0,  1, 32, TransparencyMode::WHITE, TransparencyMode::BLACK, glm::ivec2( 1,  1))}},
     {{ENG_MOUSE_WAIT},    {EngineMouse( 2,  3, 33, TransparencyMode::WHITE, TransparencyMode::BLACK, glm::ivec2( 8, 12))}},
@@ -176,6 +227,14 @@ const std::map<EngineMouseType, EngineMouse> MOUSE_TYPES = {
     {{ENG_MOUSE_SCROLLD}, {EngineMouse(30, 31, 46, TransparencyMode::BLACK, TransparencyMode::WHITE, glm::ivec2( 9, 17))}},
 };
 
+void SortDrawQueue(std::vector<EngineDrawItem>& queue)
+{
+    std::stable_sort(queue.begin(), queue.end(), [](const EngineDrawItem& a, const EngineDrawItem& b)
+    {
+        return a.textures < b.textures;
+    });
+}
+
 CEngine::CEngine(CApplication *app, CSystemUtils* systemUtils)
     : m_app(app),
       m_systemUtils(systemUtils),
@@ -444,6 +503,12 @@ void CEngine::Destroy()
         m_shadowMap = Texture();
     }
 
+    if (m_staticShadowMap.id != 0)
+    {
+        m_device->DestroyTexture(m_staticShadowMap);
+        m_staticShadowMap = Texture();
+    }
+
     m_lightMan.reset();
     m_text.reset();
     m_particle.reset();
@@ -554,7 +619,7 @@ void CEngine::FrameUpdate()
 
 void CEngine::WriteScreenShot(const std::string& fileName)
 {
-    auto data = std::make_unique<WriteScreenShotData>();
+    auto data = std::make_shared<WriteScreenShotData>();
     data->img = std::make_unique<CImage>(glm::ivec2(m_size.x, m_size.y));
 
     auto pixels = m_device->GetFrameBufferPixels();
@@ -563,21 +628,26 @@ void CEngine::WriteScreenShot(const std::string& fileName)
 
     data->fileName = fileName;
 
-    std::thread{&CEngine::WriteScreenShotThread, std::move(data)}.detach();
+    m_app->GetJobSystem()->Submit([data]()
+    {
+        WriteScreenShotFile(*data);
+    },
+    [this]()
+    {
+        m_app->GetEventQueue()->AddEvent(Event(EVENT_WRITE_SCENE_FINISHED));
+    });
 }
 
-void CEngine::WriteScreenShotThread(std::unique_ptr<WriteScreenShotData> data)
+void CEngine::WriteScreenShotFile(const WriteScreenShotData& data)
 {
-    if ( data->img->SavePNG(data->fileName.c_str()) )
+    if ( data.img->SavePNG(data.fileName.c_str()) )
     {
        GetLogger()->Debug("Save screenshot saved successfully");
     }
     else
     {
-       GetLogger()->Error("%%!", data->img->GetError());
+       GetLogger()->Error("%%!", data.img->GetError());
     }
-
-    CApplication::GetInstancePointer()->GetEventQueue()->AddEvent(Event(EVENT_WRITE_SCENE_FINISHED));
 }
 
 void CEngine::SetPause(bool pause)
@@ -725,6 +795,8 @@ void CEngine::DeleteBaseObject(int baseObjRank)
     if (! p1.used)
         return;
 
+    DeleteBaseObjectLOD(p1);
+
     for (auto& data : p1.next)
     {
         m_device->DestroyVertexBuffer(data.buffer);
@@ -732,7 +804,13 @@ void CEngine::DeleteBaseObject(int baseObjRank)
     }
 
     p1.next.clear();
+    p1.pickingTree.Clear();
+    p1.pickingTriangles.clear();
+    p1.pickingTreeDirty = true;
     p1.used = false;
+
+    m_pickingObjectsDirty = true;
+    InvalidateShadowCache();
 }
 
 void CEngine::DeleteAllBaseObjects()
@@ -742,6 +820,8 @@ void CEngine::DeleteAllBaseObjects()
         if (!object.used)
             continue;
 
+        DeleteBaseObjectLOD(object);
+
         for (auto& data : object.next)
         {
             m_device->DestroyVertexBuffer(data.buffer);
@@ -750,6 +830,8 @@ void CEngine::DeleteAllBaseObjects()
     }
 
     m_baseObjects.clear();
+    m_pickingObjectsDirty = true;
+    InvalidateShadowCache();
 }
 
 void CEngine::CopyBaseObject(int sourceBaseObjRank, int destBaseObjRank)
@@ -767,10 +849,16 @@ void CEngine::CopyBaseObject(int sourceBaseObjRank, int destBaseObjRank)
     for (auto& data : p1.next)
     {
         data.buffer = nullptr;
+        data.lodBuffers.clear();
         data.updateStaticBuffer = true;
     }
 
+    p1.lodErrors.clear();
+    p1.lodDirty = true;
+
     m_updateStaticBuffers = true;
+    m_pickingObjectsDirty = true;
+    InvalidateShadowCache();
 }
 
 void CEngine::AddBaseObjTriangles(int baseObjRank, const std::vector<Vertex3D>& vertices,
@@ -803,6 +891,11 @@ void CEngine::AddBaseObjTriangles(int baseObjRank, const std::vector<Vertex3D>&
     p1.boundingSphere = Math::BoundingSphereForBox(p1.bboxMin, p1.bboxMax);
 
     p1.totalTriangles += vertices.size() / 3;
+
+    p1.pickingTreeDirty = true;
+    p1.lodDirty = true;
+    m_pickingObjectsDirty = true;
+    InvalidateShadowCache();
 }
 
 void CEngine::DebugObject(int objRank)
@@ -908,6 +1001,7 @@ int CEngine::CreateObject()
 void CEngine::DeleteAllObjects()
 {
     m_objects.clear();
+    m_pickingObjectsDirty = true;
     m_shadowSpots.clear();
 
     DeleteAllGroundSpots();
@@ -919,6 +1013,7 @@ void CEngine::DeleteObject(int objRank)
 
     // Mark object as deleted
     m_objects[objRank].used = false;
+    m_pickingObjectsDirty = true;
 
     // Delete associated shadows
     DeleteShadowSpot(objRank);
@@ -929,6 +1024,8 @@ void CEngine::SetObjectBaseRank(int objRank, int baseObjRank)
     assert(objRank == -1 || (objRank >= 0 && objRank < static_cast<int>( m_objects.size() )));
 
     m_objects[objRank].baseObjRank = baseObjRank;
+    m_objects[objRank].lastMoveFrame = m_frameCount;
+    m_pickingObjectsDirty = true;
 }
 
 int CEngine::GetObjectBaseRank(int objRank)
@@ -957,7 +1054,18 @@ void CEngine::SetObjectTransform(int objRank, const glm::mat4& transform)
 {
     assert(objRank >= 0 && objRank < static_cast<int>( m_objects.size() ));
 
+    if (m_objects[objRank].transform == transform)
+        return;
+
     m_objects[objRank].transform = transform;
+    m_objects[objRank].lastMoveFrame = m_frameCount;
+
+    // Only the box of the object is updated in the picking tree, see UpdatePickingObjects()
+    if (m_objects[objRank].pickingItem != -1 && !m_objects[objRank].pickingMoved)
+    {
+        m_objects[objRank].pickingMoved = true;
+        m_pickingMovedObjects.push_back(objRank);
+    }
 }
 
 void CEngine::GetObjectTransform(int objRank, glm::mat4& transform)
@@ -1455,6 +1563,34 @@ void CEngine::ComputeDistance()
         v.y = m_eyePt.y - m_objects[i].transform[3][1];
         v.z = m_eyePt.z - m_objects[i].transform[3][2];
         m_objects[i].distance = glm::length(v);
+
+        // Terrain is always drawn in full, it is mostly near the camera
+        int lodLevel = m_objects[i].lodLevel;
+        m_objects[i].lodLevel = 0;
+
+        int baseObjRank = m_objects[i].baseObjRank;
+        if (baseObjRank == -1 || m_objects[i].type == ENG_OBJTYPE_TERRAIN)
+            continue;
+
+        EngineBaseObject& p1 = m_baseObjects[baseObjRank];
+        if (! p1.used)
+            continue;
+
+        UpdateBaseObjectLOD(p1);
+        if (p1.lodErrors.empty())
+            continue;
+
+        // Errors are measured at the point of the object nearest to the eye
+        const glm::mat4& transform = m_objects[i].transform;
+        float scale = Math::Max(glm::length(glm::vec3(transform[0])),
+                                glm::length(glm::vec3(transform[1])),
+                                glm::length(glm::vec3(transform[2])));
+        float nearest = m_objects[i].distance - scale * (glm::length(p1.boundingSphere.pos) + p1.boundingSphere.radius);
+        if (nearest <= 0.0f)
+            continue;
+
+        float pixelsPerUnit = scale * m_matProj[1][1] * m_size.y * 0.5f / nearest;
+        m_objects[i].lodLevel = SelectMeshLODLevel(p1.lodErrors, pixelsPerUnit, LOD_MAX_PIXELS, lodLevel);
     }
 }
 
@@ -1487,6 +1623,8 @@ void CEngine::UpdateGeometry()
         object.boundingSphere = Math::BoundingSphereForBox(object.bboxMin, object.bboxMax);
     }
 
+    m_pickingObjectsDirty = true;
+    InvalidateShadowCache();
     m_updateGeometry = false;
 }
 
@@ -1536,6 +1674,61 @@ void CEngine::UpdateStaticBuffers()
     }
 }
 
+void CEngine::UpdateBaseObjectLOD(EngineBaseObject& p1)
+{
+    if (! p1.lodDirty)
+        return;
+
+    DeleteBaseObjectLOD(p1);
+
+    // Only triangle lists are simplified, strips are drawn in full at every level
+    std::vector<const std::vector<Vertex3D>*> lists;
+    for (const auto& data : p1.next)
+    {
+        if (data.type == EngineTriangleType::TRIANGLES)
+            lists.push_back(&data.vertices);
+    }
+
+    auto levels = BuildMeshLODLevels(lists, LOD_MAX_LEVELS);
+
+    for (const auto& level : levels)
+    {
+        p1.lodErrors.push_back(level.error);
+
+        size_t list = 0;
+        for (auto& data : p1.next)
+        {
+            if (data.type != EngineTriangleType::TRIANGLES)
+                continue;
+
+            const auto& vertices = level.lists[list++];
+            if (vertices.empty())
+                data.lodBuffers.push_back(nullptr);
+            else
+                data.lodBuffers.push_back(m_device->CreateVertexBuffer(PrimitiveType::TRIANGLES, vertices.data(), vertices.size()));
+        }
+    }
+
+    p1.lodDirty = false;
+}
+
+void CEngine::DeleteBaseObjectLOD(EngineBaseObject& p1)
+{
+    for (auto& data : p1.next)
+    {
+        for (auto buffer : data.lodBuffers)
+        {
+            if (buffer != nullptr)
+                m_device->DestroyVertexBuffer(buffer);
+        }
+
+        data.lodBuffers.clear();
+    }
+
+    p1.lodErrors.clear();
+    p1.lodDirty = true;
+}
+
 void CEngine::Update()
 {
     ComputeDistance();
@@ -1543,69 +1736,77 @@ void CEngine::Update()
     UpdateStaticBuffers();
 }
 
-bool CEngine::DetectBBox(int objRank, const glm::vec2& mouse)
+void CEngine::UpdatePickingTree(EngineBaseObject& p1)
 {
-    assert(objRank >= 0 && objRank < static_cast<int>(m_objects.size()));
+    if (! p1.pickingTreeDirty)
+        return;
 
-    int baseObjRank = m_objects[objRank].baseObjRank;
-    if (baseObjRank == -1)
-        return false;
+    std::vector<PickingBox> boxes;
+    p1.pickingTriangles.clear();
 
-    assert(baseObjRank >= 0 && baseObjRank < static_cast<int>(m_baseObjects.size()));
+    auto addTriangle = [&](int tier, int first)
+    {
+        const Vertex3D* triangle = &p1.next[tier].vertices[first];
 
-    EngineBaseObject& p1 = m_baseObjects[baseObjRank];
+        PickingBox box{ triangle[0].position, triangle[0].position };
+        for (int i = 1; i < 3; i++)
+        {
+            box.min = glm::min(box.min, triangle[i].position);
+            box.max = glm::max(box.max, triangle[i].position);
+        }
 
-    glm::vec2 min, max;
-    min.x =  1000000.0f;
-    min.y =  1000000.0f;
-    max.x = -1000000.0f;
-    max.y = -1000000.0f;
+        boxes.push_back(box);
+        p1.pickingTriangles.emplace_back(tier, first);
+    };
 
-    for (int i = 0; i < 8; i++)
+    for (int l2 = 0; l2 < static_cast<int>( p1.next.size() ); l2++)
     {
-        glm::vec3 p{ 0, 0, 0 };
+        EngineBaseObjDataTier& data = p1.next[l2];
 
-        if ( i & (1<<0) )  p.x = p1.bboxMin.x;
-        else               p.x = p1.bboxMax.x;
-        if ( i & (1<<1) )  p.y = p1.bboxMin.y;
-        else               p.y = p1.bboxMax.y;
-        if ( i & (1<<2) )  p.z = p1.bboxMin.z;
-        else               p.z = p1.bboxMax.z;
-
-        glm::vec3 pp{ 0, 0, 0 };
-        if ( TransformPoint(pp, objRank, p) )
+        if (data.type == EngineTriangleType::TRIANGLES)
         {
-            if (pp.x < min.x) min.x = pp.x;
-            if (pp.x > max.x) max.x = pp.x;
-            if (pp.y < min.y) min.y = pp.y;
-            if (pp.y > max.y) max.y = pp.y;
+            for (int i = 0; i + 2 < static_cast<int>(data.vertices.size()); i += 3)
+                addTriangle(l2, i);
+        }
+        else if (data.type == EngineTriangleType::SURFACE)
+        {
+            for (int i = 0; i < static_cast<int>(data.vertices.size()) - 2; i += 1)
+                addTriangle(l2, i);
         }
     }
 
-    return ( mouse.x >= min.x &&
-             mouse.x <= max.x &&
-             mouse.y >= min.y &&
-             mouse.y <= max.y );
+    p1.pickingTree.Build(boxes);
+    p1.pickingTreeDirty = false;
 }
 
-int CEngine::DetectObject(const glm::vec2& mouse, glm::vec3& targetPos, bool terrain)
+void CEngine::UpdatePickingObjects()
 {
-    float min = 1000000.0f;
-    int nearest = -1;
-    glm::vec3 pos{ 0, 0, 0 };
+    if (! m_pickingObjectsDirty)
+    {
+        for (int objRank : m_pickingMovedObjects)
+        {
+            EngineObject& object = m_objects[objRank];
+            object.pickingMoved = false;
+            m_pickingObjects.Update(object.pickingItem, GetPickingBox(object, m_baseObjects[object.baseObjRank]));
+        }
+        m_pickingMovedObjects.clear();
+        return;
+    }
+
+    std::vector<PickingBox> boxes;
+    m_pickingObjectRanks.clear();
+    m_pickingMovedObjects.clear();
 
     for (int objRank = 0; objRank < static_cast<int>( m_objects.size() ); objRank++)
     {
-        if (! m_objects[objRank].used)
-            continue;
+        EngineObject& object = m_objects[objRank];
+        object.pickingItem = -1;
+        object.pickingMoved = false;
 
-        if (m_objects[objRank].type == ENG_OBJTYPE_TERRAIN && !terrain)
-            continue;
-
-        if (! DetectBBox(objRank, mouse))
+        if (! object.used)
             continue;
 
-        int baseObjRank = m_objects[objRank].baseObjRank;
+        int baseObjRank = object.baseObjRank;
         if (baseObjRank == -1)
             continue;
 
@@ -1615,35 +1816,63 @@ int CEngine::DetectObject(const glm::vec2& mouse, glm::vec3& targetPos, bool ter
         if (! p1.used)
             continue;
 
-        for (int l2 = 0; l2 < static_cast<int>( p1.next.size() ); l2++)
+        object.pickingItem = static_cast<int>(boxes.size());
+        boxes.push_back(GetPickingBox(object, p1));
+        m_pickingObjectRanks.push_back(objRank);
+    }
+
+    m_pickingObjects.Build(boxes);
+    m_pickingObjectsDirty = false;
+}
+
+int CEngine::DetectObject(const glm::vec2& mouse, glm::vec3& targetPos, bool terrain)
+{
+    float min = 1000000.0f;
+    int nearest = -1;
+    glm::vec3 pos{ 0, 0, 0 };
+
+    // Ray from the eye through the mouse, see TransformPoint()
+    glm::mat4 matViewInverse = glm::inverse(m_matView);
+    glm::vec3 direction = glm::mat3(matViewInverse) * glm::vec3(
+        (mouse.x*2.0f-1.0f) / m_matProj[0][0],
+        (mouse.y*2.0f-1.0f) / m_matProj[1][1],
+        1.0f);
+    glm::vec3 origin = glm::vec3(matViewInverse[3]);
+
+    // Only objects and triangles crossed by the ray are tested, in the same order
+    // as they are stored, so that the nearest of equally distant triangles stays the same
+    UpdatePickingObjects();
+    m_pickingCandidates.clear();
+    m_pickingObjects.FindCrossed(origin, direction, m_pickingCandidates);
+    std::sort(m_pickingCandidates.begin(), m_pickingCandidates.end());
+
+    for (int item : m_pickingCandidates)
+    {
+        int objRank = m_pickingObjectRanks[item];
+
+        if (m_objects[objRank].type == ENG_OBJTYPE_TERRAIN && !terrain)
+            continue;
+
+        EngineBaseObject& p1 = m_baseObjects[m_objects[objRank].baseObjRank];
+        UpdatePickingTree(p1);
+
+        glm::mat4 matObjectInverse = glm::inverse(m_objects[objRank].transform);
+        m_pickingTriangles.clear();
+        p1.pickingTree.FindCrossed(Math::Transform(matObjectInverse, origin),
+                                   glm::mat3(matObjectInverse) * direction,
+                                   m_pickingTriangles);
+        std::sort(m_pickingTriangles.begin(), m_pickingTriangles.end());
+
+        for (int triangle : m_pickingTriangles)
         {
-            EngineBaseObjDataTier& data = p1.next[l2];
+            auto [tier, first] = p1.pickingTriangles[triangle];
 
-            if (data.type == EngineTriangleType::TRIANGLES)
+            float dist = 0.0f;
+            if (DetectTriangle(mouse, &p1.next[tier].vertices[first], objRank, dist, pos) && dist < min)
             {
-                for (int i = 0; i < static_cast<int>(data.vertices.size()); i += 3)
-                {
-                    float dist = 0.0f;
-                    if (DetectTriangle(mouse, &data.vertices[i], objRank, dist, pos) && dist < min)
-                    {
-                        min = dist;
-                        nearest = objRank;
-                        targetPos = pos;
-                    }
-                }
-            }
-            else if (data.type == EngineTriangleType::SURFACE)
-            {
-                for (int i = 0; i < static_cast<int>(data.vertices.size()) - 2; i += 1)
-                {
-                    float dist = 0.0f;
-                    if (DetectTriangle(mouse, &data.vertices[i], objRank, dist, pos) && dist < min)
-                    {
-                        min = dist;
-                        nearest = objRank;
-                        targetPos = pos;
-                    }
-                }
+                min = dist;
+                nearest = objRank;
+                targetPos = pos;
             }
         }
     }
@@ -1737,6 +1966,21 @@ bool CEngine::IsVisible(const glm::mat4& matrix, int objRank)
     return false;
 }
 
+void CEngine::QueueDraw(int objRank, EngineBaseObjDataTier& data)
+{
+    EngineDrawItem item;
+    item.textures = { data.albedoTexture.id, data.emissiveTexture.id, data.materialTexture.id, data.detailTexture.id };
+    item.objRank = objRank;
+    item.data = &data;
+    item.buffer = GetLODBuffer(data, m_objects[objRank].lodLevel);
+
+    // Tiers left without triangles at this level of detail are not drawn
+    if (item.buffer == nullptr)
+        return;
+
+    m_drawQueue.push_back(item);
+}
+
 int CEngine::ComputeSphereVisibility(const glm::mat4& m, const glm::vec3& center, float radius)
 {
     glm::vec3 vec[6];
@@ -2026,6 +2270,9 @@ bool CEngine::LoadAllTextures()
         }
     }
 
+    // transparent parts of albedo textures cast no shadows
+    InvalidateShadowCache();
+
     return ok;
 }
 
@@ -2467,6 +2714,8 @@ void CEngine::SetShadowMapping(bool value)
         m_device->DeleteFramebuffer("shadow");
         m_device->DestroyTexture(m_shadowMap);
         m_shadowMap.id = 0;
+        m_device->DestroyTexture(m_staticShadowMap);
+        m_staticShadowMap.id = 0;
     }
 }
 
@@ -2721,6 +2970,7 @@ void CEngine::ApplyChange()
 void CEngine::Render()
 {
     m_fpsCounter++;
+    m_frameCount++;
 
     m_currentFrameTime = m_systemUtils->GetCurrentTimeStamp();
     float diff = TimeUtils::Diff(m_lastFrameTime, m_currentFrameTime, TimeUnit::SECONDS);
@@ -2857,6 +3107,8 @@ void CEngine::Draw3DScene()
     auto projectionViewMatrix = m_matProj * scale;
     projectionViewMatrix = projectionViewMatrix * m_matView;
 
+    m_drawQueue.clear();
+
     for (int objRank = 0; objRank < static_cast<int>(m_objects.size()); objRank++)
     {
         if (! m_objects[objRank].used)
@@ -2884,19 +3136,26 @@ void CEngine::Draw3DScene()
             continue;
 
         for (auto& data : p1.next)
-        {
-            terrainRenderer->SetAlbedoColor(data.material.albedoColor);
-            terrainRenderer->SetAlbedoTexture(data.albedoTexture);
-            terrainRenderer->SetDetailTexture(data.detailTexture);
+            QueueDraw(objRank, data);
+    }
+
+    SortDrawQueue(m_drawQueue);
 
-            terrainRenderer->SetEmissiveColor(data.material.emissiveColor);
-            terrainRenderer->SetEmissiveTexture(data.emissiveTexture);
+    for (const auto& item : m_drawQueue)
+    {
+        const EngineBaseObjDataTier& data = *item.data;
 
-            terrainRenderer->SetMaterialParams(data.material.roughness, data.material.metalness, data.material.aoStrength);
-            terrainRenderer->SetMaterialTexture(data.materialTexture);
+        terrainRenderer->SetAlbedoColor(data.material.albedoColor);
+        terrainRenderer->SetAlbedoTexture(data.albedoTexture);
+        terrainRenderer->SetDetailTexture(data.detailTexture);
 
-            terrainRenderer->DrawObject(m_objects[objRank].transform, data.buffer);
-        }
+        terrainRenderer->SetEmissiveColor(data.material.emissiveColor);
+        terrainRenderer->SetEmissiveTexture(data.emissiveTexture);
+
+        terrainRenderer->SetMaterialParams(data.material.roughness, data.material.metalness, data.material.aoStrength);
+        terrainRenderer->SetMaterialTexture(data.materialTexture);
+
+        terrainRenderer->DrawObject(m_objects[item.objRank].transform, item.buffer);
     }
 
     terrainRenderer->End();
@@ -2935,6 +3194,8 @@ void CEngine::Draw3DScene()
 
     bool transparent = false;
 
+    m_drawQueue.clear();
+
     for (int objRank = 0; objRank < static_cast<int>(m_objects.size()); objRank++)
     {
         if (! m_objects[objRank].used)
@@ -2961,66 +3222,83 @@ void CEngine::Draw3DScene()
         if (! p1.used)
             continue;
 
-        objectRenderer->SetModelMatrix(m_objects[objRank].transform);
-
         //m_lightMan->UpdateDeviceLights(m_objects[objRank].type);
 
-        for (auto& data : p1.next)
+        if (m_objects[objRank].ghost)  // transparent ?
         {
-            if (m_objects[objRank].ghost)  // transparent ?
-            {
+            if (!p1.next.empty())
                 transparent = true;
-                continue;
-            }
 
-            if (data.material.alphaMode != AlphaMode::NONE)
-            {
-                objectRenderer->SetAlphaScissor(data.material.alphaThreshold);
-            }
-            else
-            {
-                objectRenderer->SetAlphaScissor(0.0f);
-            }
+            continue;
+        }
 
-            Color color = data.material.albedoColor;
+        for (auto& data : p1.next)
+            QueueDraw(objRank, data);
+    }
 
-            if (!data.material.tag.empty())
-            {
-                Color c = GetObjectColor(objRank, data.material.tag);
+    // Opaque tiers are drawn sorted by textures, the depth test makes the order irrelevant
+    SortDrawQueue(m_drawQueue);
 
-                if (c != Color(1.0, 1.0, 1.0, 1.0))
-                {
-                    color = c;
-                }
-            }
+    int lastObjRank = -1;
+
+    for (const auto& item : m_drawQueue)
+    {
+        int objRank = item.objRank;
+        const EngineBaseObjDataTier& data = *item.data;
+
+        if (objRank != lastObjRank)
+        {
+            objectRenderer->SetModelMatrix(m_objects[objRank].transform);
+            lastObjRank = objRank;
+        }
+
+        if (data.material.alphaMode != AlphaMode::NONE)
+        {
+            objectRenderer->SetAlphaScissor(data.material.alphaThreshold);
+        }
+        else
+        {
+            objectRenderer->SetAlphaScissor(0.0f);
+        }
+
+        Color color = data.material.albedoColor;
+
+        if (!data.material.tag.empty())
+        {
+            Color c = GetObjectColor(objRank, data.material.tag);
 
-            if (data.material.recolor.empty())
+            if (c != Color(1.0, 1.0, 1.0, 1.0))
             {
-                objectRenderer->SetRecolor(false);
+                color = c;
             }
-            else
-            {
-                Color recolorFrom = data.material.recolorReference;
-                Color recolorTo = GetObjectColor(objRank, data.material.recolor);
-                float recolorThreshold = 0.1;
+        }
 
-                objectRenderer->SetRecolor(true, recolorFrom, recolorTo, recolorThreshold);
-            }
+        if (data.material.recolor.empty())
+        {
+            objectRenderer->SetRecolor(false);
+        }
+        else
+        {
+            Color recolorFrom = data.material.recolorReference;
+            Color recolorTo = GetObjectColor(objRank, data.material.recolor);
+            float recolorThreshold = 0.1;
 
-            objectRenderer->SetAlbedoColor(color);
-            objectRenderer->SetAlbedoTexture(data.albedoTexture);
-            objectRenderer->SetDetailTexture(data.detailTexture);
+            objectRenderer->SetRecolor(true, recolorFrom, recolorTo, recolorThreshold);
+        }
 
-            objectRenderer->SetEmissiveColor(data.material.emissiveColor);
-            objectRenderer->SetEmissiveTexture(data.emissiveTexture);
+        objectRenderer->SetAlbedoColor(color);
+        objectRenderer->SetAlbedoTexture(data.albedoTexture);
+        objectRenderer->SetDetailTexture(data.detailTexture);
 
-            objectRenderer->SetMaterialParams(data.material.roughness, data.material.metalness, data.material.aoStrength);
-            objectRenderer->SetMaterialTexture(data.materialTexture);
+        objectRenderer->SetEmissiveColor(data.material.emissiveColor);
+        objectRenderer->SetEmissiveTexture(data.emissiveTexture);
 
-            objectRenderer->SetCullFace(data.material.cullFace);
-            objectRenderer->SetUVTransform(data.uvOffset, data.uvScale);
-            objectRenderer->DrawObject(data.buffer);
-        }
+        objectRenderer->SetMaterialParams(data.material.roughness, data.material.metalness, data.material.aoStrength);
+        objectRenderer->SetMaterialTexture(data.materialTexture);
+
+        objectRenderer->SetCullFace(data.material.cullFace);
+        objectRenderer->SetUVTransform(data.uvOffset, data.uvScale);
+        objectRenderer->DrawObject(item.buffer);
     }
 
     objectRenderer->End();
@@ -3071,11 +3349,15 @@ void CEngine::Draw3DScene()
 
             for (auto& data : p1.next)
             {
+                CVertexBuffer* buffer = GetLODBuffer(data, m_objects[objRank].lodLevel);
+                if (buffer == nullptr)
+                    continue;
+
                 objectRenderer->SetAlbedoColor(tColor);
                 objectRenderer->SetAlbedoTexture(data.albedoTexture);
                 objectRenderer->SetDetailTexture(data.detailTexture);
                 objectRenderer->SetUVTransform(data.uvOffset, data.uvScale);
-                objectRenderer->DrawObject(data.buffer);
+                objectRenderer->DrawObject(buffer);
             }
         }
     }
@@ -3407,6 +3689,8 @@ void CEngine::RenderShadowMap()
 
     CProfiler::StartPerformanceCounter(PCNT_RENDER_SHADOW_MAP);
 
+    int previousRegions = m_shadowRegions;
+
     if (m_qualityShadows)
     {
         m_shadowRegions = 4;
@@ -3436,6 +3720,10 @@ void CEngine::RenderShadowMap()
         m_shadowParams[0].scale = { 1.0, 1.0 };
     }
 
+    // regions now cover different parts of the shadow map
+    if (m_shadowRegions != previousRegions)
+        InvalidateShadowCache();
+
     // If no shadow map texture exists, create it
     if (m_shadowMap.id == 0)
     {
@@ -3446,21 +3734,26 @@ void CEngine::RenderShadowMap()
 
         GetLogger()->Info("Created shadow map texture: %%x%%, depth %%\n",
             m_shadowMap.size.x, m_shadowMap.size.y, 32);
+
+        // Objects that do not move are drawn into their own map of the same size,
+        // which is copied into the shadow map instead of drawing them again
+        if (m_staticShadowMap.id != 0)
+            m_device->DestroyTexture(m_staticShadowMap);
+
+        m_staticShadowMap = m_device->CreateDepthTexture(
+            m_shadowMap.size.x,
+            m_shadowMap.size.y,
+            32);
+
+        InvalidateShadowCache();
     }
 
     auto renderer = m_device->GetShadowRenderer();
     renderer->Begin();
     renderer->SetShadowMap(m_shadowMap);
-    renderer->SetShadowRegion({ 0.0, 0.0 }, { 1.0, 1.0 });
-
-    m_device->Clear();
 
     for (int region = 0; region < m_shadowRegions; region++)
     {
-        renderer->SetShadowRegion(
-            m_shadowParams[region].offset,
-            m_shadowParams[region].scale);
-
         // recompute matrices
         glm::vec3 worldUp(0.0f, 1.0f, 0.0f);
         glm::vec3 lightDir = glm::vec3(1.0f, 2.0f, -1.0f);
@@ -3517,10 +3810,13 @@ void CEngine::RenderShadowMap()
 
         m_shadowParams[region].transform = m_shadowTextureMat;
 
-        renderer->SetProjectionMatrix(m_shadowProjMat);
-        renderer->SetViewMatrix(m_shadowViewMat);
+        // find objects casting shadows into this region
+        CShadowRegionCache& cache = m_shadowCache[region];
+        cache.Begin(projectionViewMatrix);
+
+        m_shadowStaticCasters.clear();
+        m_shadowMovingCasters.clear();
 
-        // render objects into shadow map
         for (int objRank = 0; objRank < static_cast<int>(m_objects.size()); objRank++)
         {
             if (!m_objects[objRank].used)
@@ -3541,19 +3837,47 @@ void CEngine::RenderShadowMap()
 
             assert(baseObjRank >= 0 && baseObjRank < static_cast<int>(m_baseObjects.size()));
 
-            EngineBaseObject& p1 = m_baseObjects[baseObjRank];
-            if (!p1.used)
+            if (!m_baseObjects[baseObjRank].used)
                 continue;
 
-            renderer->SetModelMatrix(m_objects[objRank].transform);
+            bool isStatic = m_frameCount - m_objects[objRank].lastMoveFrame > SHADOW_STATIC_FRAMES;
+            int geometry = baseObjRank * (LOD_MAX_LEVELS + 1) + m_objects[objRank].lodLevel;
 
-            for (auto& data : p1.next)
-            {
-                renderer->SetTexture(data.albedoTexture);
+            cache.AddCaster(isStatic, objRank, geometry, m_objects[objRank].transform);
 
-                renderer->DrawObject(data.buffer, true);
-            }
+            if (isStatic)
+                m_shadowStaticCasters.push_back(objRank);
+            else
+                m_shadowMovingCasters.push_back(objRank);
         }
+
+        auto update = cache.End();
+
+        // the region still holds exactly these objects
+        if (update == CShadowRegionCache::Update::NOTHING)
+            continue;
+
+        renderer->SetShadowRegion(
+            m_shadowParams[region].offset,
+            m_shadowParams[region].scale);
+
+        renderer->SetProjectionMatrix(m_shadowProjMat);
+        renderer->SetViewMatrix(m_shadowViewMat);
+
+        if (update == CShadowRegionCache::Update::ALL)
+        {
+            // both maps have the same size, so the region stays the same
+            renderer->SetShadowMap(m_staticShadowMap);
+            renderer->ClearShadowRegion();
+
+            DrawShadowCasters(renderer, m_shadowStaticCasters);
+
+            renderer->SetShadowMap(m_shadowMap);
+        }
+
+        renderer->CopyShadowRegion(m_staticShadowMap);
+
+        DrawShadowCasters(renderer, m_shadowMovingCasters);
     }
 
     renderer->End();
@@ -3569,6 +3893,33 @@ void CEngine::RenderShadowMap()
     m_device->SetDepthTest(false);
 }
 
+void CEngine::DrawShadowCasters(CShadowRenderer* renderer, const std::vector<int>& casters)
+{
+    for (int objRank : casters)
+    {
+        EngineBaseObject& p1 = m_baseObjects[m_objects[objRank].baseObjRank];
+
+        renderer->SetModelMatrix(m_objects[objRank].transform);
+
+        for (auto& data : p1.next)
+        {
+            CVertexBuffer* buffer = GetLODBuffer(data, m_objects[objRank].lodLevel);
+            if (buffer == nullptr)
+                continue;
+
+            renderer->SetTexture(data.albedoTexture);
+
+            renderer->DrawObject(buffer, true);
+        }
+    }
+}
+
+void CEngine::InvalidateShadowCache()
+{
+    for (auto& cache : m_shadowCache)
+        cache.Invalidate();
+}
+
 void CEngine::UseMSAA(bool enable)
 {
     m_multisample = Math::Min(m_device->GetMaxSamples(), m_multisample);
@@ -4644,7 +4995,7 @@ void CEngine::DrawStats()
 
     float height = m_text->GetAscent(FONT_COMMON, 13.0f);
     float width = 0.4f;
-    const int TOTAL_LINES = 22;
+    const int TOTAL_LINES = 32;
 
     glm::vec2 pos(0.05f * m_size.x/m_size.y, 0.05f + TOTAL_LINES * height);
 
@@ -4718,6 +5069,8 @@ void CEngine::DrawStats()
     drawStatsCounter("    Particle update",   PCNT_UPDATE_PARTICLE);
     drawStatsValue  ("    Game update",       gameUpdate);
     drawStatsCounter("    CBot programs",     PCNT_UPDATE_CBOT);
+    drawStatsLine(   "        ticks",         StrUtils::ToString<long long>(CProfiler::GetPerformanceStat(PSTAT_CBOT_TICKS)), "");
+    drawStatsLine(   "        throttled",     StrUtils::ToString<long long>(CProfiler::GetPerformanceStat(PSTAT_CBOT_THROTTLED_PROGRAMS)), "");
     drawStatsValue(  "    Other update",      otherUpdate);
     drawStatsLine(   "", "", "");
     drawStatsCounter("Frame render",      PCNT_RENDER_ALL);
@@ -4732,6 +5085,14 @@ void CEngine::DrawStats()
     drawStatsCounter("Swap buffers & VSync",  PCNT_SWAP_BUFFERS);
     drawStatsLine(   "", "", "");
     drawStatsLine(   "Triangles",         StrUtils::ToString<int>(m_statisticTriangle), "");
+    drawStatsLine(   "Draw calls",        StrUtils::ToString<long long>(CProfiler::GetPerformanceStat(PSTAT_DRAW_CALLS)), "");
+    drawStatsLine(   "    triangles",     StrUtils::ToString<long long>(CProfiler::GetPerformanceStat(PSTAT_TRIANGLES)), "");
+    drawStatsLine(   "Texture binds",     StrUtils::ToString<long long>(CProfiler::GetPerformanceStat(PSTAT_TEXTURE_BINDS)), "");
+    drawStatsLine(   "State changes",     StrUtils::ToString<long long>(CProfiler::GetPerformanceStat(PSTAT_STATE_CHANGES)), "");
+    drawStatsLine(   "Buffer uploads",    StrUtils::ToString<long long>(CProfiler::GetPerformanceStat(PSTAT_BUFFER_UPLOADS)),
+                     StrUtils::Format("%.1f KiB", CProfiler::GetPerformanceStat(PSTAT_BUFFER_UPLOAD_BYTES)/1024.0f));
+    const CWheelTraces& traces = m_particle->GetWheelTraces();
+    drawStatsLine(   "Wheel traces",      StrUtils::ToString<int>(traces.GetCount()), StrUtils::Format("%.1f KiB", traces.GetMemoryUsage()/1024.0f));
     drawStatsLine(   "FPS",               StrUtils::Format("%.3f", m_fps), "");
     drawStatsLine(   "", "", "");
     std::stringstream str;
@@ -4792,7 +5153,11 @@ void CEngine::AddBaseObjTriangles(int baseObjRank, const std::vector<Gfx::ModelT
         p1.totalTriangles += vertices.size() / 3;
     }
 
+    p1.pickingTreeDirty = true;
+    p1.lodDirty = true;
+    m_pickingObjectsDirty = true;
     m_updateStaticBuffers = true;
+    InvalidateShadowCache();
 }
 
 void CEngine::UpdateObjectShadowSpotNormal(int objRank)
@@ -32,10 +32,14 @@
 #include "graphics/core/renderers.h"
 #include "graphics/core/vertex.h"
 
+#include "graphics/engine/picking_tree.h"
+#include "graphics/engine/shadow_cache.h"
+
 #include "math/sphere.h"
 
 #include <glm/glm.hpp>
 
+#include <array>
 #include <string>
 #include <vector>
 #include <map>
@@ -58,6 +62,7 @@ namespace Gfx
 class CDevice;
 class CUIRenderer;
 class CObjectRenderer;
+class CShadowRenderer;
 class COldModelManager;
 class CLightManager;
 class CText;
@@ -134,6 +139,14 @@ struct EngineObject
     glm::mat4              transform = {};
     //! Distance to object from eye point
     float                  distance = 0.0f;
+    //! Level of detail drawn, 0 for the full mesh
+    int                    lodLevel = 0;
+    //! Frame in which the object last moved or changed its base object
+    long long              lastMoveFrame = 0;
+    //! Item of the object in the picking tree of objects, -1 if none
+    int                    pickingItem = -1;
+    //! If true, the object moved since its box in the picking tree was updated
+    bool                   pickingMoved = false;
     //! Rank of the associated shadow
     int                    shadowRank = -1;
     //! Ghost mode
@@ -142,6 +155,29 @@ struct EngineObject
     int                    team = 0;
 };
 
+/**
+ * \struct EngineDrawItem
+ * \brief Single tier of an engine object queued for drawing
+ *
+ * Draws are queued and sorted by their textures before being submitted,
+ * so that tiers sharing the same textures are drawn one after another
+ * and the renderer does not have to rebind textures between them.
+ */
+struct EngineDrawItem
+{
+    //! Texture IDs: albedo, emissive, material and detail
+    std::array<unsigned int, 4> textures = {};
+    //! Rank of the drawn object
+    int                    objRank = -1;
+    //! Drawn tier of base object
+    EngineBaseObjDataTier* data = nullptr;
+    //! Buffer of the drawn level of detail of the tier
+    CVertexBuffer*         buffer = nullptr;
+};
+
+//! Sorts the draw queue by textures, keeping the order of objects for draws with the same textures
+void SortDrawQueue(std::vector<EngineDrawItem>& queue);
+
 /**
  * \struct EngineShadowType
  * \brief Type of shadow drawn by the graphics engine
@@ -999,6 +1035,10 @@ protected:
     void        DrawCaptured3DScene();
     //! Renders shadow map
     void        RenderShadowMap();
+    //! Draws the given objects into the current region of the shadow map
+    void        DrawShadowCasters(CShadowRenderer* renderer, const std::vector<int>& casters);
+    //! Makes every region of the shadow map be drawn again in the next frame
+    void        InvalidateShadowCache();
     //! Enables or disables MSAA
     void        UseMSAA(bool enable);
     //! Draws the user interface over the scene
@@ -1039,10 +1079,20 @@ protected:
     //! Tests whether the given object is visible
     bool        IsVisible(const glm::mat4& matrix, int objRank);
 
+    //! Adds tier of given object to the draw queue
+    void        QueueDraw(int objRank, EngineBaseObjDataTier& data);
+
+    //! Builds the simplified meshes of the base object, if its geometry changed
+    void        UpdateBaseObjectLOD(EngineBaseObject& p1);
+    //! Destroys the buffers of the simplified meshes of the base object
+    void        DeleteBaseObjectLOD(EngineBaseObject& p1);
+
     bool        InPlane(glm::vec3 normal, float originPlane, glm::vec3 center, float radius);
 
-    //! Detects whether an object is affected by the mouse
-    bool        DetectBBox(int objRank, const glm::vec2& mouse);
+    //! Builds the tree of triangles of the base object for picking, if its geometry changed
+    void        UpdatePickingTree(EngineBaseObject& p1);
+    //! Builds the tree of object boxes for picking if objects changed, updates the boxes of objects which moved
+    void        UpdatePickingObjects();
 
     //! Compute and return the 2D box on screen of any object
     bool        GetBBox2D(int objRank, glm::vec2& min, glm::vec2& max);
@@ -1055,6 +1105,7 @@ protected:
     bool        TransformPoint(glm::vec3& p2D, int objRank, glm::vec3 p3D);
 
     //! Calculates the distances between the viewpoint and the origin of different objects
+    //! and selects the level of detail they are drawn with
     void        ComputeDistance();
 
     //! Updates geometric parameters of objects (bounding box and radius)
@@ -1071,7 +1122,8 @@ protected:
         std::unique_ptr<CImage> img;
         std::string fileName;
     };
-    static void WriteScreenShotThread(std::unique_ptr<WriteScreenShotData> data);
+    //! Saves the screenshot, run as a job
+    static void WriteScreenShotFile(const WriteScreenShotData& data);
 
 protected:
     CApplication*     m_app;
@@ -1096,6 +1148,8 @@ protected:
     TimeUtils::TimeStamp m_currentFrameTime;
     int             m_fpsCounter;
     float           m_fps;
+    //! Frames rendered since the engine was created
+    long long       m_frameCount = 0;
 
     //! Whether to show stats (FPS, etc)
     bool            m_showStats;
@@ -1142,6 +1196,19 @@ protected:
     std::vector<EngineBaseObject> m_baseObjects;
     //! Object parameters
     std::vector<EngineObject>     m_objects;
+    //! Opaque draws of the current frame, reused between frames
+    std::vector<EngineDrawItem>   m_drawQueue;
+    //! World boxes of the objects, searched by DetectObject()
+    CPickingTree                  m_pickingObjects;
+    //! Rank of the object of every item in m_pickingObjects
+    std::vector<int>              m_pickingObjectRanks;
+    //! If true, m_pickingObjects must be rebuilt
+    bool                          m_pickingObjectsDirty = true;
+    //! Objects whose boxes must be updated in m_pickingObjects
+    std::vector<int>              m_pickingMovedObjects;
+    //! Items found by the last picking search, reused between searches
+    std::vector<int>              m_pickingCandidates;
+    std::vector<int>              m_pickingTriangles;
     //! Shadow list
     std::vector<EngineShadow>     m_shadowSpots;
     //! Ground spot list
@@ -1211,6 +1278,13 @@ protected:
     int             m_shadowRegions = 4;
     ShadowParam     m_shadowParams[4];
     Texture         m_shadowMap;
+    //! Shadow map of the objects that do not move, copied into m_shadowMap before moving ones are drawn
+    Texture         m_staticShadowMap;
+    //! What was drawn into each region of the shadow maps
+    CShadowRegionCache m_shadowCache[4];
+    //! Objects drawn into the current region, reused between regions
+    std::vector<int> m_shadowStaticCasters;
+    std::vector<int> m_shadowMovingCasters;
 
     struct PendingDebugDraw
     {
@@ -227,9 +227,9 @@ void CLightning::Draw()
 
     auto texture = m_engine->LoadTexture("textures/effect00.png");
 
-    renderer->SetModelMatrix(glm::mat4(1.0f));
-    renderer->SetTexture(texture);
-    renderer->SetTransparency(TransparencyMode::BLACK);
+    m_batch.SetRenderer(renderer);
+    m_batch.Begin(true);
+    m_batch.SetLook(texture, TransparencyMode::BLACK);
 
     glm::vec2 texInf;
     texInf.x = 64.5f/256.0f;
@@ -292,11 +292,13 @@ void CLightning::Draw()
             vertex[3] = { corner[3], white, { texInf.x, texInf.y } };
         }
 
-        renderer->DrawParticle(PrimitiveType::TRIANGLE_STRIP, 4, vertex);
+        m_batch.Add(PrimitiveType::TRIANGLE_STRIP, 4, vertex, Color(1.0f, 1.0f, 1.0f, 1.0f));
         m_engine->AddStatisticTriangle(2);
 
         p1 = p2;
     }
+
+    m_batch.End();
 }
 
 CObject* CLightning::SearchObject(glm::vec3 pos)
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include "graphics/engine/particle_batch.h"
+
 #include <glm/glm.hpp>
 
 #include <vector>
@@ -111,6 +113,9 @@ protected:
         float width = 0.0f;
     };
     std::vector<LightningSegment> m_segments;
+
+    //! All segments are drawn with one call
+    CParticleBatch  m_batch;
 };
 
 
@@ -0,0 +1,162 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/mesh_lod.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+namespace
+{
+
+//! Number of cells along the largest side of the mesh at the most detailed level
+constexpr float FIRST_LEVEL_CELLS = 64.0f;
+
+//! Part of the error limit below which a coarser level is chosen
+constexpr float HYSTERESIS = 0.75f;
+
+struct Cell
+{
+    glm::vec3 sum{ 0.0f, 0.0f, 0.0f };
+    int count = 0;
+};
+
+} // anonymous namespace
+
+std::vector<MeshLODLevel> BuildMeshLODLevels(const std::vector<const std::vector<Vertex3D>*>& lists, int maxLevels)
+{
+    std::vector<MeshLODLevel> levels;
+
+    bool empty = true;
+    glm::vec3 min{ 0.0f, 0.0f, 0.0f }, max{ 0.0f, 0.0f, 0.0f };
+    int triangles = 0;
+
+    for (const auto* list : lists)
+    {
+        for (const auto& vertex : *list)
+        {
+            min = empty ? vertex.position : glm::min(min, vertex.position);
+            max = empty ? vertex.position : glm::max(max, vertex.position);
+            empty = false;
+        }
+
+        triangles += static_cast<int>(list->size() / 3);
+    }
+
+    glm::vec3 size = max - min;
+    float cellSize = std::max(size.x, std::max(size.y, size.z)) / FIRST_LEVEL_CELLS;
+    if (empty || cellSize <= 0.0f)
+        return levels;
+
+    std::unordered_map<std::uint64_t, Cell> cells;
+    std::vector<std::uint64_t> keys;
+
+    for (float cellCount = FIRST_LEVEL_CELLS; cellCount >= 1.0f && static_cast<int>(levels.size()) < maxLevels; cellCount /= 2.0f, cellSize *= 2.0f)
+    {
+        // Every vertex belongs to the cell of its position, cells are at most 2^21 along each axis
+        cells.clear();
+        keys.clear();
+        for (const auto* list : lists)
+        {
+            for (const auto& vertex : *list)
+            {
+                glm::vec3 index = (vertex.position - min) / cellSize;
+                std::uint64_t key = 0;
+                for (int i = 0; i < 3; ++i)
+                    key = (key << 21) | static_cast<std::uint64_t>(std::min(index[i], 2097151.0f));
+
+                Cell& cell = cells[key];
+                cell.sum += vertex.position;
+                cell.count++;
+                keys.push_back(key);
+            }
+        }
+
+        MeshLODLevel result;
+
+        // Vertices of removed triangles count too, the shape they made is lost as well
+        size_t next = 0;
+        for (const auto* list : lists)
+        {
+            for (const auto& vertex : *list)
+            {
+                const Cell& cell = cells[keys[next++]];
+                result.error = std::max(result.error, glm::length(cell.sum / static_cast<float>(cell.count) - vertex.position));
+            }
+        }
+
+        next = 0;
+        for (const auto* list : lists)
+        {
+            auto& simplified = result.lists.emplace_back();
+
+            for (size_t i = 0; i + 2 < list->size(); i += 3, next += 3)
+            {
+                if (keys[next] == keys[next + 1] || keys[next] == keys[next + 2] || keys[next + 1] == keys[next + 2])
+                    continue;
+
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    const Cell& cell = cells[keys[next + j]];
+                    Vertex3D vertex = (*list)[i + j];
+                    vertex.position = cell.sum / static_cast<float>(cell.count);
+                    simplified.push_back(vertex);
+                }
+            }
+
+            next += list->size() % 3;
+            result.triangles += static_cast<int>(simplified.size() / 3);
+        }
+
+        if (result.triangles * 4 > triangles * 3 || result.error <= 0.0f)
+            continue;
+
+        triangles = result.triangles;
+        levels.push_back(std::move(result));
+
+        if (triangles == 0)
+            break;
+    }
+
+    return levels;
+}
+
+int SelectMeshLODLevel(const std::vector<float>& errors, float pixelsPerUnit, float maxPixels, int current)
+{
+    int level = 0;
+
+    for (int i = 0; i < static_cast<int>(errors.size()); ++i)
+    {
+        float limit = i + 1 > current ? maxPixels * HYSTERESIS : maxPixels;
+        if (errors[i] * pixelsPerUnit > limit)
+            break;
+
+        level = i + 1;
+    }
+
+    return level;
+}
+
+} // namespace Gfx
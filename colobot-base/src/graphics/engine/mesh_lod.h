@@ -0,0 +1,78 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file graphics/engine/mesh_lod.h
+ * \brief Simplified meshes for distant objects
+ */
+
+#pragma once
+
+#include "graphics/core/vertex.h"
+
+#include <vector>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+/**
+ * \struct MeshLODLevel
+ * \brief Simplified version of a mesh made of several triangle lists
+ */
+struct MeshLODLevel
+{
+    //! Largest distance between a vertex of the full mesh and its simplified position, vertices of removed triangles included
+    float error = 0.0f;
+    //! Total number of triangles left
+    int triangles = 0;
+    //! Triangle lists, in the same order as the lists of the full mesh
+    std::vector<std::vector<Vertex3D>> lists;
+};
+
+/**
+ * \brief Builds simplified versions of a mesh, from the most to the least detailed
+ *
+ * Vertices falling into the same cell of a grid laid over the whole mesh
+ * are moved to a single position and triangles left without area are removed.
+ * Every list of the mesh is simplified with the same grid, so that parts drawn
+ * with different materials stay joined. Cells start at 1/64 of the mesh size
+ * and double with every attempt; levels removing less than a quarter of the
+ * remaining triangles are not kept.
+ *
+ * \param lists    triangle lists of the mesh
+ * \param maxLevels largest number of levels to build
+ */
+std::vector<MeshLODLevel> BuildMeshLODLevels(const std::vector<const std::vector<Vertex3D>*>& lists, int maxLevels);
+
+/**
+ * \brief Selects the level of detail to draw
+ *
+ * \param errors        errors of the simplified levels, in increasing order
+ * \param pixelsPerUnit size in pixels of one unit of the mesh at the distance of the object
+ * \param maxPixels     largest error on screen that is allowed
+ * \param current       level drawn in the previous frame; a coarser level is only chosen
+ *                      once its error is well below the limit, so that objects near the limit
+ *                      do not switch every frame
+ * \return 0 for the full mesh or n for errors[n - 1]
+ */
+int SelectMeshLODLevel(const std::vector<float>& errors, float pixelsPerUnit, float maxPixels, int current);
+
+} // namespace Gfx
@@ -87,6 +87,7 @@ void CParticle::SetDevice(CDevice* device)
 {
     m_device = device;
     m_renderer = device->GetParticleRenderer();
+    m_batch.SetRenderer(m_renderer);
 }
 
 void CParticle::FlushParticle()
@@ -105,8 +106,7 @@ void CParticle::FlushParticle()
     for (int i = 0; i < MAXTRACK; i++)
         m_track[i].used = false;
 
-    m_wheelTraceTotal = 0;
-    m_wheelTraceIndex = 0;
+    m_wheelTraces.Clear();
 
     for (int i = 0; i < SH_MAX; i++)
         m_frameUpdate[i] = true;
@@ -132,10 +132,7 @@ void CParticle::FlushParticle(int sheet)
         m_track[i].used = false;
 
     if (sheet == SH_WORLD)
-    {
-        m_wheelTraceTotal = 0;
-        m_wheelTraceIndex = 0;
-    }
+        m_wheelTraces.Clear();
 }
 
 
@@ -605,35 +602,28 @@ void CParticle::CreateWheelTrace(const glm::vec3 &p1, const glm::vec3 &p2,
                                  const glm::vec3 &p3, const glm::vec3 &p4,
                                  TraceColor color)
 {
-    int max = MAXWHEELTRACE;
-    int i = m_wheelTraceIndex++;
-    if (m_wheelTraceIndex > max)  m_wheelTraceIndex = 0;
-
-    m_wheelTrace[i].color = color;
-    m_wheelTrace[i].pos[0] = p1;  // ul
-    m_wheelTrace[i].pos[1] = p2;  // dl
-    m_wheelTrace[i].pos[2] = p3;  // ur
-    m_wheelTrace[i].pos[3] = p4;  // dr
+    WheelTrace trace;
+    trace.color = color;
+    trace.pos[0] = p1;  // ul
+    trace.pos[1] = p2;  // dl
+    trace.pos[2] = p3;  // ur
+    trace.pos[3] = p4;  // dr
 
     if (m_terrain == nullptr)
         m_terrain = m_main->GetTerrain();
 
-    m_terrain->AdjustToFloor(m_wheelTrace[i].pos[0]);
-    m_wheelTrace[i].pos[0].y += 0.2f;  // just above the ground
-
-    m_terrain->AdjustToFloor(m_wheelTrace[i].pos[1]);
-    m_wheelTrace[i].pos[1].y += 0.2f;  // just above the ground
-
-    m_terrain->AdjustToFloor(m_wheelTrace[i].pos[2]);
-    m_wheelTrace[i].pos[2].y += 0.2f;  // just above the ground
+    for (int i = 0; i < 4; i++)
+    {
+        m_terrain->AdjustToFloor(trace.pos[i]);
+        trace.pos[i].y += 0.2f;  // just above the ground
+    }
 
-    m_terrain->AdjustToFloor(m_wheelTrace[i].pos[3]);
-    m_wheelTrace[i].pos[3].y += 0.2f;  // just above the ground
+    m_wheelTraces.Add(trace);
+}
 
-    if (m_wheelTraceTotal < max)
-        m_wheelTraceTotal++;
-    else
-        m_wheelTraceTotal = max;
+CWheelTraces& CParticle::GetWheelTraces()
+{
+    return m_wheelTraces;
 }
 
 
@@ -2507,9 +2497,6 @@ void CParticle::TrackDraw(int i, ParticleType type)
         if (h < 0) h = MAXTRACKLEN-1;
     }
 
-    glm::mat4 mat = glm::mat4(1.0f);
-    m_renderer->SetModelMatrix(mat);
-
     glm::vec2 texInf{ 0, 0 }, texSup{ 0, 0 };
 
     if (type == PARTITRACK1)  // technical explosion?
@@ -2660,7 +2647,7 @@ void CParticle::TrackDraw(int i, ParticleType type)
             vertex[3] = { corner[3], white, { texInf.x, texInf.y } };
         }
 
-        m_renderer->DrawParticle(PrimitiveType::TRIANGLE_STRIP, 4, vertex);
+        m_batch.Add(PrimitiveType::TRIANGLE_STRIP, 4, vertex, Color(1.0f, 1.0f, 1.0f, 1.0f));
         m_engine->AddStatisticTriangle(2);
 
         if (f2 < 0.0f) break;
@@ -2690,7 +2677,6 @@ void CParticle::DrawParticleTriangle(int i)
     mat[3][0] = pos.x;
     mat[3][1] = pos.y;
     mat[3][2] = pos.z;
-    m_renderer->SetModelMatrix(mat);
 
     VertexParticle vertices[3];
 
@@ -2701,7 +2687,7 @@ void CParticle::DrawParticleTriangle(int i)
         vertices[j].uv = m_triangle[i].triangle[j].uv;
     }
 
-    m_renderer->DrawParticle(PrimitiveType::TRIANGLES, 3, vertices);
+    m_batch.Add(PrimitiveType::TRIANGLES, 3, vertices, mat, Color(1.0f, 1.0f, 1.0f, 1.0f));
     m_engine->AddStatisticTriangle(1);
 }
 
@@ -2749,7 +2735,7 @@ void CParticle::DrawParticleNorm(int i)
         vertex[2] = { corner[3], white, { m_particle[i].texSup.x, m_particle[i].texInf.y } };
         vertex[3] = { corner[2], white, { m_particle[i].texInf.x, m_particle[i].texInf.y } };
 
-        m_renderer->DrawParticle(PrimitiveType::TRIANGLE_STRIP, 4, vertex);
+        m_batch.Add(PrimitiveType::TRIANGLE_STRIP, 4, vertex, IntensityToColor(m_particle[i].intensity));
         m_engine->AddStatisticTriangle(2);
     }
     else
@@ -2771,7 +2757,6 @@ void CParticle::DrawParticleNorm(int i)
         mat[3][0] = pos.x;
         mat[3][1] = pos.y;
         mat[3][2] = pos.z;
-        m_renderer->SetModelMatrix(mat);
 
         glm::vec3 n(0.0f, 0.0f, -1.0f);
 
@@ -2802,7 +2787,7 @@ void CParticle::DrawParticleNorm(int i)
         vertex[2] = { corner[3], color, { m_particle[i].texSup.x, m_particle[i].texInf.y } };
         vertex[3] = { corner[2], color, { m_particle[i].texInf.x, m_particle[i].texInf.y } };
 
-        m_renderer->DrawParticle(PrimitiveType::TRIANGLE_STRIP, 4, vertex);
+        m_batch.Add(PrimitiveType::TRIANGLE_STRIP, 4, vertex, mat, IntensityToColor(m_particle[i].intensity));
         m_engine->AddStatisticTriangle(2);
     }
 }
@@ -2835,7 +2820,6 @@ void CParticle::DrawParticleFlat(int i)
     mat[3][0] = pos.x;
     mat[3][1] = pos.y;
     mat[3][2] = pos.z;
-    m_renderer->SetModelMatrix(mat);
 
     glm::vec3 n(0.0f, 0.0f, -1.0f);
 
@@ -2868,7 +2852,7 @@ void CParticle::DrawParticleFlat(int i)
     vertex[2] = { corner[3], white, { m_particle[i].texSup.x, m_particle[i].texInf.y } };
     vertex[3] = { corner[2], white, { m_particle[i].texInf.x, m_particle[i].texInf.y } };
 
-    m_renderer->DrawParticle(PrimitiveType::TRIANGLE_STRIP, 4, vertex);
+    m_batch.Add(PrimitiveType::TRIANGLE_STRIP, 4, vertex, mat, IntensityToColor(m_particle[i].intensity));
     m_engine->AddStatisticTriangle(2);
 }
 
@@ -2926,7 +2910,6 @@ void CParticle::DrawParticleFog(int i)
     mat[3][0] = pos.x;
     mat[3][1] = pos.y;
     mat[3][2] = pos.z;
-    m_renderer->SetModelMatrix(mat);
 
     glm::vec3 corner[4];
 
@@ -2955,7 +2938,7 @@ void CParticle::DrawParticleFog(int i)
     vertex[2] = { corner[3], white, { m_particle[i].texSup.x, m_particle[i].texInf.y } };
     vertex[3] = { corner[2], white, { m_particle[i].texInf.x, m_particle[i].texInf.y } };
 
-    m_renderer->DrawParticle(PrimitiveType::TRIANGLE_STRIP, 4, vertex);
+    m_batch.Add(PrimitiveType::TRIANGLE_STRIP, 4, vertex, mat, IntensityToColor(m_particle[i].intensity));
     m_engine->AddStatisticTriangle(2);
 }
 
@@ -2987,7 +2970,6 @@ void CParticle::DrawParticleRay(int i)
     mat[3][0] = pos.x;
     mat[3][1] = pos.y;
     mat[3][2] = pos.z;
-    m_renderer->SetModelMatrix(mat);
 
     glm::vec3 n(0.0f, 0.0f, left ? 1.0f : -1.0f);
 
@@ -3111,7 +3093,7 @@ void CParticle::DrawParticleRay(int i)
             vertex[2] = { corner[3], white, { texSup.x, texInf.y } };
             vertex[3] = { corner[2], white, { texInf.x, texInf.y } };
 
-            m_renderer->DrawParticle(PrimitiveType::TRIANGLE_STRIP, 4, vertex);
+            m_batch.Add(PrimitiveType::TRIANGLE_STRIP, 4, vertex, mat, IntensityToColor(m_particle[i].intensity));
             m_engine->AddStatisticTriangle(2);
         }
         adv += dim.x*2.0f;
@@ -3124,8 +3106,7 @@ void CParticle::DrawParticleSphere(int i)
 
     if (zoom == 0.0f) return;
 
-    m_renderer->SetTransparency(TransparencyMode::BLACK);
-    m_renderer->SetColor(IntensityToColor(m_particle[i].intensity));
+    m_batch.SetLook(m_batch.GetTexture(), TransparencyMode::BLACK);
 
     glm::mat4 mat = glm::mat4(1.0f);
     mat[0][0] = zoom;
@@ -3146,7 +3127,6 @@ void CParticle::DrawParticleSphere(int i)
         mat = mat * rot;
     }
 
-    m_renderer->SetModelMatrix(mat);
 
     glm::vec2 ts, ti;
     ts.x = m_particle[i].texSup.x;
@@ -3212,11 +3192,9 @@ void CParticle::DrawParticleSphere(int i)
         }
     }
 
-    m_renderer->DrawParticle(PrimitiveType::TRIANGLE_STRIP, j, vertex.data());
+    m_batch.Add(PrimitiveType::TRIANGLE_STRIP, j, vertex.data(), mat, IntensityToColor(m_particle[i].intensity));
     m_engine->AddStatisticTriangle(j);
 
-    m_renderer->SetColor(IntensityToColor(m_particle[i].intensity));
-    m_renderer->SetTransparency(TransparencyMode::BLACK);
 }
 
 //! Returns the height depending on the progress
@@ -3235,8 +3213,7 @@ void CParticle::DrawParticleCylinder(int i)
     float diam = m_particle[i].dim.y;
     if (progress >= 1.0f || zoom == 0.0f)  return;
 
-    m_renderer->SetColor(IntensityToColor(m_particle[i].intensity));
-    m_renderer->SetTransparency(TransparencyMode::BLACK);
+    m_batch.SetLook(m_batch.GetTexture(), TransparencyMode::BLACK);
 
     glm::mat4 mat = glm::mat4(1.0f);
     mat[0][0] = zoom;
@@ -3246,7 +3223,6 @@ void CParticle::DrawParticleCylinder(int i)
     mat[3][1] = m_particle[i].pos.y;
     mat[3][2] = m_particle[i].pos.z;
 
-    m_renderer->SetModelMatrix(mat);
 
     glm::vec2 ts, ti;
     ts.x = m_particle[i].texSup.x;
@@ -3310,11 +3286,9 @@ void CParticle::DrawParticleCylinder(int i)
         }
     }
 
-    m_renderer->DrawParticle(PrimitiveType::TRIANGLE_STRIP, j, vertex.data());
+    m_batch.Add(PrimitiveType::TRIANGLE_STRIP, j, vertex.data(), mat, IntensityToColor(m_particle[i].intensity));
     m_engine->AddStatisticTriangle(j);
 
-    m_renderer->SetColor(IntensityToColor(m_particle[i].intensity));
-    m_renderer->SetTransparency(TransparencyMode::BLACK);
 }
 
 void CParticle::DrawParticleText(int i)
@@ -3322,9 +3296,7 @@ void CParticle::DrawParticleText(int i)
     CharTexture tex = m_engine->GetText()->GetCharTexture(static_cast<UTF8Char>(m_particle[i].text), FONT_STUDIO, FONT_SIZE_BIG*2.0f);
     if (tex.id == 0) return;
 
-    m_renderer->SetTexture({ tex.id });
-    m_renderer->SetColor(IntensityToColor(m_particle[i].intensity));
-    m_renderer->SetTransparency(TransparencyMode::ALPHA);
+    m_batch.SetLook({ tex.id }, TransparencyMode::ALPHA);
 
     glm::ivec2 fontTextureSize = m_engine->GetText()->GetFontTextureSize();
     m_particle[i].texSup.x = static_cast<float>(tex.charPos.x) / fontTextureSize.x;
@@ -3336,71 +3308,11 @@ void CParticle::DrawParticleText(int i)
     DrawParticleNorm(i);
 }
 
-void CParticle::DrawParticleWheel(int i)
-{
-    float dist = Math::DistanceProjected(m_engine->GetEyePt(), m_wheelTrace[i].pos[0]);
-    if (dist > 300.0f)  return;
-
-    glm::u8vec4 white(255);
-
-    if (m_wheelTrace[i].color == TraceColor::BlackArrow || m_wheelTrace[i].color == TraceColor::RedArrow)
-    {
-        auto texture = m_engine->LoadTexture("textures/effect03.png");
-        m_renderer->SetTexture(texture);
-        m_renderer->SetTransparency(TransparencyMode::ALPHA);
-        m_renderer->SetColor({ 1.0f, 1.0f, 1.0f, 1.0f });
-
-        glm::vec3 pos[4];
-        pos[0] = m_wheelTrace[i].pos[0];
-        pos[1] = m_wheelTrace[i].pos[1];
-        pos[2] = m_wheelTrace[i].pos[2];
-        pos[3] = m_wheelTrace[i].pos[3];
-
-        glm::vec3 n(0.0f, 1.0f, 0.0f);
-
-        glm::vec2 ts(160.0f/256.0f, 224.0f/256.0f);
-        glm::vec2 ti(ts.x+16.0f/256.0f, ts.y+16.0f/256.0f);
-
-        float dp = (1.0f/256.0f)/2.0f;
-        ts.x = ts.x+dp;
-        ts.y = ts.y+dp;
-        ti.x = ti.x-dp;
-        ti.y = ti.y-dp;
-
-        auto color = ColorToIntColor(TraceColorColor(m_wheelTrace[i].color));
-
-        VertexParticle vertex[4];
-        vertex[0] = { pos[0], color, { ts.x, ts.y } };
-        vertex[1] = { pos[1], color, { ti.x, ts.y } };
-        vertex[2] = { pos[2], color, { ts.x, ti.y } };
-        vertex[3] = { pos[3], color, { ti.x, ti.y } };
-
-        m_renderer->DrawParticle(PrimitiveType::TRIANGLE_STRIP, 4, vertex);
-        m_engine->AddStatisticTriangle(2);
-    }
-    else
-    {
-        glm::vec3 pos[4];
-        pos[0] = m_wheelTrace[i].pos[0];
-        pos[1] = m_wheelTrace[i].pos[1];
-        pos[2] = m_wheelTrace[i].pos[2];
-        pos[3] = m_wheelTrace[i].pos[3];
-
-        auto color = ColorToIntColor(TraceColorColor(m_wheelTrace[i].color));
-
-        VertexParticle vertex[4];
-        vertex[0] = { pos[0], color };
-        vertex[1] = { pos[1], color };
-        vertex[2] = { pos[2], color };
-        vertex[3] = { pos[3], color };
-
-        m_renderer->DrawParticle(PrimitiveType::TRIANGLE_STRIP, 4, vertex);
-        m_engine->AddStatisticTriangle(2);
-    }
-}
-
 void CParticle::DrawParticle(int sheet)
 {
+    // Particles of the same look are drawn together, see CParticleBatch
+    m_batch.Begin(sheet != SH_INTERFACE);
+
     // Draw the basic particles of triangles.
     if (m_totalInterface[0][sheet] > 0)
     {
@@ -3414,22 +3326,19 @@ void CParticle::DrawParticle(int sheet)
                 ? "textures/" + m_triangle[i].material.albedoTexture
                 : "");
 
-            m_renderer->SetTexture(texture);
+            // fragments of objects are opaque
+            m_batch.SetLook(texture, TransparencyMode::NONE);
             //m_engine->SetState(m_triangle[i].state);
             DrawParticleTriangle(i);
         }
     }
 
     // Draw tire marks.
-    if (m_wheelTraceTotal > 0 && sheet == SH_WORLD)
+    if (m_wheelTraces.GetCount() > 0 && sheet == SH_WORLD)
     {
-        glm::mat4 matrix = glm::mat4(1.0f);
-        m_renderer->SetModelMatrix(matrix);
-        m_renderer->SetTransparency(TransparencyMode::NONE);
-        m_renderer->SetColor({ 1.0f, 1.0f, 1.0f, 1.0f });
-
-        for (int i = 0; i < m_wheelTraceTotal; i++)
-            DrawParticleWheel(i);
+        auto texture = m_engine->LoadTexture("textures/effect03.png");
+        int triangles = m_wheelTraces.Draw(m_batch, texture, m_engine->GetEyePt(), 300.0f);
+        m_engine->AddStatisticTriangle(triangles);
     }
 
     for (int t = MAXPARTITYPE-1; t >= 1; t--)  // black behind!
@@ -3437,6 +3346,7 @@ void CParticle::DrawParticle(int sheet)
         if (m_totalInterface[t][sheet] == 0)  continue;
 
         bool loadTexture = false;
+        Texture texture;
 
         TransparencyMode mode = TransparencyMode::ALPHA;
 
@@ -3445,9 +3355,6 @@ void CParticle::DrawParticle(int sheet)
         else
             mode = TransparencyMode::BLACK;
 
-        m_renderer->SetTransparency(mode);
-        m_renderer->SetColor({ 1.0f, 1.0f, 1.0f, 1.0f });
-
         for (int j = 0; j < MAXPARTICULE; j++)
         {
             int i = MAXPARTICULE*t+j;
@@ -3458,24 +3365,21 @@ void CParticle::DrawParticle(int sheet)
             {
                 std::string name;
                 NameParticle(name, t);
-                auto texture = m_engine->LoadTexture("textures/" + name);
-                m_renderer->SetTexture(texture);
+                texture = m_engine->LoadTexture("textures/" + name);
                 loadTexture = true;
             }
 
+            // without a texture of its own, the particle keeps the last one (e.g. of a text particle)
+            m_batch.SetLook(loadTexture ? texture : m_batch.GetTexture(), mode);
+
             int r = m_particle[i].trackRank;
             if (r != -1)
             {
-                m_renderer->SetTransparency(mode);
-                m_renderer->SetColor({ 1.0f, 1.0f, 1.0f, 1.0f });
                 //m_engine->SetState(state);
                 TrackDraw(r, m_particle[i].type);  // draws the drag
                 if (!m_track[r].drawParticle)  continue;
             }
 
-            m_renderer->SetTransparency(mode);
-            m_renderer->SetColor(IntensityToColor(m_particle[i].intensity));
-
             if (m_particle[i].ray)  // ray?
             {
                 DrawParticleRay(i);
@@ -3511,6 +3415,8 @@ void CParticle::DrawParticle(int sheet)
             }
         }
     }
+
+    m_batch.End();
 }
 
 CObject* CParticle::SearchObjectGun(glm::vec3 old, glm::vec3 pos,
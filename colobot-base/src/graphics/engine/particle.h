@@ -26,6 +26,9 @@
 
 #include "graphics/core/color.h"
 
+#include "graphics/engine/particle_batch.h"
+#include "graphics/engine/wheel_trace.h"
+
 #include "object/interface/trace_drawing_object.h"
 
 #include "sound/sound_type.h"
@@ -54,7 +57,6 @@ const short MAXPARTITYPE = 6;
 const short MAXTRACK = 100;
 const short MAXTRACKLEN = 10;
 const short MAXPARTIFOG = 100;
-const short MAXWHEELTRACE = 1000;
 
 const short SH_WORLD = 0;       // particle in the world in the interface
 const short SH_FRONT = 1;       // particle in the world on the interface
@@ -215,12 +217,6 @@ struct Track
     float           len[MAXTRACKLEN] = {};
 };
 
-struct WheelTrace
-{
-    TraceColor      color = TraceColor::Black;
-    glm::vec3    pos[4];
-};
-
 
 /**
  * \class CParticle
@@ -271,6 +267,9 @@ public:
                                  const glm::vec3 &p4, TraceColor color);
 
     //! Removes all particles of a given type
+    //! Returns the traces drawn on the ground
+    CWheelTraces& GetWheelTraces();
+
     void        DeleteParticle(ParticleType type);
     //! Removes all particles of a given channel
     void        DeleteParticle(int channel);
@@ -327,8 +326,6 @@ protected:
     void        DrawParticleCylinder(int i);
     //! Draws a text particle
     void        DrawParticleText(int i);
-    //! Draws a tire mark
-    void        DrawParticleWheel(int i);
     //! Seeks if an object collided with a bullet
     CObject*    SearchObjectGun(glm::vec3 old, glm::vec3 pos, ParticleType type, CObject *father);
     //! Seeks if an object collided with a ray
@@ -348,13 +345,13 @@ protected:
     CRobotMain*       m_main = nullptr;
     CSoundInterface*  m_sound = nullptr;
     CParticleRenderer* m_renderer = nullptr;
+    //! Collects particles of the same look drawn by DrawParticle()
+    CParticleBatch m_batch;
 
     Particle       m_particle[MAXPARTICULE*MAXPARTITYPE];
     std::vector<EngineTriangle> m_triangle;  // triangle if PartiType == 0
     Track          m_track[MAXTRACK];
-    int           m_wheelTraceTotal = 0;
-    int           m_wheelTraceIndex = 0;
-    WheelTrace    m_wheelTrace[MAXWHEELTRACE];
+    CWheelTraces  m_wheelTraces;
     int           m_totalInterface[MAXPARTITYPE][SH_MAX] = {};
     bool          m_frameUpdate[SH_MAX] = {};
     int           m_fogTotal = 0;
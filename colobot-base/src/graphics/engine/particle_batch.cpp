@@ -0,0 +1,174 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/particle_batch.h"
+
+#include "graphics/core/renderers.h"
+
+#include <algorithm>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+CParticleBatch::CParticleBatch(CParticleRenderer* renderer)
+    : m_renderer(renderer)
+{
+}
+
+void CParticleBatch::SetRenderer(CParticleRenderer* renderer)
+{
+    m_renderer = renderer;
+}
+
+void CParticleBatch::Begin(bool worldSpace)
+{
+    m_vertices.clear();
+    m_texture = Texture{};
+    m_transparency = TransparencyMode::NONE;
+    m_worldSpace = worldSpace;
+}
+
+void CParticleBatch::End()
+{
+    Flush();
+}
+
+void CParticleBatch::SetLook(const Texture& texture, TransparencyMode mode)
+{
+    if (texture.id == m_texture.id && mode == m_transparency)
+        return;
+
+    Flush();
+
+    m_texture = texture;
+    m_transparency = mode;
+}
+
+const Texture& CParticleBatch::GetTexture() const
+{
+    return m_texture;
+}
+
+void CParticleBatch::Add(PrimitiveType type, int count, const VertexParticle* vertices, const Color& color)
+{
+    AddTriangles(type, count, vertices, color, [](const glm::vec3& position)
+    {
+        return position;
+    });
+}
+
+void CParticleBatch::Add(PrimitiveType type, int count, const VertexParticle* vertices,
+                         const glm::mat4& matrix, const Color& color)
+{
+    AddTriangles(type, count, vertices, color, [&matrix](const glm::vec3& position)
+    {
+        return glm::vec3(matrix * glm::vec4(position, 1.0f));
+    });
+}
+
+void CParticleBatch::AddTriangleList(int count, const VertexParticle* vertices)
+{
+    count -= count % 3;
+
+    while (count > 0)
+    {
+        int added = std::min(count, MAX_VERTICES - static_cast<int>(m_vertices.size()));
+        added -= added % 3;
+        if (added == 0)
+        {
+            // Batch full
+            Flush();
+            continue;
+        }
+
+        m_vertices.insert(m_vertices.end(), vertices, vertices + added);
+        vertices += added;
+        count -= added;
+    }
+}
+
+template<typename Transform>
+void CParticleBatch::AddTriangles(PrimitiveType type, int count, const VertexParticle* vertices,
+                                  const Color& color, Transform transform)
+{
+    if (count < 3) return;
+
+    int added = (type == PrimitiveType::TRIANGLE_STRIP) ? (count - 2) * 3 : count - count % 3;
+    if (static_cast<int>(m_vertices.size()) + added > MAX_VERTICES)
+        Flush();
+
+    bool white = color == Color(1.0f, 1.0f, 1.0f, 1.0f);
+
+    auto add = [&](const VertexParticle& vertex)
+    {
+        VertexParticle result = vertex;
+        result.position = transform(vertex.position);
+        if (!white)
+            result.color = glm::u8vec4(glm::vec4(vertex.color) * static_cast<const glm::vec4&>(color) + 0.5f);
+        m_vertices.push_back(result);
+    };
+
+    if (type == PrimitiveType::TRIANGLE_STRIP)
+    {
+        // Every other triangle of a strip has reversed order, keep the winding of the strip
+        for (int i = 2; i < count; i++)
+        {
+            if (i % 2 == 0)
+            {
+                add(vertices[i-2]);
+                add(vertices[i-1]);
+            }
+            else
+            {
+                add(vertices[i-1]);
+                add(vertices[i-2]);
+            }
+            add(vertices[i]);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < added; i++)
+            add(vertices[i]);
+    }
+}
+
+void CParticleBatch::Flush()
+{
+    if (m_vertices.empty()) return;
+
+    m_renderer->SetTexture(m_texture);
+    m_renderer->SetTransparency(m_transparency);
+    m_renderer->SetColor({ 1.0f, 1.0f, 1.0f, 1.0f });
+    if (m_worldSpace)
+        m_renderer->SetModelMatrix(glm::mat4(1.0f));
+
+    m_renderer->DrawParticle(PrimitiveType::TRIANGLES, static_cast<int>(m_vertices.size()), m_vertices.data());
+
+    m_vertices.clear();
+}
+
+int CParticleBatch::GetVertexCount() const
+{
+    return static_cast<int>(m_vertices.size());
+}
+
+} // namespace Gfx
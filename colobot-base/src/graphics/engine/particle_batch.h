@@ -0,0 +1,109 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file graphics/engine/particle_batch.h
+ * \brief Batching of particles - CParticleBatch class
+ */
+
+#pragma once
+
+#include "graphics/core/color.h"
+#include "graphics/core/texture.h"
+#include "graphics/core/transparency.h"
+#include "graphics/core/vertex.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+class CParticleRenderer;
+enum class PrimitiveType : unsigned char;
+
+/**
+ * \class CParticleBatch
+ * \brief Collects particles of the same look and draws them with one call
+ *
+ * The look of a particle is its texture and transparency mode.
+ * The transformation and the color of every particle are applied
+ * to its vertices on the CPU, so that particles with different
+ * positions and intensities still end up in the same draw call.
+ * The number of draw calls and state changes thus depends on the number
+ * of distinct looks drawn one after the other, not on the number of particles.
+ */
+class CParticleBatch
+{
+public:
+    //! Maximum number of vertices drawn with one call
+    static constexpr int MAX_VERTICES = 12 * 1024;
+
+    explicit CParticleBatch(CParticleRenderer* renderer = nullptr);
+
+    //! Sets the renderer to draw with
+    void SetRenderer(CParticleRenderer* renderer);
+
+    /**
+     * \brief Starts drawing a new set of particles
+     * \param worldSpace whether the vertices are in world coordinates,
+     *        in which case the model matrix is reset when drawing;
+     *        otherwise the model matrix set by the caller is kept
+     */
+    void Begin(bool worldSpace);
+    //! Draws what remains in the batch
+    void End();
+
+    //! Sets the look of the following particles, draws the batch if the look changes
+    void SetLook(const Texture& texture, TransparencyMode mode);
+    //! Returns the texture of the current look
+    const Texture& GetTexture() const;
+
+    //! Adds triangles in final coordinates, tinted by the given color
+    void Add(PrimitiveType type, int count, const VertexParticle* vertices, const Color& color);
+    //! Adds triangles transformed by the given matrix, tinted by the given color
+    void Add(PrimitiveType type, int count, const VertexParticle* vertices, const glm::mat4& matrix, const Color& color);
+
+    //! Adds a list of triangles already in final coordinates and colors
+    void AddTriangleList(int count, const VertexParticle* vertices);
+
+    //! Draws the collected particles
+    void Flush();
+
+    //! Returns the number of vertices waiting to be drawn
+    int GetVertexCount() const;
+
+private:
+    //! Adds the vertices as a list of triangles
+    template<typename Transform>
+    void AddTriangles(PrimitiveType type, int count, const VertexParticle* vertices,
+                      const Color& color, Transform transform);
+
+private:
+    CParticleRenderer* m_renderer = nullptr;
+    std::vector<VertexParticle> m_vertices;
+    Texture m_texture;
+    TransparencyMode m_transparency = TransparencyMode::NONE;
+    bool m_worldSpace = true;
+};
+
+} // namespace Gfx
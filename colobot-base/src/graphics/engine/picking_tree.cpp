@@ -0,0 +1,246 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/picking_tree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+namespace
+{
+
+//! Deepest tree built from int item counts, with leaves split at the median
+constexpr int MAX_DEPTH = 64;
+
+//! Grows the box a little, so that rounding never misses what the exact triangle test finds
+PickingBox Enlarged(const PickingBox& box)
+{
+    glm::vec3 size = glm::max(glm::abs(box.min), glm::abs(box.max));
+    glm::vec3 margin = size * 1e-4f + 1e-4f;
+    return { box.min - margin, box.max + margin };
+}
+
+void Merge(PickingBox& box, const PickingBox& other)
+{
+    box.min = glm::min(box.min, other.min);
+    box.max = glm::max(box.max, other.max);
+}
+
+bool Crosses(const PickingBox& box, const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& inverse)
+{
+    float tMin = 0.0f;
+    float tMax = std::numeric_limits<float>::infinity();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if (direction[i] == 0.0f)
+        {
+            if (origin[i] < box.min[i] || origin[i] > box.max[i])
+                return false;
+            continue;
+        }
+
+        float t1 = (box.min[i] - origin[i]) * inverse[i];
+        float t2 = (box.max[i] - origin[i]) * inverse[i];
+        if (t1 > t2) std::swap(t1, t2);
+
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax)
+            return false;
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+void CPickingTree::Build(const std::vector<PickingBox>& boxes)
+{
+    Clear();
+
+    if (boxes.empty()) return;
+
+    std::vector<PickingBox> enlarged;
+    std::vector<glm::vec3> centers;
+    enlarged.reserve(boxes.size());
+    centers.reserve(boxes.size());
+    for (const auto& box : boxes)
+    {
+        enlarged.push_back(Enlarged(box));
+        centers.push_back((box.min + box.max) * 0.5f);
+    }
+
+    m_items.resize(boxes.size());
+    for (int i = 0; i < static_cast<int>(m_items.size()); ++i)
+        m_items[i] = i;
+
+    m_itemLeaves.resize(boxes.size());
+    m_nodes.reserve(2 * boxes.size() / LEAF_SIZE + 1);
+    BuildNode(enlarged, centers, 0, static_cast<int>(m_items.size()), -1);
+
+    m_itemBoxes.reserve(m_items.size());
+    m_itemPositions.resize(m_items.size());
+    for (int i = 0; i < static_cast<int>(m_items.size()); ++i)
+    {
+        m_itemBoxes.push_back(enlarged[m_items[i]]);
+        m_itemPositions[m_items[i]] = i;
+    }
+
+    m_boxes = boxes;
+}
+
+void CPickingTree::Update(int item, const PickingBox& box)
+{
+    m_boxes[item] = box;
+
+    if (++m_updates > static_cast<int>(m_boxes.size()))
+    {
+        std::vector<PickingBox> boxes = std::move(m_boxes);
+        Build(boxes);
+        return;
+    }
+
+    int position = m_itemPositions[item];
+    m_itemBoxes[position] = Enlarged(box);
+
+    // Boxes of the branch are recomputed from the leaf up, they may grow or shrink
+    for (int index = m_itemLeaves[position]; index != -1; index = m_nodes[index].parent)
+    {
+        Node& node = m_nodes[index];
+        if (node.count > 0)
+        {
+            node.box = m_itemBoxes[node.first];
+            for (int i = node.first + 1; i < node.first + node.count; ++i)
+                Merge(node.box, m_itemBoxes[i]);
+        }
+        else
+        {
+            node.box = m_nodes[index + 1].box;
+            Merge(node.box, m_nodes[node.first].box);
+        }
+    }
+}
+
+int CPickingTree::BuildNode(const std::vector<PickingBox>& boxes, const std::vector<glm::vec3>& centers, int first, int last, int parent)
+{
+    int index = static_cast<int>(m_nodes.size());
+    m_nodes.emplace_back();
+    m_nodes[index].parent = parent;
+
+    PickingBox box = boxes[m_items[first]];
+    PickingBox centerBox{ centers[m_items[first]], centers[m_items[first]] };
+    for (int i = first + 1; i < last; ++i)
+    {
+        Merge(box, boxes[m_items[i]]);
+        centerBox.min = glm::min(centerBox.min, centers[m_items[i]]);
+        centerBox.max = glm::max(centerBox.max, centers[m_items[i]]);
+    }
+    m_nodes[index].box = box;
+
+    if (last - first <= LEAF_SIZE)
+    {
+        m_nodes[index].first = first;
+        m_nodes[index].count = last - first;
+        for (int i = first; i < last; ++i)
+            m_itemLeaves[i] = index;
+        return index;
+    }
+
+    // Split at the median of the longest axis of the centers
+    glm::vec3 extent = centerBox.max - centerBox.min;
+    int axis = 0;
+    if (extent.y > extent[axis]) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+
+    int middle = first + (last - first) / 2;
+    std::nth_element(m_items.begin() + first, m_items.begin() + middle, m_items.begin() + last,
+        [&centers, axis](int a, int b) { return centers[a][axis] < centers[b][axis]; });
+
+    BuildNode(boxes, centers, first, middle, index);
+    int second = BuildNode(boxes, centers, middle, last, index);
+    m_nodes[index].first = second;
+    m_nodes[index].count = 0;
+    return index;
+}
+
+void CPickingTree::Clear()
+{
+    m_nodes.clear();
+    m_items.clear();
+    m_itemBoxes.clear();
+    m_itemLeaves.clear();
+    m_itemPositions.clear();
+    m_boxes.clear();
+    m_updates = 0;
+}
+
+bool CPickingTree::IsEmpty() const
+{
+    return m_nodes.empty();
+}
+
+PickingBox CPickingTree::GetBounds() const
+{
+    if (m_nodes.empty()) return {};
+    return m_nodes.front().box;
+}
+
+void CPickingTree::FindCrossed(const glm::vec3& origin, const glm::vec3& direction, std::vector<int>& items) const
+{
+    if (m_nodes.empty()) return;
+
+    glm::vec3 inverse;
+    for (int i = 0; i < 3; ++i)
+        inverse[i] = direction[i] != 0.0f ? 1.0f / direction[i] : 0.0f;
+
+    int stack[MAX_DEPTH];
+    int size = 0;
+    stack[size++] = 0;
+
+    while (size > 0)
+    {
+        const Node& node = m_nodes[stack[--size]];
+        if (!Crosses(node.box, origin, direction, inverse))
+            continue;
+
+        if (node.count > 0)
+        {
+            for (int i = node.first; i < node.first + node.count; ++i)
+            {
+                if (Crosses(m_itemBoxes[i], origin, direction, inverse))
+                    items.push_back(m_items[i]);
+            }
+        }
+        else
+        {
+            int self = static_cast<int>(&node - m_nodes.data());
+            stack[size++] = node.first;
+            stack[size++] = self + 1;
+        }
+    }
+}
+
+} // namespace Gfx
@@ -0,0 +1,116 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file graphics/engine/picking_tree.h
+ * \brief Bounding volume hierarchy for mouse picking - CPickingTree class
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+/**
+ * \struct PickingBox
+ * \brief Axis aligned box of an item put in CPickingTree
+ */
+struct PickingBox
+{
+    glm::vec3 min{ 0.0f, 0.0f, 0.0f };
+    glm::vec3 max{ 0.0f, 0.0f, 0.0f };
+};
+
+/**
+ * \class CPickingTree
+ * \brief Bounding volume hierarchy of boxes, searched with rays
+ *
+ * Items are given by their boxes and referred to by their index.
+ * A search only visits the branches of the tree crossed by the ray,
+ * so finding what lies under the mouse takes time proportional
+ * to the logarithm of the number of items rather than to that number.
+ *
+ * Moved items are handled by Update(), which only enlarges or shrinks the boxes
+ * of the branch holding the item. The tree is rebuilt once there have been as
+ * many updates as items, as refitted branches get looser and slower to search.
+ */
+class CPickingTree
+{
+public:
+    //! Maximum number of items in a leaf
+    static constexpr int LEAF_SIZE = 4;
+
+    //! Builds the tree of the given boxes, item i having the box boxes[i]
+    void Build(const std::vector<PickingBox>& boxes);
+    //! Changes the box of an item, refitting the boxes of its branch
+    void Update(int item, const PickingBox& box);
+    //! Removes all items
+    void Clear();
+
+    //! Returns true if the tree has no items
+    bool IsEmpty() const;
+    //! Returns the bounding box of all items
+    PickingBox GetBounds() const;
+
+    /**
+     * \brief Finds the items whose boxes are crossed by a ray
+     * \param origin start of the ray
+     * \param direction direction of the ray, need not be normalized
+     * \param items receives the indexes of the items, in no particular order
+     */
+    void FindCrossed(const glm::vec3& origin, const glm::vec3& direction, std::vector<int>& items) const;
+
+private:
+    //! Builds the node of items m_items[first, last) and returns its index
+    int BuildNode(const std::vector<PickingBox>& boxes, const std::vector<glm::vec3>& centers, int first, int last, int parent);
+
+private:
+    struct Node
+    {
+        PickingBox box;
+        //! Leaf: index of the first item, inner node: index of the second child (the first one follows the node)
+        int first = 0;
+        //! Number of items of a leaf, 0 for inner nodes
+        int count = 0;
+        //! Index of the parent node, -1 for the root
+        int parent = -1;
+    };
+
+    std::vector<Node> m_nodes;
+    //! Item indexes, in the order of the leaves
+    std::vector<int> m_items;
+    //! Boxes of the items, in the same order
+    std::vector<PickingBox> m_itemBoxes;
+    //! Leaf node holding every entry of m_items
+    std::vector<int> m_itemLeaves;
+    //! Position of every item in m_items
+    std::vector<int> m_itemPositions;
+    //! Boxes of the items as given, by item index, to rebuild the tree
+    std::vector<PickingBox> m_boxes;
+    //! Number of Update() calls since the tree was built
+    int m_updates = 0;
+};
+
+} // namespace Gfx
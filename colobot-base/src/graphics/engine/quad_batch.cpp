@@ -0,0 +1,88 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/quad_batch.h"
+
+#include "graphics/core/renderers.h"
+
+#include <algorithm>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+CQuadBatch::CQuadBatch(CUIRenderer* renderer)
+    : m_renderer(renderer)
+{
+    m_quads.reserve(1024);
+}
+
+void CQuadBatch::SetRenderer(CUIRenderer* renderer)
+{
+    m_renderer = renderer;
+}
+
+void CQuadBatch::Add(const Vertex2D vertices[4], const Texture& texture, TransparencyMode mode)
+{
+    if (texture.id != m_texture.id || mode != m_transparency)
+    {
+        Flush();
+        m_texture = texture;
+        m_transparency = mode;
+    }
+
+    m_quads.emplace_back(Quad{{ vertices[0], vertices[1], vertices[2], vertices[3] }});
+}
+
+int CQuadBatch::Flush()
+{
+    if (m_quads.empty()) return 0;
+
+    m_renderer->SetTexture(m_texture);
+    m_renderer->SetTransparency(m_transparency);
+
+    if (m_counts.size() < m_quads.size())
+    {
+        m_counts.resize(m_quads.size(), 4);
+    }
+
+    auto vertices = m_renderer->BeginPrimitives(PrimitiveType::TRIANGLE_STRIP, m_quads.size(), m_counts.data());
+
+    size_t offset = 0;
+
+    for (const auto& quad : m_quads)
+    {
+        std::copy_n(quad.vertices, 4, vertices + offset);
+        offset += 4;
+    }
+
+    m_renderer->EndPrimitive();
+
+    int triangles = static_cast<int>(m_quads.size() * 2);
+    m_quads.clear();
+    return triangles;
+}
+
+int CQuadBatch::GetQuadCount() const
+{
+    return static_cast<int>(m_quads.size());
+}
+
+} // namespace Gfx
@@ -0,0 +1,76 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file graphics/engine/quad_batch.h
+ * \brief Batching of interface quads - CQuadBatch class
+ */
+
+#pragma once
+
+#include "graphics/core/texture.h"
+#include "graphics/core/transparency.h"
+#include "graphics/core/vertex.h"
+
+#include <vector>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+class CUIRenderer;
+
+/**
+ * \class CQuadBatch
+ * \brief Collects textured interface quads and draws them with one call
+ *
+ * Quads are grouped by texture and transparency mode only. Their color
+ * is taken from the vertices, so runs of differently colored quads,
+ * like syntax highlighted text, still end up in the same draw call
+ * and the same vertex upload.
+ */
+class CQuadBatch
+{
+public:
+    explicit CQuadBatch(CUIRenderer* renderer = nullptr);
+
+    //! Sets the renderer to draw with
+    void SetRenderer(CUIRenderer* renderer);
+
+    //! Adds a quad given as a triangle strip, draws the batch first if the texture or transparency change
+    void Add(const Vertex2D vertices[4], const Texture& texture, TransparencyMode mode);
+
+    //! Draws the collected quads and returns the number of triangles drawn
+    int Flush();
+
+    //! Returns the number of quads waiting to be drawn
+    int GetQuadCount() const;
+
+private:
+    struct Quad { Vertex2D vertices[4]; };
+
+    CUIRenderer* m_renderer = nullptr;
+    std::vector<Quad> m_quads;
+    std::vector<int> m_counts;
+    Texture m_texture;
+    TransparencyMode m_transparency = TransparencyMode::NONE;
+};
+
+} // namespace Gfx
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/shadow_cache.h"
+
+#include <cstring>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+namespace
+{
+
+constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr std::uint64_t FNV_PRIME = 1099511628211ull;
+
+//! Adds 32-bit words to a FNV-1a hash, a word at a time instead of a byte at a time
+std::uint64_t Hash(std::uint64_t hash, const void* data, std::size_t words)
+{
+    auto bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < words; ++i)
+    {
+        std::uint32_t word;
+        std::memcpy(&word, bytes + i * sizeof(word), sizeof(word));
+        hash = (hash ^ word) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+} // anonymous namespace
+
+void CShadowRegionCache::Invalidate()
+{
+    m_valid = false;
+}
+
+void CShadowRegionCache::Begin(const glm::mat4& matrix)
+{
+    m_matrix = matrix;
+    m_static = FNV_OFFSET;
+    m_moving = FNV_OFFSET;
+}
+
+void CShadowRegionCache::AddCaster(bool isStatic, int objRank, int geometry, const glm::mat4& transform)
+{
+    std::uint64_t& hash = isStatic ? m_static : m_moving;
+
+    hash = Hash(hash, &objRank, 1);
+    hash = Hash(hash, &geometry, 1);
+    for (int i = 0; i < 4; ++i)
+        hash = Hash(hash, &transform[i][0], 4);
+}
+
+CShadowRegionCache::Update CShadowRegionCache::End()
+{
+    Update update = Update::NOTHING;
+
+    if (!m_valid || m_matrix != m_drawnMatrix || m_static != m_drawnStatic)
+        update = Update::ALL;
+    else if (m_moving != m_drawnMoving)
+        update = Update::MOVING;
+
+    m_valid = true;
+    m_drawnMatrix = m_matrix;
+    m_drawnStatic = m_static;
+    m_drawnMoving = m_moving;
+
+    return update;
+}
+
+} // namespace Gfx
@@ -0,0 +1,86 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file graphics/engine/shadow_cache.h
+ * \brief Content of shadow map regions - CShadowRegionCache class
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+/**
+ * \class CShadowRegionCache
+ * \brief Remembers what was drawn into one region of the shadow map
+ *
+ * Shadow casters are split into static ones, which have not moved for a while,
+ * and moving ones. Static casters are drawn into a separate shadow map
+ * and copied into the region before moving casters are drawn over them.
+ * Casters of every frame are compared with those of the previous one,
+ * so that a region is only drawn again when what it shows changed,
+ * and static casters only when one of them or the region itself changed.
+ */
+class CShadowRegionCache
+{
+public:
+    //! What must be drawn again in the region
+    enum class Update
+    {
+        //! The region is unchanged
+        NOTHING,
+        //! Static casters are unchanged, moving ones must be drawn over a copy of them
+        MOVING,
+        //! Static casters must be drawn again, then moving ones
+        ALL
+    };
+
+    //! Forgets the content of the region, so that the next frame draws it all
+    void Invalidate();
+
+    //! Starts a frame of the region, drawn with the given projection and view matrix
+    void Begin(const glm::mat4& matrix);
+    //! Adds a caster drawn in the region; geometry identifies what is drawn (base object and level of detail)
+    void AddCaster(bool isStatic, int objRank, int geometry, const glm::mat4& transform);
+    //! Ends the frame and returns what must be drawn
+    Update End();
+
+private:
+    //! Projection and view matrix of the region
+    glm::mat4 m_matrix = glm::mat4(1.0f);
+    //! Hashes of the static and moving casters of the frame
+    std::uint64_t m_static = 0;
+    std::uint64_t m_moving = 0;
+
+    //! If false, the region must be drawn in full
+    bool m_valid = false;
+    //! Content drawn in the previous frame
+    glm::mat4 m_drawnMatrix = glm::mat4(1.0f);
+    std::uint64_t m_drawnStatic = 0;
+    std::uint64_t m_drawnMoving = 0;
+};
+
+} // namespace Gfx
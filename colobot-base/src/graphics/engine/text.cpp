@@ -34,6 +34,7 @@
 #include "graphics/core/transparency.h"
 
 #include "graphics/engine/engine.h"
+#include "graphics/engine/quad_batch.h"
 
 #include "math/func.h"
 
@@ -147,77 +148,6 @@ Gfx::FontType ToItalicFontType(Gfx::FontType type)
 }
 } // anonymous namespace
 
-/// The QuadBatch is responsible for collecting as many quad (aka rectangle) draws as possible and
-/// sending them to the CDevice in one big batch. This avoids making one CDevice::DrawPrimitive call
-/// for every CText::DrawCharAndAdjustPos call, which makes text rendering much faster.
-/// Currently we only collect textured quads (ie. ones using Vertex), not untextured quads (which
-/// use VertexCol). Untextured quads are only drawn via DrawHighlight, which happens much less often
-/// than drawing textured quads.
-class CText::CQuadBatch
-{
-public:
-    explicit CQuadBatch(CEngine& engine)
-        : m_engine(engine)
-    {
-        m_quads.reserve(1024);
-    }
-
-    /// Add a quad to be rendered.
-    /// This may trigger a call to Flush() if necessary.
-    void Add(Vertex2D vertices[4], unsigned int texID, TransparencyMode transparency, Color color)
-    {
-        if (texID != m_texID || transparency != m_transparency || color != m_color)
-        {
-            Flush();
-            m_texID = texID;
-            m_transparency = transparency;
-            m_color = color;
-        }
-        m_quads.emplace_back(Quad{{vertices[0], vertices[1], vertices[2], vertices[3]}});
-    }
-
-    /// Draw all pending quads immediately.
-    void Flush()
-    {
-        if (m_quads.empty()) return;
-
-        auto renderer = m_engine.GetUIRenderer();
-        renderer->SetTexture(Texture{ m_texID });
-        renderer->SetTransparency(m_transparency);
-        renderer->SetColor(m_color);
-
-        if (m_counts.size() < m_quads.size())
-        {
-            m_counts.resize(m_quads.size(), 4);
-        }
-
-        auto vertices = renderer->BeginPrimitives(PrimitiveType::TRIANGLE_STRIP, m_quads.size(), m_counts.data());
-
-        size_t offset = 0;
-
-        for (const auto& quad : m_quads)
-        {
-            std::copy_n(quad.vertices, 4, vertices + offset);
-            offset += 4;
-        }
-
-        renderer->EndPrimitive();
-
-        m_engine.AddStatisticTriangle(static_cast<int>(m_quads.size() * 2));
-        m_quads.clear();
-    }
-private:
-    CEngine& m_engine;
-
-    struct Quad { Vertex2D vertices[4]; };
-    std::vector<Quad> m_quads;
-    std::vector<int> m_counts;
-
-    Color m_color;
-    unsigned int m_texID{};
-    TransparencyMode m_transparency = TransparencyMode::NONE;
-};
-
 class FontsCache
 {
 public:
@@ -389,7 +319,7 @@ CText::CText(CEngine* engine)
 
     m_fontsCache = std::make_unique<FontsCache>();
 
-    m_quadBatch = std::make_unique<CQuadBatch>(*engine);
+    m_quadBatch = std::make_unique<CQuadBatch>();
 }
 
 CText::~CText()
@@ -443,6 +373,7 @@ void CText::Destroy()
 void CText::SetDevice(CDevice* device)
 {
     m_device = device;
+    m_quadBatch->SetRenderer(device != nullptr ? device->GetUIRenderer() : nullptr);
 }
 
 std::string CText::GetError()
@@ -1063,7 +994,7 @@ void CText::DrawString(const std::string &text, std::vector<FontMetaChar>::itera
         color = Color(1.0f, 0.0f, 0.0f);
         DrawCharAndAdjustPos(ch, font, size, pos, color);
     }
-    m_quadBatch->Flush();
+    m_engine->AddStatisticTriangle(m_quadBatch->Flush());
     m_engine->SetInterfaceCoordinates();
 }
 
@@ -1149,7 +1080,7 @@ void CText::DrawString(const std::string &text, FontType font,
     {
         DrawCharAndAdjustPos(*it, font, size, pos, color);
     }
-    m_quadBatch->Flush();
+    m_engine->AddStatisticTriangle(m_quadBatch->Flush());
     m_engine->SetInterfaceCoordinates();
 }
 
@@ -1173,7 +1104,7 @@ void CText::DrawHighlight(FontMetaChar hl, const glm::ivec2& pos, const glm::ive
         return;
     }
 
-    m_quadBatch->Flush();
+    m_engine->AddStatisticTriangle(m_quadBatch->Flush());
 
     glm::ivec2 vsize = m_engine->GetWindowSize();
     float h = 0.0f;
@@ -1249,7 +1180,7 @@ void CText::DrawCharAndAdjustPos(UTF8Char ch, FontType font, float size, glm::iv
         vertices[2] = { { p2.x, p2.y }, { uv2.x, uv2.y } };
         vertices[3] = { { p2.x, p1.y }, { uv2.x, uv1.y } };
 
-        m_quadBatch->Add(vertices, texID, TransparencyMode::NONE, color);
+        m_quadBatch->Add(vertices, Texture{ texID }, TransparencyMode::NONE);
 
         pos.x += width;
     }
@@ -1287,7 +1218,7 @@ void CText::DrawCharAndAdjustPos(UTF8Char ch, FontType font, float size, glm::iv
         vertices[2] = { { p2.x, p2.y }, { texCoord2.x, texCoord2.y }, col };
         vertices[3] = { { p2.x, p1.y }, { texCoord2.x, texCoord1.y }, col };
 
-        m_quadBatch->Add(vertices, tex.id, TransparencyMode::ALPHA, color);
+        m_quadBatch->Add(vertices, Texture{ tex.id }, TransparencyMode::ALPHA);
 
         pos.x += tex.charSize.x * width;
     }
@@ -41,6 +41,7 @@ namespace Gfx
 
 class CEngine;
 class CDevice;
+class CQuadBatch;
 
 //! Standard small font size
 const float FONT_SIZE_SMALL = 12.0f;
@@ -350,7 +351,6 @@ protected:
     std::unique_ptr<FontsCache> m_fontsCache;
     std::vector<FontTexture> m_fontTextures;
 
-    class CQuadBatch;
     std::unique_ptr<CQuadBatch> m_quadBatch;
 };
 
@@ -0,0 +1,153 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/wheel_trace.h"
+
+#include "graphics/core/color.h"
+#include "graphics/core/texture.h"
+#include "graphics/core/transparency.h"
+
+#include "graphics/engine/particle_batch.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+void CWheelTraces::Add(const WheelTrace& trace)
+{
+    m_traces.push_back(trace);
+
+    std::pair<int, int> key(static_cast<int>(std::floor(trace.pos[0].x / CHUNK_SIZE)),
+                            static_cast<int>(std::floor(trace.pos[0].z / CHUNK_SIZE)));
+
+    auto it = m_chunks.find(key);
+    bool created = it == m_chunks.end();
+    if (created)
+        it = m_chunks.emplace(key, Chunk{}).first;
+
+    Chunk& chunk = it->second;
+    for (int i = 0; i < 4; i++)
+    {
+        glm::vec2 pos(trace.pos[i].x, trace.pos[i].z);
+        chunk.min = (created && i == 0) ? pos : glm::min(chunk.min, pos);
+        chunk.max = (created && i == 0) ? pos : glm::max(chunk.max, pos);
+    }
+
+    auto color = ColorToIntColor(TraceColorColor(trace.color));
+
+    glm::vec2 ts(0.0f, 0.0f);
+    glm::vec2 ti(0.0f, 0.0f);
+    if (IsArrow(trace.color))
+    {
+        ts = glm::vec2(160.0f/256.0f, 224.0f/256.0f);
+        ti = glm::vec2(ts.x+16.0f/256.0f, ts.y+16.0f/256.0f);
+
+        float dp = (1.0f/256.0f)/2.0f;
+        ts.x = ts.x+dp;
+        ts.y = ts.y+dp;
+        ti.x = ti.x-dp;
+        ti.y = ti.y-dp;
+    }
+
+    VertexParticle vertex[4];
+    vertex[0] = { trace.pos[0], color, { ts.x, ts.y } };  // ul
+    vertex[1] = { trace.pos[1], color, { ti.x, ts.y } };  // dl
+    vertex[2] = { trace.pos[2], color, { ts.x, ti.y } };  // ur
+    vertex[3] = { trace.pos[3], color, { ti.x, ti.y } };  // dr
+
+    // Two triangles with the winding of the strip 0, 1, 2, 3
+    auto& vertices = IsArrow(trace.color) ? chunk.arrows : chunk.plain;
+    for (int i : { 0, 1, 2, 2, 1, 3 })
+        vertices.push_back(vertex[i]);
+}
+
+void CWheelTraces::Clear()
+{
+    m_traces.clear();
+    m_traces.shrink_to_fit();
+    m_chunks.clear();
+}
+
+const std::vector<WheelTrace>& CWheelTraces::GetTraces() const
+{
+    return m_traces;
+}
+
+int CWheelTraces::GetCount() const
+{
+    return static_cast<int>(m_traces.size());
+}
+
+std::size_t CWheelTraces::GetMemoryUsage() const
+{
+    // Map nodes hold the key, the chunk and about three pointers
+    const std::size_t nodeSize = sizeof(std::pair<const std::pair<int, int>, Chunk>) + 3 * sizeof(void*);
+
+    std::size_t size = m_traces.capacity() * sizeof(WheelTrace);
+    for (const auto& [key, chunk] : m_chunks)
+    {
+        size += nodeSize;
+        size += (chunk.plain.capacity() + chunk.arrows.capacity()) * sizeof(VertexParticle);
+    }
+    return size;
+}
+
+int CWheelTraces::Draw(CParticleBatch& batch, const Texture& arrowTexture, const glm::vec3& eye, float distance) const
+{
+    glm::vec2 center(eye.x, eye.z);
+    int triangles = 0;
+
+    auto isVisible = [&](const Chunk& chunk)
+    {
+        glm::vec2 nearest = glm::clamp(center, chunk.min, chunk.max);
+        return glm::distance(center, nearest) <= distance;
+    };
+
+    // Plain traces first, so that arrows only change the look once
+    for (const auto& [key, chunk] : m_chunks)
+    {
+        if (chunk.plain.empty() || !isVisible(chunk)) continue;
+
+        batch.SetLook(Texture{}, TransparencyMode::NONE);
+        batch.AddTriangleList(static_cast<int>(chunk.plain.size()), chunk.plain.data());
+        triangles += static_cast<int>(chunk.plain.size()) / 3;
+    }
+
+    for (const auto& [key, chunk] : m_chunks)
+    {
+        if (chunk.arrows.empty() || !isVisible(chunk)) continue;
+
+        batch.SetLook(arrowTexture, TransparencyMode::ALPHA);
+        batch.AddTriangleList(static_cast<int>(chunk.arrows.size()), chunk.arrows.data());
+        triangles += static_cast<int>(chunk.arrows.size()) / 3;
+    }
+
+    return triangles;
+}
+
+bool CWheelTraces::IsArrow(TraceColor color)
+{
+    return color == TraceColor::BlackArrow || color == TraceColor::RedArrow;
+}
+
+} // namespace Gfx
@@ -0,0 +1,109 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file graphics/engine/wheel_trace.h
+ * \brief Traces left on the ground by robots - CWheelTraces class
+ */
+
+#pragma once
+
+#include "graphics/core/vertex.h"
+
+#include "object/interface/trace_drawing_object.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+class CParticleBatch;
+struct Texture;
+
+/**
+ * \struct WheelTrace
+ * \brief One quad of a trace, with corners just above the ground
+ */
+struct WheelTrace
+{
+    TraceColor      color = TraceColor::Black;
+    glm::vec3    pos[4];
+};
+
+/**
+ * \class CWheelTraces
+ * \brief Keeps all the traces drawn on the ground (pen, tire marks)
+ *
+ * Traces are never dropped. They are grouped by square areas of the ground,
+ * which keep the vertices of their traces ready to be drawn,
+ * so drawing only costs a copy of the areas near the camera.
+ */
+class CWheelTraces
+{
+public:
+    //! Side of the square areas of the ground the traces are grouped by
+    static constexpr float CHUNK_SIZE = 32.0f;
+
+    //! Adds a trace
+    void Add(const WheelTrace& trace);
+    //! Removes all traces
+    void Clear();
+
+    //! Returns all traces in the order they were added
+    const std::vector<WheelTrace>& GetTraces() const;
+    //! Returns the number of traces
+    int GetCount() const;
+    //! Returns the number of bytes allocated for the traces
+    std::size_t GetMemoryUsage() const;
+
+    /**
+     * \brief Adds the traces not further than \a distance from \a eye to the batch
+     * \param batch batch in world coordinates
+     * \param arrowTexture texture with the arrow drawn by BlackArrow and RedArrow traces
+     * \return number of triangles added
+     */
+    int Draw(CParticleBatch& batch, const Texture& arrowTexture, const glm::vec3& eye, float distance) const;
+
+    //! Returns whether the trace is drawn with arrows
+    static bool IsArrow(TraceColor color);
+
+private:
+    //! Traces of one square area of the ground
+    struct Chunk
+    {
+        //! Bounds of the traces on the XZ plane
+        glm::vec2 min{ 0.0f, 0.0f }, max{ 0.0f, 0.0f };
+        //! Triangles of plain traces
+        std::vector<VertexParticle> plain;
+        //! Triangles of arrow traces
+        std::vector<VertexParticle> arrows;
+    };
+
+    std::vector<WheelTrace> m_traces;
+    std::map<std::pair<int, int>, Chunk> m_chunks;
+};
+
+} // namespace Gfx
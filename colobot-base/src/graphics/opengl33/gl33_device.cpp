@@ -31,6 +31,7 @@
 #include "common/config_file.h"
 #include "common/image.h"
 #include "common/logger.h"
+#include "common/profiler.h"
 #include "common/version.h"
 
 #include "graphics/core/light.h"
@@ -94,6 +95,9 @@ void CGL33VertexBuffer::Update()
 {
     glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
     glBufferSubData(GL_ARRAY_BUFFER, 0, m_data.size() * sizeof(Vertex3D), m_data.data());
+
+    CProfiler::AddPerformanceStat(PSTAT_BUFFER_UPLOADS);
+    CProfiler::AddPerformanceStat(PSTAT_BUFFER_UPLOAD_BYTES, m_data.size() * sizeof(Vertex3D));
 }
 
 CGL33Device::CGL33Device(const DeviceConfig &config)
@@ -596,6 +600,8 @@ void CGL33Device::SetTransparency(TransparencyMode mode)
 
     m_transparency = mode;
 
+    CProfiler::AddPerformanceStat(PSTAT_STATE_CHANGES);
+
     switch (mode)
     {
     case TransparencyMode::NONE:
@@ -27,6 +27,7 @@
 #include "graphics/core/vertex.h"
 
 #include "common/logger.h"
+#include "common/profiler.h"
 
 #include <GL/glew.h>
 
@@ -281,6 +282,8 @@ void CGL33ObjectRenderer::SetAlbedoTexture(const Texture& texture)
 
     m_albedoTexture = texture.id;
 
+    CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+
     glActiveTexture(GL_TEXTURE0 + m_albedoIndex);
 
     if (texture.id == 0)
@@ -300,6 +303,8 @@ void CGL33ObjectRenderer::SetEmissiveTexture(const Texture& texture)
 
     m_emissiveTexture = texture.id;
 
+    CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+
     glActiveTexture(GL_TEXTURE0 + m_emissiveIndex);
 
     if (texture.id == 0)
@@ -321,6 +326,8 @@ void CGL33ObjectRenderer::SetMaterialTexture(const Texture& texture)
 
     m_materialTexture = texture.id;
 
+    CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+
     glActiveTexture(GL_TEXTURE0 + m_materialIndex);
 
     if (texture.id == 0)
@@ -335,6 +342,8 @@ void CGL33ObjectRenderer::SetDetailTexture(const Texture& texture)
 
     m_detailTexture = texture.id;
 
+    CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+
     glActiveTexture(GL_TEXTURE0 + m_detailIndex);
 
     if (texture.id == 0)
@@ -349,6 +358,8 @@ void CGL33ObjectRenderer::SetShadowMap(const Texture& texture)
 
     m_shadowMap = texture.id;
 
+    CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+
     glActiveTexture(GL_TEXTURE0 + m_shadowIndex);
 
     if (texture.id == 0)
@@ -457,6 +468,9 @@ void CGL33ObjectRenderer::DrawObject(const CVertexBuffer* buffer)
 
     glBindVertexArray(b->GetVAO());
 
+    CProfiler::AddPerformanceStat(PSTAT_DRAW_CALLS);
+    CProfiler::AddPerformanceStat(PSTAT_TRIANGLES, GetTriangleCount(b->GetType(), static_cast<int>(b->Size())));
+
     glDrawArrays(TranslateGfxPrimitive(b->GetType()), 0, static_cast<GLsizei>(b->Size()));
 }
 
@@ -470,11 +484,13 @@ void CGL33ObjectRenderer::DrawPrimitives(PrimitiveType type, int drawCount, int
     m_first.resize(drawCount);
 
     GLint offset = 0;
+    long long triangles = 0;
 
     for (size_t i = 0; i < drawCount; i++)
     {
         m_first[i] = offset;
         offset += count[i];
+        triangles += GetTriangleCount(type, count[i]);
     }
 
     glBindVertexArray(m_bufferVAO);
@@ -482,10 +498,12 @@ void CGL33ObjectRenderer::DrawPrimitives(PrimitiveType type, int drawCount, int
 
     size_t size = offset * sizeof(Vertex3D);
 
-    // Send new vertices to GPU
+    // Send new vertices to GPU, orphaning the old storage in the same call
     glBindBuffer(GL_ARRAY_BUFFER, m_bufferVBO);
-    glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, size, vertices);
+    glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STREAM_DRAW);
+
+    CProfiler::AddPerformanceStat(PSTAT_BUFFER_UPLOADS);
+    CProfiler::AddPerformanceStat(PSTAT_BUFFER_UPLOAD_BYTES, size);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex3D),
         reinterpret_cast<void*>(offsetof(Vertex3D, position)));
@@ -502,5 +520,8 @@ void CGL33ObjectRenderer::DrawPrimitives(PrimitiveType type, int drawCount, int
     glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex3D),
         reinterpret_cast<void*>(offsetof(Vertex3D, uv2)));
 
+    CProfiler::AddPerformanceStat(PSTAT_DRAW_CALLS);
+    CProfiler::AddPerformanceStat(PSTAT_TRIANGLES, triangles);
+
     glMultiDrawArrays(TranslateGfxPrimitive(type), m_first.data(), count, drawCount);
 }
@@ -27,6 +27,7 @@
 #include "graphics/core/vertex.h"
 
 #include "common/logger.h"
+#include "common/profiler.h"
 
 #include <GL/glew.h>
 
@@ -135,6 +136,7 @@ void CGL33ParticleRenderer::Begin()
     m_device->SetCullFace(CullFace::NONE);
 
     glUniform4f(m_color, 1.0f, 1.0f, 1.0f, 1.0f);
+    m_currentColor = glm::vec4(1.0f);
 
     glBindVertexArray(m_bufferVAO);
     glBindBuffer(GL_ARRAY_BUFFER, m_bufferVBO);
@@ -168,11 +170,19 @@ void CGL33ParticleRenderer::SetViewMatrix(const glm::mat4& matrix)
 
 void CGL33ParticleRenderer::SetModelMatrix(const glm::mat4& matrix)
 {
+    CProfiler::AddPerformanceStat(PSTAT_STATE_CHANGES);
+
     glUniformMatrix4fv(m_modelMatrix, 1, GL_FALSE, value_ptr(matrix));
 }
 
 void CGL33ParticleRenderer::SetColor(const glm::vec4& color)
 {
+    if (m_currentColor == color) return;
+
+    m_currentColor = color;
+
+    CProfiler::AddPerformanceStat(PSTAT_STATE_CHANGES);
+
     glUniform4f(m_color, color.r, color.g, color.b, color.a);
 }
 
@@ -182,6 +192,8 @@ void CGL33ParticleRenderer::SetTexture(const Texture& texture)
 
     m_texture = texture.id;
 
+    CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+
     glActiveTexture(GL_TEXTURE10);
 
     if (texture.id == 0)
@@ -220,7 +232,7 @@ void CGL33ParticleRenderer::DrawParticle(PrimitiveType type, int count, const Ve
     void* ptr = glMapBufferRange(GL_ARRAY_BUFFER,
         m_bufferOffset * sizeof(VertexParticle),
         count * sizeof(VertexParticle),
-        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
 
     if (ptr)
     {
@@ -238,6 +250,11 @@ void CGL33ParticleRenderer::DrawParticle(PrimitiveType type, int count, const Ve
             vertices);
     }
 
+    CProfiler::AddPerformanceStat(PSTAT_BUFFER_UPLOADS);
+    CProfiler::AddPerformanceStat(PSTAT_BUFFER_UPLOAD_BYTES, count * sizeof(VertexParticle));
+    CProfiler::AddPerformanceStat(PSTAT_DRAW_CALLS);
+    CProfiler::AddPerformanceStat(PSTAT_TRIANGLES, GetTriangleCount(type, count));
+
     glDrawArrays(TranslateGfxPrimitive(type),
         m_bufferOffset,
         count);
@@ -84,6 +84,8 @@ private:
     GLuint m_whiteTexture = 0;
     // Currently bound primary texture
     GLuint m_texture = 0;
+    // Current color
+    glm::vec4 m_currentColor = glm::vec4(1.0f);
 
     // Vertex buffer object
     GLuint m_bufferVBO = 0;
@@ -27,6 +27,7 @@
 #include "graphics/core/vertex.h"
 
 #include "common/logger.h"
+#include "common/profiler.h"
 
 #include <GL/glew.h>
 
@@ -84,6 +85,7 @@ CGL33ShadowRenderer::CGL33ShadowRenderer(CGL33Device* device)
     glUseProgram(0);
 
     glGenFramebuffers(1, &m_framebuffer);
+    glGenFramebuffers(1, &m_copyFramebuffer);
 
     GetLogger()->Info("CGL33ShadowRenderer created successfully");
 }
@@ -93,6 +95,7 @@ CGL33ShadowRenderer::~CGL33ShadowRenderer()
     glDeleteProgram(m_program);
 
     glDeleteFramebuffers(1, &m_framebuffer);
+    glDeleteFramebuffers(1, &m_copyFramebuffer);
 }
 
 void CGL33ShadowRenderer::Begin()
@@ -149,6 +152,8 @@ void CGL33ShadowRenderer::SetModelMatrix(const glm::mat4& matrix)
 
 void CGL33ShadowRenderer::SetTexture(const Texture& texture)
 {
+    CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, texture.id);
 }
@@ -175,9 +180,34 @@ void CGL33ShadowRenderer::SetShadowRegion(const glm::vec2& offset, const glm::ve
     int width = static_cast<int>(m_width * scale.x);
     int height = static_cast<int>(m_height * scale.y);
 
+    m_region = { x, y, width, height };
+
     glViewport(x, y, width, height);
 }
 
+void CGL33ShadowRenderer::ClearShadowRegion()
+{
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(m_region.x, m_region.y, m_region.z, m_region.w);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    glDisable(GL_SCISSOR_TEST);
+}
+
+void CGL33ShadowRenderer::CopyShadowRegion(const Texture& source)
+{
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_copyFramebuffer);
+    glFramebufferTexture(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, source.id, 0);
+    glReadBuffer(GL_NONE);
+
+    int x1 = m_region.x + m_region.z;
+    int y1 = m_region.y + m_region.w;
+    glBlitFramebuffer(m_region.x, m_region.y, x1, y1, m_region.x, m_region.y, x1, y1,
+        GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+    glFramebufferTexture(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, 0, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+}
+
 void CGL33ShadowRenderer::DrawObject(const CVertexBuffer* buffer, bool transparent)
 {
     auto b = dynamic_cast<const CGL33VertexBuffer*>(buffer);
@@ -188,5 +218,8 @@ void CGL33ShadowRenderer::DrawObject(const CVertexBuffer* buffer, bool transpare
 
     glBindVertexArray(b->GetVAO());
 
+    CProfiler::AddPerformanceStat(PSTAT_DRAW_CALLS);
+    CProfiler::AddPerformanceStat(PSTAT_TRIANGLES, GetTriangleCount(b->GetType(), static_cast<int>(b->Size())));
+
     glDrawArrays(TranslateGfxPrimitive(b->GetType()), 0, b->Size());
 }
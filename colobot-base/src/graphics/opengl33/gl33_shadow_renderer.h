@@ -61,6 +61,10 @@ public:
     virtual void SetShadowMap(const Texture& texture) override;
     //! Sets shadow region
     virtual void SetShadowRegion(const glm::vec2& offset, const glm::vec2& scale) override;
+    //! Clears the depth of the current shadow region
+    virtual void ClearShadowRegion() override;
+    //! Copies the depth of the current shadow region from another shadow map of the same size
+    virtual void CopyShadowRegion(const Texture& source) override;
 
     //! Draws terrain object
     virtual void DrawObject(const CVertexBuffer* buffer, bool transparent) override;
@@ -81,6 +85,12 @@ private:
     GLuint m_framebuffer = 0;
     int m_width = 0;
     int m_height = 0;
+
+    // Framebuffer reading the shadow map copied by CopyShadowRegion()
+    GLuint m_copyFramebuffer = 0;
+
+    // Current shadow region
+    glm::ivec4 m_region = { 0, 0, 0, 0 };
 };
 
 } // namespace Gfx
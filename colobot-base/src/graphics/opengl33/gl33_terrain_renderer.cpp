@@ -27,6 +27,7 @@
 #include "graphics/core/vertex.h"
 
 #include "common/logger.h"
+#include "common/profiler.h"
 
 #include <GL/glew.h>
 
@@ -257,6 +258,8 @@ void CGL33TerrainRenderer::SetAlbedoTexture(const Texture& texture)
 
     m_albedoTexture = texture.id;
 
+    CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+
     glActiveTexture(GL_TEXTURE0 + m_albedoIndex);
 
     if (texture.id == 0)
@@ -276,6 +279,8 @@ void CGL33TerrainRenderer::SetEmissiveTexture(const Texture& texture)
 
     m_emissiveTexture = texture.id;
 
+    CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+
     glActiveTexture(GL_TEXTURE0 + m_emissiveIndex);
 
     if (texture.id == 0)
@@ -297,6 +302,8 @@ void CGL33TerrainRenderer::SetMaterialTexture(const Texture& texture)
 
     m_materialTexture = texture.id;
 
+    CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+
     glActiveTexture(GL_TEXTURE0 + m_materialIndex);
 
     if (texture.id == 0)
@@ -311,6 +318,8 @@ void CGL33TerrainRenderer::SetDetailTexture(const Texture& texture)
 
     m_detailTexture = texture.id;
 
+    CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+
     glActiveTexture(GL_TEXTURE0 + m_detailIndex);
 
     if (texture.id == 0)
@@ -325,6 +334,8 @@ void CGL33TerrainRenderer::SetShadowMap(const Texture& texture)
 
     m_shadowMap = texture.id;
 
+    CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+
     glActiveTexture(GL_TEXTURE0 + m_shadowIndex);
 
     if (texture.id == 0)
@@ -373,5 +384,8 @@ void CGL33TerrainRenderer::DrawObject(const glm::mat4& matrix, const CVertexBuff
     SetModelMatrix(matrix);
     glBindVertexArray(b->GetVAO());
 
+    CProfiler::AddPerformanceStat(PSTAT_DRAW_CALLS);
+    CProfiler::AddPerformanceStat(PSTAT_TRIANGLES, GetTriangleCount(b->GetType(), static_cast<int>(b->Size())));
+
     glDrawArrays(TranslateGfxPrimitive(b->GetType()), 0, static_cast<GLsizei>(b->Size()));
 }
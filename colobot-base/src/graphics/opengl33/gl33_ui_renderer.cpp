@@ -27,6 +27,7 @@
 #include "graphics/core/vertex.h"
 
 #include "common/logger.h"
+#include "common/profiler.h"
 
 #include <GL/glew.h>
 
@@ -132,7 +133,10 @@ CGL33UIRenderer::~CGL33UIRenderer()
 
 void CGL33UIRenderer::SetProjection(float left, float right, float bottom, float top)
 {
-    m_uniforms.projectionMatrix = glm::ortho(left, right, bottom, top);
+    glm::mat4 matrix = glm::ortho(left, right, bottom, top);
+    if (m_uniforms.projectionMatrix == matrix) return;
+
+    m_uniforms.projectionMatrix = matrix;
     m_uniformsDirty = true;
 }
 
@@ -144,6 +148,8 @@ void CGL33UIRenderer::SetTexture(const Texture& texture)
 
     m_currentTexture = texture.id;
 
+    CProfiler::AddPerformanceStat(PSTAT_TEXTURE_BINDS);
+
     if (m_currentTexture == 0)
         glBindTexture(GL_TEXTURE_2D, m_whiteTexture);
     else
@@ -152,6 +158,8 @@ void CGL33UIRenderer::SetTexture(const Texture& texture)
 
 void CGL33UIRenderer::SetColor(const glm::vec4& color)
 {
+    if (m_uniforms.color == color) return;
+
     m_uniforms.color = color;
     m_uniformsDirty = true;
 }
@@ -217,7 +225,7 @@ Vertex2D* CGL33UIRenderer::BeginPrimitives(PrimitiveType type, int drawCount, co
     auto ptr = glMapBufferRange(GL_ARRAY_BUFFER,
         m_bufferOffset * sizeof(Vertex2D),
         m_currentCount * sizeof(Vertex2D),
-        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
 
     m_mapped = true;
     m_type = type;
@@ -253,6 +261,9 @@ bool CGL33UIRenderer::EndPrimitive()
         glUnmapBuffer(GL_ARRAY_BUFFER);
     }
 
+    CProfiler::AddPerformanceStat(PSTAT_BUFFER_UPLOADS);
+    CProfiler::AddPerformanceStat(PSTAT_BUFFER_UPLOAD_BYTES, m_currentCount * sizeof(Vertex2D));
+
     glUseProgram(m_program);
 
     glBindBufferBase(GL_UNIFORM_BUFFER, 0, m_uniformBuffer);
@@ -262,6 +273,10 @@ bool CGL33UIRenderer::EndPrimitive()
     m_device->SetDepthTest(false);
     m_device->SetCullFace(CullFace::NONE);
 
+    CProfiler::AddPerformanceStat(PSTAT_DRAW_CALLS);
+    for (GLuint i = 0; i < m_drawCount; i++)
+        CProfiler::AddPerformanceStat(PSTAT_TRIANGLES, GetTriangleCount(m_type, m_count[i]));
+
     if (m_drawCount == 1)
         glDrawArrays(TranslateGfxPrimitive(m_type), m_first.front(), m_count.front());
     else
@@ -279,8 +294,13 @@ void CGL33UIRenderer::UpdateUniforms()
 {
     if (!m_uniformsDirty) return;
 
+    // Orphans the old storage and fills the new one in a single call
     glBindBuffer(GL_COPY_WRITE_BUFFER, m_uniformBuffer);
-    glBufferData(GL_COPY_WRITE_BUFFER, sizeof(Uniforms), nullptr, GL_STREAM_DRAW);
-    glBufferSubData(GL_COPY_WRITE_BUFFER, 0, sizeof(Uniforms), &m_uniforms);
+    glBufferData(GL_COPY_WRITE_BUFFER, sizeof(Uniforms), &m_uniforms, GL_STREAM_DRAW);
     glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    CProfiler::AddPerformanceStat(PSTAT_BUFFER_UPLOADS);
+    CProfiler::AddPerformanceStat(PSTAT_BUFFER_UPLOAD_BYTES, sizeof(Uniforms));
+
+    m_uniformsDirty = false;
 }
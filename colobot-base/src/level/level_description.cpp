@@ -0,0 +1,119 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.description; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "level/level_description.h"
+
+#include "common/resources/resourcemanager.h"
+
+#include "level/parser/parser.h"
+
+
+const LevelDescription& CLevelDescriptionCache::Get(const std::string& filename)
+{
+    int locationsRevision = CResourceManager::GetLocationsRevision();
+    if (locationsRevision != m_locationsRevision)
+    {
+        Clear();
+        m_locationsRevision = locationsRevision;
+    }
+
+    auto it = m_entries.find(filename);
+    if (it != m_entries.end() && !HasChanged(it->second.files))
+        return it->second.description;
+
+    if (it == m_entries.end())
+        it = m_entries.emplace(filename, Entry()).first;
+
+    Entry& entry = it->second;
+    entry.files.clear();
+    entry.description = Read(filename, entry.files);
+    return entry.description;
+}
+
+void CLevelDescriptionCache::SetLanguage(char language)
+{
+    if (language == m_language) return;
+
+    Clear();
+    m_language = language;
+}
+
+void CLevelDescriptionCache::Clear()
+{
+    m_entries.clear();
+}
+
+bool CLevelDescriptionCache::HasChanged(const std::vector<FileTime>& files)
+{
+    // Missing files have no modification time, so files appearing or disappearing are noticed too
+    for (const FileTime& file : files)
+    {
+        if (CResourceManager::GetLastModificationTime(file.filename) != file.modificationTime)
+            return true;
+    }
+    return false;
+}
+
+LevelDescription CLevelDescriptionCache::Read(const std::string& filename, std::vector<FileTime>& files)
+{
+    LevelDescription description;
+
+    files.push_back({ filename, CResourceManager::GetLastModificationTime(filename) });
+
+    CLevelParser levelParser(filename);
+    description.exists = levelParser.Exists();
+    bool loaded = true;
+    try
+    {
+        levelParser.Load();
+    }
+    catch (CLevelParserException& e)
+    {
+        description.titleError = e.what();
+        description.resumeError = e.what();
+        loaded = false;
+    }
+
+    // Includes read before an error are known too, so fixing them is noticed
+    for (const std::string& includedFile : levelParser.GetIncludedFiles())
+        files.push_back({ includedFile, CResourceManager::GetLastModificationTime(includedFile) });
+
+    if (!loaded)
+        return description;
+
+    try
+    {
+        description.title = levelParser.Get("Title")->GetParam("text")->AsString();
+    }
+    catch (CLevelParserException& e)
+    {
+        description.titleError = e.what();
+    }
+
+    try
+    {
+        description.resume = levelParser.Get("Resume")->GetParam("text")->AsString();
+    }
+    catch (CLevelParserException& e)
+    {
+        description.resumeError = e.what();
+    }
+
+    return description;
+}
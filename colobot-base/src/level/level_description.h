@@ -0,0 +1,92 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file level/level_description.h
+ * \brief Cache of level titles and summaries - CLevelDescriptionCache class
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \struct LevelDescription
+ * \brief What the level lists show of a level file
+ */
+struct LevelDescription
+{
+    //! Whether the file exists
+    bool exists = false;
+    //! Text of the Title command
+    std::string title;
+    //! Error that occurred reading the title, empty if none
+    std::string titleError;
+    //! Text of the Resume command
+    std::string resume;
+    //! Error that occurred reading the summary, empty if none
+    std::string resumeError;
+};
+
+/**
+ * \class CLevelDescriptionCache
+ * \brief Keeps the titles and summaries of level files, so that level lists don't parse them every time
+ *
+ * A file is read again when its modification time or the one of a file it includes changes,
+ * and everything is read again when the search path of the resource system or the language changes.
+ */
+class CLevelDescriptionCache
+{
+public:
+    //! Returns the description of a level file, like levels/missions/chapter001/level002/scene.txt
+    const LevelDescription& Get(const std::string& filename);
+
+    //! Sets the language of the texts, forgets everything if it changed
+    void SetLanguage(char language);
+
+    //! Forgets everything
+    void Clear();
+
+private:
+    //! Modification time of a file the description was read from
+    struct FileTime
+    {
+        std::string filename;
+        long long modificationTime = -1;
+    };
+
+    //! Parses the level file, appending the files it was read from to \a files
+    static LevelDescription Read(const std::string& filename, std::vector<FileTime>& files);
+    //! Checks whether one of the files changed since it was read
+    static bool HasChanged(const std::vector<FileTime>& files);
+
+private:
+    struct Entry
+    {
+        //! The level file, then the files it includes
+        std::vector<FileTime> files;
+        LevelDescription description;
+    };
+
+    std::unordered_map<std::string, Entry> m_entries;
+    int m_locationsRevision = -1;
+    char m_language = 0;
+};
@@ -19,23 +19,191 @@
 
 #include "level/parser/parser.h"
 
+#include "CBot/CBotFileUtils.h"
+
 #include "app/app.h"
 
 #include "common/stringutils.h"
 
-#include "common/resources/inputstream.h"
+#include "common/resources/mapped_file.h"
 #include "common/resources/outputstream.h"
 #include "common/resources/resourcemanager.h"
 
+#include "common/thread/job_system.h"
+
 #include "level/robotmain.h"
 
 #include "level/parser/parserexceptions.h"
 
+#include <algorithm>
+#include <cctype>
 #include <string>
+#include <string_view>
 #include <exception>
 #include <sstream>
 #include <iomanip>
 #include <set>
+#include <unordered_map>
+
+namespace
+{
+
+//! Header of binary level files
+const std::string BINARY_MAGIC = "CLVB";
+//! Version of binary level file format
+const int BINARY_VERSION = 1;
+
+/**
+ * \brief Stream buffer reading from memory, so that all of the data is available at once
+ *
+ * Binary level files are read from their mapped contents through this buffer,
+ * lengths in the file are checked against what is left in it.
+ */
+class CMemoryStreamBuffer : public std::streambuf
+{
+public:
+    explicit CMemoryStreamBuffer(std::string_view data)
+    {
+        char* begin = const_cast<char*>(data.data());
+        setg(begin, begin, begin + data.size());
+    }
+};
+
+//! Text files with fewer lines are parsed on the calling thread only
+const std::size_t PARALLEL_MIN_LINES = 2048;
+//! Lines parsed by one job
+const std::size_t PARALLEL_BATCH_LINES = 512;
+
+//! Returns language of translated lines, English if there is no application, as in benchmarks
+char GetLanguageChar()
+{
+    if (!CApplication::IsCreated())
+        return 'E';
+    return CApplication::GetInstancePointer()->GetLanguageChar();
+}
+
+//! Line of a text level file, parsed before translations and includes are resolved
+struct ParsedLine
+{
+    //! Null if the line has no command
+    CLevelParserLineUPtr line;
+    //! Error in params of the line, thrown only if the line is used
+    std::exception_ptr error;
+};
+
+//! Returns \a text without whitespace at both ends, like StrUtils::Trim()
+std::string_view Trimmed(std::string_view text)
+{
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+        text.remove_prefix(1);
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+        text.remove_suffix(1);
+    return text;
+}
+
+//! Returns \a text without comment of form // comment, like StrUtils::RemoveComments()
+std::string_view WithoutComment(std::string_view text)
+{
+    for (std::size_t i = 0; i + 1 < text.size(); i++)
+    {
+        char c = text[i];
+
+        // Skip string literals of form "text" or 'text'
+        if (c == '"' || c == '\'')
+        {
+            i = text.find(c, i + 1);
+            if (i == std::string_view::npos)
+                break;
+        }
+        else if (c == '/' && text[i + 1] == '/')
+        {
+            return text.substr(0, i);
+        }
+    }
+    return text;
+}
+
+//! Copies text of a command param, tabs are read as spaces
+std::string ToParamText(std::string_view text)
+{
+    std::string result(text);
+    std::replace(result.begin(), result.end(), '\t', ' ');
+    return result;
+}
+
+//! Adds params of form name=value name="text" to \a line
+void ParseParams(std::string_view text, int lineNumber, CLevelParserLine& line, const std::string& filename)
+{
+    while (!text.empty())
+    {
+        std::size_t pos = text.find('=');
+        std::string paramName = ToParamText(Trimmed(text.substr(0, pos)));
+        if (pos != std::string_view::npos)
+            text = Trimmed(text.substr(pos + 1));
+
+        char first = text.empty() ? '\0' : text[0];
+        if (first == '\"')
+        {
+            pos = text.find('\"', 1);
+            if (pos == std::string_view::npos)
+                throw CLevelParserException("Unclosed \" in " + filename + ":" + StrUtils::ToString(lineNumber));
+        }
+        else if (first == '\'')
+        {
+            pos = text.find('\'', 1);
+            if (pos == std::string_view::npos)
+                throw CLevelParserException("Unclosed ' in " + filename + ":" + StrUtils::ToString(lineNumber));
+        }
+        else
+        {
+            pos = text.find('=');
+            if (pos != std::string_view::npos)
+            {
+                std::size_t pos2 = text.find_last_of(" \t\n", text.find_last_not_of(" \t\n", pos-1));
+                if (pos2 != std::string_view::npos)
+                    pos = pos2;
+            }
+            else
+            {
+                pos = text.length()-1;
+            }
+        }
+        std::string paramValue = ToParamText(Trimmed(text.substr(0, pos + 1)));
+
+        line.AddParam(paramName, std::make_unique<CLevelParserParam>(paramName, std::move(paramValue)));
+
+        if (pos == std::string_view::npos)
+            break;
+        text = Trimmed(text.substr(pos + 1));
+    }
+}
+
+//! Parses one line of a text level file, independently of other lines
+void ParseLine(std::string_view text, int lineNumber, CLevelParser* level, ParsedLine& result)
+{
+    text = Trimmed(WithoutComment(text));
+
+    std::size_t pos = text.find_first_of(" \t\n");
+    std::string_view command = text.substr(0, pos);
+    if (command.empty())
+        return;
+
+    text = pos != std::string_view::npos ? Trimmed(text.substr(pos + 1)) : std::string_view();
+
+    result.line = std::make_unique<CLevelParserLine>(lineNumber, std::string(command));
+    result.line->SetLevel(level);
+
+    try
+    {
+        ParseParams(text, lineNumber, *result.line, level->GetFilename());
+    }
+    catch (...)
+    {
+        result.error = std::current_exception();
+    }
+}
+
+} // anonymous namespace
 
 CLevelParser::CLevelParser()
 {
@@ -150,50 +318,76 @@ bool CLevelParser::Exists()
 
 void CLevelParser::Load()
 {
-    CInputStream file;
-    file.open(m_filename);
-    if (!file.is_open())
-        throw CLevelParserException("Failed to open file: " + m_filename);
+    CJobSystem* jobSystem = nullptr;
+    if (CApplication::IsCreated())
+        jobSystem = CApplication::GetInstancePointer()->GetJobSystem();
 
-    char lang = CApplication::GetInstancePointer()->GetLanguageChar();
+    Load(jobSystem);
+}
 
-    std::string line;
-    int lineNumber = 0;
-    std::set<std::string> translatableLines;
-    while (getline(file, line))
-    {
-        lineNumber++;
+void CLevelParser::Load(CJobSystem* jobSystem)
+{
+    CMappedFile file;
+    if (!file.Open(m_filename))
+        throw CLevelParserException("Failed to open file: " + m_filename);
 
-        line = StrUtils::Replace(line, "\t", " "); // replace tab by space
+    std::string_view text(file.GetData(), file.GetSize());
+    if (text.substr(0, BINARY_MAGIC.size()) == BINARY_MAGIC)
+    {
+        CMemoryStreamBuffer buffer(text.substr(BINARY_MAGIC.size()));
+        std::istream stream(&buffer);
+        LoadBinary(stream);
+        return;
+    }
 
-        StrUtils::RemoveComments(line);
+    // Lines don't depend on each other until translations and includes are resolved,
+    // so they are parsed first, on worker threads for large files
+    std::vector<std::string_view> lines;
+    while (!text.empty())
+    {
+        std::size_t end = text.find('\n');
+        lines.push_back(text.substr(0, end));
+        if (end == std::string_view::npos)
+            break;
+        text.remove_prefix(end + 1);
+    }
 
-        StrUtils::Trim(line);
+    std::vector<ParsedLine> parsedLines(lines.size());
+    auto parseLines = [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; i++)
+            ParseLine(lines[i], static_cast<int>(i) + 1, this, parsedLines[i]);
+    };
 
-        size_t pos = line.find_first_of(" \t\n");
-        std::string command = line.substr(0, pos);
-        if (pos != std::string::npos)
-        {
-            line = line.substr(pos + 1);
-            StrUtils::Trim(line);
-        }
-        else
+    if (jobSystem != nullptr && lines.size() >= PARALLEL_MIN_LINES)
+    {
+        int batchCount = static_cast<int>((lines.size() + PARALLEL_BATCH_LINES - 1) / PARALLEL_BATCH_LINES);
+        jobSystem->ParallelFor(batchCount, 1, [&](int batch)
         {
-            line = "";
-        }
+            std::size_t begin = batch * PARALLEL_BATCH_LINES;
+            parseLines(begin, std::min(lines.size(), begin + PARALLEL_BATCH_LINES));
+        });
+    }
+    else
+    {
+        parseLines(0, lines.size());
+    }
 
-        if (command.empty())
+    char lang = GetLanguageChar();
+    std::set<std::string> translatableLines;
+    for (auto& parsedLine : parsedLines)
+    {
+        auto& parserLine = parsedLine.line;
+        if (parserLine == nullptr)
             continue;
 
-        auto parserLine = std::make_unique<CLevelParserLine>(lineNumber, command);
-        parserLine->SetLevel(this);
-
+        const std::string& command = parserLine->GetCommand();
         if (command.length() > 2 && command[command.length() - 2] == '.')
         {
+            char languageChar = command[command.length() - 1];
             std::string baseCommand = command.substr(0, command.length() - 2);
             parserLine->SetCommand(baseCommand);
 
-            char languageChar = command[command.length() - 1];
             if (languageChar == 'E' && translatableLines.count(baseCommand) == 0)
             {
                 translatableLines.insert(baseCommand);
@@ -220,50 +414,9 @@ void CLevelParser::Load()
             }
         }
 
-        while (!line.empty())
-        {
-            pos = line.find_first_of("=");
-            std::string paramName = line.substr(0, pos);
-            StrUtils::Trim(paramName);
-            line = line.substr(pos + 1);
-            StrUtils::Trim(line);
-
-            if (line[0] == '\"')
-            {
-                pos = line.find_first_of("\"", 1);
-                if (pos == std::string::npos)
-                    throw CLevelParserException("Unclosed \" in " + m_filename + ":" + StrUtils::ToString(lineNumber));
-            }
-            else if (line[0] == '\'')
-            {
-                pos = line.find_first_of("'", 1);
-                if (pos == std::string::npos)
-                    throw CLevelParserException("Unclosed ' in " + m_filename + ":" + StrUtils::ToString(lineNumber));
-            }
-            else
-            {
-                pos = line.find_first_of("=");
-                if (pos != std::string::npos)
-                {
-                    std::size_t pos2 = line.find_last_of(" \t\n", line.find_last_not_of(" \t\n", pos-1));
-                    if (pos2 != std::string::npos)
-                        pos = pos2;
-                }
-                else
-                {
-                    pos = line.length()-1;
-                }
-            }
-            std::string paramValue = line.substr(0, pos + 1);
-            StrUtils::Trim(paramValue);
-
-            parserLine->AddParam(paramName, std::make_unique<CLevelParserParam>(paramName, paramValue));
-
-            if (pos == std::string::npos)
-                break;
-            line = line.substr(pos + 1);
-            StrUtils::Trim(line);
-        }
+        // Errors of lines in other languages are ignored, like these lines are
+        if (parsedLine.error != nullptr)
+            std::rethrow_exception(parsedLine.error);
 
         if (parserLine->GetCommand().length() > 1 && parserLine->GetCommand()[0] == '#')
         {
@@ -271,7 +424,18 @@ void CLevelParser::Load()
             if(cmd == "Include")
             {
                 std::unique_ptr<CLevelParser> includeParser = std::make_unique<CLevelParser>(parserLine->GetParam("file")->AsPath(""));
-                includeParser->Load();
+                m_includedFiles.push_back(includeParser->GetFilename());
+                try
+                {
+                    includeParser->Load(jobSystem);
+                }
+                catch (CLevelParserException&)
+                {
+                    // Files of a broken include are still reported, so that callers notice when they are fixed
+                    m_includedFiles.insert(m_includedFiles.end(), includeParser->m_includedFiles.begin(), includeParser->m_includedFiles.end());
+                    throw;
+                }
+                m_includedFiles.insert(m_includedFiles.end(), includeParser->m_includedFiles.begin(), includeParser->m_includedFiles.end());
                 for(CLevelParserLineUPtr& line : includeParser->m_lines)
                 {
                     AddLine(std::move(line));
@@ -279,7 +443,7 @@ void CLevelParser::Load()
             }
             else
             {
-                throw CLevelParserException("Unknown preprocessor command '#" + cmd + "' (in " + m_filename + ":" + StrUtils::ToString<int>(lineNumber) + ")");
+                throw CLevelParserException("Unknown preprocessor command '#" + cmd + "' (in " + m_filename + ":" + StrUtils::ToString<int>(parserLine->GetLineNumber()) + ")");
             }
         }
         else
@@ -287,8 +451,6 @@ void CLevelParser::Load()
             AddLine(std::move(parserLine));
         }
     }
-
-    file.close();
 }
 
 void CLevelParser::Save()
@@ -306,6 +468,110 @@ void CLevelParser::Save()
     file.close();
 }
 
+void CLevelParser::SaveBinary()
+{
+    COutputStream file;
+    file.open(m_filename);
+    if (!file.is_open())
+        throw CLevelParserException("Failed to open file: " + m_filename);
+
+    // Commands and param names repeat on almost every line, so each is written once
+    // and referred to by index afterwards
+    std::unordered_map<std::string, int> names;
+    auto writeName = [&](const std::string& name)
+    {
+        auto it = names.find(name);
+        if (it != names.end())
+            return CBot::WriteInt(file, it->second);
+
+        int index = names.size();
+        names[name] = index;
+        return CBot::WriteInt(file, index) && CBot::WriteString(file, name);
+    };
+
+    file.write(BINARY_MAGIC.data(), BINARY_MAGIC.size());
+    bool ok = CBot::WriteInt(file, BINARY_VERSION) && CBot::WriteInt(file, m_lines.size());
+
+    for (auto& line : m_lines)
+    {
+        if (!ok) break;
+
+        const auto& params = line->GetParams();
+        int count = std::count_if(params.begin(), params.end(), [](const auto& param) { return param.second->IsDefined(); });
+        ok = writeName(line->GetCommand()) && CBot::WriteInt(file, count);
+
+        for (const auto& param : params)
+        {
+            if (!ok) break;
+            if (!param.second->IsDefined()) continue;
+
+            ok = writeName(param.first) && param.second->WriteBinary(file);
+        }
+    }
+
+    file.close();
+
+    if (!ok)
+        throw CLevelParserException("Failed to write file: " + m_filename);
+}
+
+void CLevelParser::LoadBinary(std::istream& istr)
+{
+    std::vector<std::string> names;
+    auto readName = [&](std::string& name)
+    {
+        int index;
+        if (!CBot::ReadInt(istr, index) || index < 0 || index > static_cast<int>(names.size()))
+            return false;
+
+        if (index == static_cast<int>(names.size()))
+        {
+            if (!CLevelParserParam::ReadBinaryText(istr, name)) return false;
+            names.push_back(name);
+        }
+        else
+        {
+            name = names[index];
+        }
+        return true;
+    };
+
+    // counts are checked against the bytes left before anything is allocated for them,
+    // every line and param takes at least one byte
+    int version, lineCount;
+    if (!CBot::ReadInt(istr, version) || !CBot::ReadInt(istr, lineCount) || lineCount < 0 ||
+        static_cast<std::size_t>(lineCount) > CLevelParserParam::GetBinaryBytesLeft(istr))
+        throw CLevelParserException("Corrupted file: " + m_filename);
+    if (version != BINARY_VERSION)
+        throw CLevelParserException("Unsupported binary level file version " + StrUtils::ToString(version) + " in " + m_filename);
+
+    m_lines.reserve(m_lines.size() + lineCount);
+    for (int lineNumber = 1; lineNumber <= lineCount; lineNumber++)
+    {
+        std::string command;
+        int paramCount;
+        if (!readName(command) || !CBot::ReadInt(istr, paramCount) || paramCount < 0 ||
+            static_cast<std::size_t>(paramCount) > CLevelParserParam::GetBinaryBytesLeft(istr))
+            throw CLevelParserException("Corrupted file: " + m_filename + ":" + StrUtils::ToString(lineNumber));
+
+        auto parserLine = std::make_unique<CLevelParserLine>(lineNumber, command);
+        for (int i = 0; i < paramCount; i++)
+        {
+            std::string paramName;
+            if (!readName(paramName))
+                throw CLevelParserException("Corrupted file: " + m_filename + ":" + StrUtils::ToString(lineNumber));
+
+            auto param = CLevelParserParam::ReadBinary(istr, paramName);
+            if (param == nullptr)
+                throw CLevelParserException("Corrupted file: " + m_filename + ":" + StrUtils::ToString(lineNumber));
+
+            parserLine->AddParam(paramName, std::move(param));
+        }
+
+        AddLine(std::move(parserLine));
+    }
+}
+
 void CLevelParser::SetLevelPaths(LevelCategory category, int chapter, int rank)
 {
     m_pathCat  = BuildCategoryPath(category);
@@ -325,7 +591,7 @@ std::string CLevelParser::InjectLevelPaths(const std::string& path, const std::s
     }
 
     std::string langPath = newPath;
-    std::string langStr(1, CApplication::GetInstancePointer()->GetLanguageChar());
+    std::string langStr(1, GetLanguageChar());
     langPath = StrUtils::Replace(langPath, "%lng%", langStr);
     if(CResourceManager::Exists(langPath))
         return langPath;
@@ -31,10 +31,13 @@
 #include "level/parser/parserline.h"
 #include "level/parser/parserparam.h"
 
+#include <istream>
 #include <string>
 #include <vector>
 #include <memory>
 
+class CJobSystem;
+
 class CLevelParser
 {
 public:
@@ -61,10 +64,15 @@ public:
 
     //! Check if level file exists
     bool Exists();
-    //! Load file
+    //! Load file, using worker threads of the application for large files
     void Load();
+    //! Load file, parsing lines of large files on worker threads of \a jobSystem if not null
+    void Load(CJobSystem* jobSystem);
     //! Save file
     void Save();
+    //! Save file in binary format, smaller and faster to load than text
+    /** Load() recognizes binary files, so they can be used everywhere text files are */
+    void SaveBinary();
 
     //! Configure level paths for the given level
     void SetLevelPaths(LevelCategory category, int chapter = 0, int rank = 0);
@@ -74,6 +82,12 @@ public:
     //! Get filename
     const std::string& GetFilename();
 
+    //! Get files read through #Include by Load(), nested includes too
+    inline const std::vector<std::string>& GetIncludedFiles()
+    {
+        return m_includedFiles;
+    }
+
     //! Get all lines from file
     inline const std::vector<CLevelParserLineUPtr>& GetLines()
     {
@@ -92,9 +106,14 @@ public:
     //! Count lines with given command
     int CountLines(const std::string& command);
 
+private:
+    //! Load file saved with SaveBinary(), after the file header
+    void LoadBinary(std::istream& istr);
+
 private:
     std::string m_filename;
     std::vector<CLevelParserLineUPtr> m_lines;
+    std::vector<std::string> m_includedFiles;
 
     std::string m_pathCat;
     std::string m_pathChap;
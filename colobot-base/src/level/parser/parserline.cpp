@@ -63,7 +63,7 @@ const std::string& CLevelParserLine::GetLevelFilename()
     return m_levelFilename;
 }
 
-std::string CLevelParserLine::GetCommand()
+const std::string& CLevelParserLine::GetCommand()
 {
     return m_command;
 }
@@ -91,7 +91,12 @@ CLevelParserParam* CLevelParserLine::GetParam(std::string name)
 void CLevelParserLine::AddParam(std::string name, CLevelParserParamUPtr value)
 {
     value->SetLine(this);
-    m_params.insert(std::make_pair(name, std::move(value)));
+    m_params.insert(std::make_pair(std::move(name), std::move(value)));
+}
+
+const std::map<std::string, CLevelParserParamUPtr>& CLevelParserLine::GetParams()
+{
+    return m_params;
 }
 
 std::ostream& operator<<(std::ostream& str, const CLevelParserLine& line)
@@ -50,11 +50,13 @@ public:
 
     const std::string& GetLevelFilename();
 
-    std::string GetCommand();
+    const std::string& GetCommand();
     void SetCommand(std::string command);
 
     CLevelParserParam* GetParam(std::string name);
     void AddParam(std::string name, CLevelParserParamUPtr value);
+    //! Get all params of this line
+    const std::map<std::string, CLevelParserParamUPtr>& GetParams();
 
     friend std::ostream& operator<<(std::ostream& str, const CLevelParserLine& line);
 
@@ -19,6 +19,8 @@
 
 #include "level/parser/parserparam.h"
 
+#include "CBot/CBotFileUtils.h"
+
 #include "app/app.h"
 
 #include "common/logger.h"
@@ -33,9 +35,75 @@
 
 #include "level/parser/parser.h"
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+
+namespace
+{
+
+//! Types of values in binary level files
+enum BinaryParamType : char
+{
+    BINARY_PARAM_TEXT  = 0,
+    BINARY_PARAM_INT   = 1,
+    BINARY_PARAM_FLOAT = 2,
+    BINARY_PARAM_ARRAY = 3,
+    //! Float with a whole value, stored like an int as it takes less space
+    BINARY_PARAM_WHOLE_FLOAT = 4,
+};
+
+/**
+ * \brief Reads a number from text like std::istream does, without creating a stream
+ *
+ * Leading whitespace is skipped and 0 is returned if the text is not a number.
+ * Unlike std::from_chars(), infinity, NaN and numbers ending with a bare exponent are not numbers.
+ */
+template<typename T>
+T ReadNumber(const std::string& text)
+{
+    const char* first = text.data();
+    const char* last = first + text.size();
+    while (first != last && std::isspace(static_cast<unsigned char>(*first))) ++first;
+    if (first != last && *first == '+')
+    {
+        ++first;
+        if (first != last && *first == '-') return 0;
+    }
+
+    T value = 0;
+    auto result = std::from_chars(first, last, value);
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        if (result.ec == std::errc() && !std::isfinite(value)) return 0;
+        if (result.ec == std::errc() && result.ptr != last && (*result.ptr == 'e' || *result.ptr == 'E')) return 0;
+    }
+    if (result.ec == std::errc::result_out_of_range)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            // Too small numbers are read as they are, too big ones are limited, as by std::istream
+            value = std::strtof(first, nullptr);
+            return std::clamp(value, std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max());
+        }
+        else
+        {
+            return *first == '-' ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+        }
+    }
+    return value;
+}
+
+} // anonymous namespace
+
 CLevelParserParam::CLevelParserParam(std::string name, std::string value)
-  : m_name(name)
-  , m_value(value)
+  : m_name(std::move(name))
+  , m_value(std::move(value))
 {}
 
 CLevelParserParam::CLevelParserParam(std::string name, bool empty)
@@ -46,11 +114,14 @@ CLevelParserParam::CLevelParserParam(std::string name, bool empty)
 }
 
 CLevelParserParam::CLevelParserParam(int value)
-  : m_value(StrUtils::ToString(value))
+  : m_hasText(false)
+  , m_number(value)
 {}
 
 CLevelParserParam::CLevelParserParam(float value)
-  : m_value(StrUtils::ToString(value))
+  : m_hasText(false)
+  , m_number(value)
+  , m_isFloat(true)
 {}
 
 CLevelParserParam::CLevelParserParam(std::string value)
@@ -58,7 +129,8 @@ CLevelParserParam::CLevelParserParam(std::string value)
 {}
 
 CLevelParserParam::CLevelParserParam(bool value)
-  : m_value(value ? "1" : "0")
+  : m_hasText(false)
+  , m_number(value ? 1 : 0)
 {}
 
 CLevelParserParam::CLevelParserParam(Gfx::Color value)
@@ -68,7 +140,8 @@ CLevelParserParam::CLevelParserParam(Gfx::Color value)
     m_array.push_back(std::make_unique<CLevelParserParam>(value.b));
     m_array.push_back(std::make_unique<CLevelParserParam>(value.a));
 
-    LoadArray();
+    m_hasText = false;
+    m_isArray = true;
 }
 
 CLevelParserParam::CLevelParserParam(glm::vec2 value)
@@ -76,7 +149,8 @@ CLevelParserParam::CLevelParserParam(glm::vec2 value)
     m_array.push_back(std::make_unique<CLevelParserParam>(value.x));
     m_array.push_back(std::make_unique<CLevelParserParam>(value.y));
 
-    LoadArray();
+    m_hasText = false;
+    m_isArray = true;
 }
 
 CLevelParserParam::CLevelParserParam(glm::vec3 value)
@@ -86,7 +160,8 @@ CLevelParserParam::CLevelParserParam(glm::vec3 value)
         m_array.push_back(std::make_unique<CLevelParserParam>(value.y));
     m_array.push_back(std::make_unique<CLevelParserParam>(value.z));
 
-    LoadArray();
+    m_hasText = false;
+    m_isArray = true;
 }
 
 CLevelParserParam::CLevelParserParam(ObjectType value)
@@ -101,12 +176,15 @@ CLevelParserParam::CLevelParserParam(CLevelParserParamVec&& array)
 {
     m_array.swap(array);
 
-    LoadArray();
+    m_hasText = false;
+    m_isArray = true;
 }
 
 void CLevelParserParam::SetLine(CLevelParserLine* line)
 {
     m_line = line;
+    for (auto& value : m_array)
+        value->SetLine(line);
 }
 
 CLevelParserLine* CLevelParserParam::GetLine()
@@ -121,6 +199,22 @@ std::string CLevelParserParam::GetName()
 
 std::string CLevelParserParam::GetValue()
 {
+    return GetText();
+}
+
+const std::string& CLevelParserParam::GetText()
+{
+    if (!m_hasText)
+    {
+        if (m_isArray)
+            LoadArray();
+        else if (m_isFloat)
+            m_value = StrUtils::ToString(static_cast<float>(*m_number));
+        else
+            m_value = StrUtils::ToString(static_cast<int>(*m_number));
+
+        m_hasText = true;
+    }
     return m_value;
 }
 
@@ -132,23 +226,30 @@ bool CLevelParserParam::IsDefined()
 template<typename T>
 T CLevelParserParam::Cast(const std::string& value, const std::string& requestedType)
 {
-    try
+    if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>)
     {
-        std::stringstream stream(value);
-        T result;
-        stream >> result;
-        return result;
+        return ReadNumber<T>(value);
     }
-    catch(...)
+    else
     {
-        throw CLevelParserExceptionBadParam(this, requestedType);
+        try
+        {
+            std::stringstream stream(value);
+            T result;
+            stream >> result;
+            return result;
+        }
+        catch(...)
+        {
+            throw CLevelParserExceptionBadParam(this, requestedType);
+        }
     }
 }
 
 template<typename T>
 T CLevelParserParam::Cast(const std::string& requestedType)
 {
-    return Cast<T>(m_value, requestedType);
+    return Cast<T>(GetText(), requestedType);
 }
 
 
@@ -156,7 +257,11 @@ int CLevelParserParam::AsInt()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return Cast<int>("int");
+    if (m_number.has_value())
+        return static_cast<int>(*m_number);
+    if (auto converted = std::get_if<int>(&m_converted))
+        return *converted;
+    return m_converted.emplace<int>(Cast<int>("int"));
 }
 
 
@@ -172,7 +277,11 @@ float CLevelParserParam::AsFloat()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return Cast<float>("float");
+    if (m_number.has_value())
+        return static_cast<float>(*m_number);
+    if (auto converted = std::get_if<float>(&m_converted))
+        return *converted;
+    return m_converted.emplace<float>(Cast<float>("float"));
 }
 
 float CLevelParserParam::AsFloat(float def)
@@ -187,9 +296,10 @@ std::string CLevelParserParam::AsString()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    if ((m_value[0] == '\"' && m_value[m_value.length()-1] == '\"') || (m_value[0] == '\'' && m_value[m_value.length()-1] == '\''))
+    const std::string& text = GetText();
+    if ((text[0] == '\"' && text[text.length()-1] == '\"') || (text[0] == '\'' && text[text.length()-1] == '\''))
     {
-        return m_value.substr(1, m_value.length()-2);
+        return text.substr(1, text.length()-2);
     }
     else
     {
@@ -209,11 +319,15 @@ bool CLevelParserParam::AsBool()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    std::string value = m_value;
+    if (m_number.has_value())
+        return *m_number != 0;
+    if (auto converted = std::get_if<bool>(&m_converted))
+        return *converted;
+    std::string value = GetText();
     value = StrUtils::ToLower(value);
-    if (value == "true") return true;
-    if (value == "false") return false;
-    return Cast<bool>("bool");
+    if (value == "true") return m_converted.emplace<bool>(true);
+    if (value == "false") return m_converted.emplace<bool>(false);
+    return m_converted.emplace<bool>(Cast<bool>("bool"));
 }
 
 bool CLevelParserParam::AsBool(bool def)
@@ -253,16 +367,19 @@ Gfx::Color CLevelParserParam::AsColor()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
+    if (auto converted = std::get_if<Gfx::Color>(&m_converted))
+        return *converted;
 
     float red, green, blue, alpha;
-    if (m_value.length() >= 1 && m_value[0] == '#')
+    const std::string& text = GetText();
+    if (text.length() >= 1 && text[0] == '#')
     {
-        if (m_value.length() != 7 && m_value.length() != 9)
+        if (text.length() != 7 && text.length() != 9)
             throw CLevelParserExceptionBadParam(this, "color");
 
         try
         {
-            std::string_view value = m_value;
+            std::string_view value = text;
 
             red = StrUtils::HexStringToInt(value.substr(1, 2));
             green = StrUtils::HexStringToInt(value.substr(3, 2));
@@ -296,7 +413,7 @@ Gfx::Color CLevelParserParam::AsColor()
         alpha = alpha / 255.0f;
     }
 
-    return Gfx::Color(red, green, blue, alpha);
+    return m_converted.emplace<Gfx::Color>(red, green, blue, alpha);
 }
 
 Gfx::Color CLevelParserParam::AsColor(Gfx::Color def)
@@ -311,16 +428,18 @@ glm::vec3 CLevelParserParam::AsPoint()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
+    if (auto converted = std::get_if<glm::vec3>(&m_converted))
+        return *converted;
 
     ParseArray();
 
     if (m_array.size() == 2) //XZ
     {
-        return glm::vec3(m_array[0]->AsFloat(), 0.0f, m_array[1]->AsFloat());
+        return m_converted.emplace<glm::vec3>(m_array[0]->AsFloat(), 0.0f, m_array[1]->AsFloat());
     }
     else if (m_array.size() == 3) //XYZ
     {
-        return glm::vec3(m_array[0]->AsFloat(), m_array[1]->AsFloat(), m_array[2]->AsFloat());
+        return m_converted.emplace<glm::vec3>(m_array[0]->AsFloat(), m_array[1]->AsFloat(), m_array[2]->AsFloat());
     }
     else
     {
@@ -336,7 +455,7 @@ glm::vec3 CLevelParserParam::AsPoint(glm::vec3 def)
 }
 
 
-ObjectType CLevelParserParam::ToObjectType(std::string value)
+ObjectType CLevelParserParam::ToObjectType(const std::string& value)
 {
     if (value == "All"               ) return OBJECT_NULL; // For use in NewScript
     if (value == "Any"               ) return OBJECT_NULL; // For use in type= in ending conditions
@@ -759,7 +878,9 @@ ObjectType CLevelParserParam::AsObjectType()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return ToObjectType(m_value);
+    if (auto converted = std::get_if<ObjectType>(&m_converted))
+        return *converted;
+    return m_converted.emplace<ObjectType>(ToObjectType(GetText()));
 }
 
 ObjectType CLevelParserParam::AsObjectType(ObjectType def)
@@ -770,7 +891,7 @@ ObjectType CLevelParserParam::AsObjectType(ObjectType def)
 }
 
 
-DriveType CLevelParserParam::ToDriveType(std::string value)
+DriveType CLevelParserParam::ToDriveType(const std::string& value)
 {
     if (value == "Wheeled"   ) return DriveType::Wheeled;
     if (value == "Tracked"   ) return DriveType::Tracked;
@@ -786,7 +907,7 @@ DriveType CLevelParserParam::AsDriveType()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return ToDriveType(m_value);
+    return ToDriveType(GetText());
 }
 
 DriveType CLevelParserParam::AsDriveType(DriveType def)
@@ -797,7 +918,7 @@ DriveType CLevelParserParam::AsDriveType(DriveType def)
 }
 
 
-ToolType CLevelParserParam::ToToolType(std::string value)
+ToolType CLevelParserParam::ToToolType(const std::string& value)
 {
     if (value == "Grabber"    ) return ToolType::Grabber;
     if (value == "Sniffer"    ) return ToolType::Sniffer;
@@ -812,7 +933,7 @@ ToolType CLevelParserParam::AsToolType()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return ToToolType(m_value);
+    return ToToolType(GetText());
 }
 
 ToolType CLevelParserParam::AsToolType(ToolType def)
@@ -823,7 +944,7 @@ ToolType CLevelParserParam::AsToolType(ToolType def)
 }
 
 
-Gfx::WaterType CLevelParserParam::ToWaterType(std::string value)
+Gfx::WaterType CLevelParserParam::ToWaterType(const std::string& value)
 {
     if (value == "nullptr") return Gfx::WATER_NULL;
     if (value == "TT"  ) return Gfx::WATER_TT;
@@ -837,7 +958,7 @@ Gfx::WaterType CLevelParserParam::AsWaterType()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return ToWaterType(m_value);
+    return ToWaterType(GetText());
 }
 
 Gfx::WaterType CLevelParserParam::AsWaterType(Gfx::WaterType def)
@@ -848,7 +969,7 @@ Gfx::WaterType CLevelParserParam::AsWaterType(Gfx::WaterType def)
 }
 
 
-Gfx::EngineObjectType CLevelParserParam::ToTerrainType(std::string value)
+Gfx::EngineObjectType CLevelParserParam::ToTerrainType(const std::string& value)
 {
     if (value == "Terrain") return Gfx::ENG_OBJTYPE_TERRAIN;
     if (value == "Object" ) return Gfx::ENG_OBJTYPE_FIX;
@@ -861,7 +982,7 @@ Gfx::EngineObjectType CLevelParserParam::AsTerrainType()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return ToTerrainType(m_value);
+    return ToTerrainType(GetText());
 }
 
 Gfx::EngineObjectType CLevelParserParam::AsTerrainType(Gfx::EngineObjectType def)
@@ -872,7 +993,7 @@ Gfx::EngineObjectType CLevelParserParam::AsTerrainType(Gfx::EngineObjectType def
 }
 
 
-int CLevelParserParam::ToBuildFlag(std::string value)
+int CLevelParserParam::ToBuildFlag(const std::string& value)
 {
     if (value == "BotFactory"    ) return BUILD_FACTORY;
     if (value == "Derrick"       ) return BUILD_DERRICK;
@@ -899,7 +1020,7 @@ int CLevelParserParam::AsBuildFlag()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return ToBuildFlag(m_value);
+    return ToBuildFlag(GetText());
 }
 
 int CLevelParserParam::AsBuildFlag(int def)
@@ -910,7 +1031,7 @@ int CLevelParserParam::AsBuildFlag(int def)
 }
 
 
-int CLevelParserParam::ToResearchFlag(std::string value)
+int CLevelParserParam::ToResearchFlag(const std::string& value)
 {
     if (value == "TRACKER" ) return RESEARCH_TANK;
     if (value == "WINGER"  ) return RESEARCH_FLY;
@@ -972,7 +1093,7 @@ int CLevelParserParam::AsResearchFlag()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return ToResearchFlag(m_value);
+    return ToResearchFlag(GetText());
 }
 
 int CLevelParserParam::AsResearchFlag(int def)
@@ -982,7 +1103,7 @@ int CLevelParserParam::AsResearchFlag(int def)
     return AsResearchFlag();
 }
 
-CScoreboard::SortType CLevelParserParam::ToSortType(std::string value)
+CScoreboard::SortType CLevelParserParam::ToSortType(const std::string& value)
 {
     if (value == "Points") return CScoreboard::SortType::SORT_POINTS;
     if (value == "Name"  ) return CScoreboard::SortType::SORT_ID;
@@ -993,7 +1114,7 @@ CScoreboard::SortType CLevelParserParam::AsSortType()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return ToSortType(m_value);
+    return ToSortType(GetText());
 }
 
 CScoreboard::SortType CLevelParserParam::AsSortType(CScoreboard::SortType def)
@@ -1003,7 +1124,7 @@ CScoreboard::SortType CLevelParserParam::AsSortType(CScoreboard::SortType def)
     return AsSortType();
 }
 
-Gfx::PyroType CLevelParserParam::ToPyroType(std::string value)
+Gfx::PyroType CLevelParserParam::ToPyroType(const std::string& value)
 {
     if (value == "FRAGt" ) return Gfx::PT_FRAGT;
     if (value == "FRAGo" ) return Gfx::PT_FRAGO;
@@ -1030,7 +1151,7 @@ Gfx::PyroType CLevelParserParam::AsPyroType()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return ToPyroType(m_value);
+    return ToPyroType(GetText());
 }
 
 Gfx::PyroType CLevelParserParam::AsPyroType(Gfx::PyroType def)
@@ -1041,7 +1162,7 @@ Gfx::PyroType CLevelParserParam::AsPyroType(Gfx::PyroType def)
 }
 
 
-Gfx::CameraType CLevelParserParam::ToCameraType(std::string value)
+Gfx::CameraType CLevelParserParam::ToCameraType(const std::string& value)
 {
     if (value == "BACK"   ) return Gfx::CAM_TYPE_BACK;
     if (value == "PLANE"  ) return Gfx::CAM_TYPE_PLANE;
@@ -1061,7 +1182,7 @@ Gfx::CameraType CLevelParserParam::AsCameraType()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return ToCameraType(m_value);
+    return ToCameraType(GetText());
 }
 
 Gfx::CameraType CLevelParserParam::AsCameraType(Gfx::CameraType def)
@@ -1071,7 +1192,7 @@ Gfx::CameraType CLevelParserParam::AsCameraType(Gfx::CameraType def)
     return AsCameraType();
 }
 
-MissionType CLevelParserParam::ToMissionType(std::string value)
+MissionType CLevelParserParam::ToMissionType(const std::string& value)
 {
     if (value == "NORMAL"     ) return MISSION_NORMAL;
     if (value == "RETRO"      ) return MISSION_RETRO;
@@ -1083,7 +1204,7 @@ MissionType CLevelParserParam::AsMissionType()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return ToMissionType(m_value);
+    return ToMissionType(GetText());
 }
 
 MissionType CLevelParserParam::AsMissionType(MissionType def)
@@ -1097,20 +1218,141 @@ Gfx::PlanetType CLevelParserParam::AsPlanetType()
 {
     Gfx::PlanetType planetType{};
 
-    if (m_value == "0")
+    if (GetText() == "0")
         planetType = Gfx::PlanetType::Sky;
-    else if (m_value == "1")
+    else if (GetText() == "1")
         planetType = Gfx::PlanetType::OuterSpace;
 
     return planetType;
 }
 
+bool CLevelParserParam::WriteBinary(std::ostream& ostr)
+{
+    if (m_number.has_value())
+    {
+        if (m_isFloat)
+        {
+            float value = static_cast<float>(*m_number);
+            if (std::trunc(value) == value && std::abs(value) < 1e6f)
+                return CBot::WriteByte(ostr, BINARY_PARAM_WHOLE_FLOAT) && CBot::WriteInt(ostr, static_cast<int>(value));
+
+            return CBot::WriteByte(ostr, BINARY_PARAM_FLOAT) && CBot::WriteFloat(ostr, value);
+        }
+
+        return CBot::WriteByte(ostr, BINARY_PARAM_INT) && CBot::WriteInt(ostr, static_cast<int>(*m_number));
+    }
+
+    if (m_isArray)
+    {
+        if (!CBot::WriteByte(ostr, BINARY_PARAM_ARRAY)) return false;
+        if (!CBot::WriteInt(ostr, m_array.size())) return false;
+        for (auto& value : m_array)
+        {
+            if (!value->WriteBinary(ostr)) return false;
+        }
+        return true;
+    }
+
+    return CBot::WriteByte(ostr, BINARY_PARAM_TEXT) && CBot::WriteString(ostr, m_value);
+}
+
+CLevelParserParamUPtr CLevelParserParam::ReadBinary(std::istream& istr, const std::string& name)
+{
+    char type;
+    if (!CBot::ReadByte(istr, type)) return nullptr;
+
+    CLevelParserParamUPtr param;
+    switch (type)
+    {
+        case BINARY_PARAM_TEXT:
+        {
+            std::string value;
+            if (!ReadBinaryText(istr, value)) return nullptr;
+            param = std::make_unique<CLevelParserParam>(name, value);
+            break;
+        }
+
+        case BINARY_PARAM_INT:
+        {
+            int value;
+            if (!CBot::ReadInt(istr, value)) return nullptr;
+            param = std::make_unique<CLevelParserParam>(value);
+            break;
+        }
+
+        case BINARY_PARAM_WHOLE_FLOAT:
+        {
+            int value;
+            if (!CBot::ReadInt(istr, value)) return nullptr;
+            param = std::make_unique<CLevelParserParam>(static_cast<float>(value));
+            break;
+        }
+
+        case BINARY_PARAM_FLOAT:
+        {
+            float value;
+            if (!CBot::ReadFloat(istr, value)) return nullptr;
+            param = std::make_unique<CLevelParserParam>(value);
+            break;
+        }
+
+        case BINARY_PARAM_ARRAY:
+        {
+            // every value takes at least one byte
+            int count;
+            if (!CBot::ReadInt(istr, count) || count < 0) return nullptr;
+            if (static_cast<std::size_t>(count) > GetBinaryBytesLeft(istr)) return nullptr;
+
+            CLevelParserParamVec array;
+            for (int i = 0; i < count; i++)
+            {
+                auto value = ReadBinary(istr, name + "[" + std::to_string(i) + "]");
+                if (value == nullptr) return nullptr;
+                array.push_back(std::move(value));
+            }
+            param = std::make_unique<CLevelParserParam>(std::move(array));
+            break;
+        }
+
+        default:
+            return nullptr;
+    }
+
+    param->m_name = name;
+    return param;
+}
+
+bool CLevelParserParam::ReadBinaryText(std::istream& istr, std::string& text)
+{
+    // length is unsigned LEB128, as written by CBot::WriteString()
+    std::uint64_t length = 0;
+    for (unsigned shift = 0; ; shift += 7)
+    {
+        char byte;
+        if (!CBot::ReadByte(istr, byte) || shift >= 64) return false;
+
+        length |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) break;
+    }
+
+    if (length > GetBinaryBytesLeft(istr)) return false;
+
+    text.resize(length);
+    return length == 0 || istr.read(text.data(), length);
+}
+
+std::size_t CLevelParserParam::GetBinaryBytesLeft(std::istream& istr)
+{
+    std::streamsize left = istr.rdbuf()->in_avail();
+    return left > 0 ? static_cast<std::size_t>(left) : 0;
+}
+
 void CLevelParserParam::ParseArray()
 {
     if (m_array.size() != 0)
         return;
 
-    std::vector<std::string> values = StrUtils::Split(m_value, ";");
+    std::vector<std::string> values = StrUtils::Split(GetText(), ";");
     int i = 0;
     for (auto& value : values)
     {
@@ -40,7 +40,11 @@
 
 #include <glm/glm.hpp>
 
+#include <istream>
+#include <optional>
+#include <ostream>
 #include <string>
+#include <variant>
 #include <vector>
 #include <memory>
 
@@ -57,6 +61,14 @@ class CEngine;
 enum EngineObjectType : unsigned char;
 }
 
+/**
+ * \class CLevelParserParam
+ * \brief Value of a command argument, converted to the requested type by the getters
+ *
+ * Getters keep the value they converted and generate the text of params created
+ * from values, so they change the param even though they only read it: a param
+ * must not be read from several threads at once.
+ */
 class CLevelParserParam
 {
 public:
@@ -133,27 +145,43 @@ public:
     std::string GetValue();
     bool IsDefined();
 
+    //! Write value in binary level file format
+    bool WriteBinary(std::ostream& ostr);
+    /**
+     * \brief Read value written by WriteBinary(), returns nullptr on error
+     *
+     * \a istr must read from a buffer holding the rest of the file, lengths and counts
+     * larger than what is left in it are errors, see ReadBinaryText().
+     */
+    static CLevelParserParamUPtr ReadBinary(std::istream& istr, const std::string& name);
+    //! Read text written by CBot::WriteString(), returns false on error or if it is longer than what is left in \a istr
+    static bool ReadBinaryText(std::istream& istr, std::string& text);
+    //! Returns number of bytes left in the buffer of \a istr
+    static std::size_t GetBinaryBytesLeft(std::istream& istr);
+
     static const std::string FromObjectType(ObjectType value);
 
 private:
     void ParseArray();
     void LoadArray();
+    //! Returns value as text, generating it first for params created from values
+    const std::string& GetText();
 
     template<typename T> T Cast(const std::string& value, const std::string& requestedType);
     template<typename T> T Cast(const std::string& requestedType);
 
     std::string ToPath(std::string path, const std::string defaultDir);
-    ObjectType ToObjectType(std::string value);
-    DriveType ToDriveType(std::string value);
-    ToolType ToToolType(std::string value);
-    Gfx::WaterType ToWaterType(std::string value);
-    Gfx::EngineObjectType ToTerrainType(std::string value);
-    int ToBuildFlag(std::string value);
-    int ToResearchFlag(std::string value);
-    CScoreboard::SortType ToSortType(std::string value);
-    Gfx::PyroType ToPyroType(std::string value);
-    Gfx::CameraType ToCameraType(std::string value);
-    MissionType ToMissionType(std::string value);
+    ObjectType ToObjectType(const std::string& value);
+    DriveType ToDriveType(const std::string& value);
+    ToolType ToToolType(const std::string& value);
+    Gfx::WaterType ToWaterType(const std::string& value);
+    Gfx::EngineObjectType ToTerrainType(const std::string& value);
+    int ToBuildFlag(const std::string& value);
+    int ToResearchFlag(const std::string& value);
+    CScoreboard::SortType ToSortType(const std::string& value);
+    Gfx::PyroType ToPyroType(const std::string& value);
+    Gfx::CameraType ToCameraType(const std::string& value);
+    MissionType ToMissionType(const std::string& value);
 
     const std::string FromCameraType(Gfx::CameraType value);
 
@@ -161,6 +189,15 @@ private:
     CLevelParserLine* m_line = nullptr;
     bool m_empty = false;
     std::string m_name;
+    //! Value as text, only valid if m_hasText is set
     std::string m_value;
+    bool m_hasText = true;
+    //! Value of params created from int, float or bool, read without parsing text
+    std::optional<double> m_number;
+    bool m_isFloat = false;
+    //! Param created from an array of values
+    bool m_isArray = false;
     CLevelParserParamVec m_array;
+    //! Value returned by the last typed getter, so that values read repeatedly are converted once
+    std::variant<std::monostate, bool, int, float, ObjectType, glm::vec3, Gfx::Color> m_converted;
 };
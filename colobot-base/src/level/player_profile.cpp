@@ -471,6 +471,8 @@ bool CPlayerProfile::HasAnySavedScene()
 
 std::vector<SavedScene> CPlayerProfile::GetSavedSceneList()
 {
+    CRobotMain::GetInstancePointer()->IOWaitWriteScene();
+
     auto saveDirs = CResourceManager::ListDirectories(GetSaveDir());
     std::map<int, SavedScene> sortedSaveDirs;
 
@@ -514,6 +516,8 @@ void CPlayerProfile::SaveScene(std::string dir, std::string info)
 
 void CPlayerProfile::LoadScene(std::string dir)
 {
+    CRobotMain::GetInstancePointer()->IOWaitWriteScene();
+
     CLevelParser levelParser(dir + "/data.sav");
     levelParser.Load();
 
@@ -565,6 +569,8 @@ void CPlayerProfile::LoadScene(std::string dir)
 
 bool CPlayerProfile::DeleteScene(std::string dir)
 {
+    CRobotMain::GetInstancePointer()->IOWaitWriteScene();
+
     if (CResourceManager::DirectoryExists(dir))
     {
         return CResourceManager::RemoveExistingDirectory(dir);
@@ -37,6 +37,8 @@
 #include "common/resources/outputstream.h"
 #include "common/resources/resourcemanager.h"
 
+#include "common/thread/job_system.h"
+
 #include "graphics/core/material.h"
 
 #include "graphics/engine/camera.h"
@@ -57,6 +59,7 @@
 #include "level/mainmovie.h"
 #include "level/player_profile.h"
 #include "level/scene_conditions.h"
+#include "level/scene_writer.h"
 #include "level/scoreboard.h"
 
 #include "level/parser/parser.h"
@@ -87,6 +90,7 @@
 
 #include "script/cbottoken.h"
 #include "script/script.h"
+#include "script/script_scheduler.h"
 #include "script/scriptfunc.h"
 
 #include "sound/sound.h"
@@ -154,6 +158,7 @@ CRobotMain::CRobotMain()
     m_modelManager = std::make_unique<Gfx::CModelManager>();
     m_settings    = std::make_unique<CSettings>();
     m_pause       = std::make_unique<CPauseManager>();
+    m_scriptScheduler = std::make_unique<CScriptScheduler>();
     m_interface   = std::make_unique<Ui::CInterface>();
     m_terrain     = std::make_unique<Gfx::CTerrain>();
     m_camera      = std::make_unique<Gfx::CCamera>();
@@ -310,6 +315,11 @@ CPauseManager* CRobotMain::GetPauseManager()
     return m_pause.get();
 }
 
+CScriptScheduler* CRobotMain::GetScriptScheduler()
+{
+    return m_scriptScheduler.get();
+}
+
 std::string PhaseToString(Phase phase)
 {
     if (phase == PHASE_WELCOME1) return "PHASE_WELCOME1";
@@ -2397,6 +2407,9 @@ bool CRobotMain::EventFrame(const Event &event)
     CObject* toto = nullptr;
     if (!m_pause->IsPauseType(PAUSE_OBJECT_UPDATES))
     {
+        // Programs of all robots share the time given to CBot in a frame
+        m_scriptScheduler->BeginFrame();
+
         // Advances all the robots, but not toto.
         for (CObject* obj : m_objMan->GetAllObjects())
         {
@@ -2435,6 +2448,8 @@ bool CRobotMain::EventFrame(const Event &event)
                 dynamic_cast<CInteractiveObject&>(*obj).EventProcess(event);
         }
 
+        m_scriptScheduler->EndFrame();
+
         m_engine->GetPyroManager()->EventProcess(event);
     }
 
@@ -4683,7 +4698,9 @@ bool CRobotMain::IOWriteScene(std::string filename, std::string filecbot, std::s
 
     std::string dirname = filename.substr(0, filename.find_last_of("/"));
 
-    CLevelParser levelParser(filename);
+    // Only the state of the scene is captured here, files are written by a background job
+    auto writer = std::make_shared<CSceneWriter>(filename, filecbot, !m_textSaves);
+    CLevelParser& levelParser = writer->GetLevelParser();
     CLevelParserLineUPtr line;
 
     line = std::make_unique<CLevelParserLine>("Title");
@@ -4731,6 +4748,8 @@ bool CRobotMain::IOWriteScene(std::string filename, std::string filecbot, std::s
         levelParser.AddLine(std::move(line));
     }
 
+    IOWriteWheelTraces(levelParser);
+
 
     int objRank = 0;
     for (CObject* obj : m_objMan->GetAllObjects())
@@ -4763,19 +4782,8 @@ bool CRobotMain::IOWriteScene(std::string filename, std::string filecbot, std::s
         IOWriteObject(line.get(), obj, dirname, objRank++);
         levelParser.AddLine(std::move(line));
     }
-    try
-    {
-        levelParser.Save();
-    }
-    catch (CLevelParserException& e)
-    {
-        GetLogger()->Error("Failed to save level state - %%", e.what()); // TODO add visual error to notify user that save failed
-        return false;
-    }
-
     // Writes the file of stacks of execution.
-    COutputStream ostr(filecbot);
-    if (!ostr.is_open()) return false;
+    std::ostream& ostr = writer->GetStackStream();
 
     bool bError = false;
     long version = 1;
@@ -4803,7 +4811,23 @@ bool CRobotMain::IOWriteScene(std::string filename, std::string filecbot, std::s
         GetLogger()->Error("CBotClass save static state failed");
     }
 
-    ostr.close();
+    if (emergencySave)
+    {
+        // We may be crashing, there is no time for anything else
+        return writer->Write();
+    }
+
+    // Saves are written in order, a new one waits for the previous one
+    m_shotSaving++;
+    m_saveJob = m_app->GetJobSystem()->Submit([writer]()
+    {
+        writer->Write();
+    },
+    [this]()
+    {
+        m_shotSaving--;
+    },
+    { m_saveJob });
 
     if (!emergencySave)
     {
@@ -4826,6 +4850,12 @@ bool CRobotMain::IOWriteScene(std::string filename, std::string filecbot, std::s
     return true;
 }
 
+//! Waits until the last saved scene is completely written
+void CRobotMain::IOWaitWriteScene()
+{
+    m_app->GetJobSystem()->Wait(m_saveJob);
+}
+
 //! Notifies the user that scene write is finished
 void CRobotMain::IOWriteSceneFinished()
 {
@@ -4833,6 +4863,73 @@ void CRobotMain::IOWriteSceneFinished()
     m_shotSaving--;
 }
 
+//! Writes the traces drawn on the ground into the backup file
+void CRobotMain::IOWriteWheelTraces(CLevelParser& levelParser)
+{
+    const auto& traces = m_particle->GetWheelTraces().GetTraces();
+
+    std::size_t first = 0;
+    while (first < traces.size())
+    {
+        // Traces left by a robot moving on share an edge with the previous one,
+        // a line holds such a run as the list of the edges
+        std::size_t last = first + 1;
+        while (last < traces.size() &&
+               traces[last].color == traces[first].color &&
+               traces[last].pos[0] == traces[last-1].pos[2] &&
+               traces[last].pos[1] == traces[last-1].pos[3])
+        {
+            last++;
+        }
+
+        CLevelParserParamVec points;
+        auto addPoint = [&points](const glm::vec3& pos)
+        {
+            points.push_back(std::make_unique<CLevelParserParam>(pos.x/g_unit));
+            points.push_back(std::make_unique<CLevelParserParam>(pos.y/g_unit));
+            points.push_back(std::make_unique<CLevelParserParam>(pos.z/g_unit));
+        };
+
+        addPoint(traces[first].pos[0]);
+        addPoint(traces[first].pos[1]);
+        for (std::size_t i = first; i < last; i++)
+        {
+            addPoint(traces[i].pos[2]);
+            addPoint(traces[i].pos[3]);
+        }
+
+        auto line = std::make_unique<CLevelParserLine>("WheelTrace");
+        line->AddParam("color", std::make_unique<CLevelParserParam>(static_cast<int>(traces[first].color)));
+        line->AddParam("points", std::make_unique<CLevelParserParam>(std::move(points)));
+        levelParser.AddLine(std::move(line));
+
+        first = last;
+    }
+}
+
+//! Reads a run of traces written by IOWriteWheelTraces()
+void CRobotMain::IOReadWheelTrace(CLevelParserLine* line)
+{
+    int color = line->GetParam("color")->AsInt();
+    if (color < 0 || color >= static_cast<int>(TraceColor::Max)) return;
+
+    const auto& values = line->GetParam("points")->AsArray();
+
+    std::vector<glm::vec3> points;
+    for (std::size_t i = 0; i + 2 < values.size(); i += 3)
+        points.push_back(glm::vec3(values[i]->AsFloat(), values[i+1]->AsFloat(), values[i+2]->AsFloat()) * g_unit);
+
+    Gfx::WheelTrace trace;
+    trace.color = static_cast<TraceColor>(color);
+    for (std::size_t i = 0; i + 3 < points.size(); i += 2)
+    {
+        for (int j = 0; j < 4; j++)
+            trace.pos[j] = points[i+j];
+
+        m_particle->GetWheelTraces().Add(trace);
+    }
+}
+
 //! Resumes the game
 CObject* CRobotMain::IOReadObject(CLevelParserLine *line, const std::string& programDir, const std::string& objCounterText, float objectProgress, int objRank)
 {
@@ -4885,6 +4982,8 @@ CObject* CRobotMain::IOReadObject(CLevelParserLine *line, const std::string& pro
 //! Resumes some part of the game
 CObject* CRobotMain::IOReadScene(std::string filename, std::string filecbot)
 {
+    IOWaitWriteScene();
+
     std::string dirname = filename.substr(0, filename.find_last_of("/"));
 
     CLevelParser levelParser(filename);
@@ -4920,6 +5019,9 @@ CObject* CRobotMain::IOReadScene(std::string filename, std::string filecbot)
             m_lightning->SetStatus(sleep, delay, magnetic, progress);
         }
 
+        if (line->GetCommand() == "WheelTrace")
+            IOReadWheelTrace(line.get());
+
         if (line->GetCommand() == "CreateFret")
         {
             cargo = IOReadObject(line.get(), dirname, StrUtils::ToString<int>(objCounter+1)+" / "+StrUtils::ToString<int>(numObjects), static_cast<float>(objCounter) / static_cast<float>(numObjects));
@@ -5811,6 +5913,16 @@ int CRobotMain::GetAutosaveSlots()
     return m_autosaveSlots;
 }
 
+void CRobotMain::SetTextSaves(bool text)
+{
+    m_textSaves = text;
+}
+
+bool CRobotMain::GetTextSaves()
+{
+    return m_textSaves;
+}
+
 // Remove oldest saves with autosave prefix
 void CRobotMain::AutosaveRotate()
 {
@@ -5818,6 +5930,8 @@ void CRobotMain::AutosaveRotate()
         return;
 
     GetLogger()->Debug("Rotate autosaves...");
+    IOWaitWriteScene(); // the last autosave may be about to be removed
+
     auto saveDirs = CResourceManager::ListDirectories(m_playerProfile->GetSaveDir());
     const std::string autosavePrefix = "autosave";
     std::vector<std::string> autosaves;
@@ -30,6 +30,8 @@
 #include "common/event.h"
 #include "common/singleton.h"
 
+#include "common/thread/job_system.h"
+
 #include "graphics/engine/camera.h"
 #include "graphics/engine/particle.h"
 
@@ -87,6 +89,7 @@ bool IsMainMenuPhase(Phase phase);
 class CApplication;
 class CEventQueue;
 class CSoundInterface;
+class CLevelParser;
 class CLevelParserLine;
 class CInput;
 class CObjectManager;
@@ -97,6 +100,7 @@ class CPlayerProfile;
 class CSettings;
 class COldObject;
 class CPauseManager;
+class CScriptScheduler;
 struct ActivePause;
 
 namespace Gfx
@@ -193,6 +197,7 @@ public:
     Ui::CInterface* GetInterface();
     Ui::CDisplayText* GetDisplayText();
     CPauseManager* GetPauseManager();
+    CScriptScheduler* GetScriptScheduler();
 
     /**
      * \name Phase management
@@ -336,9 +341,12 @@ public:
     bool        IOIsBusy();
     bool        IOWriteScene(std::string filename, std::string filecbot, std::string filescreenshot, const std::string& info, bool emergencySave = false);
     void        IOWriteSceneFinished();
+    void        IOWaitWriteScene();
     CObject*    IOReadScene(std::string filename, std::string filecbot);
     void        IOWriteObject(CLevelParserLine *line, CObject* obj, const std::string& programDir, int objRank);
     CObject*    IOReadObject(CLevelParserLine *line, const std::string& programDir, const std::string& objCounterText, float objectProgress, int objRank = -1);
+    void        IOWriteWheelTraces(CLevelParser& levelParser);
+    void        IOReadWheelTrace(CLevelParserLine *line);
     //@}
 
     int         CreateSpot(glm::vec3 pos, Gfx::Color color);
@@ -370,6 +378,10 @@ public:
     int         GetAutosaveSlots();
     //@}
 
+    //! Save scenes as text instead of the smaller binary format, for inspection
+    void        SetTextSaves(bool text);
+    bool        GetTextSaves();
+
     //! Enable mode where completing mission closes the game
     void        SetExitAfterMission(bool exit);
 
@@ -584,6 +596,7 @@ protected:
     std::unique_ptr<CObjectManager> m_objMan;
     std::unique_ptr<CMainMovie> m_movie;
     std::unique_ptr<CPauseManager> m_pause;
+    std::unique_ptr<CScriptScheduler> m_scriptScheduler;
     std::unique_ptr<Gfx::CModelManager> m_modelManager;
     std::unique_ptr<Gfx::CTerrain> m_terrain;
     std::unique_ptr<Gfx::CCamera> m_camera;
@@ -746,7 +759,11 @@ protected:
     int             m_autosaveSlots = 0;
     float           m_autosaveLast = 0.0f;
 
+    bool            m_textSaves = false;
+
     int             m_shotSaving = 0;
+    //! Background job writing the last saved scene
+    JobHandle       m_saveJob;
 
     std::deque<CObject*> m_selectionHistory;
     bool            m_debugCrashSpheres;
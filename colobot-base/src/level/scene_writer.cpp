@@ -0,0 +1,90 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "level/scene_writer.h"
+
+#include "common/logger.h"
+
+#include "common/resources/outputstream.h"
+#include "common/resources/resourcemanager.h"
+
+namespace
+{
+
+const std::string TEMPORARY_SUFFIX = ".tmp";
+
+} // anonymous namespace
+
+CSceneWriter::CSceneWriter(const std::string& filename, const std::string& filecbot, bool binary)
+    : m_filename(filename),
+      m_filecbot(filecbot),
+      m_binary(binary),
+      m_levelParser(filename + TEMPORARY_SUFFIX)
+{
+}
+
+CLevelParser& CSceneWriter::GetLevelParser()
+{
+    return m_levelParser;
+}
+
+std::ostream& CSceneWriter::GetStackStream()
+{
+    return m_stacks;
+}
+
+bool CSceneWriter::Write()
+{
+    try
+    {
+        if (m_binary)
+            m_levelParser.SaveBinary();
+        else
+            m_levelParser.Save();
+    }
+    catch (CLevelParserException& e)
+    {
+        GetLogger()->Error("Failed to save level state - %%", e.what()); // TODO add visual error to notify user that save failed
+        return false;
+    }
+
+    std::string tempcbot = m_filecbot + TEMPORARY_SUFFIX;
+    {
+        COutputStream ostr(tempcbot);
+        if (!ostr.is_open())
+        {
+            GetLogger()->Error("Failed to open file: %%", tempcbot);
+            return false;
+        }
+
+        ostr << m_stacks.rdbuf();
+        ostr.flush();
+        if (!ostr)
+        {
+            GetLogger()->Error("Failed to write file: %%", tempcbot);
+            return false;
+        }
+    }
+
+    // Both files are complete now, the level file goes last as it is the one listed as a saved game
+    if (!CResourceManager::Move(tempcbot, m_filecbot)) return false;
+    if (!CResourceManager::Move(m_levelParser.GetFilename(), m_filename)) return false;
+
+    return true;
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file level/scene_writer.h
+ * \brief Writing of saved scenes to disk - CSceneWriter class
+ */
+
+#pragma once
+
+#include "level/parser/parser.h"
+
+#include <sstream>
+#include <string>
+
+/**
+ * \class CSceneWriter
+ * \brief Writes a saved scene to disk
+ *
+ * The state of the scene is captured on the main thread into the level file
+ * lines and the serialized program stacks. Write() only formats and writes
+ * them, so it can be run as a background job.
+ *
+ * The level file is written in the binary level format unless text was
+ * requested, see CLevelParser::SaveBinary().
+ *
+ * Files are first written under temporary names and renamed when complete,
+ * so an interrupted save never leaves a half-written file behind.
+ */
+class CSceneWriter
+{
+public:
+    CSceneWriter(const std::string& filename, const std::string& filecbot, bool binary = true);
+
+    CSceneWriter(const CSceneWriter&) = delete;
+    CSceneWriter& operator=(const CSceneWriter&) = delete;
+
+    //! Returns parser of the level file (data.sav) to add lines to
+    CLevelParser& GetLevelParser();
+    //! Returns stream for the program stacks (cbot.run)
+    std::ostream& GetStackStream();
+
+    //! Writes both files, returns false on error
+    bool Write();
+
+private:
+    std::string m_filename;
+    std::string m_filecbot;
+    bool m_binary;
+    CLevelParser m_levelParser;
+    std::stringstream m_stacks;
+};
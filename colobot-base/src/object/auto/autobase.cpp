@@ -1237,7 +1237,7 @@ void CAutoBase::UpdateInterface()
 void CAutoBase::FreezeCargo(bool freeze)
 {
     m_cargoObjects.clear();
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(m_pos, 32.0f))
     {
         if ( obj == m_object )  continue;  // yourself?
         if (IsObjectBeingTransported(obj)) continue;
@@ -399,7 +399,7 @@ CObject* CAutoConvert::SearchStone(ObjectType type)
 {
     glm::vec3 cPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(cPos, 5.0f))
     {
         ObjectType oType = obj->GetType();
         if ( oType != type )  continue;
@@ -420,7 +420,7 @@ bool CAutoConvert::SearchVehicle()
 {
     glm::vec3 cPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(cPos, 8.0f, true))
     {
         if (obj == m_object) continue;
         ObjectType type = obj->GetType();
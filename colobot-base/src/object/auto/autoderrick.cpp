@@ -464,7 +464,7 @@ bool CAutoDerrick::Read(CLevelParserLine* line)
 CObject* CAutoDerrick::SearchCargo()
 {
     glm::vec3 cargoPos = GetCargoPos();
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(cargoPos, 0.0f))
     {
         ObjectType type = obj->GetType();
         if ( type == OBJECT_DERRICK )  continue;
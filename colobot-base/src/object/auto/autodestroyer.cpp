@@ -282,7 +282,7 @@ CObject* CAutoDestroyer::SearchPlastic()
 {
     glm::vec3 sPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(sPos, 5.0f))
     {
         if (obj == m_object) continue;
         if (!obj->Implements(ObjectInterfaceType::Destroyable)) continue;
@@ -560,7 +560,7 @@ bool CAutoFactory::Read(CLevelParserLine* line)
 
 CObject* CAutoFactory::SearchCargo()
 {
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(m_cargoPos, 8.0f))
     {
         ObjectType type = obj->GetType();
         if ( type != OBJECT_METAL )  continue;
@@ -689,7 +689,7 @@ bool CAutoFactory::CreateVehicle()
 
 CObject* CAutoFactory::SearchVehicle()
 {
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(m_cargoPos, 8.0f))
     {
         if ( !obj->GetLock() )  continue;
 
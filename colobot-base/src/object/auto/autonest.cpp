@@ -178,7 +178,7 @@ void CAutoNest::CreateCargo(glm::vec3 pos, float angle, ObjectType type)
 
 CObject* CAutoNest::SearchCargo()
 {
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(m_cargoPos, 0.0f))
     {
         if ( !obj->GetLock() )  continue;
 
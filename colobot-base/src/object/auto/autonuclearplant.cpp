@@ -334,7 +334,7 @@ CObject* CAutoNuclearPlant::SearchUranium()
 
 bool CAutoNuclearPlant::SearchVehicle()
 {
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(m_pos, 10.0f, true))
     {
         ObjectType type = obj->GetType();
         if ( type != OBJECT_HUMAN    &&
@@ -246,7 +246,7 @@ void CAutoPowerCaptor::ChargeObject(float rTime)
 {
     glm::vec3 sPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(sPos, 20.0f))
     {
         glm::vec3 oPos = obj->GetPosition();
         float dist = glm::distance(oPos, sPos);
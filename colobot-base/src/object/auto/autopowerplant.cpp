@@ -402,7 +402,7 @@ bool CAutoPowerPlant::SearchVehicle()
 {
     glm::vec3 cPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(cPos, 10.0f, true))
     {
         ObjectType type = obj->GetType();
         if ( type != OBJECT_HUMAN    &&
@@ -476,7 +476,7 @@ CObject* CAutoPowerPlant::SearchPower()
 {
     glm::vec3 cPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(cPos, 0.0f))
     {
         if ( !obj->GetLock() )  continue;
 
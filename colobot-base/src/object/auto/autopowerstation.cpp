@@ -224,7 +224,7 @@ CObject* CAutoPowerStation::SearchVehicle()
 {
     glm::vec3 sPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(sPos, 5.0f))
     {
         ObjectType type = obj->GetType();
         if ( type != OBJECT_HUMAN    &&
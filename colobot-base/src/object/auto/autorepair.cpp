@@ -241,7 +241,7 @@ CObject* CAutoRepair::SearchVehicle()
 {
     glm::vec3 sPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(sPos, 5.0f))
     {
         if (obj == m_object) continue;
         if ( !obj->Implements(ObjectInterfaceType::Shielded) ) continue;
@@ -264,7 +264,7 @@ CObject* CAutoTower::SearchTarget(glm::vec3 &impact)
     float min = 1000000.0f;
 
     CObject* best = nullptr;
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(iPos, TOWER_SCOPE, true))
     {
         int oTeam=obj->GetTeam();
         int myTeam=m_object->GetTeam();
@@ -396,7 +396,7 @@ int CAutoVault::CountKeys()
         m_keyPos[index] = cPos;
     }
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(cPos, 20.0f))
     {
         if (IsObjectBeingTransported(obj))  continue;
 
@@ -467,7 +467,7 @@ void CAutoVault::LockKeys()
 {
     glm::vec3 cPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(cPos, 20.0f))
     {
         ObjectType oType = obj->GetType();
         if (IsObjectBeingTransported(obj))  continue;
@@ -491,7 +491,7 @@ void CAutoVault::DownKeys(float progress)
 {
     glm::vec3 cPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(cPos, 20.0f))
     {
         ObjectType oType = obj->GetType();
         if (IsObjectBeingTransported(obj))  continue;
@@ -548,7 +548,7 @@ CObject* CAutoVault::SearchVehicle()
 {
     glm::vec3 cPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsNear(cPos, 4.0f))
     {
         if ( obj == m_object )  continue;
         if (IsObjectBeingTransported(obj))  continue;
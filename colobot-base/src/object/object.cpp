@@ -32,6 +32,8 @@
 
 #include "math/const.h"
 
+#include "object/object_manager.h"
+
 #include "script/scriptfunc.h"
 
 #include <stdexcept>
@@ -88,6 +90,7 @@ void CObject::SetCrashSpheres(const std::vector<Gfx::ModelCrashSphere>& crashSph
 void CObject::AddCrashSphere(const CrashSphere& crashSphere)
 {
     m_crashSpheres.push_back(crashSphere);
+    UpdateShapeInManager();
 }
 
 CrashSphere CObject::GetFirstCrashSphere()
@@ -261,6 +264,13 @@ int CObject::GetCrashSphereCount()
 void CObject::DeleteAllCrashSpheres()
 {
     m_crashSpheres.clear();
+    UpdateShapeInManager();
+}
+
+void CObject::UpdateShapeInManager()
+{
+    if (CObjectManager::IsCreated())
+        CObjectManager::GetInstancePointer()->UpdateObjectShape(this);
 }
 
 void CObject::SetCameraCollisionSphere(const Math::Sphere& sphere)
@@ -212,6 +212,9 @@ public:
     virtual bool IsBulletWall() { return false; }
 
 protected:
+    //! Tells CObjectManager that the scale or the crash spheres changed, see CObjectManager::UpdateObjectShape()
+    void UpdateShapeInManager();
+
     //! Transform crash sphere by object's world matrix
     virtual void TransformCrashSphere(Math::Sphere& crashSphere) = 0;
     //! Transform crash sphere by object's world matrix
@@ -0,0 +1,163 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "object/object_grid.h"
+
+#include "object/object.h"
+
+#include <cmath>
+
+
+void CObjectGrid::Add(CObject* object)
+{
+    if (m_entries.count(object) != 0) return;
+
+    UpdateCrashSphereReach(object);
+    Insert(object, GetCellKey(object));
+}
+
+void CObjectGrid::Remove(CObject* object)
+{
+    auto it = m_entries.find(object);
+    if (it == m_entries.end()) return;
+
+    Entry entry = it->second;
+    m_entries.erase(it);
+    Erase(entry.key, entry.index);
+}
+
+void CObjectGrid::Update(CObject* object)
+{
+    auto it = m_entries.find(object);
+    if (it == m_entries.end()) return;
+
+    std::int64_t key = GetCellKey(object);
+    if (key == it->second.key) return;
+
+    Entry entry = it->second;
+    m_entries.erase(it);
+    Erase(entry.key, entry.index);
+
+    UpdateCrashSphereReach(object);
+    Insert(object, key);
+}
+
+void CObjectGrid::UpdateShape(CObject* object)
+{
+    if (m_entries.count(object) == 0) return;
+
+    UpdateCrashSphereReach(object);
+}
+
+void CObjectGrid::Clear()
+{
+    m_cells.clear();
+    m_entries.clear();
+    m_crashSphereReach = 0.0f;
+}
+
+int CObjectGrid::GetCount() const
+{
+    return static_cast<int>(m_entries.size());
+}
+
+void CObjectGrid::Find(const glm::vec3& center, float radius, std::vector<CObject*>& objects) const
+{
+    int minX = static_cast<int>(std::floor((center.x - radius) / CELL_SIZE));
+    int maxX = static_cast<int>(std::floor((center.x + radius) / CELL_SIZE));
+    int minZ = static_cast<int>(std::floor((center.z - radius) / CELL_SIZE));
+    int maxZ = static_cast<int>(std::floor((center.z + radius) / CELL_SIZE));
+
+    // Large areas are cheaper to check cell by cell than by looking up every cell they cover
+    if (static_cast<std::size_t>(maxX - minX + 1) * static_cast<std::size_t>(maxZ - minZ + 1) > m_cells.size())
+    {
+        for (const auto& [key, cell] : m_cells)
+        {
+            int x = static_cast<int>(key >> 32);
+            int z = static_cast<int>(static_cast<std::int32_t>(key & 0xffffffff));
+            if (x < minX || x > maxX || z < minZ || z > maxZ) continue;
+
+            objects.insert(objects.end(), cell.begin(), cell.end());
+        }
+        return;
+    }
+
+    for (int x = minX; x <= maxX; x++)
+    {
+        for (int z = minZ; z <= maxZ; z++)
+        {
+            auto it = m_cells.find(GetCellKey(x, z));
+            if (it == m_cells.end()) continue;
+
+            objects.insert(objects.end(), it->second.begin(), it->second.end());
+        }
+    }
+}
+
+float CObjectGrid::GetCrashSphereReach() const
+{
+    return m_crashSphereReach;
+}
+
+std::int64_t CObjectGrid::GetCellKey(int x, int z)
+{
+    return (static_cast<std::int64_t>(x) << 32) | static_cast<std::uint32_t>(z);
+}
+
+std::int64_t CObjectGrid::GetCellKey(CObject* object)
+{
+    glm::vec3 pos = object->GetPosition();
+    return GetCellKey(static_cast<int>(std::floor(pos.x / CELL_SIZE)),
+                      static_cast<int>(std::floor(pos.z / CELL_SIZE)));
+}
+
+void CObjectGrid::UpdateCrashSphereReach(CObject* object)
+{
+    if (object->GetCrashSphereCount() == 0) return;
+
+    // Rotations keep the distance to the sphere, only changes of scale or spheres make it grow, see UpdateShape()
+    auto sphere = object->GetFirstCrashSphere().sphere;
+    float reach = glm::distance(sphere.pos, object->GetPosition()) + sphere.radius;
+    if (reach > m_crashSphereReach)
+        m_crashSphereReach = reach;
+}
+
+void CObjectGrid::Insert(CObject* object, std::int64_t key)
+{
+    auto& cell = m_cells[key];
+    m_entries[object] = { key, cell.size() };
+    cell.push_back(object);
+}
+
+void CObjectGrid::Erase(std::int64_t key, std::size_t index)
+{
+    auto it = m_cells.find(key);
+    auto& cell = it->second;
+
+    // Moves the last object of the cell in place of the removed one
+    if (index + 1 != cell.size())
+    {
+        cell[index] = cell.back();
+        m_entries[cell[index]].index = index;
+    }
+    cell.pop_back();
+
+    if (cell.empty())
+        m_cells.erase(it);
+}
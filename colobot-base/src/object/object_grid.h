@@ -0,0 +1,102 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file object/object_grid.h
+ * \brief Spatial index of objects - CObjectGrid class
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class CObject;
+
+/**
+ * \class CObjectGrid
+ * \brief Groups objects by square cells of the XZ plane to find the objects near a point
+ *
+ * The grid must be told about every move of an object with Update(),
+ * which only does work when the object enters another cell.
+ */
+class CObjectGrid
+{
+public:
+    //! Side of the square cells
+    static constexpr float CELL_SIZE = 64.0f;
+
+    //! Adds an object at its current position
+    void Add(CObject* object);
+    //! Removes an object
+    void Remove(CObject* object);
+    //! Moves an object to the cell of its current position, objects not in the grid are ignored
+    void Update(CObject* object);
+    //! Takes into account a change of scale or of crash spheres of an object, objects not in the grid are ignored
+    void UpdateShape(CObject* object);
+    //! Removes all objects
+    void Clear();
+
+    //! Returns the number of objects in the grid
+    int GetCount() const;
+
+    /**
+     * \brief Appends the objects whose position may be within \a radius of \a center on the XZ plane
+     *
+     * These are all objects of the cells touching the square around \a center,
+     * so the caller still has to check the distance it needs.
+     */
+    void Find(const glm::vec3& center, float radius, std::vector<CObject*>& objects) const;
+
+    /**
+     * \brief Returns how far from its position an object may have the surface of its first crash sphere
+     *
+     * This is the largest such distance seen for the objects of the grid since the last Clear(),
+     * so UpdateShape() must be called when the first crash sphere of an object may have grown.
+     */
+    float GetCrashSphereReach() const;
+
+private:
+    //! Returns the key of the cell containing the given coordinates
+    static std::int64_t GetCellKey(int x, int z);
+    //! Returns the key of the cell containing the position of the object
+    static std::int64_t GetCellKey(CObject* object);
+    //! Takes into account the first crash sphere of the object in GetCrashSphereReach()
+    void UpdateCrashSphereReach(CObject* object);
+    //! Inserts the object in a cell
+    void Insert(CObject* object, std::int64_t key);
+    //! Removes the object at the given index of a cell
+    void Erase(std::int64_t key, std::size_t index);
+
+private:
+    //! Location of an object in m_cells
+    struct Entry
+    {
+        std::int64_t key = 0;
+        std::size_t index = 0;
+    };
+
+    std::unordered_map<std::int64_t, std::vector<CObject*>> m_cells;
+    std::unordered_map<CObject*, Entry> m_entries;
+    float m_crashSphereReach = 0.0f;
+};
@@ -64,6 +64,8 @@ bool CObjectManager::DeleteObject(CObject* instance)
     if (oldObj != nullptr)
         oldObj->DeleteObject();
 
+    m_grid.Remove(instance);
+
     auto it = m_objects.find(instance->GetID());
     if (it != m_objects.end())
     {
@@ -106,6 +108,7 @@ void CObjectManager::DeleteAllObjects()
         }
     }
 
+    m_grid.Clear();
     m_objects.clear();
 
     m_nextId = 0;
@@ -153,6 +156,7 @@ CObject* CObjectManager::CreateObject(ObjectCreateParams params)
     CObject* objectPtr = objectUPtr.get();
 
     m_objects[params.id] = std::move(objectUPtr);
+    m_grid.Add(objectPtr);
 
     return objectPtr;
 }
@@ -237,6 +241,33 @@ int CObjectManager::CountObjectsImplementing(ObjectInterfaceType interface)
     return count;
 }
 
+void CObjectManager::UpdateObjectPosition(CObject* object)
+{
+    m_grid.Update(object);
+}
+
+void CObjectManager::UpdateObjectShape(CObject* object)
+{
+    m_grid.UpdateShape(object);
+}
+
+std::vector<CObject*> CObjectManager::GetObjectsNear(const glm::vec3& center, float radius, bool firstCrashSphere)
+{
+    if (firstCrashSphere)
+        radius += m_grid.GetCrashSphereReach();
+
+    std::vector<CObject*> objects;
+    m_grid.Find(center, radius, objects);
+
+    // Same order as GetAllObjects(), so that searches keep picking the same object among equals
+    std::sort(objects.begin(), objects.end(), [](CObject* a, CObject* b)
+    {
+        return a->GetID() < b->GetID();
+    });
+
+    return objects;
+}
+
 std::vector<CObject*> CObjectManager::RadarAll(CObject* pThis, ObjectType type, float angle, float focus, float minDist, float maxDist, bool furthest, RadarFilter filter, bool cbotTypes)
 {
     std::vector<ObjectType> types;
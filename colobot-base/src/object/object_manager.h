@@ -29,6 +29,7 @@
 #include "math/const.h"
 
 #include "object/object_create_params.h"
+#include "object/object_grid.h"
 #include "object/object_interface_type.h"
 #include "object/object_type.h"
 
@@ -190,6 +191,19 @@ public:
         return CObjectContainerProxy(m_objects, m_activeObjectIterators);
     }
 
+    //! Updates the position of the object for GetObjectsNear(), must be called when the object moves
+    void UpdateObjectPosition(CObject* object);
+    //! Updates the object for GetObjectsNear(), must be called when its scale or crash spheres change
+    void UpdateObjectShape(CObject* object);
+
+    /**
+     * \brief Returns the objects which may be within \a radius of \a center, in the order of GetAllObjects()
+     *
+     * The result may contain objects further away, callers still check the distance they need.
+     * With \a firstCrashSphere, it contains all objects having the surface of their first crash sphere within \a radius.
+     */
+    std::vector<CObject*> GetObjectsNear(const glm::vec3& center, float radius, bool firstCrashSphere = false);
+
     //! Finds an object, like radar() in CBot
     //@{
     std::vector<CObject*> RadarAll(CObject* pThis,
@@ -305,6 +319,8 @@ private:
 
 private:
     CObjectMap m_objects;
+    //! Objects by position, for GetObjectsNear()
+    CObjectGrid m_grid;
     std::unique_ptr<CObjectFactory> m_objectFactory;
     int m_nextId;
     int m_activeObjectIterators;
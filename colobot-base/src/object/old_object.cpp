@@ -1462,6 +1462,11 @@ void COldObject::SetPartPosition(int part, const glm::vec3 &pos)
     m_objectPart[part].position = pos;
     m_objectPart[part].bTranslate = true;  // it will recalculate the matrices
 
+    if ( part == 0 && CObjectManager::IsCreated() )
+    {
+        CObjectManager::GetInstancePointer()->UpdateObjectPosition(this);
+    }
+
     if ( part == 0 && !m_bFlat )  // main part?
     {
         int rank = m_objectPart[0].object;
@@ -1568,6 +1573,8 @@ void COldObject::SetPartScale(int part, float zoom)
     m_objectPart[part].bZoom = ( m_objectPart[part].zoom.x != 1.0f ||
                                  m_objectPart[part].zoom.y != 1.0f ||
                                  m_objectPart[part].zoom.z != 1.0f );
+
+    if ( part == 0 )  UpdateShapeInManager();
 }
 
 void COldObject::SetPartScale(int part, glm::vec3 zoom)
@@ -1578,6 +1585,8 @@ void COldObject::SetPartScale(int part, glm::vec3 zoom)
     m_objectPart[part].bZoom = ( m_objectPart[part].zoom.x != 1.0f ||
                                  m_objectPart[part].zoom.y != 1.0f ||
                                  m_objectPart[part].zoom.z != 1.0f );
+
+    if ( part == 0 )  UpdateShapeInManager();
 }
 
 glm::vec3 COldObject::GetPartScale(int part) const
@@ -1593,6 +1602,8 @@ void COldObject::SetPartScaleX(int part, float zoom)
     m_objectPart[part].bZoom = ( m_objectPart[part].zoom.x != 1.0f ||
                                  m_objectPart[part].zoom.y != 1.0f ||
                                  m_objectPart[part].zoom.z != 1.0f );
+
+    if ( part == 0 )  UpdateShapeInManager();
 }
 
 void COldObject::SetPartScaleY(int part, float zoom)
@@ -1603,6 +1614,8 @@ void COldObject::SetPartScaleY(int part, float zoom)
     m_objectPart[part].bZoom = ( m_objectPart[part].zoom.x != 1.0f ||
                                  m_objectPart[part].zoom.y != 1.0f ||
                                  m_objectPart[part].zoom.z != 1.0f );
+
+    if ( part == 0 )  UpdateShapeInManager();
 }
 
 void COldObject::SetPartScaleZ(int part, float zoom)
@@ -1613,6 +1626,8 @@ void COldObject::SetPartScaleZ(int part, float zoom)
     m_objectPart[part].bZoom = ( m_objectPart[part].zoom.x != 1.0f ||
                                  m_objectPart[part].zoom.y != 1.0f ||
                                  m_objectPart[part].zoom.z != 1.0f );
+
+    if ( part == 0 )  UpdateShapeInManager();
 }
 
 float COldObject::GetPartScaleX(int part)
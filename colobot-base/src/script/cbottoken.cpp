@@ -395,6 +395,9 @@ std::string GetHelpFilename(const char *token)
     if ( strcmp(token, "strfind"       ) == 0 )  helpfile = "cbot/string";
     if ( strcmp(token, "strlower"      ) == 0 )  helpfile = "cbot/string";
     if ( strcmp(token, "strupper"      ) == 0 )  helpfile = "cbot/string";
+    if ( strcmp(token, "strjoin"       ) == 0 )  helpfile = "cbot/string";
+    if ( strcmp(token, "strsplit"      ) == 0 )  helpfile = "cbot/string";
+    if ( strcmp(token, "strformat"     ) == 0 )  helpfile = "cbot/string";
     if ( strcmp(token, "open"          ) == 0 )  helpfile = "cbot/open";
     if ( strcmp(token, "close"         ) == 0 )  helpfile = "cbot/close";
     if ( strcmp(token, "writeln"       ) == 0 )  helpfile = "cbot/writeln";
@@ -442,6 +445,8 @@ bool IsType(const char *token)
     if ( strcmp(token, "point"  ) == 0 )  return true;
     if ( strcmp(token, "object" ) == 0 )  return true;
     if ( strcmp(token, "file"   ) == 0 )  return true;
+    if ( strcmp(token, "map"    ) == 0 )  return true;
+    if ( strcmp(token, "set"    ) == 0 )  return true;
     return false;
 }
 
@@ -523,6 +528,9 @@ bool IsFunction(const char *token)
     if ( strcmp(token, "strfind"      ) == 0 )  return true;
     if ( strcmp(token, "strlower"     ) == 0 )  return true;
     if ( strcmp(token, "strupper"     ) == 0 )  return true;
+    if ( strcmp(token, "strjoin"      ) == 0 )  return true;
+    if ( strcmp(token, "strsplit"     ) == 0 )  return true;
+    if ( strcmp(token, "strformat"    ) == 0 )  return true;
     if ( strcmp(token, "open"         ) == 0 )  return true;
     if ( strcmp(token, "close"        ) == 0 )  return true;
     if ( strcmp(token, "writeln"      ) == 0 )  return true;
@@ -632,6 +640,9 @@ const char* GetHelpText(const char *token)
     if ( strcmp(token, "strfind"   ) == 0 )  return "strfind ( string, substring );";
     if ( strcmp(token, "strlower"  ) == 0 )  return "strlower ( string );";
     if ( strcmp(token, "strupper"  ) == 0 )  return "strupper ( string );";
+    if ( strcmp(token, "strjoin"   ) == 0 )  return "strjoin ( array, separator );";
+    if ( strcmp(token, "strsplit"  ) == 0 )  return "strsplit ( string, separator );";
+    if ( strcmp(token, "strformat" ) == 0 )  return "strformat ( format, value, ... );";
     if ( strcmp(token, "open"      ) == 0 )  return "file.open ( filename, mode );";
     if ( strcmp(token, "close"     ) == 0 )  return "file.close ( );";
     if ( strcmp(token, "writeln"   ) == 0 )  return "file.writeln ( string );";
@@ -24,6 +24,7 @@
 
 #include "common/restext.h"
 #include "common/stringutils.h"
+#include "common/timeutils.h"
 
 #include "common/resources/inputstream.h"
 #include "common/resources/outputstream.h"
@@ -37,6 +38,8 @@
 #include "object/old_object.h"
 
 #include "script/cbottoken.h"
+#include "script/script_scheduler.h"
+#include "script/scriptfunc.h"
 
 #include "ui/displaytext.h"
 
@@ -44,6 +47,7 @@
 #include "ui/controls/interface.h"
 #include "ui/controls/list.h"
 
+#include <chrono>
 #include <libintl.h>
 
 const int CBOT_IPF = 100;       // CBOT: default number of instructions / frame
@@ -240,7 +244,8 @@ bool CScript::Compile()
         m_botProg = std::make_unique<CBot::CBotProgram>(m_object->GetBotVar());
     }
 
-    if ( m_botProg->Compile(m_script.get(), functionList, this) )
+    ScriptCompileInfo info = GetCompileInfo();
+    if ( m_botProg->Compile(m_script.get(), functionList, &info) )
     {
         if (functionList.empty())
         {
@@ -363,7 +368,15 @@ bool CScript::Continue()
         return false;
     }
 
-    if ( m_botProg->Run(this, m_ipf) )
+    // m_ipf is only an upper bound, all programs share the frame time
+    CScriptScheduler* scheduler = m_main->GetScriptScheduler();
+    int ticks = scheduler->GetTimerBudget(m_ipf);
+
+    TimeUtils::TimeStamp start = std::chrono::high_resolution_clock::now();
+    bool finished = m_botProg->Run(this, ticks);
+    scheduler->AddRun(m_botProg->GetRunTicks(), TimeUtils::ExactDiff(start, std::chrono::high_resolution_clock::now()));
+
+    if ( finished )
     {
         m_botProg->GetError(m_error, m_cursor1, m_cursor2);
         if ( m_cursor1 < 0 || m_cursor1 > m_len ||
@@ -651,8 +664,7 @@ void CScript::ColorizeScript(Ui::CEdit* edit, int rangeStart, int rangeEnd)
     edit->SetFormat(rangeStart, rangeEnd, Gfx::FONT_HIGHLIGHT_COMMENT); // anything not processed is a comment
 
     // NOTE: Images are registered as index in some array, and that can be 0 which normally ends the string!
-    std::string text = edit->GetText();
-    text = text.substr(rangeStart, rangeEnd-rangeStart);
+    std::string text = edit->GetText().substr(rangeStart, rangeEnd-rangeStart);
 
     auto tokens = CBot::CBotToken::CompileTokens(text.c_str());
     CBot::CBotToken* bt = tokens.get();
@@ -1085,3 +1097,10 @@ const std::string& CScript::GetFilename()
 {
     return m_filename;
 }
+
+ScriptCompileInfo CScript::GetCompileInfo()
+{
+    ScriptCompileInfo info;
+    info.objectType = m_object->GetType();
+    return info;
+}
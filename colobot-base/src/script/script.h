@@ -35,6 +35,7 @@ class COldObject;
 class CTaskExecutorObject;
 class CRobotMain;
 class CScriptFunctions;
+struct ScriptCompileInfo;
 
 namespace Ui
 {
@@ -95,6 +96,9 @@ public:
     void        SetFilename(const std::string &filename);
     const std::string& GetFilename();
 
+    //! Returns what compile functions of the game know of the program
+    ScriptCompileInfo GetCompileInfo();
+
 protected:
     bool        IsEmpty();
     bool        CheckToken();
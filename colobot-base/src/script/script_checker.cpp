@@ -0,0 +1,98 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "script/script_checker.h"
+
+#include "CBot/CBot.h"
+
+#include "script/script.h"
+#include "script/scriptfunc.h"
+
+#include <vector>
+
+CScriptChecker::CScriptChecker(CJobSystem* jobSystem)
+    : m_jobSystem(jobSystem),
+      m_context(std::make_unique<CBot::CBotContext>())
+{
+}
+
+CScriptChecker::~CScriptChecker()
+{
+    if (m_running)
+        m_jobSystem->Wait(m_job);
+}
+
+bool CScriptChecker::Start(const std::string& text, CScript* script)
+{
+    if (m_running)
+        return false;
+
+    const CBot::CBotContext& main = CBot::CBotContext::GetDefault();
+    bool ignoreUndefined = !main.publicClasses.empty() || !main.publicFunctions.empty();
+
+    // The object may change or be deleted while the check runs
+    ScriptCompileInfo info = script->GetCompileInfo();
+
+    m_running = true;
+    m_job = m_jobSystem->Submit([this, text, info, ignoreUndefined]()
+    {
+        {
+            CBot::CBotContextGuard guard(*m_context);
+            if (!m_bContextReady)
+            {
+                CScriptFunctions::InitContext();
+                m_bContextReady = true;
+            }
+
+            m_error = CBot::CBotNoErr;
+            m_cursor1 = m_cursor2 = 0;
+
+            ScriptCompileInfo compileInfo = info;
+            auto program = std::make_unique<CBot::CBotProgram>();
+            std::vector<std::string> functions;
+            if (!program->Compile(text, functions, &compileInfo))
+            {
+                program->GetError(m_error, m_cursor1, m_cursor2);
+
+                if (ignoreUndefined && (m_error == CBot::CBotErrUndefVar  ||
+                                        m_error == CBot::CBotErrUndefCall ||
+                                        m_error == CBot::CBotErrUndefClass))
+                {
+                    m_error = CBot::CBotNoErr;
+                }
+            }
+        }
+
+        // Last use of the checker, which may be destroyed as soon as this is seen
+        m_running = false;
+    });
+    return true;
+}
+
+bool CScriptChecker::GetResult(CBot::CBotError& error, int& cursor1, int& cursor2)
+{
+    if (m_job == nullptr || m_running)
+        return false;
+
+    m_job = nullptr;
+    error = m_error;
+    cursor1 = m_cursor1;
+    cursor2 = m_cursor2;
+    return true;
+}
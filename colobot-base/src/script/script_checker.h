@@ -0,0 +1,92 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file script/script_checker.h
+ * \brief Compilation of edited programs in background - CScriptChecker class
+ */
+
+#pragma once
+
+#include "CBot/CBotEnums.h"
+
+#include "common/thread/job_system.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+class CScript;
+
+namespace CBot
+{
+class CBotContext;
+}
+
+/**
+ * \class CScriptChecker
+ * \brief Compiles a program being edited on a worker thread of CJobSystem
+ *
+ * The program is compiled in a CBot context of its own, which knows the
+ * functions and classes of the game but not the public functions and classes
+ * of other programs. Errors about undefined names are therefore ignored
+ * when some other program defines public ones.
+ */
+class CScriptChecker
+{
+public:
+    explicit CScriptChecker(CJobSystem* jobSystem);
+    /**
+     * \brief Waits for the running check
+     *
+     * The job system is used only while a check runs, and it finishes all jobs
+     * before it is destroyed, so a checker may outlive it.
+     */
+    ~CScriptChecker();
+
+    /**
+     * \brief Starts compiling \a text
+     * \param text Code of the program
+     * \param script Script the program belongs to, what compile functions of the game need of it is copied now
+     * \return false if the previous check is still running
+     */
+    bool        Start(const std::string& text, CScript* script);
+
+    /**
+     * \brief Gives the result of the last check, once after it finished
+     * \return false if no new result is available
+     */
+    bool        GetResult(CBot::CBotError& error, int& cursor1, int& cursor2);
+
+private:
+    CJobSystem* m_jobSystem;
+    //! Context of the checks, used only by the running check
+    std::unique_ptr<CBot::CBotContext> m_context;
+    //! True when functions of the game are defined in m_context
+    bool        m_bContextReady = false;
+    //! Last check, null once its result was given
+    JobHandle   m_job;
+    //! True until the running check stops using the checker
+    std::atomic<bool> m_running{false};
+
+    //! Result of the last check, written by the check
+    CBot::CBotError m_error = CBot::CBotNoErr;
+    int         m_cursor1 = 0;
+    int         m_cursor2 = 0;
+};
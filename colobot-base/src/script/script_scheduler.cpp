@@ -0,0 +1,110 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "script/script_scheduler.h"
+
+#include "common/profiler.h"
+
+#include <algorithm>
+
+
+namespace
+{
+
+//! Default time of all programs in one frame, in seconds
+const float DEFAULT_FRAME_BUDGET = 0.005f;
+//! Speed assumed until the first frame is measured, in timer ticks per second
+const double INITIAL_TICKS_PER_SECOND = 2000000.0;
+//! Weight of the last frame in the estimated speed
+const double SPEED_SMOOTHING = 0.2;
+
+} // anonymous namespace
+
+
+CScriptScheduler::CScriptScheduler()
+    : m_frameBudget(DEFAULT_FRAME_BUDGET),
+      m_ticksPerSecond(INITIAL_TICKS_PER_SECOND)
+{
+}
+
+CScriptScheduler::~CScriptScheduler()
+{
+}
+
+void CScriptScheduler::SetFrameBudget(float seconds)
+{
+    m_frameBudget = std::max(0.0f, seconds);
+}
+
+float CScriptScheduler::GetFrameBudget() const
+{
+    return m_frameBudget;
+}
+
+void CScriptScheduler::BeginFrame()
+{
+    m_programs = 0;
+    m_frameTicks = 0;
+    m_frameTime = 0;
+    m_ticksLeft = static_cast<long long>(m_frameBudget * m_ticksPerSecond);
+}
+
+void CScriptScheduler::EndFrame()
+{
+    m_expectedPrograms = m_programs;
+
+    // Frames where programs only waited for tasks tell nothing about their speed
+    if (m_frameTicks > 0 && m_frameTime > 0)
+    {
+        double speed = m_frameTicks / (m_frameTime * 1e-9);
+        m_ticksPerSecond += (speed - m_ticksPerSecond) * SPEED_SMOOTHING;
+    }
+
+    CProfiler::AddPerformanceStat(PSTAT_CBOT_TICKS, m_frameTicks);
+}
+
+int CScriptScheduler::GetTimerBudget(int ipf)
+{
+    ++m_programs;
+
+    if (m_frameBudget <= 0.0f || ipf <= 1)
+        return ipf;
+
+    // Programs which did not run yet get equal parts of what is left
+    long long programsLeft = std::max(1, m_expectedPrograms - m_programs + 1);
+    long long share = std::max(0LL, m_ticksLeft) / programsLeft;
+
+    if (share >= ipf)
+        return ipf;
+
+    CProfiler::AddPerformanceStat(PSTAT_CBOT_THROTTLED_PROGRAMS);
+    return static_cast<int>(std::max(1LL, share));
+}
+
+void CScriptScheduler::AddRun(int ticks, long long nanoseconds)
+{
+    m_ticksLeft -= ticks;
+    m_frameTicks += ticks;
+    m_frameTime += nanoseconds;
+}
+
+double CScriptScheduler::GetTicksPerSecond() const
+{
+    return m_ticksPerSecond;
+}
@@ -0,0 +1,84 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file script/script_scheduler.h
+ * \brief Sharing of frame time between running programs - CScriptScheduler class
+ */
+
+#pragma once
+
+
+/**
+ * \class CScriptScheduler
+ * \brief Keeps time spent running CBot programs within a budget per frame
+ *
+ * Every running program asks for its timer ticks (parts of instructions)
+ * before it runs in a frame. The number of ticks which fit in the frame budget
+ * is estimated from the speed measured in previous frames and shared equally
+ * between the programs. Ticks a program does not use, e.g. because it waits
+ * for a task or has a low ipf(), are left to the programs run after it.
+ * The ipf() of a program is always an upper bound of its share.
+ *
+ * Programs given less than their ipf() in a frame are counted
+ * as PSTAT_CBOT_THROTTLED_PROGRAMS in CProfiler.
+ */
+class CScriptScheduler
+{
+public:
+    CScriptScheduler();
+    ~CScriptScheduler();
+
+    //! Sets target time spent by all programs in one frame, in seconds, 0 for no limit
+    void        SetFrameBudget(float seconds);
+    float       GetFrameBudget() const;
+
+    //! Starts a new frame, called before programs run
+    void        BeginFrame();
+    //! Ends the frame, updates estimated speed of programs
+    void        EndFrame();
+
+    /**
+     * \brief Returns the number of timer ticks a program may run now
+     * \param ipf Limit of the program, see CScript::m_ipf
+     * \return Number of ticks, between 1 and \a ipf
+     */
+    int         GetTimerBudget(int ipf);
+    //! Records that a program ran \a ticks timer ticks in \a nanoseconds
+    void        AddRun(int ticks, long long nanoseconds);
+
+    //! Returns the estimated number of timer ticks run per second
+    double      GetTicksPerSecond() const;
+
+private:
+    //! Target time of all programs in one frame, in seconds
+    float       m_frameBudget;
+    //! Estimated number of timer ticks run per second
+    double      m_ticksPerSecond;
+    //! Number of programs run in the previous frame
+    int         m_expectedPrograms = 0;
+    //! Number of programs run so far in this frame
+    int         m_programs = 0;
+    //! Ticks left to share in this frame
+    long long   m_ticksLeft = 0;
+    //! Ticks run in this frame
+    long long   m_frameTicks = 0;
+    //! Time spent running programs in this frame, in nanoseconds
+    long long   m_frameTime = 0;
+};
@@ -2646,10 +2646,7 @@ bool CScriptFunctions::rShield(CBotVar* var, CBotVar* result, int& exception, vo
 
 CBotTypResult CScriptFunctions::cFire(CBotVar* &var, void* user)
 {
-    CObject*    pThis = static_cast<CScript*>(user)->m_object;
-    ObjectType  type;
-
-    type = pThis->GetType();
+    ObjectType  type = static_cast<ScriptCompileInfo*>(user)->objectType;
 
     if ( type == OBJECT_ANT )
     {
@@ -3442,6 +3439,15 @@ private:
 // Initializes all functions for module CBOT.
 
 void CScriptFunctions::Init()
+{
+    InitContext();
+
+    SetFileAccessHandler(std::make_unique<CBotFileAccessHandlerColobot>());
+}
+
+// Defines functions of the game in the current CBot context.
+
+void CScriptFunctions::InitContext()
 {
     CBotProgram::Init();
 
@@ -3626,18 +3632,15 @@ void CScriptFunctions::Init()
     CBotProgram::AddFunction("isbusy",    rIsBusy,    cIsBusy);
     CBotProgram::AddFunction("research",  rResearch,  cResearch);
     CBotProgram::AddFunction("destroy",   rDestroy,   cOneObject);
-
-    SetFileAccessHandler(std::make_unique<CBotFileAccessHandlerColobot>());
 }
 
 
-// Updates the class Object.
+// Updates one field of the class Object.
+// Only fields used by the program are updated, see CBotClass::SetUpdateItemFunc().
 
-void CScriptFunctions::uObject(CBotVar* botThis, void* user)
+void CScriptFunctions::uObject(CBotVar* botThis, CBotVar* item, void* user)
 {
-    CPhysics*   physics;
-    CBotVar     *pVar, *pSub;
-    ObjectType  type;
+    CBotVar*    pSub;
     glm::vec3    pos;
     float       value;
 
@@ -3647,142 +3650,130 @@ void CScriptFunctions::uObject(CBotVar* botThis, void* user)
     assert(obj->Implements(ObjectInterfaceType::Old));
     COldObject* object = static_cast<COldObject*>(obj);
 
-    physics = object->GetPhysics();
-
-    // Updates the object's type.
-    pVar = botThis->GetItemList();  // "category"
-    type = object->GetType();
-    pVar->SetValInt(type, object->GetName());
+    const std::string& name = item->GetName();
 
-    // Updates the position of the object.
-    pVar = pVar->GetNext();  // "position"
-    if (IsObjectBeingTransported(object))
+    if (name == "category")
     {
-        pSub = pVar->GetItemList();  // "x"
-        pSub->SetValFloat(nanf(""));
-        pSub = pSub->GetNext();  // "y"
-        pSub->SetValFloat(nanf(""));
-        pSub = pSub->GetNext();  // "z"
-        pSub->SetValFloat(nanf(""));
+        // Updates the object's type.
+        item->SetValInt(object->GetType(), object->GetName());
     }
-    else
+    else if (name == "position")
     {
-        pos = object->GetPosition();
-        float waterLevel = Gfx::CEngine::GetInstancePointer()->GetWater()->GetLevel();
-        pos.y -= waterLevel;  // relative to sea level!
-        pSub = pVar->GetItemList();  // "x"
-        pSub->SetValFloat(pos.x/g_unit);
-        pSub = pSub->GetNext();  // "y"
-        pSub->SetValFloat(pos.z/g_unit);
-        pSub = pSub->GetNext();  // "z"
-        pSub->SetValFloat(pos.y/g_unit);
-    }
-
-    // Updates the angle.
-    pos = object->GetRotation();
-    pos += object->GetTilt();
-    pVar = pVar->GetNext();  // "orientation"
-    pVar->SetValFloat(Math::NormAngle(2*Math::PI - pos.y)*180.0f/Math::PI);
-    pVar = pVar->GetNext();  // "pitch"
-    pVar->SetValFloat((Math::NormAngle(pos.z + Math::PI) - Math::PI)*180.0f/Math::PI);
-    pVar = pVar->GetNext();  // "roll"
-    pVar->SetValFloat((Math::NormAngle(pos.x + Math::PI) - Math::PI)*180.0f/Math::PI);
-
-    // Updates the energy level of the object.
-    pVar = pVar->GetNext();  // "energyLevel"
-    value = object->GetEnergyLevel();
-    pVar->SetValFloat(value);
-
-    // Updates the shield level of the object.
-    pVar = pVar->GetNext();  // "shieldLevel"
-    if ( !obj->Implements(ObjectInterfaceType::Shielded) ) value = 1.0f;
-    else value = dynamic_cast<CShieldedObject*>(object)->GetShield();
-    pVar->SetValFloat(value);
-
-    // Updates the temperature of the reactor.
-    pVar = pVar->GetNext();  // "temperature"
-    if ( !obj->Implements(ObjectInterfaceType::JetFlying) )  value = 0.0f;
-    else value = 1.0f-dynamic_cast<CJetFlyingObject*>(object)->GetReactorRange();
-    pVar->SetValFloat(value);
-
-    // Updates the height above the ground.
-    pVar = pVar->GetNext();  // "altitude"
-    if ( physics == nullptr )  value = 0.0f;
-    else                 value = physics->GetFloorHeight();
-    pVar->SetValFloat(value/g_unit);
-
-    // Updates the lifetime of the object.
-    pVar = pVar->GetNext();  // "lifeTime"
-    value = object->GetAbsTime();
-    pVar->SetValFloat(value);
-
-    // Updates the type of battery.
-    pVar = pVar->GetNext();  // "energyCell"
-    CSlottedObject *asSlotted = object->Implements(ObjectInterfaceType::Slotted) ? dynamic_cast<CSlottedObject*>(object) : nullptr;
-    if (asSlotted != nullptr && asSlotted->MapPseudoSlot(CSlottedObject::Pseudoslot::POWER) >= 0)
-    {
-        CObject *power = asSlotted->GetSlotContainedObjectReq(CSlottedObject::Pseudoslot::POWER);
-        if (power == nullptr)
+        // Updates the position of the object.
+        if (IsObjectBeingTransported(object))
         {
-            pVar->SetPointer(nullptr);
+            pos = glm::vec3(nanf(""), nanf(""), nanf(""));
         }
-        else if (power->Implements(ObjectInterfaceType::Old))
+        else
         {
-            pVar->SetPointer(power->GetBotVar());
+            pos = object->GetPosition();
+            float waterLevel = Gfx::CEngine::GetInstancePointer()->GetWater()->GetLevel();
+            pos.y -= waterLevel;  // relative to sea level!
+            pos /= g_unit;
         }
+        pSub = item->GetItemList();  // "x"
+        pSub->SetValFloat(pos.x);
+        pSub = pSub->GetNext();  // "y"
+        pSub->SetValFloat(pos.z);
+        pSub = pSub->GetNext();  // "z"
+        pSub->SetValFloat(pos.y);
     }
-
-    // Updates the transported object's type.
-    pVar = pVar->GetNext();  // "load"
-    if (asSlotted != nullptr && asSlotted->MapPseudoSlot(CSlottedObject::Pseudoslot::CARRYING) >= 0)
+    else if (name == "orientation" || name == "pitch" || name == "roll")
     {
-        CObject* cargo = asSlotted->GetSlotContainedObjectReq(CSlottedObject::Pseudoslot::CARRYING);
-        if (cargo == nullptr)
-        {
-            pVar->SetPointer(nullptr);
-        }
-        else if (cargo->Implements(ObjectInterfaceType::Old))
+        // Updates the angle.
+        pos = object->GetRotation();
+        pos += object->GetTilt();
+        if (name == "orientation")
+            item->SetValFloat(Math::NormAngle(2*Math::PI - pos.y)*180.0f/Math::PI);
+        else if (name == "pitch")
+            item->SetValFloat((Math::NormAngle(pos.z + Math::PI) - Math::PI)*180.0f/Math::PI);
+        else
+            item->SetValFloat((Math::NormAngle(pos.x + Math::PI) - Math::PI)*180.0f/Math::PI);
+    }
+    else if (name == "energyLevel")
+    {
+        // Updates the energy level of the object.
+        item->SetValFloat(object->GetEnergyLevel());
+    }
+    else if (name == "shieldLevel")
+    {
+        // Updates the shield level of the object.
+        if ( !obj->Implements(ObjectInterfaceType::Shielded) ) value = 1.0f;
+        else value = dynamic_cast<CShieldedObject*>(object)->GetShield();
+        item->SetValFloat(value);
+    }
+    else if (name == "temperature")
+    {
+        // Updates the temperature of the reactor.
+        if ( !obj->Implements(ObjectInterfaceType::JetFlying) )  value = 0.0f;
+        else value = 1.0f-dynamic_cast<CJetFlyingObject*>(object)->GetReactorRange();
+        item->SetValFloat(value);
+    }
+    else if (name == "altitude")
+    {
+        // Updates the height above the ground.
+        CPhysics* physics = object->GetPhysics();
+        if ( physics == nullptr )  value = 0.0f;
+        else                 value = physics->GetFloorHeight();
+        item->SetValFloat(value/g_unit);
+    }
+    else if (name == "lifeTime")
+    {
+        // Updates the lifetime of the object.
+        item->SetValFloat(object->GetAbsTime());
+    }
+    else if (name == "energyCell" || name == "load")
+    {
+        // Updates the type of battery or the transported object.
+        auto pseudoslot = name == "energyCell" ? CSlottedObject::Pseudoslot::POWER : CSlottedObject::Pseudoslot::CARRYING;
+        CSlottedObject *asSlotted = object->Implements(ObjectInterfaceType::Slotted) ? dynamic_cast<CSlottedObject*>(object) : nullptr;
+        if (asSlotted != nullptr && asSlotted->MapPseudoSlot(pseudoslot) >= 0)
         {
-            pVar->SetPointer(cargo->GetBotVar());
+            CObject *contained = asSlotted->GetSlotContainedObjectReq(pseudoslot);
+            if (contained == nullptr)
+            {
+                item->SetPointer(nullptr);
+            }
+            else if (contained->Implements(ObjectInterfaceType::Old))
+            {
+                item->SetPointer(contained->GetBotVar());
+            }
         }
     }
-
-    pVar = pVar->GetNext();  // "id"
-    value = object->GetID();
-    pVar->SetValInt(value);
-
-    pVar = pVar->GetNext();  // "team"
-    value = object->GetTeam();
-    pVar->SetValInt(value);
-
-    pVar = pVar->GetNext();  // "dead"
-    value = object->IsDying();
-    pVar->SetValInt(value);
-
-    // Updates the velocity of the object.
-    pVar = pVar->GetNext();  // "velocity"
-    if (IsObjectBeingTransported(object) || physics == nullptr)
+    else if (name == "id")
     {
-        pSub = pVar->GetItemList();  // "x"
-        pSub->SetValFloat(nanf(""));
-        pSub = pSub->GetNext();  // "y"
-        pSub->SetValFloat(nanf(""));
-        pSub = pSub->GetNext();  // "z"
-        pSub->SetValFloat(nanf(""));
+        item->SetValInt(object->GetID());
     }
-    else
+    else if (name == "team")
     {
-        glm::mat4 matRotate;
-        Math::LoadRotationZXYMatrix(matRotate, object->GetRotation());
-        pos = physics->GetLinMotion(MO_CURSPEED);
-        pos = Math::Transform(matRotate, pos);
-
-        pSub = pVar->GetItemList();  // "x"
-        pSub->SetValFloat(pos.x/g_unit);
+        item->SetValInt(object->GetTeam());
+    }
+    else if (name == "dead")
+    {
+        item->SetValInt(object->IsDying());
+    }
+    else if (name == "velocity")
+    {
+        // Updates the velocity of the object.
+        CPhysics* physics = object->GetPhysics();
+        if (IsObjectBeingTransported(object) || physics == nullptr)
+        {
+            pos = glm::vec3(nanf(""), nanf(""), nanf(""));
+        }
+        else
+        {
+            glm::mat4 matRotate;
+            Math::LoadRotationZXYMatrix(matRotate, object->GetRotation());
+            pos = physics->GetLinMotion(MO_CURSPEED);
+            pos = Math::Transform(matRotate, pos);
+            pos /= g_unit;
+        }
+        pSub = item->GetItemList();  // "x"
+        pSub->SetValFloat(pos.x);
         pSub = pSub->GetNext();  // "y"
-        pSub->SetValFloat(pos.z/g_unit);
+        pSub->SetValFloat(pos.z);
         pSub = pSub->GetNext();  // "z"
-        pSub->SetValFloat(pos.y/g_unit);
+        pSub->SetValFloat(pos.y);
     }
 }
 
@@ -3791,7 +3782,7 @@ CBotVar* CScriptFunctions::CreateObjectVar(CObject* obj)
     CBotClass* bc = CBotClass::Find("object");
     if ( bc != nullptr )
     {
-        bc->SetUpdateFunc(CScriptFunctions::uObject);
+        bc->SetUpdateItemFunc(CScriptFunctions::uObject);
     }
 
     CBotVar* botVar = CBotVar::Create("", CBotTypResult(CBotTypClass, "object"));
@@ -28,6 +28,8 @@
 
 #include "common/error.h"
 
+#include "object/object_type.h"
+
 #include <string>
 #include <unordered_map>
 #include <memory>
@@ -40,11 +42,24 @@ namespace CBot
 class CBotVar;
 }
 
+/**
+ * \struct ScriptCompileInfo
+ * \brief What compile functions know of the program being compiled, passed as user pointer to CBotProgram::Compile()
+ *
+ * It holds copies rather than pointers to game objects, so that programs can also be compiled on worker threads.
+ */
+struct ScriptCompileInfo
+{
+    //! Type of the object running the program
+    ObjectType objectType = OBJECT_NULL;
+};
 
 class CScriptFunctions
 {
 public:
     static void Init();
+    //! Defines constants, classes and functions of the game in the current CBot context, see CBot::CBotContext
+    static void InitContext();
 
     static CBot::CBotVar* CreateObjectVar(CObject* obj);
     static void DestroyObjectVar(CBot::CBotVar* botVar, bool permanent);
@@ -160,7 +175,7 @@ private:
     static CBot::CBotTypResult cPointConstructor(CBot::CBotVar* pThis, CBot::CBotVar* &var);
     static bool rPointConstructor(CBot::CBotVar* pThis, CBot::CBotVar* var, CBot::CBotVar* pResult, int& Exception, void* user);
 
-    static void uObject(CBot::CBotVar* botThis, void* user);
+    static void uObject(CBot::CBotVar* botThis, CBot::CBotVar* item, void* user);
 
 private:
     static bool     WaitForForegroundTask(CScript* script, CBot::CBotVar* result, int &exception);
@@ -96,7 +96,9 @@ void CALSound::Reset()
 
     m_sounds.clear();
 
+    std::lock_guard<std::mutex> lock(m_musicMutex);
     m_music.clear();
+    m_nextMusic = NextMusic();
 }
 
 bool CALSound::GetEnable()
@@ -149,14 +151,20 @@ void CALSound::CacheMusic(const std::string &filename)
 {
     m_thread.Start([this, filename]()
     {
-        if (m_music.find(filename) == m_music.end())
         {
-            auto buffer = std::make_unique<CBuffer>();
-            if (buffer->LoadFromFile(filename, static_cast<SoundType>(-1)))
-            {
-                m_music[filename] = std::move(buffer);
-            }
+            std::lock_guard<std::mutex> lock(m_musicMutex);
+            if (m_music.find(filename) != m_music.end())
+                return;
         }
+
+        auto music = std::make_unique<CMusicStream>();
+        if (!music->Open(filename))
+            return;
+
+        music->Preload();
+
+        std::lock_guard<std::mutex> lock(m_musicMutex);
+        m_music[filename] = std::move(music);
     });
 }
 
@@ -167,6 +175,7 @@ bool CALSound::IsCached(SoundType sound)
 
 bool CALSound::IsCachedMusic(const std::string &filename)
 {
+    std::lock_guard<std::mutex> lock(m_musicMutex);
     return m_music.find(filename) != m_music.end();
 }
 
@@ -539,6 +548,13 @@ void CALSound::FrameMove(float rTime)
         }
     }
 
+    StartNextMusic();
+
+    if (m_currentMusic)
+    {
+        m_currentMusic->Update();
+    }
+
     auto it = m_oldMusic.begin();
     while (it != m_oldMusic.end())
     {
@@ -550,6 +566,7 @@ void CALSound::FrameMove(float rTime)
         {
             it->currentTime += rTime;
             it->music->SetVolume(((it->fadeTime-it->currentTime) / it->fadeTime) * m_musicVolume);
+            it->music->Update();
             ++it;
         }
     }
@@ -564,6 +581,7 @@ void CALSound::FrameMove(float rTime)
         {
             m_previousMusic.currentTime += rTime;
             m_previousMusic.music->SetVolume(((m_previousMusic.fadeTime-m_previousMusic.currentTime) / m_previousMusic.fadeTime) * m_musicVolume);
+            m_previousMusic.music->Update();
         }
     }
 }
@@ -586,46 +604,75 @@ void CALSound::PlayMusic(const std::string &filename, bool repeat, float fadeTim
         return;
     }
 
-    m_thread.Start([this, filename, repeat, fadeTime]()
-    {
-        CBuffer* buffer = nullptr;
+    int request = ++m_musicRequest;
 
-        // check if we have music in cache
-        if (m_music.find(filename) == m_music.end())
+    // the worker thread only opens the track and decodes its beginning,
+    // the music is started by FrameMove() and the rest is streamed there
+    m_thread.Start([this, filename, repeat, fadeTime, request]()
+    {
+        std::unique_ptr<CMusicStream> music;
         {
-            GetLogger()->Debug("Music %% was not cached!", filename);
-
-            auto newBuffer = std::make_unique<CBuffer>();
-            buffer = newBuffer.get();
-            if (!newBuffer->LoadFromFile(filename, static_cast<SoundType>(-1)))
+            std::lock_guard<std::mutex> lock(m_musicMutex);
+            auto it = m_music.find(filename);
+            if (it != m_music.end())
             {
-                return;
+                // a cached stream is used once, it will be opened again next time
+                GetLogger()->Debug("Music loaded from cache");
+                music = std::move(it->second);
+                m_music.erase(it);
             }
-            m_music[filename] = std::move(newBuffer);
-        }
-        else
-        {
-            GetLogger()->Debug("Music loaded from cache");
-            buffer = m_music[filename].get();
         }
 
-        if (m_currentMusic)
+        if (music == nullptr)
         {
-            OldMusic old;
-            old.music = std::move(m_currentMusic);
-            old.fadeTime = fadeTime;
-            old.currentTime = 0.0f;
-            m_oldMusic.push_back(std::move(old));
+            GetLogger()->Debug("Music %% was not cached!", filename);
+
+            music = std::make_unique<CMusicStream>();
+            if (!music->Open(filename))
+                return;
         }
 
-        m_currentMusic = std::make_unique<CChannel>();
-        m_currentMusic->SetBuffer(buffer);
-        m_currentMusic->SetVolume(m_musicVolume);
-        m_currentMusic->SetLoop(repeat);
-        m_currentMusic->Play();
+        music->SetLoop(repeat);
+        music->Preload();
+
+        std::lock_guard<std::mutex> lock(m_musicMutex);
+        m_nextMusic.music = std::move(music);
+        m_nextMusic.fadeTime = fadeTime;
+        m_nextMusic.request = request;
     });
 }
 
+void CALSound::StartNextMusic()
+{
+    NextMusic next;
+    {
+        std::lock_guard<std::mutex> lock(m_musicMutex);
+        if (m_nextMusic.music == nullptr)
+            return;
+
+        next = std::move(m_nextMusic);
+        m_nextMusic = NextMusic();
+    }
+
+    // music was stopped or other music was requested in the meantime
+    if (next.request != m_musicRequest)
+        return;
+
+    next.music->SetVolume(m_musicVolume);
+    next.music->Play();
+
+    if (m_currentMusic)
+    {
+        OldMusic old;
+        old.music = std::move(m_currentMusic);
+        old.fadeTime = next.fadeTime;
+        old.currentTime = 0.0f;
+        m_oldMusic.push_back(std::move(old));
+    }
+
+    m_currentMusic = std::move(next.music);
+}
+
 void CALSound::PlayPauseMusic(const std::string &filename, bool repeat)
 {
     if (m_previousMusic.fadeTime > 0.0f)
@@ -672,6 +719,9 @@ void CALSound::StopPauseMusic()
 
 void CALSound::StopMusic(float fadeTime)
 {
+    // music still being opened is not started
+    ++m_musicRequest;
+
     if (!m_enabled || m_currentMusic == nullptr)
     {
         return;
@@ -686,7 +736,19 @@ void CALSound::StopMusic(float fadeTime)
 
 bool CALSound::IsPlayingMusic()
 {
-    if (!m_enabled || m_currentMusic == nullptr)
+    if (!m_enabled)
+    {
+        return false;
+    }
+
+    {
+        // music opened by the worker thread starts in the next frame
+        std::lock_guard<std::mutex> lock(m_musicMutex);
+        if (m_nextMusic.music != nullptr && m_nextMusic.request == m_musicRequest)
+            return true;
+    }
+
+    if (m_currentMusic == nullptr)
     {
         return false;
     }
@@ -31,9 +31,11 @@
 #include "sound/oalsound/buffer.h"
 #include "sound/oalsound/channel.h"
 #include "sound/oalsound/check.h"
+#include "sound/oalsound/music_stream.h"
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <list>
 
@@ -62,7 +64,7 @@ struct OldMusic
         return *this;
     }
 
-    std::unique_ptr<CChannel> music;
+    std::unique_ptr<CMusicStream> music;
     float fadeTime = 0.0f;
     float currentTime = 0.0f;
 
@@ -77,6 +79,17 @@ struct OldMusic
     }
 };
 
+/**
+ * \brief Music opened by the worker thread, started by FrameMove() on the main thread
+ */
+struct NextMusic
+{
+    std::unique_ptr<CMusicStream> music;
+    float fadeTime = 0.0f;
+    //! Value of CALSound::m_musicRequest when the music was requested
+    int request = 0;
+};
+
 class CALSound : public CSoundInterface
 {
 public:
@@ -121,6 +134,8 @@ private:
     int GetPriority(SoundType);
     bool SearchFreeBuffer(SoundType sound, int &channel, bool &alreadyLoaded);
     bool CheckChannel(int &channel);
+    //! Starts music opened by the worker thread, if it is still wanted
+    void StartNextMusic();
 
     bool m_enabled;
     float m_audioVolume;
@@ -129,9 +144,15 @@ private:
     ALCdevice* m_device;
     ALCcontext* m_context;
     std::map<SoundType, std::unique_ptr<CBuffer>> m_sounds;
-    std::map<std::string, std::unique_ptr<CBuffer>> m_music;
+    //! Guards m_music and m_nextMusic, shared with the worker thread
+    std::mutex m_musicMutex;
+    //! Opened music with its beginning decoded, by file name
+    std::map<std::string, std::unique_ptr<CMusicStream>> m_music;
+    NextMusic m_nextMusic;
+    //! Incremented by every PlayMusic() and StopMusic(), older requests are dropped
+    int m_musicRequest = 0;
     std::map<int, std::unique_ptr<CChannel>> m_channels;
-    std::unique_ptr<CChannel> m_currentMusic;
+    std::unique_ptr<CMusicStream> m_currentMusic;
     std::list<OldMusic> m_oldMusic;
     OldMusic m_previousMusic;
     glm::vec3 m_eye;
@@ -0,0 +1,332 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "sound/oalsound/music_stream.h"
+
+#include "common/resources/resourcemanager.h"
+#include "common/resources/sndfile_wrapper.h"
+
+
+CMusicStream::CMusicStream()
+    : m_buffers{},
+      m_source(0),
+      m_volume(1.0f),
+      m_ready(false),
+      m_loop(false),
+      m_playing(false),
+      m_ended(false)
+{}
+
+CMusicStream::~CMusicStream()
+{
+    DestroySource();
+}
+
+bool CMusicStream::Open(const std::string& filename)
+{
+    GetLogger()->Debug("Opening music stream: %%", filename);
+
+    m_file = CResourceManager::GetSNDFileHandler(filename);
+    if (!m_file->IsOpen() || m_file->GetFileInfo().channels < 1)
+    {
+        GetLogger()->Warn("Could not load file %%. Reason: %%", filename, m_file->GetLastError());
+        m_file.reset();
+        return false;
+    }
+
+    if (m_file->GetFileInfo().channels > 2)
+    {
+        GetLogger()->Warn("Could not load file %%. Reason: %% channels, only mono and stereo music is supported",
+            filename, m_file->GetFileInfo().channels);
+        m_file.reset();
+        return false;
+    }
+
+    // whole frames only, libsndfile doesn't read partial ones
+    std::size_t channels = m_file->GetFileInfo().channels;
+    m_samples.resize(BUFFER_SAMPLES - BUFFER_SAMPLES % channels);
+    m_preloaded.clear();
+    m_ended = false;
+    return true;
+}
+
+void CMusicStream::Preload()
+{
+    while (!m_ended && m_preloaded.size() < BUFFER_COUNT)
+    {
+        std::vector<int16_t> chunk(m_samples.size());
+        std::size_t count = Decode(chunk.data(), chunk.size());
+        if (count == 0)
+        {
+            m_ended = true;
+            break;
+        }
+
+        chunk.resize(count);
+        m_preloaded.push_back(std::move(chunk));
+    }
+}
+
+std::size_t CMusicStream::Decode(int16_t* samples, std::size_t count)
+{
+    if (m_file == nullptr)
+        return 0;
+
+    count -= count % m_file->GetFileInfo().channels;
+
+    std::size_t total = 0;
+    bool rewound = false;
+    while (total < count)
+    {
+        sf_count_t read = m_file->Read(samples + total, count - total);
+        if (read > 0)
+        {
+            total += read;
+            rewound = false;
+            continue;
+        }
+
+        // end of file, rewinding twice in a row means there is nothing to read
+        if (!m_loop || rewound || m_file->Seek(0) < 0)
+            break;
+
+        rewound = true;
+    }
+
+    return total;
+}
+
+bool CMusicStream::CreateSource()
+{
+    alGenSources(1, &m_source);
+    if (CheckOpenALError())
+    {
+        GetLogger()->Warn("Could not create music source. Code: %%", GetOpenALErrorCode());
+        return false;
+    }
+
+    alGenBuffers(BUFFER_COUNT, m_buffers.data());
+    if (CheckOpenALError())
+    {
+        GetLogger()->Warn("Could not create music buffers. Code: %%", GetOpenALErrorCode());
+        alDeleteSources(1, &m_source);
+        return false;
+    }
+
+    m_ready = true;
+
+    alSourcei(m_source, AL_LOOPING, AL_FALSE);
+    alSourcef(m_source, AL_GAIN, m_volume);
+
+    for (ALuint buffer : m_buffers)
+    {
+        if (!FillBuffer(buffer))
+            break;
+
+        alSourceQueueBuffers(m_source, 1, &buffer);
+    }
+
+    return true;
+}
+
+void CMusicStream::DestroySource()
+{
+    if (!m_ready)
+        return;
+
+    alSourceStop(m_source);
+    alSourcei(m_source, AL_BUFFER, 0);
+    alDeleteSources(1, &m_source);
+    alDeleteBuffers(BUFFER_COUNT, m_buffers.data());
+    if (CheckOpenALError())
+        GetLogger()->Debug("Failed to delete music stream. Code: %%", GetOpenALErrorCode());
+
+    m_ready = false;
+}
+
+bool CMusicStream::FillBuffer(ALuint buffer)
+{
+    std::vector<int16_t> preloaded;
+    const int16_t* samples = m_samples.data();
+    std::size_t count = 0;
+
+    if (!m_preloaded.empty())
+    {
+        preloaded = std::move(m_preloaded.front());
+        m_preloaded.pop_front();
+        samples = preloaded.data();
+        count = preloaded.size();
+    }
+    else
+    {
+        if (m_ended)
+            return false;
+
+        count = Decode(m_samples.data(), m_samples.size());
+        if (count == 0)
+        {
+            m_ended = true;
+            return false;
+        }
+    }
+
+    const SF_INFO& info = m_file->GetFileInfo();
+    ALenum format = info.channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+    alBufferData(buffer, format, samples, count * sizeof(int16_t), info.samplerate);
+    if (CheckOpenALError())
+    {
+        GetLogger()->Warn("Could not fill music buffer. Code: %%", GetOpenALErrorCode());
+        return false;
+    }
+    return true;
+}
+
+bool CMusicStream::Play()
+{
+    if (m_file == nullptr)
+        return false;
+
+    if (!m_ready && !CreateSource())
+        return false;
+
+    alSourcePlay(m_source);
+    if (CheckOpenALError())
+    {
+        GetLogger()->Debug("Could not play music. Code: %%", GetOpenALErrorCode());
+    }
+    m_playing = true;
+    return true;
+}
+
+bool CMusicStream::Pause()
+{
+    if (!m_ready || !m_playing)
+        return false;
+
+    alSourcePause(m_source);
+    if (CheckOpenALError())
+    {
+        GetLogger()->Debug("Could not pause music. Code: %%", GetOpenALErrorCode());
+    }
+    m_playing = false;
+    return true;
+}
+
+bool CMusicStream::Stop()
+{
+    if (!m_ready)
+        return false;
+
+    alSourceStop(m_source);
+    if (CheckOpenALError())
+    {
+        GetLogger()->Warn("Could not stop music. Code: %%", GetOpenALErrorCode());
+        return false;
+    }
+    m_playing = false;
+    return true;
+}
+
+void CMusicStream::Update()
+{
+    if (!m_ready || !m_playing)
+        return;
+
+    ALint processed = 0;
+    alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processed);
+    while (processed-- > 0)
+    {
+        ALuint buffer = 0;
+        alSourceUnqueueBuffers(m_source, 1, &buffer);
+        if (FillBuffer(buffer))
+            alSourceQueueBuffers(m_source, 1, &buffer);
+    }
+
+    // source stops by itself when it runs out of buffers, e.g. after a long frame
+    ALint state = 0, queued = 0;
+    alGetSourcei(m_source, AL_SOURCE_STATE, &state);
+    alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued);
+    if (state != AL_PLAYING && queued > 0)
+        alSourcePlay(m_source);
+
+    if (CheckOpenALError())
+        GetLogger()->Debug("Could not update music stream. Code: %%", GetOpenALErrorCode());
+}
+
+bool CMusicStream::SetVolume(float volume)
+{
+    if (volume < 0)
+        return false;
+
+    m_volume = volume;
+    if (!m_ready)
+        return true;
+
+    alSourcef(m_source, AL_GAIN, volume);
+    if (CheckOpenALError())
+    {
+        GetLogger()->Debug("Could not set music volume to '%%'. Code: %%", volume, GetOpenALErrorCode());
+        return false;
+    }
+    return true;
+}
+
+void CMusicStream::SetLoop(bool loop)
+{
+    m_loop = loop;
+
+    // a short track preloaded without looping can start over now
+    if (loop)
+        m_ended = false;
+}
+
+bool CMusicStream::IsPlaying()
+{
+    if (!m_ready || !m_playing)
+        return false;
+
+    ALint state = 0, queued = 0;
+    alGetSourcei(m_source, AL_SOURCE_STATE, &state);
+    alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued);
+    if (CheckOpenALError())
+    {
+        GetLogger()->Warn("Could not get music status. Code: %%", GetOpenALErrorCode());
+        return false;
+    }
+
+    return state == AL_PLAYING || queued > 0;
+}
+
+int CMusicStream::GetChannels()
+{
+    return m_file != nullptr ? m_file->GetFileInfo().channels : 0;
+}
+
+int CMusicStream::GetSampleRate()
+{
+    return m_file != nullptr ? m_file->GetFileInfo().samplerate : 0;
+}
+
+float CMusicStream::GetDuration()
+{
+    if (m_file == nullptr)
+        return 0.0f;
+
+    return static_cast<float>(m_file->GetFileInfo().frames) / m_file->GetFileInfo().samplerate;
+}
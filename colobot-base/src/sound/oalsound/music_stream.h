@@ -0,0 +1,107 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file music_stream.h
+ * \brief OpenAL streamed music
+ */
+
+#pragma once
+
+#include "sound/oalsound/check.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <al.h>
+
+class CSNDFileWrapper;
+
+/**
+ * \class CMusicStream
+ * \brief Music track decoded in small chunks while it plays
+ *
+ * Only BUFFER_COUNT buffers of BUFFER_SAMPLES samples are queued on the
+ * source at any time, so memory use does not depend on track length.
+ * Update() must be called regularly to refill buffers that finished playing.
+ *
+ * Open(), Preload() and Decode() don't use OpenAL, the device objects are only
+ * created by the first call to Play(). Only mono and stereo tracks can be opened.
+ */
+class CMusicStream
+{
+public:
+    //! Number of buffers queued on the source
+    static constexpr int BUFFER_COUNT = 4;
+    //! Size of one buffer in samples (16-bit, all channels interleaved)
+    static constexpr std::size_t BUFFER_SAMPLES = 32768;
+
+    CMusicStream();
+    ~CMusicStream();
+
+    CMusicStream(const CMusicStream&) = delete;
+    CMusicStream& operator=(const CMusicStream&) = delete;
+
+    //! Opens file for decoding
+    bool Open(const std::string& filename);
+    //! Decodes the first BUFFER_COUNT buffers ahead of Play()
+    void Preload();
+    //! Decodes at most \a count samples, starting over at the end of a looped track
+    std::size_t Decode(int16_t* samples, std::size_t count);
+
+    bool Play();
+    bool Pause();
+    bool Stop();
+    //! Refills buffers that were already played
+    void Update();
+
+    bool SetVolume(float volume);
+    void SetLoop(bool loop);
+    bool IsPlaying();
+
+    int GetChannels();
+    int GetSampleRate();
+    float GetDuration();
+
+private:
+    bool CreateSource();
+    void DestroySource();
+    //! Decodes the next chunk into \a buffer, returns false at the end of track
+    bool FillBuffer(ALuint buffer);
+
+    std::unique_ptr<CSNDFileWrapper> m_file;
+    std::vector<int16_t> m_samples;
+    //! Chunks decoded by Preload() and not queued on the source yet
+    std::deque<std::vector<int16_t>> m_preloaded;
+    std::array<ALuint, BUFFER_COUNT> m_buffers;
+    ALuint m_source;
+    float m_volume;
+    //! OpenAL source and buffers were created
+    bool m_ready;
+    bool m_loop;
+    //! Play() was called and playback was not paused or stopped since
+    bool m_playing;
+    //! Decoder reached the end of a not looped track
+    bool m_ended;
+};
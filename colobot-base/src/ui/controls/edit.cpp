@@ -46,6 +46,7 @@
 
 #include <SDL.h>
 
+#include <algorithm>
 #include <cstring>
 
 namespace Ui
@@ -107,9 +108,7 @@ bool IsDelimiter(char c)
 CEdit::CEdit()
     : CControl(),
       m_maxChar( std::numeric_limits<int>::max() ),
-      m_text(),
-      m_lineOffset(),
-      m_lineIndent()
+      m_text()
 {
     m_len = 0;
 
@@ -136,7 +135,6 @@ CEdit::CEdit()
     m_bMultiFont = false;
     m_lineAscent = 0.0f;
     m_historyTotal = 0;
-    m_lineTotal = 0;
     m_lineHeight = 0.0f;
     m_lineVisible = 0;
     m_lineFirst = 0;
@@ -237,11 +235,12 @@ void CEdit::MoveAdjust()
         m_scroll->SetDim(dim);
     }
 
+    m_layout.Invalidate();
     Justif();
 
-    if ( m_lineFirst > m_lineTotal-m_lineVisible )
+    if ( m_lineFirst > m_layout.GetLineTotal()-m_lineVisible )
     {
-        m_lineFirst = m_lineTotal-m_lineVisible;
+        m_lineFirst = m_layout.GetLineTotal()-m_lineVisible;
         if ( m_lineFirst < 0 )  m_lineFirst = 0;
     }
 
@@ -741,16 +740,16 @@ int CEdit::MouseDetect(const glm::vec2& mouse)
     }
 
     pos.y = m_pos.y+m_dim.y-m_lineHeight-(m_bMulti?MARGY:MARGY1);
-    for ( i=m_lineFirst ; i<m_lineTotal ; i++ )
+    for ( i=m_lineFirst ; i<m_layout.GetLineTotal() ; i++ )
     {
-        bTitle = ( m_format.size() > 0 && (m_format[m_lineOffset[i]]&Gfx::FONT_MASK_TITLE) == Gfx::FONT_TITLE_BIG );
+        bTitle = ( m_format.size() > 0 && (m_format[m_layout.GetLineOffset(i)]&Gfx::FONT_MASK_TITLE) == Gfx::FONT_TITLE_BIG );
 
         if ( i >= m_lineFirst+m_lineVisible )  break;
 
         pos.x = m_pos.x+(7.5f/640.0f)*(m_fontSize/Gfx::FONT_SIZE_SMALL);
         if ( m_bAutoIndent )
         {
-            pos.x += indentLength*m_lineIndent[i];
+            pos.x += indentLength*m_layout.GetLineIndent(i);
         }
         offset = mouse.x-pos.x;
 
@@ -758,14 +757,14 @@ int CEdit::MouseDetect(const glm::vec2& mouse)
 
         if ( mouse.y > pos.y )
         {
-            len = m_lineOffset[i+1] - m_lineOffset[i];
+            len = m_layout.GetLineOffset(i+1) - m_layout.GetLineOffset(i);
 
             if ( m_format.empty() )
             {
 //                c = m_engine->GetText()->Detect(m_text.data()+m_lineOffset[i],
 //                                                len, offset, m_fontSize,
 //                                                m_fontStretch, m_fontType);
-                c = m_engine->GetText()->Detect(std::string(m_text.data()+m_lineOffset[i]).substr(0, len), m_fontType, m_fontSize, offset); // TODO check if good
+                c = m_engine->GetText()->Detect(GetTextPart(m_layout.GetLineOffset(i), len), m_fontType, m_fontSize, offset); // TODO check if good
             }
             else
             {
@@ -776,13 +775,13 @@ int CEdit::MouseDetect(const glm::vec2& mouse)
 //                                                m_format+m_lineOffset[i],
 //                                                len, offset, size,
 //                                                m_fontStretch);
-                c = m_engine->GetText()->Detect(std::string(m_text.data()+m_lineOffset[i]).substr(0, len),
-                                                m_format.begin() + m_lineOffset[i],
+                c = m_engine->GetText()->Detect(GetTextPart(m_layout.GetLineOffset(i), len),
+                                                m_format.begin() + m_layout.GetLineOffset(i),
                                                 m_format.end(),
                                                 size,
                                                 offset); // TODO check if good
             }
-            return m_lineOffset[i]+c;
+            return m_layout.GetLineOffset(i)+c;
         }
 
         if ( bTitle )  i ++;
@@ -829,14 +828,7 @@ void CEdit::HyperJump(std::string name, std::string marker)
         auto it = std::find_if(m_marker.begin(), m_marker.end(), [&marker](HyperMarker hyperMarker) { return hyperMarker.name == marker; });
         if(it != m_marker.end())
         {
-            int pos = it->pos;
-            for ( int i=0 ; i<m_lineTotal ; i++ )
-            {
-                if ( pos >= m_lineOffset[i] )
-                {
-                    line = i;
-                }
-            }
+            line = m_layout.GetLine(it->pos);
         }
 
         SetFirstLine(line);
@@ -951,10 +943,10 @@ void CEdit::Draw()
     }
 
     pos.y = m_pos.y+m_dim.y-m_lineHeight-(m_bMulti?MARGY:MARGY1);
-    for ( i=m_lineFirst ; i<m_lineTotal ; i++ )
+    for ( i=m_lineFirst ; i<m_layout.GetLineTotal() ; i++ )
     {
-        if ( i == m_lineFirst && i < m_lineTotal-1 &&
-             m_lineOffset[i] == m_lineOffset[i+1] )
+        if ( i == m_lineFirst && i < m_layout.GetLineTotal()-1 &&
+             m_layout.GetLineOffset(i) == m_layout.GetLineOffset(i+1) )
         {
             pos.y -= m_lineHeight;  // Double jump line \b;
             i ++;
@@ -966,15 +958,15 @@ void CEdit::Draw()
         if ( m_bAutoIndent )
         {
             const char *s = "\t";  // line | dotted
-            for ( j=0 ; j<m_lineIndent[i] ; j++ )
+            for ( j=0 ; j<m_layout.GetLineIndent(i) ; j++ )
             {
                 m_engine->GetText()->DrawText(s, m_fontType, m_fontSize, pos, 1.0f, Gfx::TEXT_ALIGN_LEFT, 0);
                 pos.x += indentLength;
             }
         }
 
-        beg = m_lineOffset[i];
-        len = m_lineOffset[i+1] - m_lineOffset[i];
+        beg = m_layout.GetLineOffset(i);
+        len = m_layout.GetLineOffset(i+1) - m_layout.GetLineOffset(i);
 
         ppos = pos;
         size = m_fontSize;
@@ -1033,7 +1025,7 @@ void CEdit::Draw()
             line = 1;
             while ( true )  // includes the image slices
             {
-                if ( i+line >= m_lineTotal                ||
+                if ( i+line >= m_layout.GetLineTotal()    ||
                      i+line >= m_lineFirst+m_lineVisible  ||
                      (m_format.size() > static_cast<unsigned int>(beg+line) && m_format[beg+line]&Gfx::FONT_MASK_IMAGE) == 0 )  break;
                 line ++;
@@ -1109,7 +1101,7 @@ void CEdit::Draw()
 
         pos.y -= m_lineHeight;
 
-        if ( i < m_lineTotal-2 && m_lineOffset[i+1] == m_lineOffset[i+2] )
+        if ( i < m_layout.GetLineTotal()-2 && m_layout.GetLineOffset(i+1) == m_layout.GetLineOffset(i+2) )
         {
             pos.y -= m_lineHeight;  // double jump line \b;
             i ++;
@@ -1120,28 +1112,28 @@ void CEdit::Draw()
     if ( (m_bEdit && m_bFocus && m_bHilite && Math::Mod(m_timeBlink, 1.0f) <= 0.5f) )  // it blinks
     {
         pos.y = m_pos.y+m_dim.y-m_lineHeight-(m_bMulti?MARGY:MARGY1*2.0f);
-        for ( i=m_lineFirst ; i<m_lineTotal ; i++ )
+        for ( i=m_lineFirst ; i<m_layout.GetLineTotal() ; i++ )
         {
-            if ( i == m_lineTotal-1 || m_cursor1 < m_lineOffset[i+1] )
+            if ( i == m_layout.GetLineTotal()-1 || m_cursor1 < m_layout.GetLineOffset(i+1) )
             {
                 pos.x = m_pos.x+(7.5f/640.0f);
                 if ( m_bAutoIndent )
                 {
-                    pos.x += indentLength*m_lineIndent[i];
+                    pos.x += indentLength*m_layout.GetLineIndent(i);
                 }
 
-                len = m_cursor1 - m_lineOffset[i];
+                len = m_cursor1 - m_layout.GetLineOffset(i);
 
                 if ( m_format.empty() )
                 {
-                    m_engine->GetText()->SizeText(std::string(m_text.data()+m_lineOffset[i]).substr(0, len), m_fontType,
+                    m_engine->GetText()->SizeText(GetTextPart(m_layout.GetLineOffset(i), len), m_fontType,
                                                   size, pos, Gfx::TEXT_ALIGN_LEFT,
                                                   start, end);
                 }
                 else
                 {
-                    m_engine->GetText()->SizeText(std::string(m_text.data()+m_lineOffset[i]).substr(0, len),
-                                                  m_format.begin() + m_lineOffset[i],
+                    m_engine->GetText()->SizeText(GetTextPart(m_layout.GetLineOffset(i), len),
+                                                  m_format.begin() + m_layout.GetLineOffset(i),
                                                   m_format.end(),
                                                   size, pos, Gfx::TEXT_ALIGN_LEFT,
                                                   start, end);
@@ -1385,6 +1377,9 @@ void CEdit::SetText(const std::string& text, bool bNew)
 
     m_cursor1 = 0;
     m_cursor2 = 0;  // cursor to the beginning
+    m_layout.Invalidate();
+    m_modified.Reset();
+    m_modified.Change(0, m_len);
     Justif();
     ColumnFix();
 }
@@ -1863,6 +1858,9 @@ bool CEdit::ReadText(std::string filename)
     }
     m_len = j;
 
+    m_layout.Invalidate();
+    m_modified.Reset();
+    m_modified.Change(0, m_len);
     Justif();
     ColumnFix();
     return true;
@@ -1898,15 +1896,16 @@ void CEdit::GetIndentedText(std::ostream& stream, unsigned int start, unsigned i
     {
         iDim = m_dim.x;
         m_dim.x = 1000.0f;  // puts an infinite width!
+        m_layout.Invalidate();
         Justif();
     }
 
     unsigned int i = 0, line = 0;
     while ( m_text[i] != 0 && i < end && i < static_cast<unsigned int>(m_len) ) // TODO: fix this (un)signed comparation
     {
-        if ( m_bAutoIndent && i == static_cast<unsigned int>(m_lineOffset[line]) ) // TODO: fix this (un)signed comparation
+        if ( m_bAutoIndent && i == static_cast<unsigned int>(m_layout.GetLineOffset(line)) ) // TODO: fix this (un)signed comparation
         {
-            for (int n = 0; n < m_lineIndent[line]; n++)
+            for (int n = 0; n < m_layout.GetLineIndent(line); n++)
             {
                 if (i > start)
                 {
@@ -1927,6 +1926,7 @@ void CEdit::GetIndentedText(std::ostream& stream, unsigned int start, unsigned i
     if ( m_bAutoIndent )
     {
         m_dim.x = iDim;  // presents the initial width
+        m_layout.Invalidate();
         Justif();
     }
 }
@@ -1948,6 +1948,9 @@ void CEdit::SetMaxChar(int max)
     m_len = 0;
     m_cursor1 = 0;
     m_cursor2 = 0;
+    m_layout.Invalidate();
+    m_modified.Reset();
+    m_modified.Change(0, m_len);
     Justif();
     UndoFlush();
 }
@@ -2024,6 +2027,7 @@ bool CEdit::GetGenericMode()
 void CEdit::SetAutoIndent(bool bMode)
 {
     m_bAutoIndent = bMode;
+    m_layout.Invalidate();
 }
 
 bool CEdit::GetAutoIndent()
@@ -2132,6 +2136,7 @@ bool CEdit::GetDisplaySpec()
 void CEdit::SetMultiFont(bool bMulti)
 {
     m_format.clear();
+    m_layout.Invalidate();
 
     if (bMulti)
     {
@@ -2163,7 +2168,7 @@ void CEdit::Scroll()
     if (m_scroll != nullptr)
     {
         float value = m_scroll->GetVisibleValue();
-        value *= m_lineTotal - m_lineVisible;
+        value *= m_layout.GetLineTotal() - m_lineVisible;
         Scroll(static_cast<int>(value + 0.5f), true);
     }
 }
@@ -2178,7 +2183,7 @@ void CEdit::Scroll(int pos, bool bAdjustCursor)
 
     if ( m_lineFirst < 0 )  m_lineFirst = 0;
 
-    max = m_lineTotal-m_lineVisible;
+    max = m_layout.GetLineTotal()-m_lineVisible;
     if ( max < 0 )  max = 0;
     if ( m_lineFirst > max )  m_lineFirst = max;
 
@@ -2438,25 +2443,25 @@ void CEdit::MoveLine(int move, bool bWord, bool bSelect)
     {
         indentLength = m_engine->GetText()->GetCharWidth(static_cast<Gfx::UTF8Char>(' '), m_fontType, m_fontSize, 0.0f)
                         * m_engine->GetEditIndentValue();
-        column -= indentLength*m_lineIndent[line];
+        column -= indentLength*m_layout.GetLineIndent(line);
     }
 
     if ( m_format.empty() )
     {
-        c = m_engine->GetText()->Detect(std::string(m_text.data()+m_lineOffset[line]),
+        c = m_engine->GetText()->Detect(GetLineText(m_layout.GetLineOffset(line)),
                                         m_fontType, m_fontSize,
-                                        m_lineOffset[line+1]-m_lineOffset[line]);
+                                        m_layout.GetLineOffset(line+1)-m_layout.GetLineOffset(line));
     }
     else
     {
-        c = m_engine->GetText()->Detect(std::string(m_text.data()+m_lineOffset[line]),
-                                        m_format.begin() + m_lineOffset[line],
+        c = m_engine->GetText()->Detect(GetLineText(m_layout.GetLineOffset(line)),
+                                        m_format.begin() + m_layout.GetLineOffset(line),
                                         m_format.end(),
                                         m_fontSize,
-                                        m_lineOffset[line+1]-m_lineOffset[line]);
+                                        m_layout.GetLineOffset(line+1)-m_layout.GetLineOffset(line));
     }
 
-    m_cursor1 = m_lineOffset[line]+c;
+    m_cursor1 = m_layout.GetLineOffset(line)+c;
     if ( !bSelect )  m_cursor2 = m_cursor1;
 
     m_bUndoForce = true;
@@ -2475,14 +2480,14 @@ void CEdit::ColumnFix()
     if ( m_format.empty() )
     {
         m_column = m_engine->GetText()->GetStringWidth(
-                                std::string(m_text.data()+m_lineOffset[line]),
+                                GetTextPart(m_layout.GetLineOffset(line), m_cursor1-m_layout.GetLineOffset(line)),
                                 m_fontType, m_fontSize);
     }
     else
     {
         m_column = m_engine->GetText()->GetStringWidth(
-                                std::string(m_text.data()+m_lineOffset[line]),
-                                m_format.begin() + m_lineOffset[line],
+                                GetTextPart(m_layout.GetLineOffset(line), m_cursor1-m_layout.GetLineOffset(line)),
+                                m_format.begin() + m_layout.GetLineOffset(line),
                                 m_format.end(),
                                 m_fontSize
                             );
@@ -2492,7 +2497,7 @@ void CEdit::ColumnFix()
     {
         indentLength = m_engine->GetText()->GetCharWidth(static_cast<Gfx::UTF8Char>(' '), m_fontType, m_fontSize, 0.0f)
                         * m_engine->GetEditIndentValue();
-        m_column += indentLength*m_lineIndent[line];
+        m_column += indentLength*m_layout.GetLineIndent(line);
     }
 }
 
@@ -2748,6 +2753,10 @@ void CEdit::InsertOne(char character)
 
     if ( m_len >= GetMaxChar() )  return;
 
+    if ( m_format.empty() )  m_layout.Invalidate();  // the text gets formatted
+    m_layout.Insert(m_cursor1, 1);
+    m_modified.Insert(m_cursor1, 1);
+
     m_text.resize( m_text.size() + 1, '\0' );
     m_format.resize( m_format.size() + 1, m_fontType );
 
@@ -2817,6 +2826,8 @@ void CEdit::DeleteOne(int dir)
 
     hole = m_cursor2-m_cursor1;
     end = m_len-hole;
+    m_layout.Erase(m_cursor1, hole);
+    m_modified.Erase(m_cursor1, hole);
     for ( i=m_cursor1 ; i<end ; i++ )
     {
         m_text[i] = m_text[i+hole];
@@ -3027,6 +3038,8 @@ bool CEdit::MinMaj(bool bMaj)
         else         character = tolower(character);
         m_text[i] = character;
     }
+    m_layout.Change(c1, c2-c1);
+    m_modified.Change(c1, c2-c1);
 
     Justif();
     ColumnFix();
@@ -3036,21 +3049,12 @@ bool CEdit::MinMaj(bool bMaj)
 
 
 // Cut all text lines.
+// Only lines around the text modified since the last call are cut again.
 
 void CEdit::Justif()
 {
-    float   width, size, indentLength = 0.0f;
-    int     i, j, k, line, indent;
-    bool    bDual, bString, bRem;
-
-    m_lineOffset.clear();
-    m_lineIndent.clear();
-
-    indent = 0;
-    m_lineTotal = 0;
-    m_lineOffset.push_back( 0 );
-    m_lineIndent.push_back( indent );
-    m_lineTotal ++;
+    float   width, indentLength = 0.0f;
+    int     line;
 
     if ( m_bAutoIndent )
     {
@@ -3058,99 +3062,41 @@ void CEdit::Justif()
                         * m_engine->GetEditIndentValue();
     }
 
-    bString = bRem = false;
-    i = k = 0;
-    while ( true )
-    {
-        bDual = false;
+    width = m_dim.x-(7.5f/640.0f)*(m_fontSize/Gfx::FONT_SIZE_SMALL)*2.0f-(m_bMulti?MARGX*2.0f+SCROLL_WIDTH:0.0f);
 
-        width = m_dim.x-(7.5f/640.0f)*(m_fontSize/Gfx::FONT_SIZE_SMALL)*2.0f-(m_bMulti?MARGX*2.0f+SCROLL_WIDTH:0.0f);
+    m_layout.Update(m_text, m_len, m_bAutoIndent, [&](int i, int indent, bool& bDual)
+    {
+        float lineWidth = width;
         if ( m_bAutoIndent )
         {
-            width -= indentLength*m_lineIndent[m_lineTotal-1];
+            lineWidth -= indentLength*indent;
         }
 
         if ( m_format.empty() )
         {
-            // TODO check if good
-
-            i += m_engine->GetText()->Justify(m_text.data()+i, m_fontType,
-                                              m_fontSize, width);
-        }
-        else
-        {
-            size = m_fontSize;
-
-            if ( m_format.size() > static_cast<unsigned int>(i) && (m_format[i]&Gfx::FONT_MASK_TITLE) == Gfx::FONT_TITLE_BIG )  // headline?
-            {
-                size *= BIG_FONT;
-                bDual = true;
-            }
-
-            if ( m_format.size() > static_cast<unsigned int>(i) && (m_format[i]&Gfx::FONT_MASK_IMAGE) != 0 )  // image part?
-            {
-                i ++;  // jumps just a character (index in m_image)
-            }
-            else
-            {
-                // TODO check if good
-                i += m_engine->GetText()->Justify(std::string(m_text.data()+i),
-                                                  m_format.begin() + i,
-                                                  m_format.end(),
-                                                  size,
-                                                  width);
-            }
+            return i + m_engine->GetText()->Justify(GetLineText(i), m_fontType,
+                                                    m_fontSize, lineWidth);
         }
 
-        if ( i >= m_len )  break;
+        float size = m_fontSize;
 
-        if ( m_bAutoIndent )
+        if ( m_format.size() > static_cast<unsigned int>(i) && (m_format[i]&Gfx::FONT_MASK_TITLE) == Gfx::FONT_TITLE_BIG )  // headline?
         {
-            for ( j=m_lineOffset[m_lineTotal-1] ; j<i ; j++ )
-            {
-                if ( !bRem && m_text[j] == '\"' )  bString = !bString;
-                if ( !bString &&
-                     m_text[j] == '/' &&
-                     m_text[j+1] == '/' )  bRem = true;
-                if ( m_text[j] == '\n' )  bString = bRem = false;
-                if ( m_text[j] == '{' && !bString && !bRem )  indent ++;
-                if ( m_text[j] == '}' && !bString && !bRem )  indent --;
-            }
-            if ( indent < 0 )  indent = 0;
+            size *= BIG_FONT;
+            bDual = true;
         }
 
-        m_lineOffset.push_back( i );
-        m_lineIndent.push_back( indent );
-        m_lineTotal ++;
-        if ( bDual )
+        if ( m_format.size() > static_cast<unsigned int>(i) && (m_format[i]&Gfx::FONT_MASK_IMAGE) != 0 )  // image part?
         {
-            m_lineOffset.push_back( i );
-            m_lineIndent.push_back( indent );
-            m_lineTotal ++;
+            return i + 1;  // jumps just a character (index in m_image)
         }
-        if ( k == i ) break;
-        k = i;
-    }
-
-    if ( m_len > 0 && m_text[m_len-1] == '\n' )
-    {
-        m_lineOffset.push_back( m_len );
-        m_lineIndent.push_back( 0 );
-        m_lineTotal ++;
-    }
-    m_lineOffset.push_back( m_len );
-    m_lineIndent.push_back( 0 );
 
-    if ( m_bAutoIndent )
-    {
-        for ( i=0 ; i<=m_lineTotal ; i++ )
-        {
-            if ( m_text[m_lineOffset[i]] == '}' )
-            {
-                if ( m_lineIndent[i] > 0 )  m_lineIndent[i] --;
-            }
-        }
-    }
+        return i + m_engine->GetText()->Justify(GetLineText(i),
+                                                m_format.begin() + i,
+                                                m_format.end(),
+                                                size,
+                                                lineWidth);
+    });
 
     if ( m_bMulti )
     {
@@ -3177,21 +3123,58 @@ void CEdit::Justif()
     m_timeBlink = 0.0f;  // lights the cursor immediately
 }
 
+// Gives the part of the text modified since the previous call.
+// Returns false if the text was not modified.
+
+bool CEdit::GetModifiedRange(int &start, int &end)
+{
+    if ( m_modified.IsEmpty() )  return false;
+
+    start = std::min(m_modified.GetStart(), m_len);
+    end = std::min(m_modified.GetEnd(), m_len);
+    m_modified.Reset();
+    return true;
+}
+
+// Forgets the modifications, the next GetModifiedRange() gives
+// only the ones made after this call.
+
+void CEdit::ResetModifiedRange()
+{
+    m_modified.Reset();
+}
+
 // Returns the rank of the line where the cursor is located.
 
 int CEdit::GetCursorLine(int cursor)
 {
-    int     line, i;
+    return m_layout.GetLine(cursor);
+}
+
+// Returns the text from the given offset up to the end of its line.
+// Functions measuring one line of text never look further.
 
-    line = 0;
-    for ( i=0 ; i<m_lineTotal ; i++ )
+std::string CEdit::GetLineText(int start)
+{
+    int end = start;
+    while ( end < m_len && m_text[end] != '\0' )
     {
-        if ( cursor >= m_lineOffset[i] )
-        {
-            line = i;
-        }
+        if ( m_text[end++] == '\n' &&
+             (m_format.size() < static_cast<unsigned int>(end) || (m_format[end-1]&Gfx::FONT_MASK_FONT) != Gfx::FONT_BUTTON) )  break;
+    }
+    return m_text.substr(start, end-start);
+}
+
+// Returns at most len characters of the text from the given offset.
+
+std::string CEdit::GetTextPart(int start, int len)
+{
+    int end = start;
+    while ( end < start+len && end < m_len && m_text[end] != '\0' )
+    {
+        end ++;
     }
-    return line;
+    return m_text.substr(start, end-start);
 }
 
 
@@ -3228,7 +3211,7 @@ void CEdit::UndoMemorize(OperUndo oper)
 
     for ( i=EDITUNDOMAX-1 ; i>=1 ; i-- )
     {
-        m_undo[i] = m_undo[i-1];
+        m_undo[i] = std::move(m_undo[i-1]);
     }
 
     len = m_len;
@@ -3258,11 +3241,14 @@ bool CEdit::UndoRecall()
 
     for ( i=0 ; i<EDITUNDOMAX-1 ; i++ )
     {
-        m_undo[i] = m_undo[i+1];
+        m_undo[i] = std::move(m_undo[i+1]);
     }
     m_undo[EDITUNDOMAX-1].text.clear();
 
     m_bUndoForce = true;
+    m_layout.Invalidate();
+    m_modified.Reset();
+    m_modified.Change(0, m_len);
     Justif();
     ColumnFix();
     SendModifEvent();
@@ -3279,10 +3265,19 @@ bool CEdit::ClearFormat()
         SetMultiFont(true);
     }
     m_format.clear();
+    m_layout.Invalidate();
 
     return true;
 }
 
+// Returns the format of a character.
+
+int CEdit::GetFormat(int cursor)
+{
+    if ( cursor < 0 || m_format.size() <= static_cast<unsigned int>(cursor) )  return 0;
+    return m_format[cursor];
+}
+
 // Changes the format of a sequence of characters.
 
 bool CEdit::SetFormat(int cursor1, int cursor2, int format)
@@ -3297,6 +3292,8 @@ bool CEdit::SetFormat(int cursor1, int cursor2, int format)
         m_format.at(i) = (m_format.at(i) & ~Gfx::FONT_MASK_HIGHLIGHT) | format;
     }
 
+    if ( (format & ~Gfx::FONT_MASK_HIGHLIGHT) != 0 )  m_layout.Invalidate();  // not only colors changed
+
     return true;
 }
 
@@ -3304,7 +3301,7 @@ void CEdit::UpdateScroll()
 {
     if (m_scroll != nullptr)
     {
-        if ( m_lineTotal <= m_lineVisible )
+        if ( m_layout.GetLineTotal() <= m_lineVisible )
         {
             m_scroll->SetVisibleRatio(1.0f);
             m_scroll->SetVisibleValue(0.0f);
@@ -3312,13 +3309,13 @@ void CEdit::UpdateScroll()
         }
         else
         {
-            float value = static_cast<float>(m_lineVisible) / m_lineTotal;
+            float value = static_cast<float>(m_lineVisible) / m_layout.GetLineTotal();
             m_scroll->SetVisibleRatio(value);
 
-            value = static_cast<float>(m_lineFirst) / (m_lineTotal - m_lineVisible);
+            value = static_cast<float>(m_lineFirst) / (m_layout.GetLineTotal() - m_lineVisible);
             m_scroll->SetVisibleValue(value);
 
-            value = 1.0f / (m_lineTotal - m_lineVisible);
+            value = 1.0f / (m_layout.GetLineTotal() - m_lineVisible);
             m_scroll->SetArrowStep(value);
         }
     }
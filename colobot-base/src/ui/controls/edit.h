@@ -26,6 +26,7 @@
 #pragma once
 
 #include "ui/controls/control.h"
+#include "ui/controls/edit_layout.h"
 
 #include <array>
 #include <memory>
@@ -123,6 +124,8 @@ public:
     std::string        GetText(int max);
     const std::string& GetText();
     int                GetTextLength();
+    bool               GetModifiedRange(int &start, int &end);
+    void               ResetModifiedRange();
 
     bool        ReadText(std::string filename);
     bool        WriteText(std::string filename);
@@ -174,6 +177,7 @@ public:
     void        SetFontSize(float size) override;
 
     bool        ClearFormat();
+    int         GetFormat(int cursor);
     bool        SetFormat(int cursor1, int cursor2, int format);
 
 protected:
@@ -215,6 +219,8 @@ protected:
     bool        MinMaj(bool bMaj);
     void        Justif();
     int         GetCursorLine(int cursor);
+    std::string GetLineText(int start);
+    std::string GetTextPart(int start, int len);
 
     void        UndoFlush();
     void        UndoMemorize(OperUndo oper);
@@ -251,9 +257,8 @@ protected:
     float       m_lineDescent;          // height below the baseline
     int     m_lineVisible;          // total number of viewable lines
     int     m_lineFirst;            // the first line displayed
-    int     m_lineTotal;            // number lines used (in m_lineOffset)
-    std::vector<int> m_lineOffset;
-    std::vector<char> m_lineIndent;
+    CEditLayout m_layout;           // cut of the text into lines
+    CTextChange m_modified;         // text modified since GetModifiedRange() or ResetModifiedRange()
     std::vector<ImageLine> m_image;
     std::vector<HyperLink> m_link;
     std::vector<HyperMarker> m_marker;
@@ -0,0 +1,283 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "ui/controls/edit_layout.h"
+
+#include <algorithm>
+
+namespace Ui
+{
+
+void CTextChange::Reset()
+{
+    m_start = m_end = -1;
+    m_delta = 0;
+}
+
+void CTextChange::Insert(int pos, int count)
+{
+    if ( count <= 0 )  return;
+
+    if ( m_start < 0 )
+    {
+        m_start = pos;
+        m_end = pos+count;
+    }
+    else
+    {
+        if ( m_end >= pos )  m_end += count;
+        m_start = std::min(m_start, pos);
+        m_end = std::max(m_end, pos+count);
+    }
+    m_delta += count;
+}
+
+void CTextChange::Erase(int pos, int count)
+{
+    if ( count <= 0 )  return;
+
+    if ( m_start < 0 )
+    {
+        m_start = m_end = pos;
+    }
+    else
+    {
+        if ( m_end >= pos+count )  m_end -= count;
+        else if ( m_end > pos )    m_end = pos;
+        m_start = std::min(m_start, pos);
+        m_end = std::max(m_end, pos);
+    }
+    m_delta -= count;
+}
+
+void CTextChange::Change(int pos, int count)
+{
+    if ( count <= 0 )  return;
+
+    if ( m_start < 0 )
+    {
+        m_start = pos;
+        m_end = pos+count;
+    }
+    else
+    {
+        m_start = std::min(m_start, pos);
+        m_end = std::max(m_end, pos+count);
+    }
+}
+
+bool CTextChange::IsEmpty() const
+{
+    return m_start < 0;
+}
+
+int CTextChange::GetStart() const
+{
+    return m_start;
+}
+
+int CTextChange::GetEnd() const
+{
+    return m_end;
+}
+
+int CTextChange::GetDelta() const
+{
+    return m_delta;
+}
+
+
+CEditLayout::CEditLayout()
+{
+}
+
+void CEditLayout::Invalidate()
+{
+    m_bValid = false;
+    m_change.Reset();
+}
+
+void CEditLayout::Insert(int pos, int count)
+{
+    if ( m_bValid )  m_change.Insert(pos, count);
+}
+
+void CEditLayout::Erase(int pos, int count)
+{
+    if ( m_bValid )  m_change.Erase(pos, count);
+}
+
+void CEditLayout::Change(int pos, int count)
+{
+    if ( m_bValid )  m_change.Change(pos, count);
+}
+
+void CEditLayout::Update(const std::string& text, int len, bool autoIndent, const BreakLineFunction& breakLine)
+{
+    if ( !m_bValid )
+    {
+        m_lineOffset.assign(1, 0);
+        m_lineIndent.assign(1, 0);
+        m_lineState.assign(1, LineState());
+        m_lineTotal = 1;
+        m_change.Reset();
+
+        Layout(text, len, autoIndent, breakLine, 0);
+    }
+    else if ( !m_change.IsEmpty() )
+    {
+        // Breaks of the whole edited line may change, lines before it stay the same
+        int first = GetLine(m_change.GetStart());
+        while ( first > 0 && m_lineOffset[first] > 0 && text[m_lineOffset[first]-1] != '\n' )
+        {
+            first --;
+        }
+
+        Layout(text, len, autoIndent, breakLine, first);
+    }
+
+    m_bValid = true;
+    m_change.Reset();
+}
+
+void CEditLayout::Layout(const std::string& text, int len, bool autoIndent, const BreakLineFunction& breakLine, int first)
+{
+    std::vector<int> offsets;
+    std::vector<LineState> states;
+
+    LineState state = m_lineState[first];
+    int i = m_lineOffset[first];
+    int k = i;
+    int tail = -1;  // first old line kept after the new ones
+
+    while ( true )
+    {
+        bool bDual = false;
+        int start = i;
+
+        i = breakLine(i, state.indent, bDual);
+        if ( i >= len )  break;
+
+        if ( autoIndent )
+        {
+            for ( int j=start ; j<i ; j++ )
+            {
+                if ( !state.bRem && text[j] == '\"' )  state.bString = !state.bString;
+                if ( !state.bString &&
+                     text[j] == '/' &&
+                     text[j+1] == '/' )  state.bRem = true;
+                if ( text[j] == '\n' )  state.bString = state.bRem = false;
+                if ( text[j] == '{' && !state.bString && !state.bRem )  state.indent ++;
+                if ( text[j] == '}' && !state.bString && !state.bRem )  state.indent --;
+            }
+            if ( state.indent < 0 )  state.indent = 0;
+        }
+
+        offsets.push_back( i );
+        states.push_back( state );
+        if ( bDual )
+        {
+            offsets.push_back( i );
+            states.push_back( state );
+        }
+
+        // Does the old layout continue the same way after the edited text?
+        if ( !m_change.IsEmpty() && i >= m_change.GetEnd() )
+        {
+            int old = i-m_change.GetDelta();
+            auto begin = m_lineOffset.begin();
+            auto it = std::lower_bound(begin+first+1, begin+m_lineTotal, old);
+            if ( it != begin+m_lineTotal && *it == old && m_lineState[it-begin] == state )
+            {
+                tail = std::upper_bound(it, begin+m_lineTotal, old) - begin;
+                break;
+            }
+        }
+
+        if ( k == i ) break;
+        k = i;
+    }
+
+    int total;
+    if ( tail < 0 )
+    {
+        if ( len > 0 && text[len-1] == '\n' )
+        {
+            offsets.push_back( len );
+            states.push_back( LineState() );
+        }
+        total = first+1+offsets.size();
+
+        offsets.push_back( len );
+        states.push_back( LineState() );
+        tail = m_lineOffset.size();
+    }
+    else
+    {
+        total = first+1+offsets.size()+(m_lineTotal-tail);
+    }
+
+    for ( unsigned int j=tail ; j<m_lineOffset.size() ; j++ )
+    {
+        m_lineOffset[j] += m_change.GetDelta();
+    }
+
+    m_lineOffset.erase(m_lineOffset.begin()+first+1, m_lineOffset.begin()+tail);
+    m_lineOffset.insert(m_lineOffset.begin()+first+1, offsets.begin(), offsets.end());
+    m_lineState.erase(m_lineState.begin()+first+1, m_lineState.begin()+tail);
+    m_lineState.insert(m_lineState.begin()+first+1, states.begin(), states.end());
+    m_lineIndent.erase(m_lineIndent.begin()+first+1, m_lineIndent.begin()+tail);
+    m_lineIndent.insert(m_lineIndent.begin()+first+1, offsets.size(), 0);
+    m_lineTotal = total;
+
+    // A line starting with a closing brace is indented like the opening one
+    for ( unsigned int j=first ; j<=first+offsets.size() ; j++ )
+    {
+        m_lineIndent[j] = m_lineState[j].indent;
+        if ( autoIndent && m_lineOffset[j] < len && text[m_lineOffset[j]] == '}' )
+        {
+            if ( m_lineIndent[j] > 0 )  m_lineIndent[j] --;
+        }
+    }
+}
+
+int CEditLayout::GetLineTotal() const
+{
+    return m_lineTotal;
+}
+
+int CEditLayout::GetLineOffset(int line) const
+{
+    return m_lineOffset[line];
+}
+
+int CEditLayout::GetLineIndent(int line) const
+{
+    return m_lineIndent[line];
+}
+
+int CEditLayout::GetLine(int pos) const
+{
+    auto begin = m_lineOffset.begin();
+    auto it = std::upper_bound(begin, begin+m_lineTotal, pos);
+    if ( it == begin )  return 0;
+    return it-begin-1;
+}
+
+} // namespace Ui
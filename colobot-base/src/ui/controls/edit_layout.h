@@ -0,0 +1,140 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file ui/controls/edit_layout.h
+ * \brief Line layout of CEdit - CEditLayout class
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Ui
+{
+
+/**
+ * \class CTextChange
+ * \brief Part of a text modified by a series of edits
+ *
+ * Characters before GetStart() are unchanged, the ones from GetEnd() on are
+ * unchanged but moved by GetDelta().
+ */
+class CTextChange
+{
+public:
+    //! Forgets all edits
+    void        Reset();
+    //! Records \a count characters inserted at \a pos
+    void        Insert(int pos, int count);
+    //! Records \a count characters removed at \a pos
+    void        Erase(int pos, int count);
+    //! Records \a count characters replaced at \a pos
+    void        Change(int pos, int count);
+
+    //! Returns true if nothing changed
+    bool        IsEmpty() const;
+    //! Returns the start of the modified part
+    int         GetStart() const;
+    //! Returns the end of the modified part
+    int         GetEnd() const;
+    //! Returns the change of length of the text
+    int         GetDelta() const;
+
+private:
+    int         m_start = -1;       // -1 if nothing changed
+    int         m_end = -1;
+    int         m_delta = 0;
+};
+
+/**
+ * \class CEditLayout
+ * \brief Splits the text of CEdit into lines and computes their indentation
+ *
+ * Edits are recorded with Insert(), Erase() and Change(). The next Update()
+ * then lays out only the lines around the edited part of the text, until the
+ * new layout meets the old one again, so typing costs the same in long and
+ * in short texts. Invalidate() makes the next Update() lay out everything,
+ * which is needed when anything other than the text changes the layout
+ * (size of the control, fonts, ...).
+ */
+class CEditLayout
+{
+public:
+    /**
+     * \brief Function breaking one line of text
+     * \param start offset of the first character of the line
+     * \param indent indentation level of the line
+     * \param dual set to true if the line is high and takes two rows
+     * \return offset of the first character of the next line
+     */
+    using BreakLineFunction = std::function<int(int start, int indent, bool& dual)>;
+
+    CEditLayout();
+
+    //! Makes the next Update() lay out the whole text
+    void        Invalidate();
+    //! Records \a count characters inserted at \a pos
+    void        Insert(int pos, int count);
+    //! Records \a count characters removed at \a pos
+    void        Erase(int pos, int count);
+    //! Records \a count characters replaced at \a pos
+    void        Change(int pos, int count);
+
+    //! Lays out the text changed since the previous call
+    void        Update(const std::string& text, int len, bool autoIndent, const BreakLineFunction& breakLine);
+
+    //! Returns the number of lines
+    int         GetLineTotal() const;
+    //! Returns the offset of the first character of the line, line GetLineTotal() starts at the end of the text
+    int         GetLineOffset(int line) const;
+    //! Returns the indentation level of the line
+    int         GetLineIndent(int line) const;
+    //! Returns the line of the character at offset \a pos
+    int         GetLine(int pos) const;
+
+private:
+    //! State of the text scanner at the start of a line
+    struct LineState
+    {
+        int     indent = 0;         // depth of braces
+        bool    bString = false;    // inside a string
+        bool    bRem = false;       // inside a comment
+
+        bool operator==(const LineState& other) const
+        {
+            return indent == other.indent && bString == other.bString && bRem == other.bRem;
+        }
+    };
+
+    //! Lays out the text starting with line \a first, keeps the old lines after the last edited one
+    void        Layout(const std::string& text, int len, bool autoIndent, const BreakLineFunction& breakLine, int first);
+
+    int         m_lineTotal = 0;    // number of lines used (in m_lineOffset)
+    std::vector<int> m_lineOffset;
+    std::vector<int> m_lineIndent;
+    std::vector<LineState> m_lineState;
+
+    bool        m_bValid = false;   // false -> everything must be laid out
+    CTextChange m_change;           // text changed since the last layout
+};
+
+} // namespace Ui
@@ -425,16 +425,15 @@ void CScreenLevelList::UpdateSceneChap(int &chap)
 
         for ( j=0 ; j < static_cast<int>(m_customLevelList.size()) ; j++ )
         {
-            try
+            const LevelDescription& description = GetLevelDescription(j+1, 0);
+            if ( description.titleError.empty() )
             {
-                CLevelParser levelParser("custom", j+1, 0);
-                levelParser.Load();
-                pl->SetItemName(j, levelParser.Get("Title")->GetParam("text")->AsString());
+                pl->SetItemName(j, description.title);
                 pl->SetEnable(j, true);
             }
-            catch (CLevelParserException& e)
+            else
             {
-                pl->SetItemName(j, std::string("[ERROR]: ")+e.what());
+                pl->SetItemName(j, std::string("[ERROR]: ")+description.titleError);
                 pl->SetEnable(j, false);
             }
         }
@@ -443,17 +442,16 @@ void CScreenLevelList::UpdateSceneChap(int &chap)
     {
         for ( j=0 ; j<MAXSCENE ; j++ )
         {
-            CLevelParser levelParser(m_category, j+1, 0);
-            if (!levelParser.Exists())
+            const LevelDescription& description = GetLevelDescription(j+1, 0);
+            if (!description.exists)
                 break;
-            try
+            if ( description.titleError.empty() )
             {
-                levelParser.Load();
-                snprintf(line.data(), line.size(), "%d: %s", j+1, levelParser.Get("Title")->GetParam("text")->AsString().c_str());
+                snprintf(line.data(), line.size(), "%d: %s", j+1, description.title.c_str());
             }
-            catch (CLevelParserException& e)
+            else
             {
-                snprintf(line.data(), line.size(), "%s", (std::string("[ERROR]: ")+e.what()).c_str());
+                snprintf(line.data(), line.size(), "%s", (std::string("[ERROR]: ")+description.titleError).c_str());
             }
 
             bPassed = m_main->GetPlayerProfile()->GetLevelPassed(m_category, j+1, 0);
@@ -502,8 +500,8 @@ void CScreenLevelList::UpdateSceneList(int chap, int &sel)
     bool readAll = true;
     for ( j=0 ; j<MAXSCENE ; j++ )
     {
-        CLevelParser levelParser(m_category, chap+1, j+1);
-        if (!levelParser.Exists())
+        const LevelDescription& description = GetLevelDescription(chap+1, j+1);
+        if (!description.exists)
         {
             readAll = true;
             break;
@@ -513,14 +511,13 @@ void CScreenLevelList::UpdateSceneList(int chap, int &sel)
             if (!readAll)
                 break;
         }
-        try
+        if ( description.titleError.empty() )
         {
-            levelParser.Load();
-            snprintf(line.data(), line.size(), "%d: %s", j+1, levelParser.Get("Title")->GetParam("text")->AsString().c_str());
+            snprintf(line.data(), line.size(), "%d: %s", j+1, description.title.c_str());
         }
-        catch (CLevelParserException& e)
+        else
         {
-            snprintf(line.data(), line.size(), "%s", (std::string("[ERROR]: ")+e.what()).c_str());
+            snprintf(line.data(), line.size(), "%s", (std::string("[ERROR]: ")+description.titleError).c_str());
         }
 
         bPassed = m_main->GetPlayerProfile()->GetLevelPassed(m_category, chap+1, j+1);
@@ -617,18 +614,25 @@ void CScreenLevelList::UpdateSceneResume(int chap, int rank)
 
     if(chap == 0 || rank == 0) return;
 
-    try
+    const LevelDescription& description = GetLevelDescription(chap, rank);
+    if ( description.resumeError.empty() )
     {
-        CLevelParser levelParser(m_category, chap, rank);
-        levelParser.Load();
-        pe->SetText(levelParser.Get("Resume")->GetParam("text")->AsString().c_str());
+        pe->SetText(description.resume.c_str());
     }
-    catch (CLevelParserException& e)
+    else
     {
-        pe->SetText((std::string("[ERROR]: ")+e.what()).c_str());
+        pe->SetText((std::string("[ERROR]: ")+description.resumeError).c_str());
     }
 }
 
+// Returns the title and summary of a level, read again only when its file changed.
+
+const LevelDescription& CScreenLevelList::GetLevelDescription(int chap, int rank)
+{
+    m_levelDescriptions.SetLanguage(m_app->GetLanguageChar());
+    return m_levelDescriptions.Get(CLevelParser::BuildScenePath(m_category, chap, rank));
+}
+
 void CScreenLevelList::UpdateChapterPassed()
 {
     // TODO: CScreenLevelList is a bad place for this function
@@ -22,6 +22,7 @@
 #include "ui/screen/screen.h"
 
 #include "level/level_category.h"
+#include "level/level_description.h"
 
 #include <map>
 #include <vector>
@@ -61,6 +62,7 @@ protected:
     void UpdateSceneChap(int &chap);
     void UpdateSceneList(int chap, int &sel);
     void UpdateSceneResume(int chap, int rank);
+    const LevelDescription& GetLevelDescription(int chap, int rank);
 
 protected:
     Ui::CMainDialog* m_dialog;
@@ -79,6 +81,9 @@ protected:
     std::vector<std::string> m_customLevelList;
 
     int m_accessChap;
+
+    //! Titles and summaries of the levels, kept between visits of the lists
+    CLevelDescriptionCache m_levelDescriptions;
 };
 
 } // namespace Ui
@@ -42,6 +42,7 @@
 
 #include "script/cbottoken.h"
 #include "script/script.h"
+#include "script/script_checker.h"
 
 #include "sound/sound.h"
 
@@ -65,10 +66,38 @@
 
 #include <stdio.h>
 #include <ctime>
+#include <vector>
 
 
 namespace Ui
 {
+namespace
+{
+//! Time without typing after which the program is compiled in background
+const float CHECK_DELAY = 0.5f;
+
+// Returns the offset of the beginning of the line containing pos.
+int GetLineStart(const std::string& text, int pos)
+{
+    while ( pos > 0 && text[pos-1] != '\n' )  pos --;
+    return pos;
+}
+
+// Returns the offset of the beginning of the line following pos.
+int GetLineEnd(const std::string& text, int len, int pos)
+{
+    while ( pos < len && text[pos++] != '\n' );
+    return pos;
+}
+
+// Returns true if the line at pos has nothing else than blanks and a comment.
+bool IsBlankLine(const std::string& text, int len, int pos)
+{
+    while ( pos < len && (text[pos] == ' ' || text[pos] == '\t') )  pos ++;
+    if ( pos+1 < len && text[pos] == '/' && text[pos+1] == '/' )  return true;
+    return pos >= len || text[pos] == '\n';
+}
+} // anonymous namespace
 
 
 // Object's constructor.
@@ -137,7 +166,9 @@ bool CStudio::EventProcess(const Event &event)
 
     if ( event.type == EVENT_STUDIO_EDIT )  // text modified?
     {
-        ColorizeScript(edit);
+        ColorizeModifiedScript(edit);
+        m_bCheckPending = true;
+        m_checkTime = CHECK_DELAY;
     }
 
     if ( event.type == EVENT_STUDIO_LIST )  // list clicked?
@@ -354,6 +385,8 @@ bool CStudio::EventFrame(const Event &event)
     list = static_cast< CList* >(pw->SearchControl(EVENT_STUDIO_LIST));
     if ( list == nullptr )  return false;
 
+    UpdateCheck(edit, event.rTime);
+
     if (m_script->IsRunning() && (!m_script->GetStepMode() || m_script->IsContinue()))
     {
         if (m_runningPause != nullptr)
@@ -549,9 +582,103 @@ void CStudio::SearchToken(CEdit* edit)
 
 void CStudio::ColorizeScript(CEdit* edit)
 {
+    edit->ResetModifiedRange();  // everything is colored anyway
     m_script->ColorizeScript(edit);
 }
 
+// Colors the part of the text modified since the last coloring.
+// Colors of the following lines only change if a block comment was opened
+// or closed, which shows on the first following line with code.
+
+void CStudio::ColorizeModifiedScript(CEdit* edit)
+{
+    int start, end;
+    if ( !edit->GetModifiedRange(start, end) )  return;
+
+    const std::string& text = edit->GetText();
+    int len = edit->GetTextLength();
+
+    // starts at the beginning of the line, or of a block comment containing it
+    start = GetLineStart(text, start);
+    std::size_t open = text.rfind("/*", start);
+    if ( open != std::string::npos )
+    {
+        std::size_t close = text.rfind("*/", start);
+        if ( close == std::string::npos || close < open )
+        {
+            start = GetLineStart(text, open);
+        }
+    }
+    end = GetLineEnd(text, len, end);
+
+    int check = end;
+    while ( check < len && IsBlankLine(text, len, check) )
+    {
+        check = GetLineEnd(text, len, check);
+    }
+    int checkEnd = GetLineEnd(text, len, check);
+
+    std::vector<int> colors;
+    for ( int i=check ; i<checkEnd ; i++ )
+    {
+        colors.push_back(edit->GetFormat(i) & Gfx::FONT_MASK_HIGHLIGHT);
+    }
+
+    m_script->ColorizeScript(edit, start, checkEnd);
+
+    bool bSame = true;
+    bool bCode = false;
+    for ( int i=check ; i<checkEnd ; i++ )
+    {
+        int color = edit->GetFormat(i) & Gfx::FONT_MASK_HIGHLIGHT;
+        if ( color != colors[i-check] )  bSame = false;
+        if ( color != Gfx::FONT_HIGHLIGHT_COMMENT )  bCode = true;
+    }
+
+    if ( checkEnd < len && !(bSame && bCode) )
+    {
+        m_script->ColorizeScript(edit, start, len);
+    }
+}
+
+// Shows errors found by compiling the program in background.
+
+void CStudio::UpdateCheck(CEdit* edit, float rTime)
+{
+    if ( m_checker == nullptr )  return;
+
+    if ( m_bCheckPending )
+    {
+        m_checkTime -= rTime;
+        if ( m_checkTime <= 0.0f && m_checker->Start(edit->GetText().substr(0, edit->GetTextLength()), m_script) )
+        {
+            m_bCheckPending = false;
+        }
+    }
+
+    CBot::CBotError error;
+    int cursor1, cursor2;
+    if ( !m_checker->GetResult(error, cursor1, cursor2) || m_bCheckPending )  return;
+
+    std::string text;
+    if ( error != CBot::CBotNoErr )
+    {
+        GetResource(RES_CBOT, error, text);
+    }
+    if ( text == m_checkError )  return;
+
+    if ( text.empty() )
+    {
+        m_fixInfoTextTime = 0.0f;
+        SetInfoText("", true);
+    }
+    else
+    {
+        SetInfoText(text, false);
+    }
+    m_checkError = text;
+}
+
 
 // Starts editing a program.
 
@@ -637,6 +764,10 @@ void CStudio::StartEditScript(CScript *script, std::string name, Program* progra
     m_script->PutScript(edit, name.c_str());
     ColorizeScript(edit);
 
+    m_checker = std::make_unique<CScriptChecker>(m_app->GetJobSystem());
+    m_bCheckPending = false;
+    m_checkError.clear();
+
     ViewEditScript();
 
     list = pw->CreateList(pos, dim, 1, EVENT_STUDIO_LIST, 1.2f);
@@ -921,6 +1052,7 @@ bool CStudio::StopEditScript(bool closeWithErrors)
         }
     }
     m_script->SetStepMode(false);
+    m_checker.reset();
 
     m_interface->DeleteControl(EVENT_WINDOW3);
 
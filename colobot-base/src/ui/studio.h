@@ -29,6 +29,7 @@ class CEventQueue;
 class CFileDialog;
 class CRobotMain;
 class CScript;
+class CScriptChecker;
 class CSettings;
 class CSoundInterface;
 class CPauseManager;
@@ -70,6 +71,8 @@ protected:
     bool        EventFrame(const Event &event);
     void        SearchToken(CEdit* edit);
     void        ColorizeScript(CEdit* edit);
+    void        ColorizeModifiedScript(CEdit* edit);
+    void        UpdateCheck(CEdit* edit, float rTime);
     void        AdjustEditScript();
     void        ViewEditScript();
     void        UpdateFlux();
@@ -115,6 +118,11 @@ protected:
     std::string  m_helpFilename;
 
     std::unique_ptr<CFileDialog>  m_fileDialog;
+
+    std::unique_ptr<CScriptChecker> m_checker;
+    bool         m_bCheckPending = false;   // true -> compile in background once typing stops
+    float        m_checkTime = 0.0f;        // time left until the compilation
+    std::string  m_checkError;              // error shown by the last compilation
 };
 
 
@@ -0,0 +1,143 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBot.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace CBot;
+
+namespace
+{
+
+// Compiles and runs main() of the given code, returns the error it ended with
+CBotError CompileAndRun(const std::string& code)
+{
+    auto program = std::make_unique<CBotProgram>();
+    std::vector<std::string> functions;
+    if (!program->Compile(code, functions))
+        return program->GetError();
+
+    if (!program->Start("main"))
+        return program->GetError();
+
+    while (!program->Run(nullptr, -1))
+    {
+    }
+
+    return program->GetError();
+}
+
+// Program declaring a public class named Data, which differs for every value
+std::string GetProgram(int value)
+{
+    std::string number = std::to_string(value);
+    return
+        "public class Data\n"
+        "{\n"
+        "    int field" + number + " = " + number + ";\n"
+        "}\n"
+        "extern void main()\n"
+        "{\n"
+        "    Data data();\n"
+        "    int sum = 0;\n"
+        "    for (int i = 0; i < 1000; i++) sum += VALUE;\n"
+        "    if (sum != 1000 * data.field" + number + ") { int error = 1 / 0; }\n"
+        "}\n";
+}
+
+} // namespace
+
+TEST(CBotContextUT, PublicClassesAreIsolated)
+{
+    CBotContext first;
+    CBotContext second;
+
+    std::unique_ptr<CBotProgram> program;
+    {
+        CBotContextGuard guard(first);
+        CBotProgram::Init();
+        CBotProgram::DefineNum("VALUE", 1);
+
+        program = std::make_unique<CBotProgram>();
+        std::vector<std::string> functions;
+        ASSERT_TRUE(program->Compile(GetProgram(1), functions));
+        EXPECT_NE(CBotClass::Find("Data"), nullptr);
+    }
+
+    {
+        CBotContextGuard guard(second);
+        CBotProgram::Init();
+
+        EXPECT_EQ(CBotClass::Find("Data"), nullptr);
+        EXPECT_EQ(CompileAndRun(GetProgram(2)), CBotErrUndefVar);
+
+        CBotProgram::DefineNum("VALUE", 2);
+        EXPECT_EQ(CompileAndRun(GetProgram(2)), CBotNoErr);
+
+        CBotProgram::Free();
+    }
+
+    // The program uses its own context even when another one is current
+    ASSERT_TRUE(program->Start("main"));
+    while (!program->Run(nullptr, -1))
+    {
+    }
+    EXPECT_EQ(program->GetError(), CBotNoErr);
+
+    CBotContextGuard guard(first);
+    program.reset();
+    CBotProgram::Free();
+}
+
+TEST(CBotContextUT, ContextsOnSeveralThreads)
+{
+    const int threadCount = 4;
+    std::vector<CBotError> errors(threadCount, CBotErrUndefVar);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([i, &errors]()
+        {
+            CBotContext context;
+            CBotContextGuard guard(context);
+            CBotProgram::Init();
+            CBotProgram::DefineNum("VALUE", i + 1);
+
+            CBotError error = CBotNoErr;
+            for (int repeat = 0; repeat < 20 && error == CBotNoErr; ++repeat)
+                error = CompileAndRun(GetProgram(i + 1));
+
+            errors[i] = error;
+            CBotProgram::Free();
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int i = 0; i < threadCount; ++i)
+        EXPECT_EQ(errors[i], CBotNoErr) << "thread " << i;
+}
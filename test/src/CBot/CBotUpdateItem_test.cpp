@@ -0,0 +1,166 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBot.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CBot;
+
+namespace
+{
+
+// Host object the elements of "thing" instances are read from
+struct Thing
+{
+    std::map<std::string, int> values;
+    std::map<std::string, int> updates;
+};
+
+void uThingItem(CBotVar* thisVar, CBotVar* item, void* user)
+{
+    Thing* thing = static_cast<Thing*>(user);
+    thing->updates[item->GetName()]++;
+    item->SetValInt(thing->values[item->GetName()]);
+}
+
+} // namespace
+
+class CBotUpdateItemUT : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        CBotProgram::Init();
+
+        CBotClass* thingClass = CBotClass::Create("thing", nullptr);
+        thingClass->AddItem("a", CBotTypResult(CBotTypInt));
+        thingClass->AddItem("b", CBotTypResult(CBotTypInt));
+        thingClass->SetUpdateItemFunc(uThingItem);
+
+        m_thing.values = {{"a", 1}, {"b", 2}};
+        m_var = CBotVar::Create("", CBotTypResult(CBotTypClass, "thing"));
+        m_var->SetUserPtr(&m_thing);
+
+        for (CBotVar* item = m_var->GetItemList(); item != nullptr; item = item->GetNext())
+            m_ids[item->GetName()] = item->GetUniqNum();
+    }
+
+    void TearDown() override
+    {
+        m_var->SetUserPtr(OBJECTDELETED);
+        CBotVar::Destroy(m_var);
+        CBotProgram::Free();
+    }
+
+    CBotVar* GetItemRef(const std::string& name)
+    {
+        return m_var->GetItemRef(m_ids[name]);
+    }
+
+    Thing m_thing;
+    CBotVar* m_var = nullptr;
+    std::map<std::string, long> m_ids;
+};
+
+TEST_F(CBotUpdateItemUT, UpdatesOnlyUsedElements)
+{
+    m_var->Update(nullptr);
+    EXPECT_TRUE(m_thing.updates.empty());
+
+    EXPECT_EQ(1, GetItemRef("a")->GetValInt());
+    EXPECT_EQ(1, m_thing.updates["a"]);
+    EXPECT_EQ(0, m_thing.updates["b"]);
+}
+
+TEST_F(CBotUpdateItemUT, UpdatesElementOncePerUpdate)
+{
+    m_var->Update(nullptr);
+    GetItemRef("a");
+    GetItemRef("a");
+    EXPECT_EQ(1, m_thing.updates["a"]);
+
+    m_thing.values["a"] = 10;
+    EXPECT_EQ(1, GetItemRef("a")->GetValInt());
+
+    m_var->Update(nullptr);
+    EXPECT_EQ(10, GetItemRef("a")->GetValInt());
+    EXPECT_EQ(2, m_thing.updates["a"]);
+}
+
+TEST_F(CBotUpdateItemUT, ListingElementsUpdatesAll)
+{
+    m_var->Update(nullptr);
+    m_thing.values = {{"a", 3}, {"b", 4}};
+
+    CBotVar* a = m_var->GetItemList();
+    ASSERT_NE(nullptr, a);
+    ASSERT_NE(nullptr, a->GetNext());
+    EXPECT_EQ(3, a->GetValInt());
+    EXPECT_EQ(4, a->GetNext()->GetValInt());
+
+    // the update is complete, nothing is updated again until the next one
+    GetItemRef("a");
+    EXPECT_EQ(1, m_thing.updates["a"]);
+    EXPECT_EQ(1, m_thing.updates["b"]);
+}
+
+TEST_F(CBotUpdateItemUT, DeletedObjectKeepsValuesOfPendingUpdate)
+{
+    m_var->Update(nullptr);
+    m_thing.values = {{"a", 5}, {"b", 6}};
+
+    // the update was requested while the object existed
+    m_var->SetUserPtr(OBJECTDELETED);
+    EXPECT_EQ(5, GetItemRef("a")->GetValInt());
+    EXPECT_EQ(6, GetItemRef("b")->GetValInt());
+
+    // but later ones are not done anymore
+    m_thing.values = {{"a", 7}, {"b", 8}};
+    m_var->Update(nullptr);
+    EXPECT_EQ(5, GetItemRef("a")->GetValInt());
+    EXPECT_EQ(1, m_thing.updates["a"]);
+}
+
+TEST_F(CBotUpdateItemUT, ScriptReadsUpdatedElement)
+{
+    m_thing.values = {{"a", 42}, {"b", 2}};
+
+    auto program = std::make_unique<CBotProgram>(m_var);
+    std::vector<std::string> functions;
+    ASSERT_TRUE(program->Compile(
+        "extern void thing::main()\n"
+        "{\n"
+        "    if (this.a != 42) { int error = 1 / 0; }\n"
+        "    if (this.a + this.a != 84) { int error = 1 / 0; }\n"
+        "}\n", functions));
+
+    ASSERT_TRUE(program->Start("main"));
+    while (!program->Run(nullptr, -1))
+    {
+    }
+    EXPECT_EQ(CBotNoErr, program->GetError());
+    EXPECT_GT(m_thing.updates["a"], 0);
+    EXPECT_EQ(0, m_thing.updates["b"]);
+}
@@ -0,0 +1,682 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "bench/bench.h"
+
+#include "CBot/CBot.h"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CBot;
+
+namespace
+{
+
+//! Iterations of the loops in the benchmarked programs
+constexpr int LOOP_ITERATIONS = 10000;
+//! Number of objects in the list read by property benchmarks
+constexpr int OBJECT_COUNT = 1000;
+//! Number of properties of these objects, named "a", "b", "c"...
+constexpr int OBJECT_PROPERTIES = 16;
+//! Iterations of the loops in benchmarks whose cost grows with the data size (strings, arrays)
+constexpr int SHORT_LOOP_ITERATIONS = 1000;
+//! Entries of the tables of the lookup benchmarks, the array version takes quadratic time
+constexpr int SMALL_TABLE_ENTRIES = 100;
+constexpr int LARGE_TABLE_ENTRIES = 400;
+
+//! Initializes CBot for the lifetime of a benchmark
+class CBotRuntime
+{
+public:
+    CBotRuntime()
+    {
+        CBotProgram::Init();
+    }
+
+    ~CBotRuntime()
+    {
+        CBotProgram::Free();
+    }
+};
+
+/**
+ * Compiles a program with a single function "Test" and runs it
+ * until it is finished once per benchmark iteration
+ *
+ * Reports CBot instructions (timer ticks, see CBotProgram::GetRunTicks())
+ * as the benchmark items, so the harness prints instructions per second.
+ */
+void RunProgram(Bench::CState& state, const std::string& code)
+{
+    auto program = std::make_unique<CBotProgram>();
+    std::vector<std::string> functions;
+    if (!program->Compile(code, functions))
+    {
+        state.SetCounter("compile_error", program->GetError());
+        state.SetError("compile error " + std::to_string(program->GetError()));
+        return;
+    }
+
+    long long instructions = 0;
+    while (state.KeepRunning())
+    {
+        program->Start("Test");
+        bool finished = false;
+        while (!finished)
+        {
+            finished = program->Run(nullptr, -1);
+            instructions += program->GetRunTicks();
+        }
+    }
+
+    if (program->GetError() != CBotNoErr)
+    {
+        state.SetCounter("run_error", program->GetError());
+        state.SetError("run error " + std::to_string(program->GetError()));
+    }
+
+    long long instructionsPerRun = instructions / (state.GetIterations() > 0 ? state.GetIterations() : 1);
+    state.SetCounter("instructions_per_run", instructionsPerRun);
+    state.SetItemsPerIteration(instructionsPerRun);
+}
+
+//! Game object stand-in, its properties take some work to compute
+struct BenchObject
+{
+    float values[OBJECT_PROPERTIES];
+};
+
+//! Number of properties computed since the start of the benchmark
+long long g_propertyUpdates = 0;
+
+float ComputeProperty(const BenchObject* object, int index)
+{
+    ++g_propertyUpdates;
+    float value = object->values[index];
+    for (int i = 0; i < 32; ++i)
+        value = std::sqrt(value * value + 1.0f);
+    return value;
+}
+
+//! Update function updating all properties, see CBotClass::SetUpdateFunc()
+void UpdateObject(CBotVar* thisVar, void* user)
+{
+    int index = 0;
+    for (CBotVar* item = thisVar->GetItemList(); item != nullptr; item = item->GetNext())
+        item->SetValFloat(ComputeProperty(static_cast<BenchObject*>(user), index++));
+}
+
+//! Update function updating one property, see CBotClass::SetUpdateItemFunc()
+void UpdateObjectItem(CBotVar* thisVar, CBotVar* item, void* user)
+{
+    int index = item->GetName()[0] - 'a';
+    item->SetValFloat(ComputeProperty(static_cast<BenchObject*>(user), index));
+}
+
+//! Objects returned by objects()
+std::vector<std::unique_ptr<CBotVar>>* g_objectVars = nullptr;
+
+CBotTypResult cObjects(CBotVar*& var, void* user)
+{
+    if (var != nullptr) return CBotTypResult(CBotErrOverParam);
+    return CBotTypResult(CBotTypArrayPointer, CBotTypResult(CBotTypPointer, "benchobject"));
+}
+
+// Returns all objects like radarall() does
+bool rObjects(CBotVar* var, CBotVar* result, int& exception, void* user)
+{
+    int i = 0;
+    for (const auto& objectVar : *g_objectVars)
+        result->GetItem(i++, true)->SetPointer(objectVar.get());
+    return true;
+}
+
+/**
+ * Runs a program reading one property of each object of a list,
+ * with the class updated either as a whole or one property at a time
+ */
+void RunPropertyRead(Bench::CState& state, bool updateItems)
+{
+    CBotRuntime runtime;
+
+    CBotClass* objectClass = CBotClass::Create("benchobject", nullptr);
+    for (int i = 0; i < OBJECT_PROPERTIES; ++i)
+        objectClass->AddItem(std::string(1, static_cast<char>('a' + i)), CBotTypResult(CBotTypFloat), CBotVar::ProtectionLevel::ReadOnly);
+    if (updateItems)
+        objectClass->SetUpdateItemFunc(UpdateObjectItem);
+    else
+        objectClass->SetUpdateFunc(UpdateObject);
+
+    CBotProgram::AddFunction("objects", rObjects, cObjects);
+
+    std::vector<BenchObject> objects(OBJECT_COUNT);
+    std::vector<std::unique_ptr<CBotVar>> objectVars;
+    for (int i = 0; i < OBJECT_COUNT; ++i)
+    {
+        for (int j = 0; j < OBJECT_PROPERTIES; ++j)
+            objects[i].values[j] = static_cast<float>(i + j);
+
+        objectVars.emplace_back(CBotVar::Create("", CBotTypResult(CBotTypClass, "benchobject")));
+        objectVars.back()->SetUserPtr(&objects[i]);
+    }
+    g_objectVars = &objectVars;
+    g_propertyUpdates = 0;
+
+    RunProgram(state,
+        "extern void Test()\n"
+        "{\n"
+        "    benchobject[] list = objects();\n"
+        "    int count = sizeof(list);\n"
+        "    float sum = 0;\n"
+        "    for (int i = 0; i < count; i++)\n"
+        "    {\n"
+        "        sum += list[i].c;\n"
+        "    }\n"
+        "}\n");
+
+    if (state.GetIterations() > 0)
+        state.SetCounter("updates_per_read", static_cast<double>(g_propertyUpdates) / state.GetIterations() / OBJECT_COUNT);
+    g_objectVars = nullptr;
+}
+
+//! Object returned by radar() of the stub object class
+CBotVar* g_radarResult = nullptr;
+
+CBotTypResult cRadar(CBotVar*& var, void* user)
+{
+    if (var == nullptr) return CBotTypResult(CBotErrLowParam);
+    if (var->GetType() > CBotTypDouble) return CBotTypResult(CBotErrBadNum);
+    if (var->GetNext() != nullptr) return CBotTypResult(CBotErrOverParam);
+    return CBotTypResult(CBotTypPointer, "object");
+}
+
+// Returns the same object for every category, like a radar() finding one object
+bool rRadar(CBotVar* var, CBotVar* result, int& exception, void* user)
+{
+    result->SetPointer(g_radarResult);
+    return true;
+}
+
+CBotTypResult cBusy(CBotVar* thisVar, CBotVar*& var)
+{
+    if (var != nullptr) return CBotTypResult(CBotErrOverParam);
+    return CBotTypResult(CBotTypBoolean);
+}
+
+// Method object::busy(), never busy
+bool rBusy(CBotVar* thisVar, CBotVar* var, CBotVar* result, int& exception, void* user)
+{
+    result->SetValInt(false);
+    return true;
+}
+
+/**
+ * Declares a stub of the "object" class of the game with a few fields,
+ * the busy() method and the radar() function returning an object
+ */
+std::unique_ptr<CBotVar> CreateObjectClass()
+{
+    CBotClass* objectClass = CBotClass::Create("object", nullptr);
+    objectClass->AddItem("category", CBotTypResult(CBotTypInt), CBotVar::ProtectionLevel::ReadOnly);
+    objectClass->AddItem("energyLevel", CBotTypResult(CBotTypFloat), CBotVar::ProtectionLevel::ReadOnly);
+    objectClass->AddFunction("busy", rBusy, cBusy);
+
+    CBotProgram::AddFunction("radar", rRadar, cRadar);
+
+    std::unique_ptr<CBotVar> object(CBotVar::Create("", CBotTypResult(CBotTypClass, "object")));
+    object->GetItem("category")->SetValInt(1);
+    object->GetItem("energyLevel")->SetValFloat(0.5f);
+    g_radarResult = object.get();
+    return object;
+}
+
+/**
+ * Builds a string of given number of pieces with "s = s + ...",
+ * the time per piece should not depend on the length of the string
+ */
+void RunStringBuild(Bench::CState& state, int pieces)
+{
+    CBotRuntime runtime;
+    RunProgram(state,
+        "extern void Test()\n"
+        "{\n"
+        "    string s = \"\";\n"
+        "    for (int i = 0; i < " + std::to_string(pieces) + "; i++)\n"
+        "    {\n"
+        "        s = s + \"item \" + i + \", \";\n"
+        "    }\n"
+        "}\n");
+    state.SetCounter("pieces", pieces);
+}
+
+/**
+ * Fills a table of given number of string keys and looks every key up,
+ * with the map class or with two arrays searched linearly
+ */
+void RunLookup(Bench::CState& state, int entries, bool useMap)
+{
+    CBotRuntime runtime;
+    std::string count = std::to_string(entries);
+    if (useMap)
+    {
+        RunProgram(state,
+            "extern void Test()\n"
+            "{\n"
+            "    map table();\n"
+            "    for (int i = 0; i < " + count + "; i++) table.put(\"key\" + i, i);\n"
+            "    int sum = 0;\n"
+            "    for (int i = 0; i < " + count + "; i++) sum += table.get(\"key\" + i, 0);\n"
+            "}\n");
+    }
+    else
+    {
+        RunProgram(state,
+            "extern void Test()\n"
+            "{\n"
+            "    string keys[];\n"
+            "    int values[];\n"
+            "    for (int i = 0; i < " + count + "; i++) { keys[i] = \"key\" + i; values[i] = i; }\n"
+            "    int sum = 0;\n"
+            "    for (int i = 0; i < " + count + "; i++)\n"
+            "    {\n"
+            "        string key = \"key\" + i;\n"
+            "        for (int j = 0; j < sizeof(keys); j++)\n"
+            "        {\n"
+            "            if (keys[j] == key) { sum += values[j]; break; }\n"
+            "        }\n"
+            "    }\n"
+            "}\n");
+    }
+    state.SetCounter("entries", entries);
+}
+
+
+CBotTypResult cDistance(CBotVar*& var, void* user)
+{
+    for (int i = 0; i < 2; ++i)
+    {
+        if (var == nullptr) return CBotTypResult(CBotErrLowParam);
+        if (var->GetType() != CBotTypClass && var->GetType() != CBotTypPointer) return CBotTypResult(CBotErrBadParam);
+        var = var->GetNext();
+    }
+    if (var != nullptr) return CBotTypResult(CBotErrOverParam);
+    return CBotTypResult(CBotTypFloat);
+}
+
+// Reads a point argument like the game does
+float GetCoordinate(CBotVar* point, const char* name)
+{
+    return point->GetItem(name)->GetValFloat();
+}
+
+// Instruction "distance(p1, p2)"
+bool rDistance(CBotVar* var, CBotVar* result, int& exception, void* user)
+{
+    CBotVar* other = var->GetNext();
+    float dx = GetCoordinate(var, "x") - GetCoordinate(other, "x");
+    float dy = GetCoordinate(var, "y") - GetCoordinate(other, "y");
+    float dz = GetCoordinate(var, "z") - GetCoordinate(other, "z");
+    result->SetValFloat(std::sqrt(dx * dx + dy * dy + dz * dz));
+    return true;
+}
+
+CBotTypResult cOneFloat(CBotVar*& var, void* user)
+{
+    if (var == nullptr) return CBotTypResult(CBotErrLowParam);
+    if (var->GetType() > CBotTypDouble) return CBotTypResult(CBotErrBadNum);
+    if (var->GetNext() != nullptr) return CBotTypResult(CBotErrOverParam);
+    return CBotTypResult(CBotTypFloat);
+}
+
+// Instructions "move(dist)" and "turn(angle)", done at once
+bool rMotion(CBotVar* var, CBotVar* result, int& exception, void* user)
+{
+    result->SetValInt(var->GetValFloat() > 1000.0f);
+    return true;
+}
+
+CBotTypResult cMessage(CBotVar*& var, void* user)
+{
+    if (var == nullptr) return CBotTypResult(CBotErrLowParam);
+    if (var->GetType() != CBotTypString) return CBotTypResult(CBotErrBadString);
+    if (var->GetNext() != nullptr) return CBotTypResult(CBotErrOverParam);
+    return CBotTypResult(CBotTypFloat);
+}
+
+//! Length of all displayed messages
+long long g_messageLength = 0;
+
+// Instruction "message(text)"
+bool rMessage(CBotVar* var, CBotVar* result, int& exception, void* user)
+{
+    g_messageLength += var->GetValString().size();
+    return true;
+}
+
+/**
+ * Declares stubs of the most frequently called functions of the game,
+ * with the same signatures: distance(), move(), turn() and message(),
+ * and of the intrinsic "point" class
+ */
+void CreateBuiltinFunctions()
+{
+    CBotClass* pointClass = CBotClass::Create("point", nullptr, true);
+    pointClass->AddItem("x", CBotTypResult(CBotTypFloat));
+    pointClass->AddItem("y", CBotTypResult(CBotTypFloat));
+    pointClass->AddItem("z", CBotTypResult(CBotTypFloat));
+
+    CBotProgram::AddFunction("distance", rDistance, cDistance);
+    CBotProgram::AddFunction("move", rMotion, cOneFloat);
+    CBotProgram::AddFunction("turn", rMotion, cOneFloat);
+    CBotProgram::AddFunction("message", rMessage, cMessage);
+}
+
+} // anonymous namespace
+
+// Integer arithmetic and comparisons in a loop
+BENCHMARK(CBotIntegerLoop)
+{
+    CBotRuntime runtime;
+    RunProgram(state,
+        "extern void Test()\n"
+        "{\n"
+        "    int sum = 0;\n"
+        "    for (int i = 0; i < " + std::to_string(LOOP_ITERATIONS) + "; i++)\n"
+        "    {\n"
+        "        sum = sum + i * 3 - i / 2;\n"
+        "        if (sum > 100000 || sum < -100000) sum = sum % 1000;\n"
+        "    }\n"
+        "}\n");
+}
+
+// Floating point arithmetic and boolean logic in a loop
+BENCHMARK(CBotFloatLoop)
+{
+    CBotRuntime runtime;
+    RunProgram(state,
+        "extern void Test()\n"
+        "{\n"
+        "    float x = 0.0;\n"
+        "    bool flag = false;\n"
+        "    for (int i = 0; i < " + std::to_string(LOOP_ITERATIONS) + "; i++)\n"
+        "    {\n"
+        "        x = x * 0.5 + i / 3.0;\n"
+        "        flag = !flag && x > 10.0;\n"
+        "    }\n"
+        "}\n");
+}
+
+// Long expressions on int, float and bool operands, dominated by binary operators
+BENCHMARK(CBotTypedArithmetic)
+{
+    CBotRuntime runtime;
+    RunProgram(state,
+        "extern void Test()\n"
+        "{\n"
+        "    int a = 1;\n"
+        "    float x = 0.0;\n"
+        "    bool flag = false;\n"
+        "    for (int i = 0; i < " + std::to_string(LOOP_ITERATIONS) + "; i++)\n"
+        "    {\n"
+        "        a = (a * 7 + i - (i >> 1)) % 1009 ^ (i & 15) << 2;\n"
+        "        x = x * 0.5 + a / 3.0 - i * 0.25 + (x - a) * 0.125;\n"
+        "        flag = (a > 100 && x <= 500.0) != (i % 3 == 0 || a >= i);\n"
+        "    }\n"
+        "}\n");
+}
+
+// Reading one property of every object of a list, all properties updated on every access
+BENCHMARK(CBotObjectPropertyReadFullUpdate)
+{
+    RunPropertyRead(state, false);
+}
+
+// Reading one property of every object of a list, only the read property updated
+BENCHMARK(CBotObjectPropertyReadItemUpdate)
+{
+    RunPropertyRead(state, true);
+}
+
+// Building a string one character at a time
+BENCHMARK(CBotStringBuild)
+{
+    CBotRuntime runtime;
+    RunProgram(state,
+        "extern void Test()\n"
+        "{\n"
+        "    string s = \"\";\n"
+        "    for (int i = 0; i < " + std::to_string(SHORT_LOOP_ITERATIONS) + "; i++)\n"
+        "    {\n"
+        "        s += \"x\";\n"
+        "        if (i % 100 == 0) s += i;\n"
+        "    }\n"
+        "}\n");
+}
+
+// Building a short log line piece by piece
+BENCHMARK(CBotStringBuildShort)
+{
+    RunStringBuild(state, SHORT_LOOP_ITERATIONS);
+}
+
+// Building a long log line piece by piece, 10 times longer than CBotStringBuildShort
+BENCHMARK(CBotStringBuildLong)
+{
+    RunStringBuild(state, SHORT_LOOP_ITERATIONS * 10);
+}
+
+// Splitting a string and joining the parts back, converting numbers to text
+BENCHMARK(CBotStringSplitJoinFormat)
+{
+    CBotRuntime runtime;
+    RunProgram(state,
+        "extern void Test()\n"
+        "{\n"
+        "    for (int i = 0; i < " + std::to_string(SHORT_LOOP_ITERATIONS) + "; i++)\n"
+        "    {\n"
+        "        string line = strformat(\"%d;%.2f;%s\", i, i / 3.0, \"name\");\n"
+        "        string[] fields = strsplit(line, \";\");\n"
+        "        line = strjoin(fields, \",\");\n"
+        "    }\n"
+        "}\n");
+}
+
+// Filling an array and reading it back by index
+BENCHMARK(CBotArrayFillAndIndex)
+{
+    CBotRuntime runtime;
+    RunProgram(state,
+        "extern void Test()\n"
+        "{\n"
+        "    int a[];\n"
+        "    for (int i = 0; i < " + std::to_string(SHORT_LOOP_ITERATIONS) + "; i++)\n"
+        "    {\n"
+        "        a[i] = i * 2;\n"
+        "    }\n"
+        "    int sum = 0;\n"
+        "    for (int i = 0; i < sizeof(a); i++)\n"
+        "    {\n"
+        "        sum += a[i];\n"
+        "    }\n"
+        "}\n");
+}
+
+// Reading and writing fields of an instance of a class declared in the program
+BENCHMARK(CBotClassFieldAccess)
+{
+    CBotRuntime runtime;
+    RunProgram(state,
+        "public class BenchVector\n"
+        "{\n"
+        "    int x = 0;\n"
+        "    int y = 0;\n"
+        "    int z = 0;\n"
+        "}\n"
+        "extern void Test()\n"
+        "{\n"
+        "    BenchVector v();\n"
+        "    for (int i = 0; i < " + std::to_string(LOOP_ITERATIONS) + "; i++)\n"
+        "    {\n"
+        "        v.x = i;\n"
+        "        v.y = v.x + 1;\n"
+        "        v.z = (v.z + v.y) % 1000;\n"
+        "    }\n"
+        "}\n");
+}
+
+// Calling a method of a class declared in the program
+BENCHMARK(CBotMethodCall)
+{
+    CBotRuntime runtime;
+    RunProgram(state,
+        "public class BenchCounter\n"
+        "{\n"
+        "    int count = 0;\n"
+        "    int Add(int value)\n"
+        "    {\n"
+        "        count += value;\n"
+        "        return count;\n"
+        "    }\n"
+        "}\n"
+        "extern void Test()\n"
+        "{\n"
+        "    BenchCounter counter();\n"
+        "    for (int i = 0; i < " + std::to_string(LOOP_ITERATIONS) + "; i++)\n"
+        "    {\n"
+        "        counter.Add(i % 3);\n"
+        "    }\n"
+        "}\n");
+}
+
+// Recursive calls of a function declared in the program
+BENCHMARK(CBotRecursion)
+{
+    CBotRuntime runtime;
+    RunProgram(state,
+        "int Fibonacci(int n)\n"
+        "{\n"
+        "    if (n < 2) return n;\n"
+        "    return Fibonacci(n - 1) + Fibonacci(n - 2);\n"
+        "}\n"
+        "extern void Test()\n"
+        "{\n"
+        "    int result = Fibonacci(15);\n"
+        "}\n");
+}
+
+// Throwing exceptions from a function and catching them in the caller
+BENCHMARK(CBotException)
+{
+    CBotRuntime runtime;
+    RunProgram(state,
+        "void Fail(int code)\n"
+        "{\n"
+        "    throw code;\n"
+        "}\n"
+        "extern void Test()\n"
+        "{\n"
+        "    int caught = 0;\n"
+        "    for (int i = 0; i < " + std::to_string(SHORT_LOOP_ITERATIONS) + "; i++)\n"
+        "    {\n"
+        "        try\n"
+        "        {\n"
+        "            Fail(1000 + i % 2);\n"
+        "        }\n"
+        "        catch (1000)\n"
+        "        {\n"
+        "            caught += 1;\n"
+        "        }\n"
+        "        catch (1001)\n"
+        "        {\n"
+        "            caught += 2;\n"
+        "        }\n"
+        "    }\n"
+        "}\n");
+}
+
+// Calling external functions and methods of the stub object class, as robot programs do
+BENCHMARK(CBotExternalCall)
+{
+    CBotRuntime runtime;
+    auto object = CreateObjectClass();
+    RunProgram(state,
+        "extern void Test()\n"
+        "{\n"
+        "    float energy = 0;\n"
+        "    for (int i = 0; i < " + std::to_string(LOOP_ITERATIONS) + "; i++)\n"
+        "    {\n"
+        "        object item = radar(i % 4);\n"
+        "        if (item == null || item.busy()) continue;\n"
+        "        energy += item.energyLevel * item.category;\n"
+        "    }\n"
+        "}\n");
+    g_radarResult = nullptr;
+}
+
+// Looking keys up in a map, the time per lookup should not depend on the number of entries
+BENCHMARK(CBotMapLookupSmall)
+{
+    RunLookup(state, SMALL_TABLE_ENTRIES, true);
+}
+
+BENCHMARK(CBotMapLookupLarge)
+{
+    RunLookup(state, LARGE_TABLE_ENTRIES, true);
+}
+
+// The same lookups with arrays searched linearly, for comparison with CBotMapLookup
+BENCHMARK(CBotArrayLookupSmall)
+{
+    RunLookup(state, SMALL_TABLE_ENTRIES, false);
+}
+
+BENCHMARK(CBotArrayLookupLarge)
+{
+    RunLookup(state, LARGE_TABLE_ENTRIES, false);
+}
+
+// Calling the most frequent functions of the game in a loop, should not allocate memory per call
+BENCHMARK(CBotBuiltinCalls)
+{
+    CBotRuntime runtime;
+    auto object = CreateObjectClass();
+    CreateBuiltinFunctions();
+    RunProgram(state,
+        "extern void Test()\n"
+        "{\n"
+        "    point p;\n"
+        "    point q;\n"
+        "    p.x = 1; p.y = 2; p.z = 3;\n"
+        "    q.x = 4; q.y = 5; q.z = 6;\n"
+        "    float total = 0;\n"
+        "    for (int i = 0; i < " + std::to_string(SHORT_LOOP_ITERATIONS) + "; i++)\n"
+        "    {\n"
+        "        total += distance(p, q);\n"
+        "        object item = radar(i % 4);\n"
+        "        move(total);\n"
+        "        turn(90);\n"
+        "        message(\"The distance to the target is\");\n"
+        "    }\n"
+        "}\n");
+    state.SetCounter("calls_per_run", SHORT_LOOP_ITERATIONS * 5);
+    g_radarResult = nullptr;
+}
@@ -19,9 +19,14 @@
 
 #include "CBot/CBot.h"
 
+#include "CBot/CBotVar/CBotVarValue.h"
+
 #include <gtest/gtest.h>
 #include <limits>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 extern bool g_cbotTestSaveState;
 bool g_cbotTestSaveState = false;
@@ -620,6 +625,73 @@ TEST_F(CBotUT, IntegerMathNearLimits_Issue993)
     );
 }
 
+TEST_F(CBotUT, TypedOperations)
+{
+    ExecuteTest(
+        "extern void MixedIntFloat()\n"
+        "{\n"
+        "    int i = 7;\n"
+        "    float f = 2.5;\n"
+        "    ASSERT(i / 2 == 3);\n"
+        "    ASSERT(i / 2.0 == 3.5);\n"
+        "    ASSERT(f * i == 17.5);\n"
+        "    ASSERT(i - f == 4.5);\n"
+        "    ASSERT(f % 1 == 0.5);\n"
+        "    ASSERT(-i % 3 == -1);\n"
+        "    ASSERT(i > f && f < i && i >= 7.0 && f <= 2.5);\n"
+        "    ASSERT(-1 >>> 28 == 15);\n"
+        "    ASSERT(-16 >> 2 == -4);\n"
+        "    ASSERT(1 + 2 * 3 - 4 / 2 == 5);\n"
+        "}\n"
+        "\n"
+        "extern void OperandTypeKnownAtRuntime()\n"
+        "{\n"
+        "    bool c = false;\n"
+        "    float f = (c ? 1 : 2.5) * 2;\n"
+        "    ASSERT(f == 5);\n"
+        "    ASSERT((c ? 1 : 2.5) + 1 == 3.5);\n"
+        "}\n"
+        "\n"
+        "extern void NanComparisons()\n"
+        "{\n"
+        "    float x = nan;\n"
+        "    ASSERT(x == nan);\n"
+        "    ASSERT(x != 1.0);\n"
+        "    ASSERT(!(x == 1));\n"
+        "}\n"
+    );
+
+    ExecuteTest(
+        "extern void NanArithmetic()\n"
+        "{\n"
+        "    float x = nan;\n"
+        "    float y = x + 1;\n"
+        "}\n"
+        "\n"
+        "extern void NanOrdering()\n"
+        "{\n"
+        "    float x = nan;\n"
+        "    bool b = x < 1.0;\n"
+        "}\n",
+        CBotErrNan
+    );
+
+    ExecuteTest(
+        "extern void FloatDivideByZero()\n"
+        "{\n"
+        "    float x = 0.0;\n"
+        "    float y = 1.5 / x;\n"
+        "}\n"
+        "\n"
+        "extern void IntModuloByZero()\n"
+        "{\n"
+        "    int i = 0;\n"
+        "    int j = 5 % i;\n"
+        "}\n",
+        CBotErrZeroDiv
+    );
+}
+
 TEST_F(CBotUT, BinaryLiterals)
 {
     ExecuteTest(
@@ -1967,6 +2039,437 @@ TEST_F(CBotUT, StringFunctions)
     );
 }
 
+TEST_F(CBotUT, StringJoinSplitFormat)
+{
+    ExecuteTest(
+        "extern void StringJoinSplit()\n"
+        "{\n"
+        "    string[] parts = strsplit(\"a,bc,,d\", \",\");\n"
+        "    ASSERT(sizeof(parts) == 4);\n"
+        "    ASSERT(parts[0] == \"a\");\n"
+        "    ASSERT(parts[1] == \"bc\");\n"
+        "    ASSERT(parts[2] == \"\");\n"
+        "    ASSERT(parts[3] == \"d\");\n"
+        "    ASSERT(strjoin(parts, \"--\") == \"a--bc----d\");\n"
+        "    ASSERT(strjoin(parts) == \"abcd\");\n"
+        "    ASSERT(sizeof(strsplit(\"abc\", \"\")) == 1);\n"
+        "    int[] numbers = {1, 2, 3};\n"
+        "    ASSERT(strjoin(numbers, \" \") == \"1 2 3\");\n"
+        "}\n"
+        "extern void StringFormat()\n"
+        "{\n"
+        "    ASSERT(strformat(\"%d/%03d\", 7, 5) == \"7/005\");\n"
+        "    ASSERT(strformat(\"%.2f%%\", 12.345) == \"12.35%\");\n"
+        "    ASSERT(strformat(\"[%-4s][%4s]\", \"ab\", true) == \"[ab  ][true]\");\n"
+        "    ASSERT(strformat(\"%x\", 255) == \"ff\");\n"
+        "    ASSERT(strformat(\"no values\") == \"no values\");\n"
+        "    ASSERT(strlen(strformat(\"%999s\", \"\")) == 999);\n"
+        "    ASSERT(strformat(\"%.999s\", \"abc\") == \"abc\");\n"
+        "}\n"
+    );
+
+    ExecuteTest(
+        "extern void StringFormatWidthTooLarge()\n"
+        "{\n"
+        "    strformat(\"%999999999s\", \"\");\n"
+        "}\n",
+        CBotErrBadParam
+    );
+
+    ExecuteTest(
+        "extern void StringFormatPrecisionTooLarge()\n"
+        "{\n"
+        "    strformat(\"%.1000s\", \"\");\n"
+        "}\n",
+        CBotErrBadParam
+    );
+}
+
+TEST_F(CBotUT, StringAppend)
+{
+    ExecuteTest(
+        "extern void StringAppend()\n"
+        "{\n"
+        "    string s = \"a\";\n"
+        "    s += \"b\";\n"
+        "    s += 1 + 2;\n"
+        "    s += true;\n"
+        "    ASSERT(s == \"ab3true\");\n"
+        "    s = s + 1 + 2;\n"
+        "    ASSERT(s == \"ab3true12\");\n"
+        "    s = s + \"x\" + 0.5;\n"
+        "    ASSERT(s == \"ab3true12x0.5\");\n"
+        "}\n"
+        "extern void StringAppendInLoop()\n"
+        "{\n"
+        "    string s = \"\";\n"
+        "    string t = \"\";\n"
+        "    for (int i = 0; i < 100; i++)\n"
+        "    {\n"
+        "        s += i;\n"
+        "        t = t + i + \",\";\n"
+        "    }\n"
+        "    ASSERT(strlen(s) == 190);\n"
+        "    ASSERT(strleft(t, 6) == \"0,1,2,\");\n"
+        "    ASSERT(strright(t, 3) == \"99,\");\n"
+        "}\n"
+        "extern void StringAppendUsingItself()\n"
+        "{\n"
+        "    string s = \"ab\";\n"
+        "    s += s;\n"
+        "    ASSERT(s == \"abab\");\n"
+        "    s = s + strlen(s);\n"
+        "    ASSERT(s == \"abab4\");\n"
+        "    s = \"x\" + s;\n"
+        "    ASSERT(s == \"xabab4\");\n"
+        "}\n"
+        "string Fail(int code)\n"
+        "{\n"
+        "    throw code;\n"
+        "    return \"\";\n"
+        "}\n"
+        "extern void StringAppendException()\n"
+        "{\n"
+        "    string s = \"a\";\n"
+        "    try\n"
+        "    {\n"
+        "        s = s + \"b\" + Fail(1000);\n"
+        "    }\n"
+        "    catch (1000)\n"
+        "    {\n"
+        "    }\n"
+        "    ASSERT(s == \"a\");\n"
+        "}\n"
+        "public class StringAppendClass\n"
+        "{\n"
+        "    string s = \"a\";\n"
+        "    void Append()\n"
+        "    {\n"
+        "        s += \"b\";\n"
+        "        s = s + \"c\";\n"
+        "    }\n"
+        "}\n"
+        "extern void StringAppendField()\n"
+        "{\n"
+        "    StringAppendClass c();\n"
+        "    c.Append();\n"
+        "    ASSERT(c.s == \"abc\");\n"
+        "    string[] a = {\"x\"};\n"
+        "    a[0] += \"y\";\n"
+        "    ASSERT(a[0] == \"xy\");\n"
+        "}\n"
+    );
+
+    ExecuteTest(
+        "extern void StringAppendNan()\n"
+        "{\n"
+        "    string s = \"a\";\n"
+        "    float f = nan;\n"
+        "    s = s + f;\n"
+        "}\n",
+        CBotErrNan
+    );
+}
+
+TEST_F(CBotUT, ExternalCallStringArguments)
+{
+    ExecuteTest(
+        "extern void ExternalCallStringArguments()\n"
+        "{\n"
+        "    string s = \"a text longer than a short string\";\n"
+        "    ASSERT(strlen(s) == 33);\n"
+        "    ASSERT(strleft(s, 6) == \"a text\");\n"
+        "    ASSERT(strlen(s + s) == 66);\n"
+        "    ASSERT(s == \"a text longer than a short string\");\n"
+        "    string[] parts = strsplit(s, \" \");\n"
+        "    ASSERT(strjoin(parts, \" \") == s);\n"
+        "    ASSERT(parts[1] == \"text\");\n"
+        "}\n"
+    );
+}
+
+TEST_F(CBotUT, StringNumberConversions)
+{
+    ExecuteTest(
+        "extern void StringNumberConversions()\n"
+        "{\n"
+        "    string s = \"\" + 0.1;\n"
+        "    ASSERT(s == \"0.1\");\n"
+        "    s = \"\" + 1234567.0;\n"
+        "    ASSERT(s == \"1.23457e+06\");\n"
+        "    s = \"\" + -42;\n"
+        "    ASSERT(s == \"-42\");\n"
+        "    s = \"\" + 1.0 / 3;\n"
+        "    ASSERT(s == \"0.333333\");\n"
+        "}\n"
+    );
+}
+
+// Conversions must give the same values as the string streams they replaced
+TEST(CBotStringToValueTest, MatchesStreamConversion)
+{
+    const std::vector<std::string> texts = {
+        "", "0", "42", "-42", "+42", " \t 7", "12abc", "abc", "+-1", "-", ".",
+        "0.5", ".5", "-.5", "1e3", "1.5e-3", "1e", "1e+", "1ex", "1e5e", "1.5E2", "0x10",
+        "inf", "-inf", "+inf", "infinity", "INF", "nan", "-nan", "NaN", "nan(1)",
+        "1e39", "-1e39", "1e-50", "1e309", "-1e309", "1e-400",
+        "2147483647", "2147483648", "-2147483648", "-2147483649", "99999999999999999999",
+        "32767", "32768", "-32769",
+    };
+
+    for (const std::string& text : texts)
+    {
+        SCOPED_TRACE(text);
+        auto fromStream = [&text](auto value)
+        {
+            std::istringstream s(text);
+            s >> value;
+            return value;
+        };
+
+        EXPECT_EQ(fromStream(0), CBot::StringToValue<int>(text));
+        EXPECT_EQ(fromStream(short(0)), CBot::StringToValue<short>(text));
+        EXPECT_EQ(fromStream(0L), CBot::StringToValue<long>(text));
+        EXPECT_EQ(fromStream(0.0f), CBot::StringToValue<float>(text));
+        EXPECT_EQ(fromStream(0.0), CBot::StringToValue<double>(text));
+    }
+}
+
+TEST_F(CBotUT, MapAndSet)
+{
+    ExecuteTest(
+        "extern void MapPutGet()\n"
+        "{\n"
+        "    map m();\n"
+        "    ASSERT(sizeof(m) == 0);\n"
+        "    m.put(\"a\", 1);\n"
+        "    m.put(2, \"two\");\n"
+        "    m.put(2.5, 3.5);\n"
+        "    ASSERT(sizeof(m) == 3);\n"
+        "    ASSERT(m.get(\"a\", 0) == 1);\n"
+        "    ASSERT(m.get(2.0, \"\") == \"two\");\n"
+        "    ASSERT(m.get(2.5, 0.0) == 3.5);\n"
+        "    ASSERT(m.get(\"b\", -1) == -1);\n"
+        "    ASSERT(m.get(\"2\", \"none\") == \"none\");\n"
+        "    ASSERT(m.contains(2) && !m.contains(3));\n"
+        "    m.put(\"a\", 10);\n"
+        "    ASSERT(sizeof(m) == 3);\n"
+        "    ASSERT(m.get(\"a\", 0) == 10);\n"
+        "    ASSERT(m.remove(2));\n"
+        "    ASSERT(!m.remove(2));\n"
+        "    ASSERT(sizeof(m) == 2);\n"
+        "    m.clear();\n"
+        "    ASSERT(sizeof(m) == 0);\n"
+        "}\n"
+        "extern void MapIterate()\n"
+        "{\n"
+        "    map m();\n"
+        "    for (int i = 0; i < 10; ++i) m.put(i, i * i);\n"
+        "    m.remove(3);\n"
+        "    m.remove(7);\n"
+        "    int keys = 0;\n"
+        "    int values = 0;\n"
+        "    for (int i = 0; i < sizeof(m); ++i)\n"
+        "    {\n"
+        "        keys += m.key(i, 0);\n"
+        "        values += m.value(i, 0);\n"
+        "        ASSERT(m.get(m.key(i, 0), 0) == m.value(i, 0));\n"
+        "    }\n"
+        "    ASSERT(keys == 45 - 3 - 7);\n"
+        "    ASSERT(values == 285 - 9 - 49);\n"
+        "}\n"
+        "extern void MapOfObjects()\n"
+        "{\n"
+        "    map m();\n"
+        "    int[] a = {1, 2};\n"
+        "    m.put(\"array\", a);\n"
+        "    int[] b;\n"
+        "    b = m.get(\"array\", b);\n"
+        "    b[0] = 5;\n"
+        "    ASSERT(a[0] == 5);\n"
+        "    map inner();\n"
+        "    inner.put(1, 1);\n"
+        "    m.put(\"map\", inner);\n"
+        "    map other = m.get(\"map\", null);\n"
+        "    ASSERT(other.get(1, 0) == 1);\n"
+        "}\n"
+        "extern void SetAddContains()\n"
+        "{\n"
+        "    set s();\n"
+        "    ASSERT(s.add(1));\n"
+        "    ASSERT(!s.add(1.0));\n"
+        "    ASSERT(s.add(\"1\"));\n"
+        "    ASSERT(sizeof(s) == 2);\n"
+        "    ASSERT(s.contains(1) && s.contains(\"1\") && !s.contains(2));\n"
+        "    ASSERT(s.remove(\"1\"));\n"
+        "    ASSERT(s.key(0, 0) == 1);\n"
+        "    s.clear();\n"
+        "    ASSERT(!s.contains(1));\n"
+        "}\n"
+    );
+
+    ExecuteTest(
+        "extern void SetPositionOutOfRange()\n"
+        "{\n"
+        "    set s();\n"
+        "    s.key(0, 0);\n"
+        "}\n",
+        CBotErrOutArray
+    );
+
+    ExecuteTest(
+        "extern void MapNanKey()\n"
+        "{\n"
+        "    map m();\n"
+        "    m.put(nan, 1);\n"
+        "}\n",
+        CBotErrNan
+    );
+
+    ExecuteTest(
+        "extern void MapKeyMustBeNumberOrString()\n"
+        "{\n"
+        "    map m();\n"
+        "    m.put(true, 1);\n"
+        "}\n",
+        CBotErrBadParam
+    );
+}
+
+TEST_F(CBotUT, MapAndSetResultTypes)
+{
+    ExecuteTest(
+        "extern void MapCompatibleResults()\n"
+        "{\n"
+        "    map m();\n"
+        "    m.put(1, 2);\n"
+        "    m.put(2, 2.5);\n"
+        "    int[] a = {1, 2};\n"
+        "    m.put(3, a);\n"
+        "    m.put(4, null);\n"
+        "    ASSERT(m.get(1, 0.0) == 2.0);\n"
+        "    ASSERT(m.get(2, 0) == 2);\n"
+        "    ASSERT(m.get(1, \"\") == \"2\");\n"
+        "    int[] b = m.get(3, a);\n"
+        "    ASSERT(b[1] == 2);\n"
+        "    int[] c = m.get(4, a);\n"
+        "    ASSERT(c == null);\n"
+        "    ASSERT(m.key(0, \"\") == \"1\");\n"
+        "    ASSERT(m.value(0, 0.0) == 2.0);\n"
+        "}\n"
+    );
+
+    ExecuteTest(
+        "extern void MapGetArrayAsInt()\n"
+        "{\n"
+        "    map m();\n"
+        "    int[] a = {1, 2};\n"
+        "    m.put(1, a);\n"
+        "    m.get(1, 0);\n"
+        "}\n",
+        CBotErrBadValueType
+    );
+
+    ExecuteTest(
+        "extern void MapGetIntAsArray()\n"
+        "{\n"
+        "    map m();\n"
+        "    int[] a = {1, 2};\n"
+        "    m.put(1, 5);\n"
+        "    m.get(1, a);\n"
+        "}\n",
+        CBotErrBadValueType
+    );
+
+    ExecuteTest(
+        "extern void MapGetFloatArrayAsIntArray()\n"
+        "{\n"
+        "    map m();\n"
+        "    int[] a = {1, 2};\n"
+        "    float[] f = {1.5};\n"
+        "    m.put(1, f);\n"
+        "    m.get(1, a);\n"
+        "}\n",
+        CBotErrBadValueType
+    );
+
+    ExecuteTest(
+        "extern void MapGetStringAsInt()\n"
+        "{\n"
+        "    map m();\n"
+        "    m.put(1, \"one\");\n"
+        "    m.get(1, 0);\n"
+        "}\n",
+        CBotErrBadValueType
+    );
+
+    ExecuteTest(
+        "extern void MapValueAtArrayAsString()\n"
+        "{\n"
+        "    map m();\n"
+        "    int[] a = {1, 2};\n"
+        "    m.put(1, a);\n"
+        "    m.value(0, \"\");\n"
+        "}\n",
+        CBotErrBadValueType
+    );
+
+    ExecuteTest(
+        "extern void SetKeyAtAsArray()\n"
+        "{\n"
+        "    set s();\n"
+        "    int[] a = {1, 2};\n"
+        "    s.add(1);\n"
+        "    s.key(0, a);\n"
+        "}\n",
+        CBotErrBadValueType
+    );
+}
+
+TEST_F(CBotUT, MapAndSetAreNotReserved)
+{
+    ExecuteTest(
+        "extern void MapAndSetAsVariables()\n"
+        "{\n"
+        "    int map = 1;\n"
+        "    map = map + 1;\n"
+        "    map++;\n"
+        "    string set = \"a\";\n"
+        "    set += \"b\";\n"
+        "    ASSERT(map == 3 && set == \"ab\");\n"
+        "    map m();\n"
+        "    m.put(\"a\", map);\n"
+        "    ASSERT(m.get(\"a\", 0) == 3);\n"
+        "}\n"
+    );
+
+    ExecuteTest(
+        "int map(int x) { return 2 * x; }\n"
+        "void set(int[] a, int i) { a[i] = 1; }\n"
+        "extern void MapAndSetAsFunctions()\n"
+        "{\n"
+        "    int[] a = {0, 0, 0};\n"
+        "    set(a, 2);\n"
+        "    map(3);\n"
+        "    ASSERT(map(3) == 6 && a[2] == 1);\n"
+        "}\n"
+    );
+
+    ExecuteTest(
+        "public class Grid\n"
+        "{\n"
+        "    int map = 0;\n"
+        "    void Fill() { map = 5; }\n"
+        "}\n"
+        "extern void MapAsField()\n"
+        "{\n"
+        "    Grid g();\n"
+        "    g.Fill();\n"
+        "    ASSERT(g.map == 5);\n"
+        "}\n"
+    );
+}
+
 TEST_F(CBotUT, LiteralCharacters)
 {
     ExecuteTest(
@@ -0,0 +1,227 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "bench/bench.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <new>
+
+namespace
+{
+
+std::atomic<long long> g_allocationCount{0};
+
+struct BenchmarkEntry
+{
+    const char* name;
+    Bench::BenchmarkFunction function;
+};
+
+std::vector<BenchmarkEntry>& GetBenchmarks()
+{
+    static std::vector<BenchmarkEntry> benchmarks;
+    return benchmarks;
+}
+
+} // anonymous namespace
+
+// Count every heap allocation of the process, including ones made by CBot and Colobot-Base
+
+void* operator new(std::size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+
+    return pointer;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace Bench
+{
+
+CState::CState(long long minIterations, double minSeconds)
+    : m_minIterations(minIterations), m_minSeconds(minSeconds)
+{
+}
+
+bool CState::KeepRunning()
+{
+    if (!m_started)
+    {
+        m_started = true;
+        m_allocationsAtStart = GetAllocationCount();
+        m_start = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    ++m_iterations;
+
+    if (m_iterations < m_minIterations || GetSeconds() < m_minSeconds)
+        return true;
+
+    PauseTiming();
+    return false;
+}
+
+void CState::PauseTiming()
+{
+    if (m_paused) return;
+
+    m_elapsed += std::chrono::steady_clock::now() - m_start;
+    m_allocations += GetAllocationCount() - m_allocationsAtStart;
+    m_paused = true;
+}
+
+void CState::ResumeTiming()
+{
+    if (!m_paused) return;
+
+    m_paused = false;
+    m_allocationsAtStart = GetAllocationCount();
+    m_start = std::chrono::steady_clock::now();
+}
+
+double CState::GetSeconds() const
+{
+    if (!m_started) return 0.0;
+
+    auto elapsed = m_elapsed;
+    if (!m_paused)
+        elapsed += std::chrono::steady_clock::now() - m_start;
+
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+void CState::SetCounter(const std::string& name, double value)
+{
+    for (auto& counter : m_counters)
+    {
+        if (counter.first == name)
+        {
+            counter.second = value;
+            return;
+        }
+    }
+
+    m_counters.emplace_back(name, value);
+}
+
+void CState::SetItemsPerIteration(long long items)
+{
+    m_itemsPerIteration = items;
+}
+
+void CState::SetError(const std::string& message)
+{
+    if (m_error.empty())
+        m_error = message;
+}
+
+CRegistration::CRegistration(const char* name, BenchmarkFunction function)
+{
+    GetBenchmarks().push_back({ name, function });
+}
+
+RunSummary RunBenchmarks(const std::string& filter, bool quick)
+{
+    RunSummary summary;
+
+    for (const auto& benchmark : GetBenchmarks())
+    {
+        std::string name = benchmark.name;
+        if (!filter.empty() && name.find(filter) == std::string::npos)
+            continue;
+
+        CState state(quick ? 1 : 10, quick ? 0.0 : 0.5);
+        try
+        {
+            benchmark.function(state);
+        }
+        catch (const std::exception& exception)
+        {
+            state.SetError(std::string("exception: ") + exception.what());
+        }
+        ++summary.run;
+
+        long long iterations = state.GetIterations() > 0 ? state.GetIterations() : 1;
+        double perIteration = state.GetSeconds() / iterations;
+
+        std::printf("%-40s %10lld it %14.3f us/it %10.1f allocs/it",
+            name.c_str(), iterations, perIteration * 1e6,
+            static_cast<double>(state.GetAllocations()) / iterations);
+
+        if (state.GetItemsPerIteration() > 0 && perIteration > 0.0)
+            std::printf(" %12.3e items/s", state.GetItemsPerIteration() / perIteration);
+
+        for (const auto& counter : state.GetCounters())
+            std::printf(" %s=%g", counter.first.c_str(), counter.second);
+
+        if (state.HasError())
+        {
+            std::printf(" FAILED: %s", state.GetError().c_str());
+            ++summary.failed;
+        }
+
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+    return summary;
+}
+
+long long GetAllocationCount()
+{
+    return g_allocationCount.load(std::memory_order_relaxed);
+}
+
+void UsePointer(const void*)
+{
+}
+
+} // namespace Bench
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file bench/bench.h
+ * \brief Minimal benchmark harness used by Colobot-Benchmarks
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Bench
+{
+
+/**
+ * \class CState
+ * \brief State of a running benchmark
+ *
+ * The benchmark body loops while KeepRunning() returns true; everything
+ * inside the loop is timed, and heap allocations made inside it are counted.
+ * Code before the loop is setup and is not measured.
+ */
+class CState
+{
+public:
+    CState(long long minIterations, double minSeconds);
+
+    //! Returns true as long as more iterations are needed
+    bool KeepRunning();
+
+    //! Stops measuring time and allocations, e.g. for setup done inside the loop
+    void PauseTiming();
+    //! Resumes measuring after PauseTiming()
+    void ResumeTiming();
+
+    //! Reports an additional value printed next to the timing
+    void SetCounter(const std::string& name, double value);
+
+    //! Sets how many items (e.g. instructions) a single iteration processes
+    void SetItemsPerIteration(long long items);
+
+    //! Marks the benchmark as failed, e.g. when the measured code gave a wrong result
+    void SetError(const std::string& message);
+
+    long long GetIterations() const { return m_iterations; }
+    double GetSeconds() const;
+    long long GetAllocations() const { return m_allocations; }
+    long long GetItemsPerIteration() const { return m_itemsPerIteration; }
+    const std::vector<std::pair<std::string, double>>& GetCounters() const { return m_counters; }
+    bool HasError() const { return !m_error.empty(); }
+    const std::string& GetError() const { return m_error; }
+
+private:
+    long long m_minIterations;
+    double m_minSeconds;
+
+    long long m_iterations = 0;
+    bool m_started = false;
+    bool m_paused = false;
+    std::chrono::steady_clock::time_point m_start;
+    std::chrono::steady_clock::duration m_elapsed{};
+    long long m_allocationsAtStart = 0;
+    long long m_allocations = 0;
+    long long m_itemsPerIteration = 0;
+
+    std::vector<std::pair<std::string, double>> m_counters;
+    std::string m_error;
+};
+
+using BenchmarkFunction = void (*)(CState&);
+
+/**
+ * \class CRegistration
+ * \brief Adds benchmark to the global list, used through BENCHMARK() macro
+ */
+class CRegistration
+{
+public:
+    CRegistration(const char* name, BenchmarkFunction function);
+};
+
+//! Returns number of heap allocations made so far by the whole process
+long long GetAllocationCount();
+
+//! Numbers of benchmarks run by RunBenchmarks()
+struct RunSummary
+{
+    int run = 0;
+    //! Benchmarks which called CState::SetError() or threw an exception
+    int failed = 0;
+};
+
+/**
+ * \brief Runs registered benchmarks and prints their results
+ * \param filter only benchmarks with names containing this text are run
+ * \param quick run every benchmark just once (used as smoke test)
+ */
+RunSummary RunBenchmarks(const std::string& filter, bool quick);
+
+//! Opaque to the optimizer, see DoNotOptimize()
+void UsePointer(const void* pointer);
+
+//! Prevents the compiler from optimizing away computation of \a value
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+    UsePointer(&value);
+}
+
+} // namespace Bench
+
+//! Defines and registers a benchmark
+#define BENCHMARK(name) \
+    static void name(Bench::CState& state); \
+    static Bench::CRegistration name##Registration(#name, name); \
+    static void name(Bench::CState& state)
@@ -0,0 +1,61 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "bench/bench.h"
+
+#include "common/logger.h"
+
+#include "common/resources/resourcemanager.h"
+
+#include <clocale>
+#include <cstdio>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    CLogger logger;
+    logger.SetLogLevel(LOG_ERROR);
+
+    CResourceManager resourceManager(argv[0]);
+
+    setlocale(LC_ALL, "en_US.UTF-8");
+
+    std::string filter;
+    bool quick = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        if (arg == "--quick")
+            quick = true;
+        else if (arg == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else
+        {
+            std::printf("Usage: %s [--quick] [--filter NAME]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Bench::RunSummary summary = Bench::RunBenchmarks(filter, quick);
+    if (summary.failed > 0)
+        std::printf("%d of %d benchmarks failed\n", summary.failed, summary.run);
+
+    return summary.run > 0 && summary.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "bench/bench.h"
+
+#include "common/thread/job_system.h"
+
+#include <atomic>
+#include <vector>
+
+// Scheduling overhead: submitting an empty job and waiting for it
+BENCHMARK(JobSystemSubmitWait)
+{
+    CJobSystem jobs;
+
+    while (state.KeepRunning())
+    {
+        auto job = jobs.Submit([]() {});
+        jobs.Wait(job);
+    }
+
+    state.SetCounter("threads", jobs.GetThreadCount());
+}
+
+// Throughput of many small independent jobs, per job
+BENCHMARK(JobSystemBatch)
+{
+    constexpr int JOBS = 1000;
+
+    CJobSystem jobs;
+    std::atomic<int> counter{0};
+
+    while (state.KeepRunning())
+    {
+        for (int i = 0; i < JOBS; ++i)
+            jobs.Submit([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+        jobs.WaitAll();
+    }
+
+    state.SetItemsPerIteration(JOBS);
+    state.SetCounter("threads", jobs.GetThreadCount());
+}
+
+// Chain of dependent jobs, each started only when the previous one finished
+BENCHMARK(JobSystemChain)
+{
+    constexpr int JOBS = 100;
+
+    CJobSystem jobs;
+
+    while (state.KeepRunning())
+    {
+        JobHandle previous;
+        for (int i = 0; i < JOBS; ++i)
+            previous = jobs.Submit([]() {}, nullptr, { previous });
+        jobs.Wait(previous);
+    }
+
+    state.SetItemsPerIteration(JOBS);
+}
+
+// Completion functions handed back to the calling thread
+BENCHMARK(JobSystemCompletions)
+{
+    constexpr int JOBS = 1000;
+
+    CJobSystem jobs;
+    int completed = 0;
+
+    while (state.KeepRunning())
+    {
+        for (int i = 0; i < JOBS; ++i)
+            jobs.Submit([]() {}, [&completed]() { ++completed; });
+        jobs.WaitAll();
+        jobs.ProcessCompletions();
+    }
+
+    Bench::DoNotOptimize(completed);
+    state.SetItemsPerIteration(JOBS);
+}
@@ -0,0 +1,208 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "common/thread/job_system.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST(JobSystemTest, RunsAllJobs)
+{
+    CJobSystem jobs(4);
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 1000; ++i)
+        jobs.Submit([&counter]() { ++counter; });
+
+    jobs.WaitAll();
+
+    EXPECT_EQ(counter, 1000);
+}
+
+TEST(JobSystemTest, DependenciesFinishFirst)
+{
+    CJobSystem jobs(4);
+    std::mutex mutex;
+    std::vector<char> order;
+
+    auto record = [&](char name)
+    {
+        return [&, name]()
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            order.push_back(name);
+        };
+    };
+
+    // a -> b, c -> d
+    auto a = jobs.Submit(record('a'));
+    auto b = jobs.Submit(record('b'), nullptr, { a });
+    auto c = jobs.Submit(record('c'), nullptr, { a });
+    auto d = jobs.Submit(record('d'), nullptr, { b, c });
+
+    jobs.Wait(d);
+
+    ASSERT_EQ(order.size(), 4u);
+    EXPECT_EQ(order.front(), 'a');
+    EXPECT_EQ(order.back(), 'd');
+    EXPECT_TRUE(jobs.IsFinished(b));
+    EXPECT_TRUE(jobs.IsFinished(c));
+}
+
+TEST(JobSystemTest, DependencyOnFinishedJobIsIgnored)
+{
+    CJobSystem jobs(1);
+    bool ran = false;
+
+    auto first = jobs.Submit([]() {});
+    jobs.Wait(first);
+
+    auto second = jobs.Submit([&ran]() { ran = true; }, nullptr, { first, nullptr });
+    jobs.Wait(second);
+
+    EXPECT_TRUE(ran);
+}
+
+TEST(JobSystemTest, CompletionsRunOnlyInProcessCompletions)
+{
+    CJobSystem jobs(2);
+    std::thread::id completionThread;
+    int result = 0;
+
+    auto job = jobs.Submit([&result]() { result = 42; }, [&completionThread]()
+    {
+        completionThread = std::this_thread::get_id();
+    });
+
+    jobs.Wait(job);
+    EXPECT_EQ(result, 42);
+    EXPECT_EQ(completionThread, std::thread::id());
+
+    EXPECT_EQ(jobs.ProcessCompletions(), 1);
+    EXPECT_EQ(completionThread, std::this_thread::get_id());
+
+    EXPECT_EQ(jobs.ProcessCompletions(), 0);
+}
+
+TEST(JobSystemTest, WaitInsideJobDoesNotDeadlock)
+{
+    CJobSystem jobs(1);
+    std::atomic<int> inner{0};
+
+    auto outer = jobs.Submit([&jobs, &inner]()
+    {
+        auto job = jobs.Submit([&inner]() { inner = 1; });
+        jobs.Wait(job);
+    });
+
+    jobs.Wait(outer);
+
+    EXPECT_EQ(inner, 1);
+}
+
+TEST(JobSystemTest, ParallelForVisitsEveryIndexOnce)
+{
+    CJobSystem jobs(4);
+    std::vector<std::atomic<int>> visits(1001);
+
+    jobs.ParallelFor(static_cast<int>(visits.size()), 64, [&visits](int i) { ++visits[i]; });
+
+    for (const auto& count : visits)
+        EXPECT_EQ(count, 1);
+}
+
+TEST(JobSystemTest, DestructorFinishesQueuedJobs)
+{
+    std::atomic<int> counter{0};
+
+    {
+        CJobSystem jobs(2);
+        for (int i = 0; i < 100; ++i)
+            jobs.Submit([&counter]() { ++counter; });
+    }
+
+    EXPECT_EQ(counter, 100);
+}
+
+TEST(JobSystemTest, WaitRunsOnlyWaitedJobAndDependencies)
+{
+    CJobSystem jobs(1);
+    std::atomic<bool> release{false};
+    std::thread::id unrelatedThread, dependencyThread, waitedThread;
+
+    // keeps the only worker busy, so that everything else stays queued
+    auto blocker = jobs.Submit([&release]()
+    {
+        while (!release)
+            std::this_thread::yield();
+    });
+
+    auto unrelated = jobs.Submit([&]() { unrelatedThread = std::this_thread::get_id(); });
+    auto dependency = jobs.Submit([&]() { dependencyThread = std::this_thread::get_id(); });
+    auto waited = jobs.Submit([&]() { waitedThread = std::this_thread::get_id(); }, nullptr, { dependency });
+
+    jobs.Wait(waited);
+
+    EXPECT_EQ(dependencyThread, std::this_thread::get_id());
+    EXPECT_EQ(waitedThread, std::this_thread::get_id());
+    EXPECT_FALSE(jobs.IsFinished(unrelated));
+    EXPECT_FALSE(jobs.IsFinished(blocker));
+
+    release = true;
+    while (!jobs.IsFinished(unrelated))
+        std::this_thread::yield();
+
+    EXPECT_NE(unrelatedThread, std::this_thread::get_id());
+}
+
+TEST(JobSystemTest, ExceptionOfAnyTypeDoesNotStopWorker)
+{
+    CJobSystem jobs(1);
+
+    auto throwing = jobs.Submit([]() { throw 42; });
+    while (!jobs.IsFinished(throwing))
+        std::this_thread::yield();
+
+    std::thread::id thread;
+    auto next = jobs.Submit([&thread]() { thread = std::this_thread::get_id(); });
+    while (!jobs.IsFinished(next))
+        std::this_thread::yield();
+
+    EXPECT_NE(thread, std::this_thread::get_id());
+}
+
+TEST(JobSystemTest, DestructorRunsPendingCompletions)
+{
+    int completions = 0;
+
+    {
+        CJobSystem jobs(2);
+        jobs.Submit([]() {}, [&jobs, &completions]()
+        {
+            ++completions;
+            jobs.Submit([]() {}, [&completions]() { ++completions; });
+        });
+    }
+
+    EXPECT_EQ(completions, 2);
+}
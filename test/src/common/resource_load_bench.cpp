@@ -0,0 +1,208 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "bench/bench.h"
+
+#include "common/config.h"
+#include "common/profiler.h"
+
+#include "common/resources/inputstream.h"
+#include "common/resources/resourcemanager.h"
+
+#include <physfs.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+//! Where the data directory is mounted, apart from files of other benchmarks
+const std::string MOUNT_POINT = "bench-data";
+
+/**
+ * Every file of the data directory, mounted in the resource system
+ * for the lifetime of the benchmark executable
+ */
+class CBenchDataTree
+{
+public:
+    CBenchDataTree()
+    {
+        if (!CResourceManager::AddLocation(COLOBOT_DEFAULT_DATADIR, true, MOUNT_POINT))
+            return;
+
+        AddFiles(MOUNT_POINT);
+        for (const auto& file : m_files)
+            m_totalSize += CResourceManager::GetFileSize(file);
+    }
+
+    ~CBenchDataTree()
+    {
+        CResourceManager::RemoveLocation(COLOBOT_DEFAULT_DATADIR);
+    }
+
+    const std::vector<std::string>& GetFiles() const
+    {
+        return m_files;
+    }
+
+    double GetTotalSizeMb() const
+    {
+        return m_totalSize / (1024.0 * 1024.0);
+    }
+
+private:
+    void AddFiles(const std::string& directory)
+    {
+        std::string prefix = directory + "/";
+        for (const auto& file : CResourceManager::ListFiles(directory, true))
+            m_files.push_back(prefix + file);
+        for (const auto& subdirectory : CResourceManager::ListDirectories(directory))
+            AddFiles(prefix + subdirectory);
+    }
+
+    std::vector<std::string> m_files;
+    long long m_totalSize = 0;
+};
+
+const CBenchDataTree& UseBenchDataTree()
+{
+    static CBenchDataTree dataTree;
+    return dataTree;
+}
+
+//! Reads a stream into the structures of a consumer, like the model readers do
+unsigned int Consume(std::istream& stream, std::vector<char>& data)
+{
+    unsigned int checksum = 0;
+    while (stream.read(data.data(), data.size()) || stream.gcount() > 0)
+    {
+        for (std::streamsize i = 0; i < stream.gcount(); i += 4096)
+            checksum += static_cast<unsigned char>(data[i]);
+    }
+    return checksum;
+}
+
+//! Copy of the former CInputStreamBuffer, reading PhysFS files through a fixed-size buffer
+class CBufferedPhysFSStream : public std::streambuf
+{
+public:
+    explicit CBufferedPhysFSStream(const std::string& path)
+        : m_file(PHYSFS_openRead(path.c_str()))
+    {
+    }
+
+    ~CBufferedPhysFSStream()
+    {
+        if (m_file != nullptr)
+            PHYSFS_close(m_file);
+    }
+
+    long long GetBytesCopied() const
+    {
+        return m_bytesCopied;
+    }
+
+private:
+    int_type underflow() override
+    {
+        if (m_file == nullptr || PHYSFS_eof(m_file))
+            return traits_type::eof();
+
+        PHYSFS_sint64 count = PHYSFS_readBytes(m_file, m_buffer, sizeof(m_buffer));
+        if (count <= 0)
+            return traits_type::eof();
+
+        m_bytesCopied += count;
+        setg(m_buffer, m_buffer, m_buffer + count);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    PHYSFS_File* m_file;
+    char m_buffer[512];
+    long long m_bytesCopied = 0;
+};
+
+} // anonymous namespace
+
+// Loading every file of the data directory through the resource system
+BENCHMARK(ResourceLoadDataTree)
+{
+    const auto& dataTree = UseBenchDataTree();
+    std::vector<char> data(64 * 1024);
+
+    unsigned int checksum = 0;
+    auto loadAll = [&]()
+    {
+        for (const auto& file : dataTree.GetFiles())
+        {
+            CInputStream stream(file);
+            checksum += Consume(stream, data);
+        }
+    };
+
+    // Both ways must read the same contents
+    loadAll();
+    state.SetCounter("checksum", checksum);
+
+    CProfiler::ResetPerformanceStats();
+    while (state.KeepRunning())
+        loadAll();
+    Bench::DoNotOptimize(checksum);
+
+    double copied = CProfiler::GetCurrentPerformanceStat(PSTAT_RESOURCE_BYTES_COPIED);
+    state.SetCounter("files", dataTree.GetFiles().size());
+    state.SetCounter("data_mb", dataTree.GetTotalSizeMb());
+    state.SetCounter("copied_mb/it", copied / state.GetIterations() / (1024.0 * 1024.0));
+    state.SetItemsPerIteration(dataTree.GetFiles().size());
+}
+
+// Same, through a fixed-size buffer as files in archives still are
+BENCHMARK(ResourceLoadDataTreeBuffered)
+{
+    const auto& dataTree = UseBenchDataTree();
+    std::vector<char> data(64 * 1024);
+
+    long long copied = 0;
+    unsigned int checksum = 0;
+    auto loadAll = [&]()
+    {
+        for (const auto& file : dataTree.GetFiles())
+        {
+            CBufferedPhysFSStream buffer(file);
+            std::istream stream(&buffer);
+            checksum += Consume(stream, data);
+            copied += buffer.GetBytesCopied();
+        }
+    };
+
+    loadAll();
+    state.SetCounter("checksum", checksum);
+
+    copied = 0;
+    while (state.KeepRunning())
+        loadAll();
+    Bench::DoNotOptimize(checksum);
+
+    state.SetCounter("files", dataTree.GetFiles().size());
+    state.SetCounter("data_mb", dataTree.GetTotalSizeMb());
+    state.SetCounter("copied_mb/it", copied / static_cast<double>(state.GetIterations()) / (1024.0 * 1024.0));
+    state.SetItemsPerIteration(dataTree.GetFiles().size());
+}
@@ -0,0 +1,199 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+#include "common/resources/mapped_file.h"
+
+#include "common/temporary_location.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace
+{
+
+//! Returns \a size bytes of every value, so that no byte is treated specially
+std::string MakeContents(std::size_t size)
+{
+    std::string contents(size, '\0');
+    for (std::size_t i = 0; i < size; ++i)
+        contents[i] = static_cast<char>((i * 7 + i / 251) & 0xFF);
+    return contents;
+}
+
+//! Returns the contents of an open file
+std::string GetContents(const CMappedFile& file)
+{
+    return std::string(file.GetData(), file.GetSize());
+}
+
+void AppendInt(std::string& data, std::uint32_t value, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        data += static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+std::uint32_t GetCrc32(const std::string& data)
+{
+    std::uint32_t crc = 0xFFFFFFFF;
+    for (char c : data)
+    {
+        crc ^= static_cast<unsigned char>(c);
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+//! Returns a zip archive holding one uncompressed file
+std::string MakeZip(const std::string& filename, const std::string& contents)
+{
+    std::uint32_t crc = GetCrc32(contents);
+    std::uint32_t size = static_cast<std::uint32_t>(contents.size());
+
+    std::string zip;
+    AppendInt(zip, 0x04034B50, 4); // local file header
+    AppendInt(zip, 10, 2);         // version needed
+    AppendInt(zip, 0, 2);          // flags
+    AppendInt(zip, 0, 2);          // stored
+    AppendInt(zip, 0, 4);          // time and date
+    AppendInt(zip, crc, 4);
+    AppendInt(zip, size, 4);
+    AppendInt(zip, size, 4);
+    AppendInt(zip, static_cast<std::uint32_t>(filename.size()), 2);
+    AppendInt(zip, 0, 2);          // extra field length
+    zip += filename;
+    zip += contents;
+
+    std::uint32_t directoryOffset = static_cast<std::uint32_t>(zip.size());
+    AppendInt(zip, 0x02014B50, 4); // central directory header
+    AppendInt(zip, 10, 2);         // version made by
+    AppendInt(zip, 10, 2);         // version needed
+    AppendInt(zip, 0, 2);          // flags
+    AppendInt(zip, 0, 2);          // stored
+    AppendInt(zip, 0, 4);          // time and date
+    AppendInt(zip, crc, 4);
+    AppendInt(zip, size, 4);
+    AppendInt(zip, size, 4);
+    AppendInt(zip, static_cast<std::uint32_t>(filename.size()), 2);
+    AppendInt(zip, 0, 2);          // extra field length
+    AppendInt(zip, 0, 2);          // comment length
+    AppendInt(zip, 0, 2);          // disk number
+    AppendInt(zip, 0, 2);          // internal attributes
+    AppendInt(zip, 0, 4);          // external attributes
+    AppendInt(zip, 0, 4);          // offset of local header
+    zip += filename;
+
+    std::uint32_t directorySize = static_cast<std::uint32_t>(zip.size()) - directoryOffset;
+    AppendInt(zip, 0x06054B50, 4); // end of central directory
+    AppendInt(zip, 0, 2);          // disk number
+    AppendInt(zip, 0, 2);          // disk with directory
+    AppendInt(zip, 1, 2);          // entries on disk
+    AppendInt(zip, 1, 2);          // entries
+    AppendInt(zip, directorySize, 4);
+    AppendInt(zip, directoryOffset, 4);
+    AppendInt(zip, 0, 2);          // comment length
+    return zip;
+}
+
+} // anonymous namespace
+
+using CMappedFileUT = CTemporaryLocationUT;
+
+TEST_F(CMappedFileUT, MapsLargeFiles)
+{
+    std::string contents = MakeContents(3 * CMappedFile::MIN_MAPPED_SIZE + 123);
+
+    for (std::size_t size : { CMappedFile::MIN_MAPPED_SIZE, contents.size() })
+    {
+        WriteFile("large.bin", contents.substr(0, size));
+
+        CMappedFile file;
+        ASSERT_TRUE(file.Open("large.bin"));
+        EXPECT_TRUE(file.IsOpen());
+        EXPECT_TRUE(file.IsMapped());
+        EXPECT_EQ(GetContents(file), contents.substr(0, size));
+    }
+}
+
+TEST_F(CMappedFileUT, BuffersSmallFiles)
+{
+    std::string contents = MakeContents(CMappedFile::MIN_MAPPED_SIZE - 1);
+    WriteFile("small.bin", contents);
+
+    CMappedFile file;
+    ASSERT_TRUE(file.Open("small.bin"));
+    EXPECT_FALSE(file.IsMapped());
+    EXPECT_EQ(GetContents(file), contents);
+
+    EXPECT_FALSE(file.Open("small.bin", true));
+    EXPECT_FALSE(file.IsOpen());
+}
+
+TEST_F(CMappedFileUT, MappedAndBufferedFilesHaveSameContents)
+{
+    // Files in archives are never mapped, whatever their size
+    std::string contents = MakeContents(2 * CMappedFile::MIN_MAPPED_SIZE + 5);
+    WriteFile("large.bin", contents);
+    WriteFile("archive.zip", MakeZip("archived/large.bin", contents));
+    ASSERT_TRUE(CResourceManager::AddLocation(GetPath("archive.zip").string()));
+
+    CMappedFile mapped;
+    ASSERT_TRUE(mapped.Open("large.bin"));
+    EXPECT_TRUE(mapped.IsMapped());
+
+    CMappedFile buffered;
+    ASSERT_TRUE(buffered.Open("archived/large.bin"));
+    EXPECT_FALSE(buffered.IsMapped());
+
+    EXPECT_EQ(GetContents(mapped), contents);
+    EXPECT_EQ(GetContents(buffered), contents);
+
+    EXPECT_FALSE(buffered.Open("archived/large.bin", true));
+
+    ASSERT_TRUE(CResourceManager::RemoveLocation(GetPath("archive.zip").string()));
+}
+
+TEST_F(CMappedFileUT, OpensEmptyFiles)
+{
+    WriteFile("empty.bin", "");
+
+    CMappedFile file;
+    ASSERT_TRUE(file.Open("empty.bin"));
+    EXPECT_TRUE(file.IsOpen());
+    EXPECT_FALSE(file.IsMapped());
+    EXPECT_EQ(file.GetSize(), 0u);
+    EXPECT_EQ(GetContents(file), "");
+}
+
+TEST_F(CMappedFileUT, FailsOnMissingFiles)
+{
+    CMappedFile file;
+    EXPECT_FALSE(file.Open("missing.bin"));
+    EXPECT_FALSE(file.IsOpen());
+    EXPECT_FALSE(file.IsMapped());
+    EXPECT_EQ(file.GetData(), nullptr);
+    EXPECT_EQ(file.GetSize(), 0u);
+
+    // A failed open releases the previous file too
+    WriteFile("large.bin", MakeContents(CMappedFile::MIN_MAPPED_SIZE));
+    ASSERT_TRUE(file.Open("large.bin"));
+    EXPECT_FALSE(file.Open("missing.bin"));
+    EXPECT_FALSE(file.IsOpen());
+    EXPECT_EQ(file.GetData(), nullptr);
+}
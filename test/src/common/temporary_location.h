@@ -0,0 +1,92 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file common/temporary_location.h
+ * \brief Fixture for tests reading and writing files through CResourceManager
+ */
+
+#pragma once
+
+#include "common/resources/resourcemanager.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+/**
+ * \class CTemporaryLocationUT
+ * \brief Creates an empty directory used as the only search path and as the save location
+ *
+ * The directory and everything written to it is removed after each test.
+ */
+class CTemporaryLocationUT : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_resourceManager = std::make_unique<CResourceManager>(nullptr);
+
+        const auto* info = testing::UnitTest::GetInstance()->current_test_info();
+        m_directory = std::filesystem::temp_directory_path() /
+            (std::string("colobot-test-") + info->test_suite_name() + "-" + info->name());
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+
+        ASSERT_TRUE(CResourceManager::SetSaveLocation(m_directory.string()));
+        ASSERT_TRUE(CResourceManager::AddLocation(m_directory.string()));
+    }
+
+    void TearDown() override
+    {
+        m_resourceManager.reset();
+
+        std::error_code error;
+        std::filesystem::remove_all(m_directory, error);
+    }
+
+    //! Returns real path of a file in the directory
+    std::filesystem::path GetPath(const std::string& filename) const
+    {
+        return m_directory / filename;
+    }
+
+    //! Writes a file directly, without going through CResourceManager
+    void WriteFile(const std::string& filename, const std::string& contents) const
+    {
+        std::filesystem::create_directories(GetPath(filename).parent_path());
+        std::ofstream file(GetPath(filename), std::ios::binary);
+        file << contents;
+    }
+
+    //! Reads a file directly, without going through CResourceManager
+    std::string ReadFile(const std::string& filename) const
+    {
+        std::ifstream file(GetPath(filename), std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+private:
+    std::unique_ptr<CResourceManager> m_resourceManager;
+    std::filesystem::path m_directory;
+};
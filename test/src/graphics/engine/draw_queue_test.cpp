@@ -0,0 +1,128 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/core/recording_device.h"
+
+#include "graphics/engine/engine.h"
+
+#include "common/profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace Gfx;
+
+namespace
+{
+
+Texture MakeTexture(unsigned int id)
+{
+    Texture texture;
+    texture.id = id;
+    return texture;
+}
+
+long long SubmitToRecordingDevice(const std::vector<EngineDrawItem>& queue)
+{
+    CRecordingDevice device;
+    device.Create();
+
+    CProfiler::ResetPerformanceStats();
+
+    auto renderer = device.GetObjectRenderer();
+    renderer->Begin();
+
+    for (const auto& item : queue)
+    {
+        renderer->SetAlbedoTexture(MakeTexture(item.textures[0]));
+        renderer->SetEmissiveTexture(MakeTexture(item.textures[1]));
+        renderer->SetMaterialTexture(MakeTexture(item.textures[2]));
+        renderer->SetDetailTexture(MakeTexture(item.textures[3]));
+        renderer->DrawObject(nullptr);
+    }
+
+    renderer->End();
+
+    return CProfiler::GetCurrentPerformanceStat(PSTAT_TEXTURE_BINDS);
+}
+
+} // anonymous namespace
+
+TEST(DrawQueueTest, RecordingDeviceCountsOnlyChangedTextures)
+{
+    CRecordingDevice device;
+    ASSERT_TRUE(device.Create());
+
+    CProfiler::ResetPerformanceStats();
+
+    auto renderer = device.GetObjectRenderer();
+    renderer->Begin();
+    renderer->SetAlbedoTexture(MakeTexture(1));
+    renderer->SetAlbedoTexture(MakeTexture(1));
+    renderer->SetAlbedoTexture(MakeTexture(2));
+    renderer->SetEmissiveTexture(MakeTexture(0));
+    renderer->DrawObject(nullptr);
+    renderer->End();
+
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_TEXTURE_BINDS), 2);
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_DRAW_CALLS), 1);
+}
+
+TEST(DrawQueueTest, SortGroupsSameTexturesAndKeepsObjectOrder)
+{
+    std::vector<EngineDrawItem> queue;
+    for (int objRank = 0; objRank < 6; ++objRank)
+    {
+        EngineDrawItem item;
+        item.textures = { static_cast<unsigned int>(1 + objRank % 2), 0, 0, 0 };
+        item.objRank = objRank;
+        queue.push_back(item);
+    }
+
+    SortDrawQueue(queue);
+
+    std::vector<int> order;
+    for (const auto& item : queue)
+        order.push_back(item.objRank);
+
+    EXPECT_EQ(order, std::vector<int>({ 0, 2, 4, 1, 3, 5 }));
+}
+
+TEST(DrawQueueTest, SortReducesTextureBinds)
+{
+    std::vector<EngineDrawItem> queue;
+    for (int objRank = 0; objRank < 100; ++objRank)
+    {
+        for (unsigned int tier = 0; tier < 3; ++tier)
+        {
+            EngineDrawItem item;
+            item.textures = { 10 + tier, 20 + tier % 2, 0, 30 };
+            item.objRank = objRank;
+            queue.push_back(item);
+        }
+    }
+
+    long long unsorted = SubmitToRecordingDevice(queue);
+    SortDrawQueue(queue);
+    long long sorted = SubmitToRecordingDevice(queue);
+
+    EXPECT_EQ(unsorted, 502);
+    EXPECT_EQ(sorted, 7);
+}
@@ -0,0 +1,747 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "bench/bench.h"
+
+#include "app/app.h"
+
+#include "graphics/core/material.h"
+#include "graphics/core/recording_device.h"
+#include "graphics/core/renderers.h"
+
+#include "graphics/engine/engine.h"
+#include "graphics/engine/mesh_lod.h"
+#include "graphics/engine/particle_batch.h"
+#include "graphics/engine/quad_batch.h"
+#include "graphics/engine/shadow_cache.h"
+#include "graphics/engine/wheel_trace.h"
+
+#include "common/profiler.h"
+
+#include "common/system/system.h"
+
+#include "math/geometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Gfx;
+
+namespace
+{
+
+// Scene of many objects sharing a few texture sets, queued in object order
+std::vector<EngineDrawItem> MakeScene()
+{
+    std::vector<EngineDrawItem> queue;
+    for (int objRank = 0; objRank < 500; ++objRank)
+    {
+        for (unsigned int tier = 0; tier < 4; ++tier)
+        {
+            EngineDrawItem item;
+            item.textures = { 1 + (objRank * 7 + tier) % 16, 100 + tier % 2, 0, 200 };
+            item.objRank = objRank;
+            queue.push_back(item);
+        }
+    }
+    return queue;
+}
+
+void Submit(CObjectRenderer* renderer, const std::vector<EngineDrawItem>& queue)
+{
+    Texture texture;
+
+    renderer->Begin();
+    for (const auto& item : queue)
+    {
+        texture.id = item.textures[0];
+        renderer->SetAlbedoTexture(texture);
+        texture.id = item.textures[1];
+        renderer->SetEmissiveTexture(texture);
+        texture.id = item.textures[2];
+        renderer->SetMaterialTexture(texture);
+        texture.id = item.textures[3];
+        renderer->SetDetailTexture(texture);
+        renderer->DrawObject(nullptr);
+    }
+    renderer->End();
+}
+
+// Pen strokes of 50 traces each, scattered over a map of 1600x1600
+void AddStrokes(CWheelTraces& traces, int count)
+{
+    unsigned int seed = 1;
+    auto random = [&seed]()
+    {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<float>((seed >> 16) & 0x7fff) / 32768.0f;
+    };
+
+    for (int stroke = 0; stroke < count / 50; ++stroke)
+    {
+        glm::vec3 pos(random() * 1600.0f - 800.0f, 0.2f, random() * 1600.0f - 800.0f);
+        auto color = static_cast<TraceColor>(static_cast<int>(random() * static_cast<float>(TraceColor::Max)));
+
+        for (int i = 0; i < 50; ++i)
+        {
+            WheelTrace trace;
+            trace.color = color;
+            trace.pos[0] = pos;
+            trace.pos[1] = pos + glm::vec3(0.0f, 0.0f, 0.5f);
+            pos.x += 2.0f;
+            trace.pos[2] = pos;
+            trace.pos[3] = pos + glm::vec3(0.0f, 0.0f, 0.5f);
+            traces.Add(trace);
+        }
+    }
+}
+
+// Draws the traces seen from the center of the map, like CParticle::DrawParticle()
+void DrawWheelTraces(Bench::CState& state, int count)
+{
+    CRecordingDevice device;
+    device.Create();
+    auto renderer = device.GetParticleRenderer();
+    CParticleBatch batch(renderer);
+
+    CWheelTraces traces;
+    AddStrokes(traces, count);
+
+    Texture arrowTexture;
+    arrowTexture.id = 1;
+
+    int triangles = 0;
+    while (state.KeepRunning())
+    {
+        CProfiler::ResetPerformanceStats();
+        renderer->Begin();
+        batch.Begin(true);
+        triangles = traces.Draw(batch, arrowTexture, { 0.0f, 0.0f, 0.0f }, 300.0f);
+        batch.End();
+        renderer->End();
+    }
+
+    state.SetItemsPerIteration(count);
+    state.SetCounter("triangles", static_cast<double>(triangles));
+    state.SetCounter("draw_calls", static_cast<double>(CProfiler::GetCurrentPerformanceStat(PSTAT_DRAW_CALLS)));
+    state.SetCounter("upload_kib", static_cast<double>(CProfiler::GetCurrentPerformanceStat(PSTAT_BUFFER_UPLOAD_BYTES)) / 1024.0);
+    state.SetCounter("memory_kib", static_cast<double>(traces.GetMemoryUsage()) / 1024.0);
+}
+
+// Glyph of a screen of highlighted program text, 60 lines of 48 characters with a new color every 6 characters
+struct Glyph
+{
+    Vertex2D vertices[4];
+    glm::u8vec4 color;
+};
+
+std::vector<Glyph> MakeProgramText()
+{
+    const glm::u8vec4 colors[] = { { 0, 0, 0, 255 }, { 0, 0, 255, 255 }, { 255, 0, 0, 255 }, { 0, 128, 0, 255 } };
+
+    std::vector<Glyph> text;
+    for (int line = 0; line < 60; ++line)
+    {
+        for (int column = 0; column < 48; ++column)
+        {
+            Glyph glyph;
+            glyph.color = colors[(line + column / 6) % 4];
+            glm::vec2 p1(column * 0.02f, line * 0.015f);
+            glm::vec2 p2 = p1 + glm::vec2(0.02f, 0.015f);
+            glyph.vertices[0] = { { p1.x, p2.y }, { 0.0f, 1.0f }, glyph.color };
+            glyph.vertices[1] = { { p1.x, p1.y }, { 0.0f, 0.0f }, glyph.color };
+            glyph.vertices[2] = { { p2.x, p2.y }, { 1.0f, 1.0f }, glyph.color };
+            glyph.vertices[3] = { { p2.x, p1.y }, { 1.0f, 0.0f }, glyph.color };
+            text.push_back(glyph);
+        }
+    }
+    return text;
+}
+
+// Draws the text with a draw call and a color for every run of one color
+void DrawTextRuns(CUIRenderer* renderer, const std::vector<Glyph>& text)
+{
+    renderer->SetTexture(Texture{ 1 });
+    renderer->SetTransparency(TransparencyMode::ALPHA);
+
+    std::vector<int> counts;
+    size_t first = 0;
+    while (first < text.size())
+    {
+        size_t last = first;
+        while (last < text.size() && text[last].color == text[first].color)
+            ++last;
+
+        counts.assign(last - first, 4);
+        renderer->SetColor(glm::vec4(text[first].color) / 255.0f);
+        auto vertices = renderer->BeginPrimitives(PrimitiveType::TRIANGLE_STRIP, static_cast<int>(counts.size()), counts.data());
+        for (size_t i = first; i < last; ++i)
+            std::copy_n(text[i].vertices, 4, vertices + (i - first) * 4);
+        renderer->EndPrimitive();
+
+        first = last;
+    }
+}
+
+// Base of buildings sharing one mesh of 432 triangles, some of them driving around
+struct PickingScene
+{
+    std::unique_ptr<CSystemUtils> systemUtils;
+    std::unique_ptr<CApplication> app;
+    std::unique_ptr<CRecordingDevice> device;
+    std::unique_ptr<CEngine> engine;
+
+    std::vector<Vertex3D> mesh;
+    std::vector<int> objects;
+    std::vector<glm::vec3> positions;
+};
+
+PickingScene MakePickingScene(int count)
+{
+    PickingScene scene;
+    scene.systemUtils = CSystemUtils::Create();
+    scene.app = std::make_unique<CApplication>(scene.systemUtils.get());
+    scene.device = std::make_unique<CRecordingDevice>();
+    scene.device->Create();
+    scene.engine = std::make_unique<CEngine>(scene.app.get(), scene.systemUtils.get());
+    scene.engine->SetDevice(scene.device.get());
+
+    // Cube of 8 units with every face cut into 6x6 squares
+    const int cuts = 6;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        for (float side : { -4.0f, 4.0f })
+        {
+            auto point = [&](int u, int v)
+            {
+                Vertex3D vertex;
+                vertex.position[axis] = side;
+                vertex.position[(axis + 1) % 3] = -4.0f + 8.0f * u / cuts;
+                vertex.position[(axis + 2) % 3] = -4.0f + 8.0f * v / cuts;
+                vertex.position.y += 4.0f;
+                return vertex;
+            };
+            for (int u = 0; u < cuts; ++u)
+            {
+                for (int v = 0; v < cuts; ++v)
+                {
+                    scene.mesh.insert(scene.mesh.end(), { point(u, v), point(u + 1, v), point(u, v + 1) });
+                    scene.mesh.insert(scene.mesh.end(), { point(u + 1, v), point(u + 1, v + 1), point(u, v + 1) });
+                }
+            }
+        }
+    }
+
+    int baseObjRank = scene.engine->CreateBaseObject();
+    scene.engine->AddBaseObjTriangles(baseObjRank, scene.mesh, Material(), EngineTriangleType::TRIANGLES);
+
+    // Buildings 12 units apart, with their centers on the grid
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+    for (int i = 0; i < count; ++i)
+    {
+        glm::vec3 position(12.0f * (i % side), 0.0f, 12.0f * (i / side));
+        glm::mat4 transform(1.0f);
+        transform[3] = glm::vec4(position, 1.0f);
+
+        int objRank = scene.engine->CreateObject();
+        scene.engine->SetObjectBaseRank(objRank, baseObjRank);
+        scene.engine->SetObjectTransform(objRank, transform);
+        scene.objects.push_back(objRank);
+        scene.positions.push_back(position);
+    }
+
+    // Camera above the middle of the base, looking down at it
+    glm::vec3 center(6.0f * side, 0.0f, 6.0f * side);
+    scene.engine->SetFocus(0.75f);
+    scene.engine->SetViewParams(center + glm::vec3(0.0f, 120.0f, -90.0f), center, glm::vec3(0.0f, 1.0f, 0.0f));
+
+    return scene;
+}
+
+// Moves 20 buildings spread over the base back and forth along their row, like vehicles between two clicks
+void MovePickingScene(PickingScene& scene, int step)
+{
+    size_t stride = std::max<size_t>(scene.objects.size() / 20, 1);
+    for (size_t i = 0; i < scene.objects.size(); i += stride)
+    {
+        glm::mat4 transform(1.0f);
+        transform[3] = glm::vec4(scene.positions[i] + glm::vec3(3.0f * std::sin(0.3f * step + static_cast<float>(i)), 0.0f, 0.0f), 1.0f);
+        scene.engine->SetObjectTransform(scene.objects[i], transform);
+    }
+}
+
+// Screen position of a point of the object, like CEngine::TransformPoint()
+bool ProjectPoint(const glm::mat4& view, const glm::mat4& projection, const glm::mat4& transform,
+                  glm::vec3 p3D, glm::vec3& p2D)
+{
+    p3D = Math::Transform(transform, p3D);
+    p3D = Math::Transform(view, p3D);
+
+    if (p3D.z < 2.0f)
+        return false;
+
+    p2D.x = (p3D.x/p3D.z)*projection[0][0];
+    p2D.y = (p3D.y/p3D.z)*projection[1][1];
+    p2D.z = p3D.z;
+
+    p2D.x = (p2D.x+1.0f)/2.0f;
+    p2D.y = (p2D.y+1.0f)/2.0f;
+
+    return true;
+}
+
+struct PickResult
+{
+    int object = -1;
+    glm::vec3 position{ 0.0f, 0.0f, 0.0f };
+};
+
+/**
+ * Picks like CEngine::DetectObject() did before the picking trees: the screen box
+ * of every object, then every triangle of the objects whose box contains the mouse
+ */
+PickResult PickAll(PickingScene& scene, const glm::vec2& mouse)
+{
+    const glm::mat4& view = scene.engine->GetMatView();
+    const glm::mat4& projection = scene.engine->GetMatProj();
+    glm::mat4 viewInverse = glm::inverse(view);
+    glm::mat4 projectionInverse = glm::inverse(projection);
+
+    PickResult result;
+    float min = 1000000.0f;
+
+    for (int objRank : scene.objects)
+    {
+        glm::mat4 transform;
+        scene.engine->GetObjectTransform(objRank, transform);
+
+        // CEngine::DetectBBox()
+        glm::vec3 bboxMin, bboxMax;
+        scene.engine->GetObjectBBox(objRank, bboxMin, bboxMax);
+        glm::vec2 boxMin( 1000000.0f,  1000000.0f);
+        glm::vec2 boxMax(-1000000.0f, -1000000.0f);
+        for (int i = 0; i < 8; i++)
+        {
+            glm::vec3 p((i & 1) ? bboxMin.x : bboxMax.x, (i & 2) ? bboxMin.y : bboxMax.y, (i & 4) ? bboxMin.z : bboxMax.z);
+            glm::vec3 pp;
+            if (ProjectPoint(view, projection, transform, p, pp))
+            {
+                boxMin = glm::min(boxMin, glm::vec2(pp));
+                boxMax = glm::max(boxMax, glm::vec2(pp));
+            }
+        }
+        if (mouse.x < boxMin.x || mouse.x > boxMax.x || mouse.y < boxMin.y || mouse.y > boxMax.y)
+            continue;
+
+        // CEngine::DetectTriangle()
+        for (size_t first = 0; first < scene.mesh.size(); first += 3)
+        {
+            const Vertex3D* triangle = &scene.mesh[first];
+
+            glm::vec3 p2D[3];
+            bool visible = true;
+            for (int i = 0; i < 3 && visible; i++)
+                visible = ProjectPoint(view, projection, transform, triangle[i].position, p2D[i]);
+            if (! visible)
+                continue;
+
+            glm::vec2 screenMin = glm::min(glm::min(glm::vec2(p2D[0]), glm::vec2(p2D[1])), glm::vec2(p2D[2]));
+            glm::vec2 screenMax = glm::max(glm::max(glm::vec2(p2D[0]), glm::vec2(p2D[1])), glm::vec2(p2D[2]));
+            if (mouse.x < screenMin.x || mouse.x > screenMax.x || mouse.y < screenMin.y || mouse.y > screenMax.y)
+                continue;
+
+            if (! Math::IsInsideTriangle(glm::vec2(p2D[0]), glm::vec2(p2D[1]), glm::vec2(p2D[2]), mouse))
+                continue;
+
+            float dist = (p2D[0].z + p2D[1].z + p2D[2].z) / 3.0f;
+            if (dist >= min)
+                continue;
+
+            glm::vec3 a = Math::Transform(transform, triangle[0].position);
+            glm::vec3 b = Math::Transform(transform, triangle[1].position);
+            glm::vec3 c = Math::Transform(transform, triangle[2].position);
+            glm::vec3 e = Math::Transform(viewInverse, glm::vec3(0.0f, 0.0f, -1.0f));
+            glm::vec3 f = Math::Transform(viewInverse, glm::vec3(
+                (mouse.x*2.0f-1.0f) * projectionInverse[0][0],
+                (mouse.y*2.0f-1.0f) * projectionInverse[1][1],
+                0.0f));
+
+            min = dist;
+            result.object = objRank;
+            Math::Intersect(a, b, c, e, f, result.position);
+        }
+    }
+
+    return result;
+}
+
+// Mouse positions spread over the screen
+std::vector<glm::vec2> MakePickingMice()
+{
+    unsigned int seed = 3;
+    auto random = [&seed]()
+    {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<float>((seed >> 16) & 0x7fff) / 32768.0f;
+    };
+
+    std::vector<glm::vec2> mice;
+    for (int i = 0; i < 100; ++i)
+        mice.emplace_back(0.05f + 0.9f * random(), 0.05f + 0.9f * random());
+    return mice;
+}
+
+void PickObjects(Bench::CState& state, int count, bool trees)
+{
+    auto scene = MakePickingScene(count);
+    const auto mice = MakePickingMice();
+
+    int step = 0;
+    int hits = 0;
+    int mismatches = 0;
+
+    // Same object and position as before the trees, with objects moving between picks
+    for (const auto& mouse : mice)
+    {
+        MovePickingScene(scene, step++);
+
+        glm::vec3 position;
+        int object = scene.engine->DetectObject(mouse, position);
+        PickResult all = PickAll(scene, mouse);
+        if (object != all.object || (object != -1 && glm::distance(position, all.position) > 0.001f))
+            mismatches++;
+    }
+
+    while (state.KeepRunning())
+    {
+        hits = 0;
+        for (const auto& mouse : mice)
+        {
+            MovePickingScene(scene, step++);
+
+            int object = -1;
+            if (trees)
+            {
+                glm::vec3 position;
+                object = scene.engine->DetectObject(mouse, position);
+            }
+            else
+            {
+                object = PickAll(scene, mouse).object;
+            }
+            if (object != -1) hits++;
+        }
+    }
+
+    state.SetItemsPerIteration(static_cast<long long>(mice.size()));
+    state.SetCounter("hits", static_cast<double>(hits));
+    state.SetCounter("mismatches", static_cast<double>(mismatches));
+    if (mismatches > 0)
+        state.SetError("CEngine::DetectObject() differs from picking all triangles");
+}
+
+// Buildings of 4608 triangles, 16 units apart, seen from a corner of the base in 1080p
+struct LODScene
+{
+    std::vector<glm::vec3> positions;
+    std::vector<CVertexBuffer*> buffers;
+    std::vector<float> errors;
+};
+
+LODScene MakeLODScene(CRecordingDevice& device, int count)
+{
+    const int segments = 48;
+    auto vertex = [](int u, int v)
+    {
+        float theta = 3.14159265f * v / segments;
+        float phi = 2.0f * 3.14159265f * u / segments;
+        Vertex3D result;
+        result.normal = glm::vec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+        result.position = 4.0f * result.normal + glm::vec3(0.0f, 4.0f, 0.0f);
+        return result;
+    };
+
+    std::vector<Vertex3D> mesh;
+    for (int u = 0; u < segments; ++u)
+    {
+        for (int v = 0; v < segments; ++v)
+        {
+            mesh.insert(mesh.end(), { vertex(u, v), vertex(u + 1, v), vertex(u, v + 1) });
+            mesh.insert(mesh.end(), { vertex(u + 1, v), vertex(u + 1, v + 1), vertex(u, v + 1) });
+        }
+    }
+
+    LODScene scene;
+    scene.buffers.push_back(device.CreateVertexBuffer(PrimitiveType::TRIANGLES, mesh.data(), static_cast<int>(mesh.size())));
+    for (const auto& level : BuildMeshLODLevels({ &mesh }, 4))
+    {
+        const auto& vertices = level.lists[0];
+        scene.buffers.push_back(vertices.empty() ? nullptr :
+            device.CreateVertexBuffer(PrimitiveType::TRIANGLES, vertices.data(), static_cast<int>(vertices.size())));
+        scene.errors.push_back(level.error);
+    }
+
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+    for (int i = 0; i < count; ++i)
+        scene.positions.emplace_back(16.0f * (i % side), 0.0f, 16.0f * (i / side));
+
+    return scene;
+}
+
+// Draws every building like CEngine, at the level of detail selected from its distance
+long long DrawLODScene(CRecordingDevice& device, const LODScene& scene, std::vector<int>& levels, bool lod)
+{
+    const glm::vec3 eye(-10.0f, 20.0f, -10.0f);
+    const float pixelsPerDistance = 2.414f * 1080.0f * 0.5f;
+
+    CProfiler::ResetPerformanceStats();
+
+    auto renderer = device.GetObjectRenderer();
+    renderer->Begin();
+    for (size_t i = 0; i < scene.positions.size(); ++i)
+    {
+        float nearest = glm::length(scene.positions[i] - eye) - 8.0f;
+        if (lod && nearest > 0.0f)
+            levels[i] = SelectMeshLODLevel(scene.errors, pixelsPerDistance / nearest, 2.0f, levels[i]);
+
+        if (scene.buffers[levels[i]] != nullptr)
+            renderer->DrawObject(scene.buffers[levels[i]]);
+    }
+    renderer->End();
+
+    return CProfiler::GetCurrentPerformanceStat(PSTAT_TRIANGLES);
+}
+
+// Buildings that stay in place and vehicles that drive around, in every shadow region
+struct ShadowScene
+{
+    CVertexBuffer* buffer = nullptr;
+    std::vector<glm::mat4> transforms;
+    std::vector<bool> moving;
+};
+
+ShadowScene MakeShadowScene(CRecordingDevice& device, int count, int movingCount)
+{
+    ShadowScene scene;
+
+    std::vector<Vertex3D> box(36);
+    scene.buffer = device.CreateVertexBuffer(PrimitiveType::TRIANGLES, box.data(), static_cast<int>(box.size()));
+
+    for (int i = 0; i < count; ++i)
+    {
+        glm::mat4 transform(1.0f);
+        transform[3] = glm::vec4(16.0f * (i % 32), 0.0f, 16.0f * (i / 32), 1.0f);
+        scene.transforms.push_back(transform);
+        scene.moving.push_back(i < movingCount);
+    }
+
+    return scene;
+}
+
+// Draws the shadow map of the scene like CEngine, either every object in every region
+// or only what changed since the previous frame
+long long DrawShadowScene(CRecordingDevice& device, ShadowScene& scene,
+                          CShadowRegionCache* caches, bool cached, int frame)
+{
+    const int regions = 4;
+
+    for (size_t i = 0; i < scene.transforms.size(); ++i)
+    {
+        if (scene.moving[i])
+            scene.transforms[i][3].x += 0.1f * ((frame % 2) * 2 - 1);
+    }
+
+    CProfiler::ResetPerformanceStats();
+
+    auto renderer = device.GetShadowRenderer();
+    renderer->Begin();
+    for (int region = 0; region < regions; ++region)
+    {
+        glm::mat4 matrix(1.0f);
+        matrix[0][0] = 1.0f / (16 << (2 * region));
+
+        auto update = CShadowRegionCache::Update::ALL;
+        if (cached)
+        {
+            caches[region].Begin(matrix);
+            for (size_t i = 0; i < scene.transforms.size(); ++i)
+                caches[region].AddCaster(!scene.moving[i], static_cast<int>(i), 0, scene.transforms[i]);
+            update = caches[region].End();
+        }
+
+        if (update == CShadowRegionCache::Update::NOTHING)
+            continue;
+
+        for (size_t i = 0; i < scene.transforms.size(); ++i)
+        {
+            if (!cached || scene.moving[i] || update == CShadowRegionCache::Update::ALL)
+            {
+                renderer->SetModelMatrix(scene.transforms[i]);
+                renderer->SetTexture(Texture{ 1 });
+                renderer->DrawObject(scene.buffer, true);
+            }
+        }
+    }
+    renderer->End();
+
+    return CProfiler::GetCurrentPerformanceStat(PSTAT_DRAW_CALLS);
+}
+
+} // anonymous namespace
+
+BENCHMARK(EngineDrawQueueTextureBinds)
+{
+    CRecordingDevice device;
+    device.Create();
+    auto renderer = device.GetObjectRenderer();
+
+    const auto scene = MakeScene();
+
+    CProfiler::ResetPerformanceStats();
+    Submit(renderer, scene);
+    long long unsortedBinds = CProfiler::GetCurrentPerformanceStat(PSTAT_TEXTURE_BINDS);
+
+    std::vector<EngineDrawItem> queue;
+    queue.reserve(scene.size());
+
+    while (state.KeepRunning())
+    {
+        queue = scene;
+        SortDrawQueue(queue);
+        CProfiler::ResetPerformanceStats();
+        Submit(renderer, queue);
+    }
+
+    state.SetItemsPerIteration(static_cast<long long>(scene.size()));
+    state.SetCounter("binds_unsorted", static_cast<double>(unsortedBinds));
+    state.SetCounter("binds_sorted", static_cast<double>(CProfiler::GetCurrentPerformanceStat(PSTAT_TEXTURE_BINDS)));
+}
+
+BENCHMARK(EngineWheelTraces1k)
+{
+    DrawWheelTraces(state, 1000);
+}
+
+BENCHMARK(EngineWheelTraces10k)
+{
+    DrawWheelTraces(state, 10000);
+}
+
+BENCHMARK(EngineWheelTraces100k)
+{
+    DrawWheelTraces(state, 100000);
+}
+
+BENCHMARK(EngineTextUploads)
+{
+    CRecordingDevice device;
+    device.Create();
+    auto renderer = device.GetUIRenderer();
+    CQuadBatch batch(renderer);
+
+    const auto text = MakeProgramText();
+
+    CProfiler::ResetPerformanceStats();
+    DrawTextRuns(renderer, text);
+    long long runUploads = CProfiler::GetCurrentPerformanceStat(PSTAT_BUFFER_UPLOADS);
+    long long runDrawCalls = CProfiler::GetCurrentPerformanceStat(PSTAT_DRAW_CALLS);
+
+    while (state.KeepRunning())
+    {
+        CProfiler::ResetPerformanceStats();
+        for (const auto& glyph : text)
+            batch.Add(glyph.vertices, Texture{ 1 }, TransparencyMode::ALPHA);
+        batch.Flush();
+    }
+
+    state.SetItemsPerIteration(static_cast<long long>(text.size()));
+    state.SetCounter("uploads_runs", static_cast<double>(runUploads));
+    state.SetCounter("draw_calls_runs", static_cast<double>(runDrawCalls));
+    state.SetCounter("uploads_batched", static_cast<double>(CProfiler::GetCurrentPerformanceStat(PSTAT_BUFFER_UPLOADS)));
+    state.SetCounter("draw_calls_batched", static_cast<double>(CProfiler::GetCurrentPerformanceStat(PSTAT_DRAW_CALLS)));
+    state.SetCounter("upload_kib", static_cast<double>(CProfiler::GetCurrentPerformanceStat(PSTAT_BUFFER_UPLOAD_BYTES)) / 1024.0);
+}
+
+BENCHMARK(EnginePickingAllObjects1k)
+{
+    PickObjects(state, 1000, false);
+}
+
+BENCHMARK(EnginePickingTrees1k)
+{
+    PickObjects(state, 1000, true);
+}
+
+BENCHMARK(EnginePickingTrees10k)
+{
+    PickObjects(state, 10000, true);
+}
+
+BENCHMARK(EngineObjectLOD1k)
+{
+    CRecordingDevice device;
+    device.Create();
+
+    const auto scene = MakeLODScene(device, 1000);
+    std::vector<int> levels(scene.positions.size(), 0);
+
+    long long fullTriangles = DrawLODScene(device, scene, levels, false);
+    long long triangles = 0;
+
+    while (state.KeepRunning())
+        triangles = DrawLODScene(device, scene, levels, true);
+
+    state.SetItemsPerIteration(static_cast<long long>(scene.positions.size()));
+    state.SetCounter("levels", static_cast<double>(scene.errors.size()));
+    state.SetCounter("triangles_full", static_cast<double>(fullTriangles));
+    state.SetCounter("triangles_lod", static_cast<double>(triangles));
+
+    for (auto buffer : scene.buffers)
+        device.DestroyVertexBuffer(buffer);
+}
+
+BENCHMARK(EngineShadowCache1k)
+{
+    CRecordingDevice device;
+    device.Create();
+
+    auto scene = MakeShadowScene(device, 1000, 10);
+    CShadowRegionCache caches[4];
+
+    int frame = 0;
+    long long fullDrawCalls = DrawShadowScene(device, scene, caches, false, frame++);
+    DrawShadowScene(device, scene, caches, true, frame++);
+
+    long long drawCalls = 0;
+    while (state.KeepRunning())
+        drawCalls = DrawShadowScene(device, scene, caches, true, frame++);
+
+    std::fill(scene.moving.begin(), scene.moving.end(), false);
+    DrawShadowScene(device, scene, caches, true, frame++);
+    long long stillDrawCalls = DrawShadowScene(device, scene, caches, true, frame++);
+
+    state.SetItemsPerIteration(static_cast<long long>(scene.transforms.size()));
+    state.SetCounter("draw_calls_full", static_cast<double>(fullDrawCalls));
+    state.SetCounter("draw_calls_cached", static_cast<double>(drawCalls));
+    state.SetCounter("draw_calls_still", static_cast<double>(stillDrawCalls));
+
+    device.DestroyVertexBuffer(scene.buffer);
+}
@@ -0,0 +1,176 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/mesh_lod.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace Gfx;
+
+namespace
+{
+
+//! Point of a sphere of radius 4 at the given UV coordinates
+glm::vec3 SpherePoint(int segments, const glm::vec2& uv)
+{
+    float theta = 3.14159265f * uv.y / segments;
+    float phi = 2.0f * 3.14159265f * uv.x / segments;
+    return 4.0f * glm::vec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+}
+
+//! Sphere of radius 4, every vertex keeps the UV coordinates of its original position
+std::vector<Vertex3D> MakeSphere(int segments)
+{
+    auto vertex = [&](int u, int v)
+    {
+        Vertex3D result;
+        result.uv = glm::vec2(u, v);
+        result.position = SpherePoint(segments, result.uv);
+        result.normal = result.position / 4.0f;
+        return result;
+    };
+
+    std::vector<Vertex3D> vertices;
+    for (int u = 0; u < segments; ++u)
+    {
+        for (int v = 0; v < segments; ++v)
+        {
+            vertices.insert(vertices.end(), { vertex(u, v), vertex(u + 1, v), vertex(u, v + 1) });
+            vertices.insert(vertices.end(), { vertex(u + 1, v), vertex(u + 1, v + 1), vertex(u, v + 1) });
+        }
+    }
+    return vertices;
+}
+
+} // anonymous namespace
+
+TEST(MeshLODTest, LevelsHaveFewerTrianglesAndLargerErrors)
+{
+    auto sphere = MakeSphere(48);
+
+    auto levels = BuildMeshLODLevels({ &sphere }, 4);
+    ASSERT_FALSE(levels.empty());
+
+    int triangles = static_cast<int>(sphere.size() / 3);
+    float error = 0.0f;
+    for (const auto& level : levels)
+    {
+        ASSERT_EQ(level.lists.size(), 1u);
+        EXPECT_EQ(level.triangles, static_cast<int>(level.lists[0].size() / 3));
+        EXPECT_LE(level.triangles * 4, triangles * 3);
+        EXPECT_GT(level.error, error);
+
+        triangles = level.triangles;
+        error = level.error;
+    }
+}
+
+TEST(MeshLODTest, VerticesMoveLessThanError)
+{
+    auto sphere = MakeSphere(48);
+
+    for (const auto& level : BuildMeshLODLevels({ &sphere }, 4))
+    {
+        for (const auto& vertex : level.lists[0])
+            EXPECT_LE(glm::length(vertex.position - SpherePoint(48, vertex.uv)), level.error * 1.0001f);
+    }
+}
+
+TEST(MeshLODTest, ListsStayJoined)
+{
+    // Both halves of the sphere share the vertices of the equator
+    auto sphere = MakeSphere(32);
+    std::vector<Vertex3D> top, bottom;
+    for (size_t i = 0; i < sphere.size(); i += 3)
+    {
+        auto& half = sphere[i].uv.y < 16.0f ? top : bottom;
+        half.insert(half.end(), sphere.begin() + i, sphere.begin() + i + 3);
+    }
+
+    for (const auto& level : BuildMeshLODLevels({ &top, &bottom }, 4))
+    {
+        ASSERT_EQ(level.lists.size(), 2u);
+        for (const auto& a : level.lists[0])
+        {
+            for (const auto& b : level.lists[1])
+            {
+                if (a.uv == b.uv)
+                    EXPECT_EQ(a.position, b.position);
+            }
+        }
+    }
+}
+
+TEST(MeshLODTest, ErrorCoversRemovedTriangles)
+{
+    // One large triangle whose vertices don't move, and small triangles on a circle of radius 0.2
+    // in a single cell of the first level, which all collapse to its center
+    std::vector<Vertex3D> mesh(3);
+    mesh[1].position = glm::vec3(64.0f, 0.0f, 0.0f);
+    mesh[2].position = glm::vec3(0.0f, 64.0f, 0.0f);
+
+    for (int i = 0; i < 12; ++i)
+    {
+        float angle = 2.0f * 3.14159265f * i / 12;
+        glm::vec3 position = glm::vec3(20.5f, 20.5f, 0.0f) + 0.2f * glm::vec3(std::cos(angle), std::sin(angle), 0.0f);
+        mesh.resize(mesh.size() + 3);
+        mesh[mesh.size() - 3].position = position;
+        mesh[mesh.size() - 2].position = position + glm::vec3(0.01f, 0.0f, 0.0f);
+        mesh[mesh.size() - 1].position = position + glm::vec3(0.0f, 0.01f, 0.0f);
+    }
+
+    auto levels = BuildMeshLODLevels({ &mesh }, 1);
+    ASSERT_EQ(levels.size(), 1u);
+    EXPECT_EQ(levels[0].triangles, 1);
+    EXPECT_GT(levels[0].error, 0.18f);
+    EXPECT_LT(levels[0].error, 0.22f);
+}
+
+TEST(MeshLODTest, SmallMeshIsNotSimplified)
+{
+    std::vector<Vertex3D> triangle(3);
+    triangle[1].position = glm::vec3(1.0f, 0.0f, 0.0f);
+    triangle[2].position = glm::vec3(0.0f, 1.0f, 0.0f);
+
+    EXPECT_TRUE(BuildMeshLODLevels({ &triangle }, 4).empty());
+    EXPECT_TRUE(BuildMeshLODLevels({}, 4).empty());
+}
+
+TEST(MeshLODTest, SelectsCoarsestLevelWithinError)
+{
+    std::vector<float> errors = { 0.1f, 0.2f, 0.4f };
+
+    EXPECT_EQ(SelectMeshLODLevel(errors, 100.0f, 1.0f, 0), 0);
+    EXPECT_EQ(SelectMeshLODLevel(errors, 3.0f, 1.0f, 0), 2);
+    EXPECT_EQ(SelectMeshLODLevel(errors, 1.0f, 1.0f, 0), 3);
+    EXPECT_EQ(SelectMeshLODLevel({}, 1.0f, 1.0f, 0), 0);
+}
+
+TEST(MeshLODTest, SwitchesToCoarserLevelWithMargin)
+{
+    std::vector<float> errors = { 0.1f };
+
+    // Error of 0.9 pixels: kept if already drawn, not chosen otherwise
+    EXPECT_EQ(SelectMeshLODLevel(errors, 9.0f, 1.0f, 1), 1);
+    EXPECT_EQ(SelectMeshLODLevel(errors, 9.0f, 1.0f, 0), 0);
+    EXPECT_EQ(SelectMeshLODLevel(errors, 7.0f, 1.0f, 0), 1);
+}
@@ -0,0 +1,200 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/particle_batch.h"
+
+#include "graphics/core/recording_device.h"
+#include "graphics/core/renderers.h"
+
+#include "common/profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace Gfx;
+
+namespace
+{
+
+constexpr int PARTICLE_COUNT = 2000;
+constexpr int LOOK_COUNT = 3;
+
+Texture MakeTexture(unsigned int id)
+{
+    Texture texture;
+    texture.id = id;
+    return texture;
+}
+
+TransparencyMode GetMode(int look)
+{
+    const TransparencyMode modes[LOOK_COUNT] = { TransparencyMode::NONE, TransparencyMode::ALPHA, TransparencyMode::BLACK };
+    return modes[look];
+}
+
+glm::mat4 GetMatrix(int particle)
+{
+    glm::mat4 matrix(1.0f);
+    matrix[3] = glm::vec4(static_cast<float>(particle), 0.0f, 1.0f, 1.0f);
+    return matrix;
+}
+
+Color GetColor(int particle)
+{
+    float intensity = static_cast<float>(particle % 10) / 10.0f;
+    return Color(intensity, intensity, intensity, intensity);
+}
+
+std::vector<VertexParticle> MakeQuad()
+{
+    std::vector<VertexParticle> quad(4);
+    quad[0].position = { -1.0f, -1.0f, 0.0f };
+    quad[1].position = { -1.0f,  1.0f, 0.0f };
+    quad[2].position = {  1.0f, -1.0f, 0.0f };
+    quad[3].position = {  1.0f,  1.0f, 0.0f };
+    return quad;
+}
+
+//! Particle renderer remembering the vertices of the last draw call
+class CCapturingParticleRenderer : public CParticleRenderer
+{
+public:
+    void Begin() override {}
+    void End() override {}
+    void SetProjectionMatrix(const glm::mat4&) override {}
+    void SetViewMatrix(const glm::mat4&) override {}
+    void SetModelMatrix(const glm::mat4&) override {}
+    void SetColor(const glm::vec4&) override {}
+    void SetTexture(const Texture&) override {}
+    void SetTransparency(TransparencyMode) override {}
+
+    void DrawParticle(PrimitiveType type, int count, const VertexParticle* vertices) override
+    {
+        this->type = type;
+        this->vertices.assign(vertices, vertices + count);
+        ++draws;
+    }
+
+    PrimitiveType type = PrimitiveType::POINTS;
+    std::vector<VertexParticle> vertices;
+    int draws = 0;
+};
+
+} // anonymous namespace
+
+TEST(ParticleBatchTest, StripBecomesTransformedTintedTriangles)
+{
+    CCapturingParticleRenderer renderer;
+    CParticleBatch batch(&renderer);
+
+    auto quad = MakeQuad();
+    glm::mat4 matrix(1.0f);
+    matrix[3] = glm::vec4(10.0f, 0.0f, 0.0f, 1.0f);
+
+    batch.Begin(true);
+    batch.SetLook(MakeTexture(1), TransparencyMode::ALPHA);
+    batch.Add(PrimitiveType::TRIANGLE_STRIP, 4, quad.data(), matrix, Color(0.5f, 0.5f, 0.5f, 1.0f));
+    EXPECT_EQ(batch.GetVertexCount(), 6);
+    EXPECT_EQ(renderer.draws, 0);
+    batch.End();
+
+    ASSERT_EQ(renderer.draws, 1);
+    EXPECT_EQ(renderer.type, PrimitiveType::TRIANGLES);
+    ASSERT_EQ(renderer.vertices.size(), 6u);
+
+    // Both triangles keep the winding of the strip
+    const int order[6] = { 0, 1, 2, 2, 1, 3 };
+    for (int i = 0; i < 6; ++i)
+    {
+        EXPECT_EQ(renderer.vertices[i].position, quad[order[i]].position + glm::vec3(10.0f, 0.0f, 0.0f));
+        EXPECT_EQ(renderer.vertices[i].color, glm::u8vec4(128, 128, 128, 255));
+    }
+}
+
+TEST(ParticleBatchTest, PerParticleDrawCallsDependOnParticles)
+{
+    CRecordingDevice device;
+    ASSERT_TRUE(device.Create());
+    auto renderer = device.GetParticleRenderer();
+    auto quad = MakeQuad();
+
+    CProfiler::ResetPerformanceStats();
+    renderer->Begin();
+    for (int look = 0; look < LOOK_COUNT; ++look)
+    {
+        renderer->SetTexture(MakeTexture(1 + look));
+        for (int i = 0; i < PARTICLE_COUNT; ++i)
+        {
+            renderer->SetTransparency(GetMode(look));
+            renderer->SetColor(GetColor(i));
+            renderer->SetModelMatrix(GetMatrix(i));
+            renderer->DrawParticle(PrimitiveType::TRIANGLE_STRIP, 4, quad.data());
+        }
+    }
+    renderer->End();
+
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_DRAW_CALLS), LOOK_COUNT * PARTICLE_COUNT);
+    EXPECT_GT(CProfiler::GetCurrentPerformanceStat(PSTAT_STATE_CHANGES), LOOK_COUNT * PARTICLE_COUNT);
+}
+
+TEST(ParticleBatchTest, BatchedDrawCallsDependOnLooks)
+{
+    CRecordingDevice device;
+    ASSERT_TRUE(device.Create());
+    auto renderer = device.GetParticleRenderer();
+    auto quad = MakeQuad();
+
+    CParticleBatch batch(renderer);
+    CProfiler::ResetPerformanceStats();
+    renderer->Begin();
+    batch.Begin(true);
+    for (int look = 0; look < LOOK_COUNT; ++look)
+    {
+        for (int i = 0; i < PARTICLE_COUNT; ++i)
+        {
+            batch.SetLook(MakeTexture(1 + look), GetMode(look));
+            batch.Add(PrimitiveType::TRIANGLE_STRIP, 4, quad.data(), GetMatrix(i), GetColor(i));
+        }
+    }
+    batch.End();
+    renderer->End();
+
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_DRAW_CALLS), LOOK_COUNT);
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_TEXTURE_BINDS), LOOK_COUNT);
+    // One model matrix per draw call and one change of transparency per look after the first
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_STATE_CHANGES), LOOK_COUNT + LOOK_COUNT - 1);
+}
+
+TEST(ParticleBatchTest, FullBatchIsDrawn)
+{
+    CCapturingParticleRenderer renderer;
+    CParticleBatch batch(&renderer);
+    auto quad = MakeQuad();
+
+    batch.Begin(false);
+    batch.SetLook(MakeTexture(1), TransparencyMode::NONE);
+    for (int i = 0; i < CParticleBatch::MAX_VERTICES / 6 + 1; ++i)
+        batch.Add(PrimitiveType::TRIANGLE_STRIP, 4, quad.data(), Color(1.0f, 1.0f, 1.0f, 1.0f));
+
+    EXPECT_EQ(renderer.draws, 1);
+    EXPECT_EQ(batch.GetVertexCount(), 6);
+    batch.End();
+    EXPECT_EQ(renderer.draws, 2);
+}
@@ -0,0 +1,161 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/picking_tree.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Gfx;
+
+namespace
+{
+
+float Random(unsigned int& seed)
+{
+    seed = seed * 1103515245u + 12345u;
+    return static_cast<float>((seed >> 16) & 0x7fff) / 32768.0f;
+}
+
+std::vector<PickingBox> MakeBoxes(int count)
+{
+    unsigned int seed = 1;
+    std::vector<PickingBox> boxes;
+    for (int i = 0; i < count; ++i)
+    {
+        glm::vec3 center(Random(seed) * 200.0f - 100.0f, Random(seed) * 20.0f, Random(seed) * 200.0f - 100.0f);
+        glm::vec3 size(Random(seed) * 4.0f, Random(seed) * 4.0f, Random(seed) * 4.0f);
+        boxes.push_back({ center - size, center + size });
+    }
+    return boxes;
+}
+
+// Whether the ray starting at origin crosses the box, testing points along the ray
+bool CrossesSampled(const PickingBox& box, const glm::vec3& origin, const glm::vec3& direction)
+{
+    for (int i = 0; i <= 4000; ++i)
+    {
+        glm::vec3 p = origin + direction * (static_cast<float>(i) * 0.1f);
+        if (p.x >= box.min.x && p.y >= box.min.y && p.z >= box.min.z &&
+            p.x <= box.max.x && p.y <= box.max.y && p.z <= box.max.z)
+            return true;
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+TEST(PickingTreeTest, EmptyTreeFindsNothing)
+{
+    CPickingTree tree;
+    tree.Build({});
+    EXPECT_TRUE(tree.IsEmpty());
+
+    std::vector<int> items;
+    tree.FindCrossed({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, items);
+    EXPECT_TRUE(items.empty());
+}
+
+TEST(PickingTreeTest, FindsEveryCrossedBox)
+{
+    const auto boxes = MakeBoxes(1000);
+    CPickingTree tree;
+    tree.Build(boxes);
+    ASSERT_FALSE(tree.IsEmpty());
+
+    unsigned int seed = 7;
+    for (int ray = 0; ray < 10; ++ray)
+    {
+        glm::vec3 origin(Random(seed) * 200.0f - 100.0f, 60.0f, Random(seed) * 200.0f - 100.0f);
+        glm::vec3 direction(Random(seed) - 0.5f, -1.0f, Random(seed) - 0.5f);
+
+        std::vector<int> items;
+        tree.FindCrossed(origin, direction, items);
+        std::sort(items.begin(), items.end());
+
+        for (int i = 0; i < static_cast<int>(boxes.size()); ++i)
+        {
+            if (CrossesSampled(boxes[i], origin, direction))
+                EXPECT_TRUE(std::binary_search(items.begin(), items.end(), i)) << "ray " << ray << " box " << i;
+        }
+
+        // Only boxes along the ray are returned
+        EXPECT_LT(items.size(), boxes.size() / 10);
+    }
+}
+
+TEST(PickingTreeTest, AxisAlignedRay)
+{
+    std::vector<PickingBox> boxes = {
+        { { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } },
+        { { 2.0f, 0.0f, 0.0f }, { 3.0f, 1.0f, 1.0f } },
+        { { 0.0f, 0.0f, 5.0f }, { 1.0f, 1.0f, 6.0f } },
+    };
+    CPickingTree tree;
+    tree.Build(boxes);
+
+    std::vector<int> items;
+    tree.FindCrossed({ 0.5f, 0.5f, -10.0f }, { 0.0f, 0.0f, 1.0f }, items);
+    std::sort(items.begin(), items.end());
+    EXPECT_EQ(items, std::vector<int>({ 0, 2 }));
+
+    // Boxes behind the start of the ray are not crossed
+    items.clear();
+    tree.FindCrossed({ 0.5f, 0.5f, 3.0f }, { 0.0f, 0.0f, 1.0f }, items);
+    EXPECT_EQ(items, std::vector<int>({ 2 }));
+}
+
+TEST(PickingTreeTest, FindsMovedBoxes)
+{
+    auto boxes = MakeBoxes(500);
+    CPickingTree tree;
+    tree.Build(boxes);
+
+    // Enough moves for the tree to be refitted many times and rebuilt
+    unsigned int seed = 3;
+    for (int move = 0; move < 1200; ++move)
+    {
+        int item = static_cast<int>(Random(seed) * boxes.size());
+        glm::vec3 offset(Random(seed) * 60.0f - 30.0f, 0.0f, Random(seed) * 60.0f - 30.0f);
+        boxes[item].min += offset;
+        boxes[item].max += offset;
+        tree.Update(item, boxes[item]);
+
+        if (move % 100 != 0) continue;
+
+        glm::vec3 origin(Random(seed) * 200.0f - 100.0f, 60.0f, Random(seed) * 200.0f - 100.0f);
+        glm::vec3 direction(Random(seed) - 0.5f, -1.0f, Random(seed) - 0.5f);
+
+        std::vector<int> items;
+        tree.FindCrossed(origin, direction, items);
+        std::sort(items.begin(), items.end());
+
+        for (int i = 0; i < static_cast<int>(boxes.size()); ++i)
+        {
+            bool crossed = CrossesSampled(boxes[i], origin, direction);
+            if (crossed)
+                EXPECT_TRUE(std::binary_search(items.begin(), items.end(), i)) << "move " << move << " box " << i;
+        }
+
+        // Only boxes along the ray are returned, branches shrink when boxes leave them
+        EXPECT_LT(items.size(), boxes.size() / 10);
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/quad_batch.h"
+
+#include "graphics/core/recording_device.h"
+#include "graphics/core/renderers.h"
+
+#include "common/profiler.h"
+
+#include <gtest/gtest.h>
+
+using namespace Gfx;
+
+namespace
+{
+
+void MakeQuad(Vertex2D vertices[4], float x, glm::u8vec4 color)
+{
+    vertices[0] = { { x, 0.0f }, { 0.0f, 1.0f }, color };
+    vertices[1] = { { x, 1.0f }, { 0.0f, 0.0f }, color };
+    vertices[2] = { { x + 1.0f, 0.0f }, { 1.0f, 1.0f }, color };
+    vertices[3] = { { x + 1.0f, 1.0f }, { 1.0f, 0.0f }, color };
+}
+
+} // anonymous namespace
+
+TEST(QuadBatchTest, DifferentColorsShareOneDraw)
+{
+    CRecordingDevice device;
+    ASSERT_TRUE(device.Create());
+    CQuadBatch batch(device.GetUIRenderer());
+
+    Vertex2D quad[4];
+    CProfiler::ResetPerformanceStats();
+    for (int i = 0; i < 100; ++i)
+    {
+        MakeQuad(quad, static_cast<float>(i), { static_cast<unsigned char>(i), 0, 0, 255 });
+        batch.Add(quad, Texture{ 1 }, TransparencyMode::ALPHA);
+    }
+    EXPECT_EQ(batch.GetQuadCount(), 100);
+    EXPECT_EQ(batch.Flush(), 200);
+    EXPECT_EQ(batch.GetQuadCount(), 0);
+
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_DRAW_CALLS), 1);
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_BUFFER_UPLOADS), 1);
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_BUFFER_UPLOAD_BYTES), 400 * static_cast<long long>(sizeof(Vertex2D)));
+}
+
+TEST(QuadBatchTest, TextureChangeDrawsBatch)
+{
+    CRecordingDevice device;
+    ASSERT_TRUE(device.Create());
+    CQuadBatch batch(device.GetUIRenderer());
+
+    Vertex2D quad[4];
+    MakeQuad(quad, 0.0f, { 255, 255, 255, 255 });
+
+    CProfiler::ResetPerformanceStats();
+    batch.Add(quad, Texture{ 1 }, TransparencyMode::ALPHA);
+    batch.Add(quad, Texture{ 1 }, TransparencyMode::ALPHA);
+    batch.Add(quad, Texture{ 2 }, TransparencyMode::ALPHA);
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_DRAW_CALLS), 1);
+    batch.Add(quad, Texture{ 2 }, TransparencyMode::NONE);
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_DRAW_CALLS), 2);
+    batch.Flush();
+
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_DRAW_CALLS), 3);
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_TEXTURE_BINDS), 2);
+}
+
+TEST(QuadBatchTest, UniformsAreSentOnlyAfterChange)
+{
+    CRecordingDevice device;
+    ASSERT_TRUE(device.Create());
+    auto renderer = device.GetUIRenderer();
+
+    CProfiler::ResetPerformanceStats();
+    for (int i = 0; i < 10; ++i)
+    {
+        renderer->SetColor({ 1.0f, 1.0f, 1.0f, 1.0f });
+        renderer->BeginPrimitive(PrimitiveType::TRIANGLE_STRIP, 4);
+        renderer->EndPrimitive();
+    }
+    // Vertices of every draw, no uniforms
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_BUFFER_UPLOADS), 10);
+
+    renderer->SetProjection(0.0f, 2.0f, 0.0f, 2.0f);
+    renderer->BeginPrimitive(PrimitiveType::TRIANGLE_STRIP, 4);
+    renderer->EndPrimitive();
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_BUFFER_UPLOADS), 12);
+}
@@ -0,0 +1,116 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/shadow_cache.h"
+
+#include <gtest/gtest.h>
+
+using namespace Gfx;
+
+using Update = CShadowRegionCache::Update;
+
+namespace
+{
+
+glm::mat4 Translation(float x)
+{
+    glm::mat4 result(1.0f);
+    result[3][0] = x;
+    return result;
+}
+
+//! Draws one frame with two static casters and one moving caster at the given position
+Update Frame(CShadowRegionCache& cache, const glm::mat4& matrix, float moving)
+{
+    cache.Begin(matrix);
+    cache.AddCaster(true, 0, 10, Translation(1.0f));
+    cache.AddCaster(true, 1, 10, Translation(2.0f));
+    cache.AddCaster(false, 2, 20, Translation(moving));
+    return cache.End();
+}
+
+} // anonymous namespace
+
+TEST(ShadowRegionCacheTest, FirstFrameDrawsAll)
+{
+    CShadowRegionCache cache;
+    EXPECT_EQ(Frame(cache, glm::mat4(1.0f), 0.0f), Update::ALL);
+}
+
+TEST(ShadowRegionCacheTest, SameFrameDrawsNothing)
+{
+    CShadowRegionCache cache;
+    Frame(cache, glm::mat4(1.0f), 0.0f);
+    EXPECT_EQ(Frame(cache, glm::mat4(1.0f), 0.0f), Update::NOTHING);
+    EXPECT_EQ(Frame(cache, glm::mat4(1.0f), 0.0f), Update::NOTHING);
+}
+
+TEST(ShadowRegionCacheTest, MovingCasterDrawsMoving)
+{
+    CShadowRegionCache cache;
+    Frame(cache, glm::mat4(1.0f), 0.0f);
+    EXPECT_EQ(Frame(cache, glm::mat4(1.0f), 0.5f), Update::MOVING);
+    EXPECT_EQ(Frame(cache, glm::mat4(1.0f), 0.5f), Update::NOTHING);
+}
+
+TEST(ShadowRegionCacheTest, StaticCasterChangeDrawsAll)
+{
+    CShadowRegionCache cache;
+    Frame(cache, glm::mat4(1.0f), 0.0f);
+
+    cache.Begin(glm::mat4(1.0f));
+    cache.AddCaster(true, 0, 10, Translation(1.0f));
+    cache.AddCaster(true, 1, 11, Translation(2.0f));
+    cache.AddCaster(false, 2, 20, Translation(0.0f));
+    EXPECT_EQ(cache.End(), Update::ALL);
+
+    cache.Begin(glm::mat4(1.0f));
+    cache.AddCaster(true, 0, 10, Translation(1.0f));
+    cache.AddCaster(false, 2, 20, Translation(0.0f));
+    EXPECT_EQ(cache.End(), Update::ALL);
+}
+
+TEST(ShadowRegionCacheTest, MovingCasterBecomingStaticDrawsAll)
+{
+    CShadowRegionCache cache;
+    Frame(cache, glm::mat4(1.0f), 0.0f);
+
+    cache.Begin(glm::mat4(1.0f));
+    cache.AddCaster(true, 0, 10, Translation(1.0f));
+    cache.AddCaster(true, 1, 10, Translation(2.0f));
+    cache.AddCaster(true, 2, 20, Translation(0.0f));
+    EXPECT_EQ(cache.End(), Update::ALL);
+}
+
+TEST(ShadowRegionCacheTest, MatrixChangeDrawsAll)
+{
+    CShadowRegionCache cache;
+    Frame(cache, glm::mat4(1.0f), 0.0f);
+    EXPECT_EQ(Frame(cache, Translation(3.0f), 0.0f), Update::ALL);
+    EXPECT_EQ(Frame(cache, Translation(3.0f), 0.0f), Update::NOTHING);
+}
+
+TEST(ShadowRegionCacheTest, InvalidateDrawsAll)
+{
+    CShadowRegionCache cache;
+    Frame(cache, glm::mat4(1.0f), 0.0f);
+    cache.Invalidate();
+    EXPECT_EQ(Frame(cache, glm::mat4(1.0f), 0.0f), Update::ALL);
+    EXPECT_EQ(Frame(cache, glm::mat4(1.0f), 0.0f), Update::NOTHING);
+}
@@ -0,0 +1,92 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/wheel_trace.h"
+
+#include "graphics/core/recording_device.h"
+#include "graphics/core/renderers.h"
+
+#include "graphics/engine/particle_batch.h"
+
+#include "common/profiler.h"
+
+#include <gtest/gtest.h>
+
+using namespace Gfx;
+
+namespace
+{
+
+WheelTrace MakeTrace(float x, float z, TraceColor color = TraceColor::Black)
+{
+    WheelTrace trace;
+    trace.color = color;
+    trace.pos[0] = { x,        0.2f, z        };
+    trace.pos[1] = { x,        0.2f, z + 1.0f };
+    trace.pos[2] = { x + 2.0f, 0.2f, z        };
+    trace.pos[3] = { x + 2.0f, 0.2f, z + 1.0f };
+    return trace;
+}
+
+} // anonymous namespace
+
+TEST(WheelTraceTest, KeepsAllTraces)
+{
+    CWheelTraces traces;
+    for (int i = 0; i < 5000; ++i)
+        traces.Add(MakeTrace(static_cast<float>(i % 100) * 2.0f, static_cast<float>(i / 100)));
+
+    EXPECT_EQ(traces.GetCount(), 5000);
+    EXPECT_EQ(traces.GetTraces().front().pos[0], MakeTrace(0.0f, 0.0f).pos[0]);
+    EXPECT_GE(traces.GetMemoryUsage(), 5000 * (sizeof(WheelTrace) + 6 * sizeof(VertexParticle)));
+
+    traces.Clear();
+    EXPECT_EQ(traces.GetCount(), 0);
+    EXPECT_EQ(traces.GetMemoryUsage(), 0u);
+}
+
+TEST(WheelTraceTest, DrawsNearbyTracesByLook)
+{
+    CWheelTraces traces;
+    for (int i = 0; i < 1000; ++i)
+    {
+        traces.Add(MakeTrace(static_cast<float>(i % 50) * 2.0f, static_cast<float>(i / 50), TraceColor::Red));
+        traces.Add(MakeTrace(static_cast<float>(i % 50) * 2.0f, 100.0f + static_cast<float>(i / 50), TraceColor::RedArrow));
+        traces.Add(MakeTrace(1000.0f + static_cast<float>(i % 50) * 2.0f, static_cast<float>(i / 50), TraceColor::Blue));
+    }
+
+    CRecordingDevice device;
+    ASSERT_TRUE(device.Create());
+    auto renderer = device.GetParticleRenderer();
+    CParticleBatch batch(renderer);
+
+    Texture arrowTexture;
+    arrowTexture.id = 1;
+
+    CProfiler::ResetPerformanceStats();
+    renderer->Begin();
+    batch.Begin(true);
+    int triangles = traces.Draw(batch, arrowTexture, { 0.0f, 0.0f, 0.0f }, 300.0f);
+    batch.End();
+    renderer->End();
+
+    // The traces far away are skipped, the others take one draw call per look
+    EXPECT_EQ(triangles, 2 * 2000);
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_DRAW_CALLS), 2);
+}
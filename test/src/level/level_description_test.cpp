@@ -0,0 +1,149 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+#include "level/level_description.h"
+
+#include "common/temporary_location.h"
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+namespace
+{
+
+//! Returns a level file with the given title
+std::string MakeLevel(const std::string& title)
+{
+    return "Title text=\"" + title + "\"\nResume text=\"Summary of " + title + "\"\n";
+}
+
+} // anonymous namespace
+
+class CLevelDescriptionCacheUT : public CTemporaryLocationUT
+{
+protected:
+    //! Writes a file, keeping its modification time if it existed, to check what the cache notices
+    void RewriteKeepingTime(const std::string& filename, const std::string& contents)
+    {
+        auto time = std::filesystem::last_write_time(GetPath(filename));
+        WriteFile(filename, contents);
+        std::filesystem::last_write_time(GetPath(filename), time);
+    }
+
+    //! Writes a file with a modification time later than the previous one
+    void RewriteLater(const std::string& filename, const std::string& contents)
+    {
+        auto time = std::filesystem::last_write_time(GetPath(filename));
+        WriteFile(filename, contents);
+        std::filesystem::last_write_time(GetPath(filename), time + std::chrono::seconds(10));
+    }
+
+    CLevelDescriptionCache m_cache;
+};
+
+TEST_F(CLevelDescriptionCacheUT, ReadsTitleAndSummary)
+{
+    WriteFile("scene.txt", MakeLevel("First"));
+
+    const LevelDescription& description = m_cache.Get("scene.txt");
+    EXPECT_TRUE(description.exists);
+    EXPECT_EQ(description.title, "First");
+    EXPECT_EQ(description.resume, "Summary of First");
+    EXPECT_TRUE(description.titleError.empty());
+    EXPECT_TRUE(description.resumeError.empty());
+}
+
+TEST_F(CLevelDescriptionCacheUT, KeepsDescriptionOfUnchangedFile)
+{
+    WriteFile("scene.txt", MakeLevel("First"));
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "First");
+
+    RewriteKeepingTime("scene.txt", MakeLevel("Second"));
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "First");
+}
+
+TEST_F(CLevelDescriptionCacheUT, RereadsChangedFile)
+{
+    WriteFile("scene.txt", MakeLevel("First"));
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "First");
+
+    RewriteLater("scene.txt", MakeLevel("Second"));
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "Second");
+}
+
+TEST_F(CLevelDescriptionCacheUT, NoticesFileAppearingAndDisappearing)
+{
+    EXPECT_FALSE(m_cache.Get("scene.txt").exists);
+
+    WriteFile("scene.txt", MakeLevel("First"));
+    EXPECT_TRUE(m_cache.Get("scene.txt").exists);
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "First");
+
+    std::filesystem::remove(GetPath("scene.txt"));
+    EXPECT_FALSE(m_cache.Get("scene.txt").exists);
+}
+
+TEST_F(CLevelDescriptionCacheUT, RereadsWhenIncludedFileChanges)
+{
+    WriteFile("scene.txt", "#Include file=\"levels/title.txt\"\n");
+    WriteFile("levels/title.txt", "#Include file=\"levels/nested.txt\"\n");
+    WriteFile("levels/nested.txt", MakeLevel("First"));
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "First");
+
+    RewriteKeepingTime("levels/nested.txt", MakeLevel("Second"));
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "First");
+
+    RewriteLater("levels/nested.txt", MakeLevel("Third"));
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "Third");
+}
+
+TEST_F(CLevelDescriptionCacheUT, RereadsWhenMissingIncludeAppears)
+{
+    WriteFile("scene.txt", "#Include file=\"levels/title.txt\"\n");
+    EXPECT_FALSE(m_cache.Get("scene.txt").titleError.empty());
+
+    WriteFile("levels/title.txt", MakeLevel("First"));
+    EXPECT_TRUE(m_cache.Get("scene.txt").titleError.empty());
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "First");
+}
+
+TEST_F(CLevelDescriptionCacheUT, RereadsWhenLocationsChange)
+{
+    WriteFile("scene.txt", MakeLevel("First"));
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "First");
+
+    RewriteKeepingTime("scene.txt", MakeLevel("Second"));
+    ASSERT_TRUE(CResourceManager::RemoveLocation(GetPath("scene.txt").parent_path().string()));
+    ASSERT_TRUE(CResourceManager::AddLocation(GetPath("scene.txt").parent_path().string()));
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "Second");
+}
+
+TEST_F(CLevelDescriptionCacheUT, RereadsWhenLanguageChanges)
+{
+    m_cache.SetLanguage('E');
+    WriteFile("scene.txt", MakeLevel("First"));
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "First");
+
+    RewriteKeepingTime("scene.txt", MakeLevel("Second"));
+    m_cache.SetLanguage('E');
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "First");
+
+    m_cache.SetLanguage('F');
+    EXPECT_EQ(m_cache.Get("scene.txt").title, "Second");
+}
@@ -0,0 +1,174 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "bench/bench.h"
+
+#include "common/resources/resourcemanager.h"
+
+#include "level/level_description.h"
+
+#include "level/parser/parser.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+
+//! Chapters of the synthetic level tree
+constexpr int CHAPTERS = 20;
+//! Levels of every chapter, so that there are as many levels as in a big collection of mods
+constexpr int LEVELS = 25;
+
+/**
+ * Synthetic mission levels in a temporary directory mounted in the resource system
+ * for the lifetime of the benchmark executable
+ */
+class CBenchLevels
+{
+public:
+    CBenchLevels()
+    {
+        m_directory = std::filesystem::temp_directory_path() / "colobot-bench-levels";
+        for (int chap = 1; chap <= CHAPTERS; ++chap)
+        {
+            WriteLevel(chap, 0, "Chapter " + std::to_string(chap));
+            for (int rank = 1; rank <= LEVELS; ++rank)
+                WriteLevel(chap, rank, "Level " + std::to_string(rank));
+        }
+        CResourceManager::AddLocation(m_directory.string());
+    }
+
+    ~CBenchLevels()
+    {
+        CResourceManager::RemoveLocation(m_directory.string());
+        std::error_code error;
+        std::filesystem::remove_all(m_directory, error);
+    }
+
+    //! Writes a level file with a title, a summary and some objects, and makes it look modified
+    void WriteLevel(int chap, int rank, const std::string& title)
+    {
+        auto path = m_directory / CLevelParser::BuildScenePath(LevelCategory::Missions, chap, rank);
+        std::filesystem::create_directories(path.parent_path());
+
+        {
+            std::ofstream file(path);
+            file << "Title text=\"" << title << "\"\n";
+            file << "Resume text=\"Summary of " << title << "\"\n";
+            file << "Terrain vision=1000 depth=1 hard=0.5\n";
+            for (int i = 0; i < 50; ++i)
+                file << "CreateObject pos=" << i << ";" << -i << " dir=0.5 type=Titanium\n";
+        }
+
+        // Modification times can have a resolution of seconds, so step them explicitly
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now() + std::chrono::seconds(++m_writes));
+    }
+
+private:
+    std::filesystem::path m_directory;
+    int m_writes = 0;
+};
+
+CBenchLevels& UseBenchLevels()
+{
+    static CBenchLevels levels;
+    return levels;
+}
+
+//! Reads the titles of all levels like the level lists did, parsing every file
+int ParseAllTitles()
+{
+    int length = 0;
+    for (int chap = 1; chap <= CHAPTERS + 1; ++chap)
+    {
+        for (int rank = 0; rank <= LEVELS + 1; ++rank)
+        {
+            CLevelParser levelParser(LevelCategory::Missions, chap, rank);
+            if (!levelParser.Exists())
+                break;
+
+            levelParser.Load();
+            length += levelParser.Get("Title")->GetParam("text")->AsString().size();
+        }
+    }
+    return length;
+}
+
+//! Reads the titles of all levels like the level lists do
+int GetAllTitles(CLevelDescriptionCache& cache)
+{
+    int length = 0;
+    for (int chap = 1; chap <= CHAPTERS + 1; ++chap)
+    {
+        for (int rank = 0; rank <= LEVELS + 1; ++rank)
+        {
+            const LevelDescription& description = cache.Get(CLevelParser::BuildScenePath(LevelCategory::Missions, chap, rank));
+            if (!description.exists)
+                break;
+
+            length += description.title.size();
+        }
+    }
+    return length;
+}
+
+} // anonymous namespace
+
+// Opening the level lists, every level parsed
+BENCHMARK(LevelListParseAll)
+{
+    UseBenchLevels();
+
+    int length = 0;
+    while (state.KeepRunning())
+        length += ParseAllTitles();
+    Bench::DoNotOptimize(length);
+
+    state.SetCounter("levels", CHAPTERS * (LEVELS + 1));
+    state.SetItemsPerIteration(CHAPTERS * (LEVELS + 1));
+}
+
+// Opening the level lists again, every level file only checked for changes
+BENCHMARK(LevelListCached)
+{
+    auto& levels = UseBenchLevels();
+
+    CLevelDescriptionCache cache;
+    int expected = GetAllTitles(cache);
+
+    int length = 0;
+    while (state.KeepRunning())
+        length += GetAllTitles(cache);
+    Bench::DoNotOptimize(length);
+
+    // A changed level must show its new title
+    levels.WriteLevel(1, 1, "Changed");
+    int stale = cache.Get(CLevelParser::BuildScenePath(LevelCategory::Missions, 1, 1)).title != "Changed";
+    levels.WriteLevel(1, 1, "Level 1");
+    stale += GetAllTitles(cache) != expected;
+
+    state.SetCounter("levels", CHAPTERS * (LEVELS + 1));
+    state.SetCounter("stale", stale);
+    state.SetItemsPerIteration(CHAPTERS * (LEVELS + 1));
+    if (stale > 0)
+        state.SetError("changed level not reloaded");
+}
@@ -0,0 +1,251 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "bench/bench.h"
+
+#include "common/config.h"
+
+#include "common/resources/resourcemanager.h"
+
+#include "common/thread/job_system.h"
+
+#include "level/parser/parser.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+//! Where the data directory is mounted, shared with the resource loading benchmarks
+const std::string DATA_MOUNT_POINT = "bench-data";
+//! Where the synthetic scene is mounted
+const std::string SCENE_MOUNT_POINT = "bench-parser";
+//! Objects in the synthetic scene, about as many as in a save of a big code battle
+constexpr int OBJECTS = 20000;
+
+/**
+ * Scene files of all levels of the data directory and a large synthetic scene,
+ * mounted in the resource system for the lifetime of the benchmark executable
+ */
+class CBenchLevelFiles
+{
+public:
+    CBenchLevelFiles()
+    {
+        if (CResourceManager::AddLocation(COLOBOT_DEFAULT_DATADIR, true, DATA_MOUNT_POINT))
+            AddLevels(DATA_MOUNT_POINT + "/levels");
+
+        m_directory = std::filesystem::temp_directory_path() / "colobot-bench-parser";
+        std::filesystem::create_directories(m_directory);
+        WriteScene(m_directory / "scene.txt");
+        CResourceManager::AddLocation(m_directory.string(), true, SCENE_MOUNT_POINT);
+    }
+
+    ~CBenchLevelFiles()
+    {
+        CResourceManager::RemoveLocation(m_directory.string());
+        CResourceManager::RemoveLocation(COLOBOT_DEFAULT_DATADIR);
+        std::error_code error;
+        std::filesystem::remove_all(m_directory, error);
+    }
+
+    const std::vector<std::string>& GetLevels() const
+    {
+        return m_levels;
+    }
+
+    std::string GetScene() const
+    {
+        return SCENE_MOUNT_POINT + "/scene.txt";
+    }
+
+private:
+    //! Adds scene files, levels also have program files which aren't level files
+    void AddLevels(const std::string& directory)
+    {
+        std::string prefix = directory + "/";
+        for (const auto& file : CResourceManager::ListFiles(directory, true))
+        {
+            if (file == "scene.txt" || file == "chaptertitle.txt")
+                m_levels.push_back(prefix + file);
+        }
+        for (const auto& subdirectory : CResourceManager::ListDirectories(directory))
+            AddLevels(prefix + subdirectory);
+    }
+
+    //! Writes a scene like a saved game, with translated lines, comments and tabs like in level files
+    void WriteScene(const std::filesystem::path& path)
+    {
+        std::ofstream file(path);
+        file << "Title.E text=\"Saved game\"\n";
+        file << "Title.F text=\"Partie sauvegard\xc3\xa9" "e\"\n";
+        file << "Resume.E text=\"Summary of the level, with = and // in text\"\n";
+        file << "AmbientColor air=102;102;102;102 water=22;22;22;22 // colors\n";
+        file << "Terrain\tvision=1000 depth=1 hard=0.5\n";
+        for (int i = 0; i < OBJECTS; ++i)
+        {
+            file << "CreateObject type=WheeledGrabber id=" << i + 1
+                 << " pos=" << i * 1.5f << ";0;" << i * -2.25f
+                 << " angle=0;" << i * 0.1f << ";0 zoom=1;1;1"
+                 << " trainer=false energy=0.75 shield=1 color=#80ff4020"
+                 << " programStorageIndex=" << i << " scriptReadOnly1=false scriptRunnable1=true\n";
+        }
+    }
+
+    std::vector<std::string> m_levels;
+    std::filesystem::path m_directory;
+};
+
+const CBenchLevelFiles& UseBenchLevelFiles()
+{
+    static CBenchLevelFiles files;
+    return files;
+}
+
+//! Sums lengths of all commands and values, to compare results of parsing
+long long GetChecksum(CLevelParser& levelParser)
+{
+    long long checksum = 0;
+    for (auto& line : levelParser.GetLines())
+    {
+        checksum = checksum * 31 + line->GetCommand().size() + line->GetLineNumber();
+        for (auto& param : line->GetParams())
+            checksum = checksum * 31 + param.first.size() * 7 + param.second->GetValue().size();
+    }
+    return checksum;
+}
+
+//! Reads the values of objects of the synthetic scene, like CRobotMain::CreateScene() does
+float ReadObjects(CLevelParser& levelParser)
+{
+    float sum = 0.0f;
+    for (auto& line : levelParser.GetLines())
+    {
+        if (line->GetCommand() != "CreateObject")
+            continue;
+
+        sum += static_cast<int>(line->GetParam("type")->AsObjectType());
+        sum += line->GetParam("id")->AsInt();
+        sum += line->GetParam("pos")->AsPoint().x;
+        sum += line->GetParam("angle")->AsPoint().y;
+        sum += line->GetParam("zoom")->AsPoint().z;
+        sum += line->GetParam("trainer")->AsBool();
+        sum += line->GetParam("energy")->AsFloat();
+        sum += line->GetParam("shield")->AsFloat();
+        sum += line->GetParam("color")->AsColor().g;
+        sum += line->GetParam("programStorageIndex")->AsInt();
+    }
+    return sum;
+}
+
+//! Loads the synthetic scene, the result must not depend on threads used
+void LoadScene(Bench::CState& state, CJobSystem* jobSystem)
+{
+    const auto& files = UseBenchLevelFiles();
+
+    CLevelParser expected(files.GetScene());
+    expected.Load(nullptr);
+
+    long long checksum = 0;
+    while (state.KeepRunning())
+    {
+        CLevelParser levelParser(files.GetScene());
+        levelParser.Load(jobSystem);
+        checksum = GetChecksum(levelParser);
+    }
+
+    state.SetCounter("lines", expected.GetLines().size());
+    state.SetCounter("mismatches", checksum != GetChecksum(expected));
+    state.SetItemsPerIteration(expected.GetLines().size());
+    if (checksum != GetChecksum(expected))
+        state.SetError("scene loaded differently");
+}
+
+} // anonymous namespace
+
+// Loading every level of the data directory
+BENCHMARK(LevelParserShippedLevels)
+{
+    const auto& files = UseBenchLevelFiles();
+
+    long long lines = 0;
+    int errors = 0;
+    while (state.KeepRunning())
+    {
+        lines = 0;
+        errors = 0;
+        for (const auto& level : files.GetLevels())
+        {
+            try
+            {
+                CLevelParser levelParser(level);
+                levelParser.Load(nullptr);
+                lines += levelParser.GetLines().size();
+            }
+            catch (const CLevelParserException&)
+            {
+                ++errors;
+            }
+        }
+    }
+
+    state.SetCounter("levels", files.GetLevels().size());
+    state.SetCounter("lines", lines);
+    state.SetCounter("errors", errors);
+    state.SetItemsPerIteration(lines);
+    if (errors > 0)
+        state.SetError(std::to_string(errors) + " levels failed to load");
+}
+
+// Loading a large saved scene on the calling thread
+BENCHMARK(LevelParserLargeScene)
+{
+    LoadScene(state, nullptr);
+}
+
+// Loading a large saved scene on all cores
+BENCHMARK(LevelParserLargeSceneParallel)
+{
+    CJobSystem jobs;
+    LoadScene(state, &jobs);
+}
+
+// Reading values of all objects of a large scene again, as done for every pass over the scene
+BENCHMARK(LevelParserRepeatedValues)
+{
+    const auto& files = UseBenchLevelFiles();
+
+    CLevelParser levelParser(files.GetScene());
+    levelParser.Load(nullptr);
+    float expected = ReadObjects(levelParser);
+
+    float sum = 0.0f;
+    while (state.KeepRunning())
+        sum = ReadObjects(levelParser);
+    Bench::DoNotOptimize(sum);
+
+    state.SetCounter("objects", OBJECTS);
+    state.SetCounter("mismatches", sum != expected);
+    state.SetItemsPerIteration(OBJECTS);
+    if (sum != expected)
+        state.SetError("values read differently");
+}
@@ -0,0 +1,209 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "level/parser/parser.h"
+
+#include "level/parser/parserexceptions.h"
+
+#include "common/temporary_location.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+//! Returns text form of all lines of \a levelParser
+std::string ToText(CLevelParser& levelParser)
+{
+    std::stringstream stream;
+    for (auto& line : levelParser.GetLines())
+        stream << *line << "\n";
+    return stream.str();
+}
+
+//! Fills \a levelParser with every kind of param
+void FillLevel(CLevelParser& levelParser)
+{
+    auto line = std::make_unique<CLevelParserLine>("Values");
+    line->AddParam("text", std::make_unique<CLevelParserParam>(std::string("some text")));
+    line->AddParam("empty", std::make_unique<CLevelParserParam>(std::string("")));
+    line->AddParam("int", std::make_unique<CLevelParserParam>(-42));
+    line->AddParam("bigInt", std::make_unique<CLevelParserParam>(123456789));
+    line->AddParam("wholeFloat", std::make_unique<CLevelParserParam>(2.0f));
+    line->AddParam("float", std::make_unique<CLevelParserParam>(-0.125f));
+    line->AddParam("bigFloat", std::make_unique<CLevelParserParam>(3.0e7f));
+    line->AddParam("bool", std::make_unique<CLevelParserParam>(true));
+    line->AddParam("pos", std::make_unique<CLevelParserParam>(glm::vec3(1.5f, -2.0f, 300.0f)));
+    levelParser.AddLine(std::move(line));
+
+    line = std::make_unique<CLevelParserLine>("Values");
+    CLevelParserParamVec array;
+    array.push_back(std::make_unique<CLevelParserParam>(1));
+    array.push_back(std::make_unique<CLevelParserParam>(2.5f));
+    array.push_back(std::make_unique<CLevelParserParam>(std::string("three")));
+    line->AddParam("array", std::make_unique<CLevelParserParam>(std::move(array)));
+    levelParser.AddLine(std::move(line));
+
+    levelParser.AddLine(std::make_unique<CLevelParserLine>("NoParams"));
+}
+
+} // namespace
+
+using CLevelParserBinaryUT = CTemporaryLocationUT;
+
+TEST_F(CLevelParserBinaryUT, RoundTripKeepsValues)
+{
+    CLevelParser saved("data.sav");
+    FillLevel(saved);
+    saved.SaveBinary();
+
+    CLevelParser loaded("data.sav");
+    loaded.Load();
+
+    ASSERT_EQ(3u, loaded.GetLines().size());
+    CLevelParserLine* line = loaded.GetLines()[0].get();
+    EXPECT_EQ("some text", line->GetParam("text")->AsString());
+    EXPECT_EQ("", line->GetParam("empty")->AsString());
+    EXPECT_EQ(-42, line->GetParam("int")->AsInt());
+    EXPECT_EQ(123456789, line->GetParam("bigInt")->AsInt());
+    EXPECT_EQ(2.0f, line->GetParam("wholeFloat")->AsFloat());
+    EXPECT_EQ(-0.125f, line->GetParam("float")->AsFloat());
+    EXPECT_EQ(3.0e7f, line->GetParam("bigFloat")->AsFloat());
+    EXPECT_TRUE(line->GetParam("bool")->AsBool());
+    EXPECT_EQ(glm::vec3(1.5f, -2.0f, 300.0f), line->GetParam("pos")->AsPoint());
+
+    const CLevelParserParamVec& array = loaded.GetLines()[1]->GetParam("array")->AsArray();
+    ASSERT_EQ(3u, array.size());
+    EXPECT_EQ(1, array[0]->AsInt());
+    EXPECT_EQ(2.5f, array[1]->AsFloat());
+    EXPECT_EQ("three", array[2]->AsString());
+}
+
+TEST_F(CLevelParserBinaryUT, RoundTripMatchesTextSave)
+{
+    CLevelParser text("data.txt");
+    FillLevel(text);
+    text.Save();
+
+    CLevelParser binary("data.sav");
+    FillLevel(binary);
+    binary.SaveBinary();
+
+    CLevelParser loadedText("data.txt");
+    loadedText.Load();
+    CLevelParser loadedBinary("data.sav");
+    loadedBinary.Load();
+
+    // written the same way means floats stayed floats and ints stayed ints
+    EXPECT_EQ(ToText(text), ToText(loadedBinary));
+    EXPECT_EQ(ToText(loadedText), ToText(loadedBinary));
+}
+
+TEST_F(CLevelParserBinaryUT, TruncatedFileThrows)
+{
+    CLevelParser saved("data.sav");
+    FillLevel(saved);
+    saved.SaveBinary();
+
+    std::string contents = ReadFile("data.sav");
+    ASSERT_GT(contents.size(), 4u);
+
+    // a file ending exactly after a line would be valid, unless the line count says otherwise
+    for (std::size_t size = 4; size < contents.size(); ++size)
+    {
+        WriteFile("data.sav", contents.substr(0, size));
+
+        CLevelParser loaded("data.sav");
+        EXPECT_THROW(loaded.Load(), CLevelParserException) << "size " << size;
+    }
+}
+
+TEST_F(CLevelParserBinaryUT, HugeLengthThrows)
+{
+    CLevelParser saved("data.sav");
+    auto line = std::make_unique<CLevelParserLine>("Values");
+    line->AddParam("text", std::make_unique<CLevelParserParam>(std::string("abc")));
+    saved.AddLine(std::move(line));
+    saved.SaveBinary();
+
+    std::string contents = ReadFile("data.sav");
+    // text params are saved quoted
+    std::size_t text = contents.rfind("\"abc\"");
+    ASSERT_NE(std::string::npos, text);
+    ASSERT_EQ('\x05', contents[text - 1]);
+
+    // replace the one byte length of the text with the largest LEB128 length
+    std::string corrupted = contents.substr(0, text - 1) + std::string(9, '\xFF') + '\x01' + contents.substr(text);
+    WriteFile("data.sav", corrupted);
+
+    CLevelParser loaded("data.sav");
+    EXPECT_THROW(loaded.Load(), CLevelParserException);
+}
+
+TEST_F(CLevelParserBinaryUT, HugeCountsThrow)
+{
+    // version 1, then INT_MAX lines, params or array values, ints are signed LEB128
+    const std::string version = "\x01";
+    const std::string huge = "\xFF\xFF\xFF\xFF\x07";
+    const std::string command = std::string("\x00", 1) + "\x04" + "Line";
+    const std::string name = std::string("\x01", 1) + "\x01" + "a";
+
+    std::vector<std::string> files = {
+        "CLVB" + version + huge,
+        "CLVB" + version + "\x01" + command + huge,
+        "CLVB" + version + "\x01" + command + "\x01" + name + "\x03" + huge,
+    };
+    for (const std::string& contents : files)
+    {
+        WriteFile("data.sav", contents);
+
+        CLevelParser loaded("data.sav");
+        EXPECT_THROW(loaded.Load(), CLevelParserException);
+    }
+}
+
+TEST_F(CLevelParserBinaryUT, CorruptedByteLoadsOrThrows)
+{
+    CLevelParser saved("data.sav");
+    FillLevel(saved);
+    saved.SaveBinary();
+
+    std::string contents = ReadFile("data.sav");
+    for (std::size_t offset = 4; offset < contents.size(); ++offset)
+    {
+        for (char value : {'\x00', '\x7F', '\xFF'})
+        {
+            std::string corrupted = contents;
+            corrupted[offset] = value;
+            WriteFile("data.sav", corrupted);
+
+            CLevelParser loaded("data.sav");
+            try
+            {
+                loaded.Load();
+            }
+            catch (const CLevelParserException&)
+            {
+            }
+        }
+    }
+}
@@ -0,0 +1,210 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+#include "level/parser/parser.h"
+#include "level/parser/parserexceptions.h"
+
+#include "common/thread/job_system.h"
+
+#include "common/temporary_location.h"
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+//! Returns the lines of a level file as text, or its error, to compare parsers with each other
+std::string Describe(const std::string& filename, CJobSystem* jobSystem = nullptr)
+{
+    CLevelParser levelParser(filename);
+    try
+    {
+        levelParser.Load(jobSystem);
+    }
+    catch (CLevelParserException& e)
+    {
+        return std::string("error: ") + e.what();
+    }
+
+    std::stringstream result;
+    for (const auto& line : levelParser.GetLines())
+    {
+        result << line->GetLineNumber() << " " << line->GetCommand();
+        for (const auto& param : line->GetParams())
+            result << " " << param.first << "=[" << param.second->GetValue() << "]";
+        result << "\n";
+    }
+    return result.str();
+}
+
+//! Reads a number from text the way level files were read before, with a stream
+template<typename T>
+T ReadWithStream(const std::string& text)
+{
+    std::stringstream stream(text);
+    T result;
+    stream >> result;
+    return result;
+}
+
+} // anonymous namespace
+
+/*
+ * Expected results below are those of the parser reading lines one at a time with getline(),
+ * which the parser reading the mapped file in one pass replaced
+ */
+class CLevelParserTextUT : public CTemporaryLocationUT
+{
+protected:
+    //! Writes level.txt and returns what is read from it
+    std::string Load(const std::string& contents)
+    {
+        WriteFile("level.txt", contents);
+        return Describe("level.txt");
+    }
+};
+
+TEST_F(CLevelParserTextUT, RemovesComments)
+{
+    EXPECT_EQ(Load("Title text=\"a // not a comment\" // comment\n"
+                   "// whole line\n"
+                   "Cmd a=1 // comment\n"
+                   "Cmd b='x//y' c=2\n"),
+              "1 Title text=[\"a // not a comment\"]\n"
+              "3 Cmd a=[1]\n"
+              "4 Cmd b=['x//y'] c=[2]\n");
+}
+
+TEST_F(CLevelParserTextUT, KeepsQuotedStrings)
+{
+    EXPECT_EQ(Load("Cmd text=\"with = sign\" other='single \"quote\"'\n"
+                   "Cmd name=value with spaces next=2\n"
+                   "Cmd empty=\"\" last=\"end\"\n"),
+              "1 Cmd other=['single \"quote\"'] text=[\"with = sign\"]\n"
+              "2 Cmd name=[value with spaces] next=[2]\n"
+              "3 Cmd empty=[\"\"] last=[\"end\"]\n");
+}
+
+TEST_F(CLevelParserTextUT, ReadsTabsAsSpaces)
+{
+    EXPECT_EQ(Load("Cmd\ta=1\tb=\t2\n"
+                   "Cmd\ttext=\"tab\tinside\"\n"
+                   "\t\tIndented x=1\n"),
+              "1 Cmd a=[1] b=[2]\n"
+              "2 Cmd text=[\"tab inside\"]\n"
+              "3 Indented x=[1]\n");
+}
+
+TEST_F(CLevelParserTextUT, ReadsWindowsLineEndings)
+{
+    EXPECT_EQ(Load("Cmd a=1\r\nCmd text=\"x\"\r\n\r\nLast b=2"),
+              "1 Cmd a=[1]\n"
+              "2 Cmd text=[\"x\"]\n"
+              "4 Last b=[2]\n");
+}
+
+TEST_F(CLevelParserTextUT, ReadsOddParams)
+{
+    EXPECT_EQ(Load("Cmd a=\n"
+                   "Cmd a\n"
+                   "Cmd =5 b\n"
+                   "Cmd a==1\n"
+                   "Cmd a=1 =2\n"),
+              "1 Cmd a=[]\n"
+              "2 Cmd a=[a]\n"
+              "3 Cmd =[5 b]\n"
+              "4 Cmd 1=[1] a=[=]\n"
+              "5 Cmd 2=[2] a=[1 =]\n");
+}
+
+TEST_F(CLevelParserTextUT, KeepsLinesOfLanguage)
+{
+    EXPECT_EQ(Load("Title.E text=\"English\"\n"
+                   "Title.F text=\"French\"\n"
+                   "Resume.F text=\"French\"\n"
+                   "Resume.E text=\"English\"\n"
+                   "Other.D x=1\n"
+                   "Plain.E y=2\n"),
+              "1 Title text=[\"English\"]\n"
+              "4 Resume text=[\"English\"]\n"
+              "6 Plain y=[2]\n");
+
+    // Lines in other languages are skipped before their params are read
+    EXPECT_EQ(Load("Title.E text=\"ok\"\n"
+                   "Title.F text=\"unclosed\n"),
+              "1 Title text=[\"ok\"]\n");
+}
+
+TEST_F(CLevelParserTextUT, ReadsIncludedFiles)
+{
+    WriteFile("inc.txt", "Inner c=3\n#Include file=\"inc2.txt\"\n");
+    WriteFile("inc2.txt", "Deep d=4\n");
+    EXPECT_EQ(Load("Before a=1\n#Include file=\"inc.txt\"\nAfter b=2\n"),
+              "1 Before a=[1]\n"
+              "1 Inner c=[3]\n"
+              "1 Deep d=[4]\n"
+              "3 After b=[2]\n");
+
+    WriteFile("inc2.txt", "Deep d=4\nDeep e=\"x\n");
+    EXPECT_EQ(Describe("level.txt"), "error: Unclosed \" in inc2.txt:2");
+}
+
+TEST_F(CLevelParserTextUT, ReportsBrokenLine)
+{
+    EXPECT_EQ(Load("Cmd a=1\nCmd text=\"unclosed\nCmd b=2\n"), "error: Unclosed \" in level.txt:2");
+    EXPECT_EQ(Load("Cmd a=1\nCmd b=2\n\tCmd c='x\n"), "error: Unclosed ' in level.txt:3");
+    EXPECT_EQ(Load("Cmd a=1\n\n#Unknown x=1\n"), "error: Unknown preprocessor command '#Unknown' (in level.txt:3)");
+}
+
+TEST_F(CLevelParserTextUT, ParallelLoadMatchesSerialLoad)
+{
+    std::string block = "Title.E text=\"English\" // comment\n"
+                        "Title.F text=\"French\"\n"
+                        "Cmd\ta=1\tb='x//y' name=value with spaces\r\n"
+                        "\n"
+                        "// comment\n";
+    std::string contents;
+    for (int i = 0; i < 1000; ++i)
+        contents += block;
+
+    CJobSystem jobSystem(4);
+    WriteFile("level.txt", contents);
+    std::string serial = Describe("level.txt");
+    EXPECT_EQ(Describe("level.txt", &jobSystem), serial);
+    EXPECT_NE(serial.find("4998 Cmd a=[1] b=['x//y'] name=[value with spaces]\n"), std::string::npos);
+
+    // The first broken line is reported, wherever the batches of lines are
+    WriteFile("level.txt", contents + "Cmd text=\"unclosed\n" + contents + "Cmd text='unclosed\n");
+    EXPECT_EQ(Describe("level.txt", &jobSystem), "error: Unclosed \" in level.txt:5001");
+    EXPECT_EQ(Describe("level.txt"), "error: Unclosed \" in level.txt:5001");
+}
+
+TEST(CLevelParserParamTest, ReadsNumbersLikeStreams)
+{
+    for (const char* text : { "0", "12", "-7", "+5", "  42", "\t3", "1.5", ".5", "5.", "-.25", "1e3", "2.5E-2",
+                              "1e", "1e+", "1.5E", "+-5", "++5", "+", "-", "-0", "0005", "12abc", "1,5", "0x10",
+                              "abc", "inf", "-inf", "+inf", "infinity", "nan", "NAN", "1e400", "-1e400",
+                              "1e-50", "99999999999", "-99999999999" })
+    {
+        CLevelParserParam floatParam("value", std::string(text));
+        CLevelParserParam intParam("value", std::string(text));
+        EXPECT_EQ(floatParam.AsFloat(), ReadWithStream<float>(text)) << "text: " << text;
+        EXPECT_EQ(intParam.AsInt(), ReadWithStream<int>(text)) << "text: " << text;
+    }
+}
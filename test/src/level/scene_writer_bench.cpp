@@ -0,0 +1,237 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "bench/bench.h"
+
+#include "CBot/CBotFileUtils.h"
+
+#include "common/resources/resourcemanager.h"
+
+#include "common/thread/job_system.h"
+
+#include "level/scene_writer.h"
+
+#include "level/parser/parser.h"
+
+#include <filesystem>
+#include <memory>
+
+namespace
+{
+
+//! Objects in the scene, about as many as in a big code battle
+constexpr int OBJECTS = 2000;
+//! Size of serialized program stack of each object
+constexpr int STACK_BYTES = 4096;
+
+/**
+ * Write directory of the resource system set to a temporary directory
+ * for the lifetime of the benchmark executable
+ */
+class CBenchSaveLocation
+{
+public:
+    CBenchSaveLocation()
+    {
+        m_directory = std::filesystem::temp_directory_path() / "colobot-bench-save";
+        std::filesystem::create_directories(m_directory);
+        CResourceManager::SetSaveLocation(m_directory.string());
+    }
+
+    ~CBenchSaveLocation()
+    {
+        std::error_code error;
+        std::filesystem::remove_all(m_directory, error);
+    }
+
+    double GetFileSizeKb(const std::string& filename) const
+    {
+        std::error_code error;
+        auto size = std::filesystem::file_size(m_directory / filename, error);
+        return error ? 0.0 : size / 1024.0;
+    }
+
+private:
+    std::filesystem::path m_directory;
+};
+
+const CBenchSaveLocation& UseBenchSaveLocation()
+{
+    static CBenchSaveLocation location;
+    return location;
+}
+
+//! Adds lines of a synthetic scene, like CRobotMain::IOWriteScene() does
+void CaptureLevel(CLevelParser& levelParser)
+{
+    for (int i = 0; i < OBJECTS; ++i)
+    {
+        auto line = std::make_unique<CLevelParserLine>("CreateObject");
+        line->AddParam("type", std::make_unique<CLevelParserParam>(OBJECT_MOBILEwa));
+        line->AddParam("id", std::make_unique<CLevelParserParam>(i + 1));
+        line->AddParam("pos", std::make_unique<CLevelParserParam>(glm::vec3(i * 1.5f, 0.0f, i * -2.25f)));
+        line->AddParam("angle", std::make_unique<CLevelParserParam>(glm::vec3(0.0f, i * 0.1f, 0.0f)));
+        line->AddParam("zoom", std::make_unique<CLevelParserParam>(glm::vec3(1.0f, 1.0f, 1.0f)));
+        line->AddParam("trainer", std::make_unique<CLevelParserParam>(false));
+        line->AddParam("energy", std::make_unique<CLevelParserParam>(0.75f));
+        line->AddParam("shield", std::make_unique<CLevelParserParam>(1.0f));
+        line->AddParam("programStorageIndex", std::make_unique<CLevelParserParam>(i));
+        line->AddParam("scriptReadOnly1", std::make_unique<CLevelParserParam>(false));
+        line->AddParam("scriptRunnable1", std::make_unique<CLevelParserParam>(true));
+        levelParser.AddLine(std::move(line));
+    }
+}
+
+//! Captures a synthetic scene, like CRobotMain::IOWriteScene() does on the main thread
+std::shared_ptr<CSceneWriter> CaptureScene()
+{
+    auto writer = std::make_shared<CSceneWriter>("data.sav", "cbot.run");
+
+    CaptureLevel(writer->GetLevelParser());
+
+    std::ostream& ostr = writer->GetStackStream();
+    for (int i = 0; i < OBJECTS; ++i)
+    {
+        for (int j = 0; j < STACK_BYTES / 4; ++j)
+            CBot::WriteInt(ostr, i * j);
+    }
+
+    return writer;
+}
+
+//! Saves the synthetic scene level file in text or binary format
+void SaveLevel(Bench::CState& state, const std::string& filename, bool binary)
+{
+    const auto& location = UseBenchSaveLocation();
+
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        CLevelParser levelParser(filename);
+        CaptureLevel(levelParser);
+        state.ResumeTiming();
+
+        if (binary)
+            levelParser.SaveBinary();
+        else
+            levelParser.Save();
+    }
+
+    state.SetCounter("objects", OBJECTS);
+    state.SetCounter("file_kb", location.GetFileSizeKb(filename));
+}
+
+//! Loads the synthetic scene level file and reads every object, like CRobotMain::IOReadScene() does
+void LoadLevel(Bench::CState& state, const std::string& filename, bool binary)
+{
+    UseBenchSaveLocation();
+
+    {
+        CLevelParser levelParser(filename);
+        CaptureLevel(levelParser);
+        if (binary)
+            levelParser.SaveBinary();
+        else
+            levelParser.Save();
+    }
+
+    float sum = 0.0f;
+    while (state.KeepRunning())
+    {
+        CLevelParser levelParser(filename);
+        levelParser.Load();
+
+        for (auto& line : levelParser.GetLines())
+        {
+            sum += static_cast<int>(line->GetParam("type")->AsObjectType());
+            sum += line->GetParam("id")->AsInt();
+            sum += line->GetParam("pos")->AsPoint().x;
+            sum += line->GetParam("angle")->AsPoint().y;
+            sum += line->GetParam("zoom")->AsPoint().z;
+            sum += line->GetParam("trainer")->AsBool();
+            sum += line->GetParam("energy")->AsFloat();
+            sum += line->GetParam("shield")->AsFloat();
+            sum += line->GetParam("programStorageIndex")->AsInt();
+            sum += line->GetParam("scriptReadOnly1")->AsBool();
+            sum += line->GetParam("scriptRunnable1")->AsBool();
+        }
+    }
+    Bench::DoNotOptimize(sum);
+
+    state.SetCounter("objects", OBJECTS);
+}
+
+} // anonymous namespace
+
+// Main thread stall of a large save, files written by a background job
+BENCHMARK(SceneSaveMainThreadStall)
+{
+    const auto& location = UseBenchSaveLocation();
+    CJobSystem jobs;
+
+    while (state.KeepRunning())
+    {
+        auto writer = CaptureScene();
+        auto job = jobs.Submit([writer]() { writer->Write(); });
+
+        state.PauseTiming();
+        jobs.Wait(job);
+        state.ResumeTiming();
+    }
+
+    state.SetCounter("objects", OBJECTS);
+    state.SetCounter("cbot_kb", location.GetFileSizeKb("cbot.run"));
+    state.SetCounter("data_kb", location.GetFileSizeKb("data.sav"));
+}
+
+// Main thread stall of a large save written synchronously, as before
+BENCHMARK(SceneSaveSynchronous)
+{
+    UseBenchSaveLocation();
+
+    while (state.KeepRunning())
+    {
+        auto writer = CaptureScene();
+        writer->Write();
+    }
+
+    state.SetCounter("objects", OBJECTS);
+}
+
+// Level file of a large save in the text format
+BENCHMARK(SceneFileSaveText)
+{
+    SaveLevel(state, "text.sav", false);
+}
+
+// Level file of a large save in the binary format
+BENCHMARK(SceneFileSaveBinary)
+{
+    SaveLevel(state, "binary.sav", true);
+}
+
+BENCHMARK(SceneFileLoadText)
+{
+    LoadLevel(state, "text.sav", false);
+}
+
+BENCHMARK(SceneFileLoadBinary)
+{
+    LoadLevel(state, "binary.sav", true);
+}
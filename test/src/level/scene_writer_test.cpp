@@ -0,0 +1,134 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "level/scene_writer.h"
+
+#include "common/thread/job_system.h"
+
+#include "level/parser/parser.h"
+
+#include "common/temporary_location.h"
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+
+//! Creates a writer of a scene with one line and a stack identified by \a id
+std::shared_ptr<CSceneWriter> MakeWriter(int id, bool binary = true)
+{
+    auto writer = std::make_shared<CSceneWriter>("data.sav", "cbot.run", binary);
+
+    auto line = std::make_unique<CLevelParserLine>("Saved");
+    line->AddParam("id", std::make_unique<CLevelParserParam>(id));
+    writer->GetLevelParser().AddLine(std::move(line));
+
+    writer->GetStackStream() << "stack " << id;
+
+    return writer;
+}
+
+//! Returns id of the scene saved in data.sav, -1 if there is none
+int ReadSavedId()
+{
+    CLevelParser levelParser("data.sav");
+    if (!levelParser.Exists())
+        return -1;
+
+    levelParser.Load();
+    return levelParser.Get("Saved")->GetParam("id")->AsInt();
+}
+
+} // anonymous namespace
+
+using CSceneWriterUT = CTemporaryLocationUT;
+
+TEST_F(CSceneWriterUT, WritesBothFiles)
+{
+    for (bool binary : { true, false })
+    {
+        ASSERT_TRUE(MakeWriter(1, binary)->Write());
+
+        EXPECT_EQ(ReadSavedId(), 1);
+        EXPECT_EQ(ReadFile("cbot.run"), "stack 1");
+        EXPECT_FALSE(std::filesystem::exists(GetPath("data.sav.tmp")));
+        EXPECT_FALSE(std::filesystem::exists(GetPath("cbot.run.tmp")));
+    }
+}
+
+TEST_F(CSceneWriterUT, FailedStackWriteKeepsPreviousSave)
+{
+    ASSERT_TRUE(MakeWriter(1)->Write());
+
+    // the temporary file can't be created where a directory is
+    std::filesystem::create_directories(GetPath("cbot.run.tmp"));
+
+    EXPECT_FALSE(MakeWriter(2)->Write());
+
+    EXPECT_EQ(ReadSavedId(), 1);
+    EXPECT_EQ(ReadFile("cbot.run"), "stack 1");
+}
+
+TEST_F(CSceneWriterUT, FailedLevelWriteKeepsPreviousSave)
+{
+    ASSERT_TRUE(MakeWriter(1)->Write());
+
+    std::filesystem::create_directories(GetPath("data.sav.tmp"));
+
+    EXPECT_FALSE(MakeWriter(2)->Write());
+
+    EXPECT_EQ(ReadSavedId(), 1);
+    EXPECT_EQ(ReadFile("cbot.run"), "stack 1");
+}
+
+TEST_F(CSceneWriterUT, ChainedSavesLandInOrder)
+{
+    const int saves = 20;
+
+    CJobSystem jobs(4);
+    std::mutex mutex;
+    std::vector<int> previousIds;
+
+    // like CRobotMain::IOWriteScene(), every save depends on the previous one
+    JobHandle job;
+    for (int i = 0; i < saves; ++i)
+    {
+        auto writer = MakeWriter(i);
+        job = jobs.Submit([&, writer]()
+        {
+            int previousId = ReadSavedId();
+            writer->Write();
+
+            std::lock_guard<std::mutex> lock{mutex};
+            previousIds.push_back(previousId);
+        }, nullptr, { job });
+    }
+
+    jobs.Wait(job);
+
+    ASSERT_EQ(previousIds.size(), static_cast<std::size_t>(saves));
+    for (int i = 0; i < saves; ++i)
+        EXPECT_EQ(previousIds[i], i - 1);
+
+    EXPECT_EQ(ReadSavedId(), saves - 1);
+    EXPECT_EQ(ReadFile("cbot.run"), "stack " + std::to_string(saves - 1));
+}
@@ -0,0 +1,247 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "bench/bench.h"
+
+#include "object/object.h"
+#include "object/object_grid.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+//! Range of CAutoTower::SearchTarget()
+constexpr float TOWER_SCOPE = 200.0f;
+//! Side of the map, like a 640x640 m level
+constexpr float MAP_SIZE = 3200.0f;
+
+//! Just enough of an object for target searches, kept in the grid like CObjectManager does
+class CBenchObject : public CObject
+{
+public:
+    CBenchObject(int id, ObjectType type, CObjectGrid& grid)
+        : CObject(id, type), m_grid(grid)
+    {
+        AddCrashSphere(CrashSphere(glm::vec3(0.0f, 2.0f, 0.0f), 3.0f));
+    }
+
+    void Write(CLevelParserLine*) override {}
+    void Read(CLevelParserLine*) override {}
+    void SetGhostMode(bool) override {}
+
+    void TransformCrashSphere(Math::Sphere& crashSphere) override
+    {
+        crashSphere.pos += m_position;
+    }
+
+    void TransformCameraCollisionSphere(Math::Sphere&) override {}
+
+    void SetPosition(const glm::vec3& pos) override
+    {
+        m_position = pos;
+        m_grid.Update(this);
+    }
+
+private:
+    CObjectGrid& m_grid;
+};
+
+/**
+ * A fortified base in the middle of the map: a ring of defense towers,
+ * with one alien in ten of the swarm spread over the map closing in on it
+ */
+class CBaseUnderAttack
+{
+public:
+    CBaseUnderAttack(int towers, int aliens)
+    {
+        int id = 1;
+        for (int i = 0; i < towers; ++i)
+        {
+            float angle = 2.0f * 3.14159265f * i / towers;
+            AddObject(id++, OBJECT_TOWER, glm::vec3(std::cos(angle) * 150.0f, 0.0f, std::sin(angle) * 150.0f));
+            m_towers.push_back(m_objects.back().get());
+        }
+
+        // Colonists of the base, never targets
+        for (int i = 0; i < 100; ++i)
+            AddObject(id++, OBJECT_MOBILEfa, Scatter(i, 300.0f));
+
+        for (int i = 0; i < aliens; ++i)
+        {
+            AddObject(id++, i % 2 == 0 ? OBJECT_ANT : OBJECT_SPIDER, Scatter(i + 1000, MAP_SIZE / 2.0f));
+            m_aliens.push_back(m_objects.back().get());
+        }
+    }
+
+    //! Attackers take a step towards the base, the others roam around their nest
+    void Advance()
+    {
+        ++m_frame;
+        for (CObject* alien : m_aliens)
+        {
+            int id = alien->GetID();
+            glm::vec3 pos = alien->GetPosition();
+            if (id % 10 == 0)
+            {
+                float distance = std::hypot(pos.x, pos.z);
+                if (distance < 100.0f)
+                    pos = Scatter(id, MAP_SIZE / 2.0f);  // killed, a new one hatches
+                else
+                    pos *= (distance - 4.0f) / distance;
+            }
+            else
+            {
+                float angle = (m_frame + id) * 0.05f;
+                pos = Scatter(id, MAP_SIZE / 2.0f) + glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * 40.0f;
+            }
+            alien->SetPosition(pos);
+        }
+    }
+
+    //! Sum of the IDs of the targets of all towers, searching all objects like before
+    int SearchAllObjects()
+    {
+        int sum = 0;
+        for (CObject* tower : m_towers)
+        {
+            CObject* best = nullptr;
+            for (const auto& obj : m_objects)
+                best = Closer(tower, obj.get(), best);
+            sum += best != nullptr ? best->GetID() : 0;
+        }
+        return sum;
+    }
+
+    //! Same as SearchAllObjects(), but only through the objects of the grid near each tower
+    int SearchGrid()
+    {
+        int sum = 0;
+        std::vector<CObject*> objects;
+        for (CObject* tower : m_towers)
+        {
+            objects.clear();
+            m_grid.Find(tower->GetPosition(), TOWER_SCOPE + m_grid.GetCrashSphereReach(), objects);
+            std::sort(objects.begin(), objects.end(), [](CObject* a, CObject* b)
+            {
+                return a->GetID() < b->GetID();
+            });
+
+            CObject* best = nullptr;
+            for (CObject* obj : objects)
+                best = Closer(tower, obj, best);
+            sum += best != nullptr ? best->GetID() : 0;
+        }
+        return sum;
+    }
+
+private:
+    void AddObject(int id, ObjectType type, const glm::vec3& pos)
+    {
+        auto object = std::make_unique<CBenchObject>(id, type, m_grid);
+        object->SetPosition(pos);
+        m_grid.Add(object.get());
+        m_objects.push_back(std::move(object));
+    }
+
+    static glm::vec3 Scatter(int seed, float range)
+    {
+        unsigned int hash = static_cast<unsigned int>(seed) * 2654435761u;
+        float x = (hash % 1000) / 1000.0f * 2.0f - 1.0f;
+        float z = ((hash / 1000) % 1000) / 1000.0f * 2.0f - 1.0f;
+        return glm::vec3(x * range, 0.0f, z * range);
+    }
+
+    //! Target selection of CAutoTower::SearchTarget()
+    static CObject* Closer(CObject* tower, CObject* obj, CObject* best)
+    {
+        ObjectType type = obj->GetType();
+        if (type != OBJECT_ANT && type != OBJECT_SPIDER) return best;
+
+        glm::vec3 iPos = tower->GetPosition();
+        float distance = glm::distance(obj->GetFirstCrashSphere().sphere.pos, iPos);
+        if (distance > TOWER_SCOPE) return best;
+        if (best != nullptr && distance >= glm::distance(best->GetFirstCrashSphere().sphere.pos, iPos)) return best;
+        return obj;
+    }
+
+    CObjectGrid m_grid;
+    std::vector<std::unique_ptr<CBenchObject>> m_objects;
+    std::vector<CObject*> m_towers;
+    std::vector<CObject*> m_aliens;
+    int m_frame = 0;
+};
+
+template<bool useGrid>
+void BaseUnderAttack(Bench::CState& state, int aliens)
+{
+    // Both searches must pick the same targets, frame after frame
+    CBaseUnderAttack check(30, aliens);
+    int mismatches = 0;
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        check.Advance();
+        if (check.SearchGrid() != check.SearchAllObjects()) ++mismatches;
+    }
+
+    CBaseUnderAttack scene(30, aliens);
+    while (state.KeepRunning())
+    {
+        // Moving the aliens costs the same in both cases, grid upkeep included
+        state.PauseTiming();
+        scene.Advance();
+        state.ResumeTiming();
+
+        int targets = useGrid ? scene.SearchGrid() : scene.SearchAllObjects();
+        Bench::UsePointer(&targets);
+    }
+
+    state.SetCounter("mismatches", mismatches);
+    state.SetItemsPerIteration(30);
+    if (mismatches > 0)
+        state.SetError("grid search differs from linear search");
+}
+
+} // anonymous namespace
+
+BENCHMARK(ObjectBaseUnderAttackAllObjects200)
+{
+    BaseUnderAttack<false>(state, 200);
+}
+
+BENCHMARK(ObjectBaseUnderAttackGrid200)
+{
+    BaseUnderAttack<true>(state, 200);
+}
+
+BENCHMARK(ObjectBaseUnderAttackAllObjects2000)
+{
+    BaseUnderAttack<false>(state, 2000);
+}
+
+BENCHMARK(ObjectBaseUnderAttackGrid2000)
+{
+    BaseUnderAttack<true>(state, 2000);
+}
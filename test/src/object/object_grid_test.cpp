@@ -0,0 +1,207 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "object/object.h"
+#include "object/object_grid.h"
+
+#include <gtest/gtest.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+//! Object with a scaled first crash sphere, kept in the grid like CObjectManager does
+class CGridTestObject : public CObject
+{
+public:
+    CGridTestObject(int id, CObjectGrid& grid)
+        : CObject(id, OBJECT_STONE), m_grid(grid)
+    {
+        m_scale = glm::vec3(1.0f, 1.0f, 1.0f);
+    }
+
+    void Write(CLevelParserLine*) override {}
+    void Read(CLevelParserLine*) override {}
+    void SetGhostMode(bool) override {}
+
+    void TransformCrashSphere(Math::Sphere& crashSphere) override
+    {
+        crashSphere.radius *= m_scale.x;
+        crashSphere.pos = m_position + crashSphere.pos * m_scale.x;
+    }
+
+    void TransformCameraCollisionSphere(Math::Sphere&) override {}
+
+    void SetPosition(const glm::vec3& pos) override
+    {
+        m_position = pos;
+        m_grid.Update(this);
+    }
+
+    void SetScale(const glm::vec3& scale) override
+    {
+        m_scale = scale;
+        m_grid.UpdateShape(this);
+    }
+
+    //! Replaces the crash spheres, as done when an object changes shape
+    void ReplaceCrashSphere(const CrashSphere& crashSphere)
+    {
+        DeleteAllCrashSpheres();
+        AddCrashSphere(crashSphere);
+        m_grid.UpdateShape(this);
+    }
+
+private:
+    CObjectGrid& m_grid;
+};
+
+//! Distance from \a center to the surface of the first crash sphere
+float GetSphereDistance(CObject* object, const glm::vec3& center)
+{
+    Math::Sphere sphere = object->GetFirstCrashSphere().sphere;
+    glm::vec2 offset(sphere.pos.x - center.x, sphere.pos.z - center.z);
+    return glm::length(offset) - sphere.radius;
+}
+
+} // namespace
+
+class CObjectGridUT : public testing::Test
+{
+protected:
+    CGridTestObject* AddObject(const glm::vec3& pos)
+    {
+        auto object = std::make_unique<CGridTestObject>(static_cast<int>(m_objects.size()), m_grid);
+        object->AddCrashSphere(CrashSphere(glm::vec3(0.0f, 2.0f, 0.0f), 3.0f));
+        object->SetPosition(pos);
+        m_grid.Add(object.get());
+        m_objects.push_back(std::move(object));
+        return m_objects.back().get();
+    }
+
+    //! Objects near \a center found the way CObjectManager::GetObjectsNear() does, then checked
+    std::vector<CObject*> SearchGrid(const glm::vec3& center, float radius)
+    {
+        std::vector<CObject*> candidates;
+        m_grid.Find(center, radius + m_grid.GetCrashSphereReach(), candidates);
+
+        std::vector<CObject*> found;
+        for (CObject* object : candidates)
+        {
+            if (GetSphereDistance(object, center) <= radius)
+                found.push_back(object);
+        }
+        std::sort(found.begin(), found.end());
+        return found;
+    }
+
+    //! Objects near \a center found by checking all of them
+    std::vector<CObject*> SearchAll(const glm::vec3& center, float radius)
+    {
+        std::vector<CObject*> found;
+        for (const auto& object : m_objects)
+        {
+            if (GetSphereDistance(object.get(), center) <= radius)
+                found.push_back(object.get());
+        }
+        std::sort(found.begin(), found.end());
+        return found;
+    }
+
+    //! Compares both searches around many points
+    void ExpectSameSearches()
+    {
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> coordinate(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> radius(0.0f, 100.0f);
+        for (int i = 0; i < 500; ++i)
+        {
+            glm::vec3 center(coordinate(random), 0.0f, coordinate(random));
+            float r = radius(random);
+            EXPECT_EQ(SearchAll(center, r), SearchGrid(center, r)) << "at " << center.x << ", " << center.z << " within " << r;
+        }
+    }
+
+    CObjectGrid m_grid;
+    std::vector<std::unique_ptr<CGridTestObject>> m_objects;
+};
+
+TEST_F(CObjectGridUT, FindsSameObjectsAsLinearScan)
+{
+    std::mt19937 random(2);
+    std::uniform_real_distribution<float> coordinate(-500.0f, 500.0f);
+    for (int i = 0; i < 300; ++i)
+        AddObject(glm::vec3(coordinate(random), 0.0f, coordinate(random)));
+
+    ExpectSameSearches();
+
+    // moved objects change cells
+    for (auto& object : m_objects)
+        object->SetPosition(object->GetPosition() + glm::vec3(37.0f, 0.0f, -81.0f));
+
+    ExpectSameSearches();
+}
+
+TEST_F(CObjectGridUT, FindsScaledObjects)
+{
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> coordinate(-500.0f, 500.0f);
+    for (int i = 0; i < 300; ++i)
+        AddObject(glm::vec3(coordinate(random), 0.0f, coordinate(random)));
+
+    // objects growing after they were added reach further than any object did before
+    for (std::size_t i = 0; i < m_objects.size(); i += 10)
+        m_objects[i]->SetScale(glm::vec3(20.0f, 20.0f, 20.0f));
+
+    EXPECT_GE(m_grid.GetCrashSphereReach(), 3.0f * 20.0f);
+    ExpectSameSearches();
+}
+
+TEST_F(CObjectGridUT, FindsObjectsWithReplacedCrashSpheres)
+{
+    std::mt19937 random(4);
+    std::uniform_real_distribution<float> coordinate(-500.0f, 500.0f);
+    for (int i = 0; i < 300; ++i)
+        AddObject(glm::vec3(coordinate(random), 0.0f, coordinate(random)));
+
+    for (std::size_t i = 0; i < m_objects.size(); i += 7)
+        m_objects[i]->ReplaceCrashSphere(CrashSphere(glm::vec3(30.0f, 0.0f, 0.0f), 25.0f));
+
+    EXPECT_GE(m_grid.GetCrashSphereReach(), 55.0f);
+    ExpectSameSearches();
+}
+
+TEST_F(CObjectGridUT, ClearForgetsObjects)
+{
+    AddObject(glm::vec3(0.0f, 0.0f, 0.0f))->SetScale(glm::vec3(10.0f, 10.0f, 10.0f));
+    m_grid.Clear();
+
+    EXPECT_EQ(0, m_grid.GetCount());
+    EXPECT_EQ(0.0f, m_grid.GetCrashSphereReach());
+
+    // objects which are not in the grid are ignored
+    m_objects[0]->SetScale(glm::vec3(20.0f, 20.0f, 20.0f));
+    EXPECT_EQ(0.0f, m_grid.GetCrashSphereReach());
+}
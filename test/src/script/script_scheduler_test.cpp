@@ -0,0 +1,139 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "script/script_scheduler.h"
+
+#include "common/profiler.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+//! Runs a frame of \a programs programs, each running \a ticks ticks at 2 million ticks per second
+void RunFrame(CScriptScheduler& scheduler, int programs, int ipf, int ticks)
+{
+    scheduler.BeginFrame();
+    for (int i = 0; i < programs; ++i)
+    {
+        scheduler.GetTimerBudget(ipf);
+        scheduler.AddRun(ticks, ticks * 500LL);
+    }
+    scheduler.EndFrame();
+}
+
+} // anonymous namespace
+
+TEST(ScriptSchedulerTest, NoLimitKeepsIpf)
+{
+    CScriptScheduler scheduler;
+    scheduler.SetFrameBudget(0.0f);
+
+    scheduler.BeginFrame();
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(scheduler.GetTimerBudget(100), 100);
+        scheduler.AddRun(100, 1000000);
+    }
+    scheduler.EndFrame();
+}
+
+TEST(ScriptSchedulerTest, IpfIsUpperBound)
+{
+    CScriptScheduler scheduler;
+    scheduler.SetFrameBudget(1.0f);
+
+    scheduler.BeginFrame();
+    EXPECT_EQ(scheduler.GetTimerBudget(100), 100);
+    EXPECT_EQ(scheduler.GetTimerBudget(5), 5);
+    scheduler.EndFrame();
+}
+
+TEST(ScriptSchedulerTest, SharesFrameEqually)
+{
+    CScriptScheduler scheduler;
+    RunFrame(scheduler, 10, 100, 100);
+    EXPECT_DOUBLE_EQ(scheduler.GetTicksPerSecond(), 2000000.0);
+
+    // 0.5 ms is 1000 ticks for 10 programs
+    scheduler.SetFrameBudget(0.0005f);
+    CProfiler::ResetPerformanceStats();
+
+    scheduler.BeginFrame();
+    for (int i = 0; i < 10; ++i)
+    {
+        int ticks = scheduler.GetTimerBudget(500);
+        EXPECT_EQ(ticks, 100);
+        scheduler.AddRun(ticks, ticks * 500LL);
+    }
+    scheduler.EndFrame();
+
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_CBOT_THROTTLED_PROGRAMS), 10);
+    EXPECT_EQ(CProfiler::GetCurrentPerformanceStat(PSTAT_CBOT_TICKS), 1000);
+}
+
+TEST(ScriptSchedulerTest, UnusedTicksGoToLaterPrograms)
+{
+    CScriptScheduler scheduler;
+    RunFrame(scheduler, 10, 100, 100);
+    scheduler.SetFrameBudget(0.0005f);
+
+    scheduler.BeginFrame();
+    EXPECT_EQ(scheduler.GetTimerBudget(500), 100);
+    scheduler.AddRun(10, 5000);  // waits for a task
+    EXPECT_EQ(scheduler.GetTimerBudget(500), 110);
+    scheduler.EndFrame();
+}
+
+TEST(ScriptSchedulerTest, AlwaysLetsProgramsProgress)
+{
+    CScriptScheduler scheduler;
+    RunFrame(scheduler, 10, 100, 100);
+    scheduler.SetFrameBudget(0.0000001f);
+
+    scheduler.BeginFrame();
+    for (int i = 0; i < 10; ++i)
+    {
+        int ticks = scheduler.GetTimerBudget(100);
+        EXPECT_EQ(ticks, 1);
+        scheduler.AddRun(ticks, ticks * 500LL);
+    }
+    scheduler.EndFrame();
+}
+
+TEST(ScriptSchedulerTest, FollowsMeasuredSpeed)
+{
+    CScriptScheduler scheduler;
+    scheduler.SetFrameBudget(0.001f);
+
+    // Programs ten times slower than expected
+    for (int frame = 0; frame < 50; ++frame)
+    {
+        scheduler.BeginFrame();
+        int ticks = scheduler.GetTimerBudget(1000000);
+        scheduler.AddRun(ticks, ticks * 5000LL);
+        scheduler.EndFrame();
+    }
+
+    EXPECT_NEAR(scheduler.GetTicksPerSecond(), 200000.0, 1000.0);
+
+    scheduler.BeginFrame();
+    EXPECT_NEAR(scheduler.GetTimerBudget(1000000), 200, 1);
+    scheduler.EndFrame();
+}
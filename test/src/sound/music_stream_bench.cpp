@@ -0,0 +1,164 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "bench/bench.h"
+
+#include "sound/oalsound/music_stream.h"
+
+#include "common/resources/resourcemanager.h"
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <sndfile.h>
+
+namespace
+{
+
+constexpr int TRACK_SECONDS = 60;
+constexpr int TRACK_RATE = 44100;
+constexpr int TRACK_CHANNELS = 2;
+
+/**
+ * Generated music track, mounted in the resource system for the lifetime
+ * of the benchmark executable
+ *
+ * OGG is used when libsndfile supports writing it, like the game's music.
+ */
+class CBenchTrack
+{
+public:
+    CBenchTrack()
+    {
+        m_directory = std::filesystem::temp_directory_path() / "colobot-bench-music";
+        std::filesystem::create_directories(m_directory);
+
+        if (!Write("bench.ogg", SF_FORMAT_OGG | SF_FORMAT_VORBIS))
+            Write("bench.wav", SF_FORMAT_WAV | SF_FORMAT_PCM_16);
+
+        CResourceManager::AddLocation(m_directory.string());
+    }
+
+    ~CBenchTrack()
+    {
+        // the resource system is already shut down here
+        std::error_code error;
+        std::filesystem::remove_all(m_directory, error);
+    }
+
+    const std::string& GetName() const
+    {
+        return m_name;
+    }
+
+private:
+    bool Write(const std::string& name, int format)
+    {
+        SF_INFO info{};
+        info.samplerate = TRACK_RATE;
+        info.channels = TRACK_CHANNELS;
+        info.format = format;
+
+        SNDFILE* file = sf_open((m_directory / name).string().c_str(), SFM_WRITE, &info);
+        if (file == nullptr)
+            return false;
+
+        std::vector<short> samples(TRACK_RATE * TRACK_CHANNELS);
+        for (int second = 0; second < TRACK_SECONDS; ++second)
+        {
+            for (int i = 0; i < TRACK_RATE; ++i)
+            {
+                float t = static_cast<float>(second * TRACK_RATE + i) / TRACK_RATE;
+                samples[i * 2] = static_cast<short>(8000.0f * std::sin(t * 440.0f * 6.2832f));
+                samples[i * 2 + 1] = static_cast<short>(8000.0f * std::sin(t * 330.0f * 6.2832f));
+            }
+            sf_write_short(file, samples.data(), samples.size());
+        }
+
+        sf_close(file);
+        m_name = name;
+        return true;
+    }
+
+    std::filesystem::path m_directory;
+    std::string m_name;
+};
+
+const CBenchTrack& GetBenchTrack()
+{
+    static CBenchTrack track;
+    return track;
+}
+
+} // anonymous namespace
+
+// Steady state of playback: decoding one buffer, as done by CMusicStream::Update()
+BENCHMARK(MusicStreamDecode)
+{
+    CMusicStream music;
+    music.Open(GetBenchTrack().GetName());
+    music.SetLoop(true);
+
+    std::vector<int16_t> samples(CMusicStream::BUFFER_SAMPLES);
+
+    while (state.KeepRunning())
+    {
+        std::size_t count = music.Decode(samples.data(), samples.size());
+        Bench::DoNotOptimize(count);
+    }
+
+    state.SetItemsPerIteration(CMusicStream::BUFFER_SAMPLES);
+    state.SetCounter("stream_kb", CMusicStream::BUFFER_COUNT * CMusicStream::BUFFER_SAMPLES * sizeof(int16_t) / 1024.0);
+    state.SetCounter("track_kb", music.GetDuration() * music.GetSampleRate() * music.GetChannels() * sizeof(int16_t) / 1024.0);
+}
+
+// Work done before a track starts: opening and decoding the first buffers
+BENCHMARK(MusicStreamStart)
+{
+    std::vector<int16_t> samples(CMusicStream::BUFFER_SAMPLES);
+
+    while (state.KeepRunning())
+    {
+        CMusicStream music;
+        music.Open(GetBenchTrack().GetName());
+        for (int i = 0; i < CMusicStream::BUFFER_COUNT; ++i)
+            Bench::DoNotOptimize(music.Decode(samples.data(), samples.size()));
+    }
+}
+
+// Decoding the whole track at once, as done for sound effects by CBuffer, for comparison
+BENCHMARK(MusicFullDecode)
+{
+    std::vector<int16_t> samples(CMusicStream::BUFFER_SAMPLES);
+
+    while (state.KeepRunning())
+    {
+        CMusicStream music;
+        music.Open(GetBenchTrack().GetName());
+
+        std::vector<int16_t> track;
+        std::size_t count = 0;
+        while ((count = music.Decode(samples.data(), samples.size())) != 0)
+            track.insert(track.end(), samples.begin(), samples.begin() + count);
+
+        Bench::DoNotOptimize(track.size());
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "bench/bench.h"
+
+#include "CBot/CBotToken.h"
+
+#include "ui/controls/edit_layout.h"
+
+#include <algorithm>
+#include <string>
+
+using namespace Ui;
+
+namespace
+{
+
+//! Word typed into the middle of the program and removed again in every iteration
+const std::string WORD = "energyCell.energyLevel";
+
+// Breaks lines like CText::Justify() does, with all characters one unit wide
+CEditLayout::BreakLineFunction MakeBreakLine(const std::string& text)
+{
+    return [&text](int start, int indent, bool&)
+    {
+        int available = std::max(8, 100-4*indent);
+        int len = text.size();
+        int cut = 0;
+        for (int i = start; i < len; ++i)
+        {
+            if (text[i] == '\n') return i+1;
+            if (text[i] == ' ') cut = i+1;
+            if (i-start+1 > available) return cut == 0 ? i : cut;
+        }
+        return len;
+    };
+}
+
+//! Program of about \a lines lines, 8 lines per function
+std::string MakeProgram(int lines)
+{
+    std::string text;
+    for (int i = 0; i < lines/8; ++i)
+    {
+        text += "extern void object::Function" + std::to_string(i) + "()\n{\n";
+        text += "float sum = 0; // sum of \"levels\"\n";
+        text += "for (int i = 0; i < 10; i++)\n{\n";
+        text += "sum += radar(WingedGrabber).energyCell.energyLevel * i;\n";
+        text += "}\n}\n";
+    }
+    return text;
+}
+
+// Returns the line containing pos, which the studio colors again
+std::string GetLine(const std::string& text, int pos)
+{
+    std::size_t start = text.rfind('\n', pos-1) + 1;
+    std::size_t end = std::min(text.find('\n', pos), text.size());
+    return text.substr(start, end-start);
+}
+
+/**
+ * Types WORD and deletes it again, one character at a time, in the middle of a program,
+ * laying out and tokenizing after every keystroke like CEdit and CStudio do
+ * \param incremental true to update only the edited lines, false for the whole text every time
+ */
+void TypeIntoProgram(Bench::CState& state, int lines, bool incremental)
+{
+    std::string text = MakeProgram(lines);
+    auto breakLine = MakeBreakLine(text);
+
+    CEditLayout layout;
+    layout.Update(text, text.size(), true, breakLine);
+
+    const int pos = text.find("* i;", text.size()/2);
+    long long tokens = 0;
+
+    auto keystroke = [&](int cursor)
+    {
+        if (incremental)
+        {
+            layout.Update(text, text.size(), true, breakLine);
+            auto line = CBot::CBotToken::CompileTokens(GetLine(text, cursor));
+            tokens += line != nullptr;
+        }
+        else
+        {
+            layout.Invalidate();
+            layout.Update(text, text.size(), true, breakLine);
+            auto all = CBot::CBotToken::CompileTokens(text);
+            tokens += all != nullptr;
+        }
+    };
+
+    while (state.KeepRunning())
+    {
+        for (std::size_t i = 0; i < WORD.size(); ++i)
+        {
+            text.insert(pos+i, 1, WORD[i]);
+            layout.Insert(pos+i, 1);
+            keystroke(pos+i+1);
+        }
+        for (std::size_t i = WORD.size(); i > 0; --i)
+        {
+            text.erase(pos+i-1, 1);
+            layout.Erase(pos+i-1, 1);
+            keystroke(pos+i-1);
+        }
+    }
+
+    Bench::DoNotOptimize(tokens);
+    state.SetItemsPerIteration(2 * WORD.size());
+    state.SetCounter("lines", layout.GetLineTotal());
+}
+
+} // anonymous namespace
+
+BENCHMARK(EditTypingSmallProgram)
+{
+    TypeIntoProgram(state, 300, true);
+}
+
+BENCHMARK(EditTypingLargeProgram)
+{
+    TypeIntoProgram(state, 3000, true);
+}
+
+BENCHMARK(EditTypingLargeProgramFullUpdate)
+{
+    TypeIntoProgram(state, 3000, false);
+}
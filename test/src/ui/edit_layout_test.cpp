@@ -0,0 +1,182 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "ui/controls/edit_layout.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+using namespace Ui;
+
+namespace
+{
+
+// Breaks lines like CText::Justify() does, with all characters one unit wide
+CEditLayout::BreakLineFunction MakeBreakLine(const std::string& text, int width)
+{
+    return [&text, width](int start, int indent, bool&)
+    {
+        int available = std::max(8, width-4*indent);
+        int len = text.size();
+        int cut = 0;
+        for (int i = start; i < len; ++i)
+        {
+            if (text[i] == '\n') return i+1;
+            if (text[i] == ' ') cut = i+1;
+            if (i-start+1 > available) return cut == 0 ? i : cut;
+        }
+        return len;
+    };
+}
+
+std::string MakeProgram(int functions)
+{
+    std::string text;
+    for (int i = 0; i < functions; ++i)
+    {
+        text += "extern void object::Function" + std::to_string(i) + "()\n{\n";
+        text += "    int count = 0; // counts \"things\"\n";
+        text += "    for (int i = 0; i < 10; i++)\n    {\n";
+        text += "        message(\"Value {\" + i + \"} of a rather long line which has to be wrapped somewhere\");\n";
+        text += "    }\n}\n\n";
+    }
+    return text;
+}
+
+void ExpectSameLayout(const CEditLayout& layout, const std::string& text, int width)
+{
+    CEditLayout full;
+    full.Update(text, text.size(), true, MakeBreakLine(text, width));
+
+    ASSERT_EQ(layout.GetLineTotal(), full.GetLineTotal());
+    for (int line = 0; line <= full.GetLineTotal(); ++line)
+    {
+        ASSERT_EQ(layout.GetLineOffset(line), full.GetLineOffset(line)) << "line " << line;
+        ASSERT_EQ(layout.GetLineIndent(line), full.GetLineIndent(line)) << "line " << line;
+    }
+}
+
+void RandomEdits(int width)
+{
+    std::string text = MakeProgram(20);
+    CEditLayout layout;
+    layout.Update(text, text.size(), true, MakeBreakLine(text, width));
+
+    std::mt19937 random(width);
+    const std::string characters = "ab {}\"/\n";
+
+    for (int edit = 0; edit < 2000; ++edit)
+    {
+        int pos = std::uniform_int_distribution<int>(0, text.size())(random);
+        int kind = std::uniform_int_distribution<int>(0, 2)(random);
+        int count = std::uniform_int_distribution<int>(1, 3)(random);
+
+        if (kind == 0)
+        {
+            std::string inserted;
+            for (int i = 0; i < count; ++i)
+                inserted += characters[std::uniform_int_distribution<int>(0, characters.size()-1)(random)];
+            text.insert(pos, inserted);
+            layout.Insert(pos, count);
+        }
+        else if (kind == 1)
+        {
+            count = std::min<int>(count, text.size()-pos);
+            text.erase(pos, count);
+            layout.Erase(pos, count);
+        }
+        else
+        {
+            count = std::min<int>(count, text.size()-pos);
+            for (int i = pos; i < pos+count; ++i)
+                text[i] = characters[std::uniform_int_distribution<int>(0, characters.size()-1)(random)];
+            layout.Change(pos, count);
+        }
+
+        // Several edits may be recorded before the layout is updated
+        if (edit % 3 != 0) continue;
+
+        layout.Update(text, text.size(), true, MakeBreakLine(text, width));
+        ExpectSameLayout(layout, text, width);
+        if (::testing::Test::HasFatalFailure()) return;
+    }
+}
+
+} // anonymous namespace
+
+TEST(EditLayoutTest, FullLayout)
+{
+    std::string text = "void f()\n{\n{\n}\n}\n";
+    CEditLayout layout;
+    layout.Update(text, text.size(), true, MakeBreakLine(text, 80));
+
+    ASSERT_EQ(layout.GetLineTotal(), 6);
+    EXPECT_EQ(layout.GetLineOffset(0), 0);
+    EXPECT_EQ(layout.GetLineOffset(1), 9);
+    EXPECT_EQ(layout.GetLineOffset(5), static_cast<int>(text.size()));
+    EXPECT_EQ(layout.GetLineIndent(1), 0);
+    EXPECT_EQ(layout.GetLineIndent(2), 1);
+    EXPECT_EQ(layout.GetLineIndent(3), 1);  // closing brace
+    EXPECT_EQ(layout.GetLineIndent(4), 0);
+
+    EXPECT_EQ(layout.GetLine(0), 0);
+    EXPECT_EQ(layout.GetLine(8), 0);
+    EXPECT_EQ(layout.GetLine(9), 1);
+    EXPECT_EQ(layout.GetLine(static_cast<int>(text.size())), 5);
+}
+
+TEST(EditLayoutTest, IncrementalMatchesFull)
+{
+    RandomEdits(80);
+}
+
+TEST(EditLayoutTest, IncrementalMatchesFullWithWrapping)
+{
+    RandomEdits(24);
+}
+
+TEST(EditLayoutTest, TypingTouchesOnlyEditedLine)
+{
+    std::string text = MakeProgram(100);
+    int lines = 0;
+    CEditLayout layout;
+    auto breakLine = MakeBreakLine(text, 80);
+    auto countingBreakLine = [&](int start, int indent, bool& dual)
+    {
+        lines++;
+        return breakLine(start, indent, dual);
+    };
+    layout.Update(text, text.size(), true, countingBreakLine);
+
+    int pos = text.find("count = 0", text.size()/2);
+    text.insert(pos, "x");
+    layout.Insert(pos, 1);
+
+    lines = 0;
+    layout.Update(text, text.size(), true, countingBreakLine);
+    EXPECT_LE(lines, 2);
+    ExpectSameLayout(layout, text, 80);
+
+    lines = 0;
+    layout.Update(text, text.size(), true, countingBreakLine);
+    EXPECT_EQ(lines, 0);
+}
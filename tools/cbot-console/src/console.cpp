@@ -17,11 +17,20 @@
  * along with this program. If not, see http://gnu.org/licenses
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "common/restext.h"
 
+#include "common/thread/job_system.h"
+
 #include "CBot/CBot.h"
 
 using namespace CBot;
@@ -49,10 +58,110 @@ bool rMessage(CBotVar* var, CBotVar* result, int& exception, void* user)
     return true;
 }
 
+void InitializeCBot()
+{
+    CBotProgram::Init();
+    CBotProgram::AddFunction("message", rMessage, cMessage);
+}
+
+void PrintCompileError(CBotProgram* program, const std::string& fileName)
+{
+    CBotError error;
+    int cursor1, cursor2;
+    program->GetError(error, cursor1, cursor2);
+    std::string errorStr;
+    GetResource(RES_CBOT, error, errorStr);
+    if (!fileName.empty())
+        std::cerr << fileName << ": ";
+    std::cerr << "COMPILE ERROR: " << errorStr << " (code: " << error << ") @ " << cursor1 << " - " << cursor2 << std::endl;
+}
+
+/**
+ * Compiles all given files, every one in its own CBot context, on all cores
+ *
+ * Usage: CBot-Console [--jobs N] [--repeat R] file...
+ */
+int CompileFiles(int argc, char* argv[])
+{
+    int threadCount = 0;
+    int repeat = 1;
+    std::vector<std::string> fileNames;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--jobs" && i + 1 < argc)
+            threadCount = std::stoi(argv[++i]);
+        else if (arg == "--repeat" && i + 1 < argc)
+            repeat = std::max(1, std::stoi(argv[++i]));
+        else
+            fileNames.push_back(arg);
+    }
+
+    std::vector<std::string> codes;
+    for (const std::string& fileName : fileNames)
+    {
+        std::ifstream file(fileName);
+        if (!file)
+        {
+            std::cerr << "CANNOT READ FILE: " << fileName << std::endl;
+            return 1;
+        }
+        std::stringstream code;
+        code << file.rdbuf();
+        codes.push_back(code.str());
+    }
+
+    if (codes.empty())
+    {
+        std::cerr << "NO FILES GIVEN" << std::endl;
+        return 1;
+    }
+
+    // Contexts are independent, so there is no shared state to lock
+    std::atomic<int> errors{0};
+    int count = static_cast<int>(codes.size()) * repeat;
+
+    auto start = std::chrono::steady_clock::now();
+    CJobSystem jobSystem(threadCount);
+    jobSystem.ParallelFor(count, 1, [&](int index)
+    {
+        int file = index % static_cast<int>(codes.size());
+
+        CBotContext context;
+        CBotContextGuard guard(context);
+        InitializeCBot();
+
+        std::vector<std::string> externFunctions;
+        std::unique_ptr<CBotProgram> program{new CBotProgram(nullptr)};
+        if (!program->Compile(codes[file], externFunctions, nullptr))
+        {
+            if (index < static_cast<int>(codes.size()))
+                PrintCompileError(program.get(), fileNames[file]);
+            ++errors;
+        }
+
+        program.reset();
+        CBotProgram::Free();
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cerr << "Compiled " << count << " files on " << jobSystem.GetThreadCount() + 1 << " threads in "
+              << seconds << " s (" << count / seconds << " files/s), " << errors << " failed" << std::endl;
+
+    return errors > 0 ? 1 : 0;
+}
+
 } // namespace
 
 int main(int argc, char* argv[])
 {
+    // Error message strings are stored on Colobot side (meh!) so let's initialize that
+    InitializeRestext();
+
+    // Files given on command line are only compiled, all of them in parallel
+    if (argc > 1)
+        return CompileFiles(argc, argv);
+
     // Read program code from stdin
     std::string code = "";
     std::string line;
@@ -63,24 +172,14 @@ int main(int argc, char* argv[])
     }
 
     // Initialize the CBot engine, add standard library functions
-    CBotProgram::Init();
-    CBotProgram::AddFunction("message", rMessage, cMessage);
-
-    // Error message strings are stored on Colobot side (meh!) so let's initialize that
-    InitializeRestext();
-
+    InitializeCBot();
 
     // Compile the program
     std::vector<std::string> externFunctions;
     std::unique_ptr<CBotProgram> program{new CBotProgram(nullptr)};
     if (!program->Compile(code.c_str(), externFunctions, nullptr))
     {
-        CBotError error;
-        int cursor1, cursor2;
-        program->GetError(error, cursor1, cursor2);
-        std::string errorStr;
-        GetResource(RES_CBOT, error, errorStr);
-        std::cerr << "COMPILE ERROR: " << errorStr << " (code: " << error << ") @ " << cursor1 << " - " << cursor2 << std::endl;
+        PrintCompileError(program.get(), "");
         return 1;
     }
 